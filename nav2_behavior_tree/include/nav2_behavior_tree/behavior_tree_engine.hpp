@@ -26,6 +26,7 @@
 #include "behaviortree_cpp/xml_parsing.h"
 
 #include "nav2_ros_common/lifecycle_node.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -57,14 +58,17 @@ public:
    * @param tree BT to execute
    * @param onLoop Function to execute on each iteration of BT execution
    * @param cancelRequested Function to check if cancel was requested during BT execution
-   * @param loopTimeout Time period for each iteration of BT execution
+   * @param loopTimeout Time period for each iteration of BT execution, or maximum time
+   * period between iterations when executed event driven
+   * @param tickScheduler Tick scheduler to execute the BT event driven with, if any
    * @return nav2_behavior_tree::BtStatus Status of BT execution
    */
   BtStatus run(
     BT::Tree * tree,
     std::function<void()> onLoop,
     std::function<bool()> cancelRequested,
-    std::chrono::milliseconds loopTimeout = std::chrono::milliseconds(10));
+    std::chrono::milliseconds loopTimeout = std::chrono::milliseconds(10),
+    TickScheduler::SharedPtr tickScheduler = nullptr);
 
   /**
    * @brief Function to create a BT from a XML string
@@ -105,6 +109,22 @@ public:
   void haltAllActions(BT::Tree & tree);
 
 protected:
+  /**
+   * @brief Function to execute a BT when its nodes request it
+   * @param tree BT to execute
+   * @param onLoop Function to execute on each iteration of BT execution
+   * @param cancelRequested Function to check if cancel was requested during BT execution
+   * @param maxTickPeriod Maximum time period between iterations of BT execution
+   * @param tickScheduler Tick scheduler the nodes of the BT request iterations with
+   * @return nav2_behavior_tree::BtStatus Status of BT execution
+   */
+  BtStatus runEventDriven(
+    BT::Tree * tree,
+    std::function<void()> onLoop,
+    std::function<bool()> cancelRequested,
+    std::chrono::milliseconds maxTickPeriod,
+    TickScheduler::SharedPtr tickScheduler);
+
   // The factory that will be used to dynamically construct the behavior tree
   BT::BehaviorTreeFactory factory_;
 
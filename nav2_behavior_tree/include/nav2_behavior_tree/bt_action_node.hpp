@@ -25,6 +25,7 @@
 #include "rclcpp_action/rclcpp_action.hpp"
 #include "nav2_behavior_tree/bt_utils.hpp"
 #include "nav2_behavior_tree/json_utils.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -98,6 +99,11 @@ public:
     // Now that we have the ROS node to use, create the action client for this BT action
     action_client_ = node_->create_action_client<ActionT>(action_name, callback_group_);
 
+    // When executed event driven, tick the tree as soon as the action server responds
+    if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+      tick_scheduler->wakeOnActionEvents(action_client_);
+    }
+
     // Make sure the server is actually there before continuing
     RCLCPP_DEBUG(node_->get_logger(), "Waiting for \"%s\" action server", action_name.c_str());
     if (!action_client_->wait_for_action_server(wait_for_service_timeout_)) {
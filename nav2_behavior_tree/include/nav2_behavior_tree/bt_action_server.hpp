@@ -273,6 +273,12 @@ protected:
   // Duration for each iteration of BT execution
   std::chrono::milliseconds bt_loop_duration_;
 
+  // Maximum duration between iterations of BT execution when event driven
+  std::chrono::milliseconds bt_max_tick_period_;
+
+  // Wakes up the BT execution when event driven, null otherwise
+  nav2_behavior_tree::TickScheduler::SharedPtr tick_scheduler_;
+
   // Default timeout value while waiting for response from a server
   std::chrono::milliseconds default_server_timeout_;
 
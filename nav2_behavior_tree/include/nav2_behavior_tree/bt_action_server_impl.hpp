@@ -62,6 +62,12 @@ BtActionServer<ActionT, NodeT>::BtActionServer(
   if (!node->has_parameter("bt_loop_duration")) {
     node->declare_parameter("bt_loop_duration", 10);
   }
+  if (!node->has_parameter("bt_event_driven_ticks")) {
+    node->declare_parameter("bt_event_driven_ticks", false);
+  }
+  if (!node->has_parameter("bt_max_tick_period")) {
+    node->declare_parameter("bt_max_tick_period", 100);
+  }
   if (!node->has_parameter("default_server_timeout")) {
     node->declare_parameter("default_server_timeout", 20);
   }
@@ -170,6 +176,22 @@ bool BtActionServer<ActionT, NodeT>::on_configure()
   int bt_loop_duration;
   node->get_parameter("bt_loop_duration", bt_loop_duration);
   bt_loop_duration_ = std::chrono::milliseconds(bt_loop_duration);
+  bool bt_event_driven_ticks;
+  node->get_parameter("bt_event_driven_ticks", bt_event_driven_ticks);
+  int bt_max_tick_period;
+  node->get_parameter("bt_max_tick_period", bt_max_tick_period);
+  bt_max_tick_period_ = std::chrono::milliseconds(bt_max_tick_period);
+  tick_scheduler_ = bt_event_driven_ticks ?
+    std::make_shared<nav2_behavior_tree::TickScheduler>() : nullptr;
+  if (tick_scheduler_) {
+    // Cancel and preempt requests wake up the BT execution. A goal is only set canceling
+    // once its cancel request is accepted, so another tick follows within a loop duration
+    action_server_->set_request_callback(
+      [scheduler = tick_scheduler_, loop_duration = bt_loop_duration_]() {
+        scheduler->notify();
+        scheduler->requestTickWithin(loop_duration);
+      });
+  }
   int default_server_timeout;
   node->get_parameter("default_server_timeout", default_server_timeout);
   default_server_timeout_ = std::chrono::milliseconds(default_server_timeout);
@@ -194,6 +216,10 @@ bool BtActionServer<ActionT, NodeT>::on_configure()
   blackboard_->set<std::chrono::milliseconds>(
     "wait_for_service_timeout",
     wait_for_service_timeout_);
+  if (tick_scheduler_) {
+    blackboard_->set<nav2_behavior_tree::TickScheduler::SharedPtr>(
+      "tick_scheduler", tick_scheduler_);
+  }
 
   return true;
 }
@@ -278,6 +304,10 @@ bool BtActionServer<ActionT, NodeT>::loadBehaviorTree(const std::string & bt_xml
       blackboard->set<std::chrono::milliseconds>(
         "wait_for_service_timeout",
         wait_for_service_timeout_);
+      if (tick_scheduler_) {
+        blackboard->set<nav2_behavior_tree::TickScheduler::SharedPtr>(
+          "tick_scheduler", tick_scheduler_);
+      }
     }
   } catch (const std::exception & e) {
     setInternalError(ActionT::Result::FAILED_TO_LOAD_BEHAVIOR_TREE,
@@ -334,7 +364,11 @@ void BtActionServer<ActionT, NodeT>::executeCallback()
     };
 
   // Execute the BT that was previously created in the configure step
-  nav2_behavior_tree::BtStatus rc = bt_->run(&tree_, on_loop, is_canceling, bt_loop_duration_);
+  // When event driven, the tree is ticked when its nodes request it, or at the latest
+  // after bt_max_tick_period
+  nav2_behavior_tree::BtStatus rc = tick_scheduler_ ?
+    bt_->run(&tree_, on_loop, is_canceling, bt_max_tick_period_, tick_scheduler_) :
+    bt_->run(&tree_, on_loop, is_canceling, bt_loop_duration_);
 
   // Make sure that the Bt is not in a running state from a previous execution
   // note: if all the ControlNodes are implemented correctly, this is not needed.
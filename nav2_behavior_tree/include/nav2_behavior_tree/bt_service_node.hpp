@@ -25,6 +25,7 @@
 #include "nav2_ros_common/lifecycle_node.hpp"
 #include "nav2_behavior_tree/bt_utils.hpp"
 #include "nav2_behavior_tree/json_utils.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 #include "nav2_ros_common/service_client.hpp"
 
 namespace nav2_behavior_tree
@@ -117,6 +118,11 @@ public:
       service_client_ =
         node_->create_client<ServiceT>(
         service_name_, true /*creates and spins an internal executor*/);
+
+      // When executed event driven, tick the tree as soon as the service server responds
+      if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+        tick_scheduler->wakeOnServiceResponse(service_client_);
+      }
     }
   }
 
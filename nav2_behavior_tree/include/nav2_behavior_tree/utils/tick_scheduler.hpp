@@ -0,0 +1,179 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_BEHAVIOR_TREE__UTILS__TICK_SCHEDULER_HPP_
+#define NAV2_BEHAVIOR_TREE__UTILS__TICK_SCHEDULER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "behaviortree_cpp/blackboard.h"
+
+namespace nav2_behavior_tree
+{
+
+/**
+ * @class nav2_behavior_tree::TickScheduler
+ * @brief Wakes up an event driven behavior tree execution loop. Tree nodes notify it when
+ * something they wait on becomes available, e.g. an action feedback or result or a topic
+ * message, or request a tick after a delay for their timers. Notifications may come from
+ * any thread, including the middleware threads.
+ */
+class TickScheduler : public std::enable_shared_from_this<TickScheduler>
+{
+public:
+  using SharedPtr = std::shared_ptr<TickScheduler>;
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Gets the tick scheduler of a blackboard
+   * @param blackboard Blackboard of a tree node
+   * @return Tick scheduler, or nullptr if the tree is not executed event driven
+   */
+  static SharedPtr fromBlackboard(const BT::Blackboard::Ptr & blackboard)
+  {
+    SharedPtr scheduler;
+    if (!blackboard || !blackboard->get<SharedPtr>("tick_scheduler", scheduler)) {
+      return nullptr;
+    }
+    return scheduler;
+  }
+
+  /**
+   * @brief Requests a tick as soon as possible
+   */
+  void notify()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      notified_ = true;
+    }
+    cv_.notify_one();
+  }
+
+  /**
+   * @brief Requests a tick once a delay has elapsed, the earliest request is kept
+   * @param delay Delay after which to tick
+   */
+  void requestTickWithin(const std::chrono::nanoseconds & delay)
+  {
+    const auto deadline = Clock::now() + delay;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (has_deadline_ && deadline >= deadline_) {
+        return;
+      }
+      has_deadline_ = true;
+      deadline_ = deadline;
+    }
+    cv_.notify_one();
+  }
+
+  /**
+   * @brief Waits until a tick is requested, or until the maximum tick period has elapsed
+   * @param max_period Maximum time to wait for
+   * @return False if no tick was requested within the maximum tick period
+   */
+  bool waitForTick(const std::chrono::nanoseconds & max_period)
+  {
+    const auto timeout = Clock::now() + max_period;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      const auto now = Clock::now();
+      if (notified_ || (has_deadline_ && deadline_ <= now)) {
+        break;
+      }
+      if (now >= timeout) {
+        return false;
+      }
+      cv_.wait_until(lock, has_deadline_ && deadline_ < timeout ? deadline_ : timeout);
+    }
+    notified_ = false;
+    if (has_deadline_ && deadline_ <= Clock::now()) {
+      has_deadline_ = false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Drops the pending requests, before starting a new execution
+   */
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    notified_ = false;
+    has_deadline_ = false;
+  }
+
+  /**
+   * @brief Notifies the scheduler whenever a subscription receives a message, without
+   * taking the message. The message is still processed by the executor of the subscription.
+   * @param subscription Subscription to watch
+   */
+  template<typename SubscriptionT>
+  void wakeOnMessage(const std::shared_ptr<SubscriptionT> & subscription)
+  {
+    subscription->set_on_new_message_callback(
+      [weak_self = weak_from_this()](size_t) {
+        if (auto self = weak_self.lock()) {
+          self->notify();
+        }
+      });
+  }
+
+  /**
+   * @brief Notifies the scheduler whenever an action client receives a goal response,
+   * a feedback, a result or a cancel response
+   * @param action_client Action client to watch
+   */
+  template<typename ActionClientT>
+  void wakeOnActionEvents(const std::shared_ptr<ActionClientT> & action_client)
+  {
+    action_client->set_on_ready_callback(
+      [weak_self = weak_from_this()](size_t, int) {
+        if (auto self = weak_self.lock()) {
+          self->notify();
+        }
+      });
+  }
+
+  /**
+   * @brief Notifies the scheduler whenever a service client receives a response, without
+   * taking the response. The response is still processed by the executor of the client.
+   * @param service_client Service client to watch
+   */
+  template<typename ServiceClientT>
+  void wakeOnServiceResponse(const std::shared_ptr<ServiceClientT> & service_client)
+  {
+    service_client->set_on_new_response_callback(
+      [weak_self = weak_from_this()](size_t) {
+        if (auto self = weak_self.lock()) {
+          self->notify();
+        }
+      });
+  }
+
+protected:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool notified_{false};
+  bool has_deadline_{false};
+  Clock::time_point deadline_;
+};
+
+}  // namespace nav2_behavior_tree
+
+#endif  // NAV2_BEHAVIOR_TREE__UTILS__TICK_SCHEDULER_HPP_
@@ -19,6 +19,7 @@
 #include "std_msgs/msg/string.hpp"
 
 #include "nav2_behavior_tree/plugins/action/controller_selector_node.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 #include "rclcpp/rclcpp.hpp"
 
@@ -60,6 +61,11 @@ void ControllerSelector::createROSInterfaces()
       std::bind(&ControllerSelector::callbackControllerSelect, this, _1),
       nav2::qos::LatchedSubscriptionQoS(),
       callback_group_);
+
+    // When executed event driven, tick the tree as soon as a message arrives
+    if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+      tick_scheduler->wakeOnMessage(controller_selector_sub_);
+    }
   }
 }
 
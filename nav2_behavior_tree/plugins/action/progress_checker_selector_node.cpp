@@ -18,6 +18,7 @@
 #include "std_msgs/msg/string.hpp"
 
 #include "nav2_behavior_tree/plugins/action/progress_checker_selector_node.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 #include "rclcpp/rclcpp.hpp"
 
@@ -56,6 +57,11 @@ void ProgressCheckerSelector::createROSInterfaces()
       std::bind(&ProgressCheckerSelector::callbackProgressCheckerSelect, this, _1),
       nav2::qos::LatchedSubscriptionQoS(),
       callback_group_);
+
+    // When executed event driven, tick the tree as soon as a message arrives
+    if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+      tick_scheduler->wakeOnMessage(progress_checker_selector_sub_);
+    }
   }
 }
 
@@ -20,6 +20,7 @@
 #include "std_msgs/msg/string.hpp"
 
 #include "nav2_behavior_tree/plugins/action/smoother_selector_node.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 #include "rclcpp/rclcpp.hpp"
 
@@ -61,6 +62,11 @@ void SmootherSelector::createROSInterfaces()
       std::bind(&SmootherSelector::callbackSmootherSelect, this, _1),
       nav2::qos::LatchedSubscriptionQoS(),
       callback_group_);
+
+    // When executed event driven, tick the tree as soon as a message arrives
+    if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+      tick_scheduler->wakeOnMessage(smoother_selector_sub_);
+    }
   }
 }
 
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "nav2_behavior_tree/plugins/condition/is_battery_charging_condition.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -56,6 +57,11 @@ void IsBatteryChargingCondition::createROSInterfaces()
       std::bind(&IsBatteryChargingCondition::batteryCallback, this, std::placeholders::_1),
       nav2::qos::StandardTopicQoS(),
       callback_group_);
+
+    // When executed event driven, tick the tree as soon as a message arrives
+    if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+      tick_scheduler->wakeOnMessage(battery_sub_);
+    }
   }
 }
 
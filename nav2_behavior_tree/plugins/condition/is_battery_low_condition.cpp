@@ -16,6 +16,7 @@
 #include <string>
 
 #include "nav2_behavior_tree/plugins/condition/is_battery_low_condition.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -62,6 +63,11 @@ void IsBatteryLowCondition::createROSInterfaces()
       std::bind(&IsBatteryLowCondition::batteryCallback, this, std::placeholders::_1),
       nav2::qos::StandardTopicQoS(),
       callback_group_);
+
+    // When executed event driven, tick the tree as soon as a message arrives
+    if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+      tick_scheduler->wakeOnMessage(battery_sub_);
+    }
   }
 }
 
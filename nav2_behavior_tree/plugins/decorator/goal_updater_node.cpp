@@ -20,6 +20,7 @@
 #include "behaviortree_cpp/decorator_node.h"
 
 #include "nav2_behavior_tree/plugins/decorator/goal_updater_node.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 #include "rclcpp/rclcpp.hpp"
 
@@ -77,6 +78,12 @@ void GoalUpdater::createROSInterfaces()
       nav2::qos::StandardTopicQoS(),
       callback_group_);
   }
+
+  // When executed event driven, tick the tree as soon as a goal update arrives
+  if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+    tick_scheduler->wakeOnMessage(goal_sub_);
+    tick_scheduler->wakeOnMessage(goals_sub_);
+  }
 }
 
 inline BT::NodeStatus GoalUpdater::tick()
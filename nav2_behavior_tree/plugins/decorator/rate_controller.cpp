@@ -16,6 +16,7 @@
 #include <string>
 
 #include "nav2_behavior_tree/plugins/decorator/rate_controller.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
 
 namespace nav2_behavior_tree
 {
@@ -82,6 +83,13 @@ BT::NodeStatus RateController::tick()
     }
   }
 
+  // When executed event driven, tick the tree again once the period has expired
+  if (auto tick_scheduler = TickScheduler::fromBlackboard(config().blackboard)) {
+    tick_scheduler->requestTickWithin(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(period_) - elapsed));
+  }
+
   return status();
 }
 
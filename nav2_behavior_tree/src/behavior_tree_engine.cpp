@@ -51,8 +51,13 @@ BehaviorTreeEngine::run(
   BT::Tree * tree,
   std::function<void()> onLoop,
   std::function<bool()> cancelRequested,
-  std::chrono::milliseconds loopTimeout)
+  std::chrono::milliseconds loopTimeout,
+  TickScheduler::SharedPtr tickScheduler)
 {
+  if (tickScheduler) {
+    return runEventDriven(tree, onLoop, cancelRequested, loopTimeout, tickScheduler);
+  }
+
   nav2_behavior_tree::LoopRate loopRate(loopTimeout, tree);
   BT::NodeStatus result = BT::NodeStatus::RUNNING;
 
@@ -86,6 +91,44 @@ BehaviorTreeEngine::run(
   return (result == BT::NodeStatus::SUCCESS) ? BtStatus::SUCCEEDED : BtStatus::FAILED;
 }
 
+BtStatus
+BehaviorTreeEngine::runEventDriven(
+  BT::Tree * tree,
+  std::function<void()> onLoop,
+  std::function<bool()> cancelRequested,
+  std::chrono::milliseconds maxTickPeriod,
+  TickScheduler::SharedPtr tickScheduler)
+{
+  BT::NodeStatus result = BT::NodeStatus::RUNNING;
+  tickScheduler->reset();
+
+  // Loop until something happens with ROS or the node completes, only ticking
+  // when a node requested it or the maximum tick period has elapsed
+  try {
+    while (rclcpp::ok() && result == BT::NodeStatus::RUNNING) {
+      if (cancelRequested()) {
+        tree->haltTree();
+        return BtStatus::CANCELED;
+      }
+
+      result = tree->tickOnce();
+
+      onLoop();
+
+      if (result == BT::NodeStatus::RUNNING) {
+        tickScheduler->waitForTick(maxTickPeriod);
+      }
+    }
+  } catch (const std::exception & ex) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("BehaviorTreeEngine"),
+      "Behavior tree threw exception: %s. Exiting with failure.", ex.what());
+    return BtStatus::FAILED;
+  }
+
+  return (result == BT::NodeStatus::SUCCESS) ? BtStatus::SUCCEEDED : BtStatus::FAILED;
+}
+
 BT::Tree
 BehaviorTreeEngine::createTreeFromText(
   const std::string & xml_string,
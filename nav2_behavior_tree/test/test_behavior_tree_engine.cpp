@@ -0,0 +1,165 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "behaviortree_cpp/bt_factory.h"
+#include "nav2_behavior_tree/behavior_tree_engine.hpp"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
+#include "nav2_ros_common/lifecycle_node.hpp"
+
+using nav2_behavior_tree::BtStatus;
+using nav2_behavior_tree::TickScheduler;
+using namespace std::chrono_literals;  // NOLINT
+
+// Executes a tree whose single node keeps running, counting its ticks
+class BehaviorTreeEngineWrapper : public nav2_behavior_tree::BehaviorTreeEngine
+{
+public:
+  explicit BehaviorTreeEngineWrapper(nav2::LifecycleNode::SharedPtr node)
+  : BehaviorTreeEngine({}, node)
+  {
+    factory_.registerSimpleAction(
+      "KeepRunning", [this](BT::TreeNode &) {
+        ticks++;
+        return BT::NodeStatus::RUNNING;
+      });
+  }
+
+  BT::Tree createTree()
+  {
+    const std::string xml_txt =
+      R"(
+      <root BTCPP_format="4">
+        <BehaviorTree ID="MainTree">
+          <KeepRunning/>
+        </BehaviorTree>
+      </root>)";
+    return createTreeFromText(xml_txt, BT::Blackboard::create());
+  }
+
+  std::atomic<int> ticks{0};
+};
+
+class BehaviorTreeEngineTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    node_ = std::make_shared<nav2::LifecycleNode>("behavior_tree_engine_test");
+    engine_ = std::make_unique<BehaviorTreeEngineWrapper>(node_);
+    scheduler_ = std::make_shared<TickScheduler>();
+  }
+
+  nav2::LifecycleNode::SharedPtr node_;
+  std::unique_ptr<BehaviorTreeEngineWrapper> engine_;
+  TickScheduler::SharedPtr scheduler_;
+};
+
+TEST_F(BehaviorTreeEngineTest, eventDrivenCancel)
+{
+  auto tree = engine_->createTree();
+  std::atomic<bool> cancel{false};
+
+  // A cancel request notifying the scheduler ends the execution without waiting
+  // for the maximum tick period
+  std::thread canceler([&]() {
+      std::this_thread::sleep_for(50ms);
+      cancel = true;
+      scheduler_->notify();
+    });
+  const auto start = std::chrono::steady_clock::now();
+  const BtStatus status = engine_->run(
+    &tree, []() {}, [&]() {return cancel.load();}, 10s, scheduler_);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  canceler.join();
+
+  EXPECT_EQ(status, BtStatus::CANCELED);
+  EXPECT_GE(elapsed, 50ms);
+  EXPECT_LT(elapsed, 5s);
+  EXPECT_EQ(engine_->ticks.load(), 1);
+}
+
+TEST_F(BehaviorTreeEngineTest, eventDrivenPreempt)
+{
+  auto tree = engine_->createTree();
+  std::atomic<bool> preempt{false};
+  std::atomic<bool> preempted{false};
+  std::atomic<bool> cancel{false};
+
+  // A preempt request notifying the scheduler is handled on the next iteration,
+  // without waiting for the maximum tick period
+  auto on_loop = [&]() {
+      if (preempt) {
+        preempt = false;
+        preempted = true;
+      }
+    };
+  std::thread preempter([&]() {
+      std::this_thread::sleep_for(50ms);
+      preempt = true;
+      scheduler_->notify();
+      while (!preempted) {
+        std::this_thread::sleep_for(1ms);
+      }
+      cancel = true;
+      scheduler_->notify();
+    });
+  const auto start = std::chrono::steady_clock::now();
+  const BtStatus status = engine_->run(
+    &tree, on_loop, [&]() {return cancel.load();}, 10s, scheduler_);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  preempter.join();
+
+  EXPECT_EQ(status, BtStatus::CANCELED);
+  EXPECT_LT(elapsed, 5s);
+  EXPECT_EQ(engine_->ticks.load(), 2);
+}
+
+TEST_F(BehaviorTreeEngineTest, eventDrivenMaxTickPeriod)
+{
+  auto tree = engine_->createTree();
+  std::atomic<bool> cancel{false};
+
+  // Without notifications, the tree is still ticked at the maximum tick period
+  std::thread canceler([&]() {
+      std::this_thread::sleep_for(250ms);
+      cancel = true;
+    });
+  const BtStatus status = engine_->run(
+    &tree, []() {}, [&]() {return cancel.load();}, 50ms, scheduler_);
+  canceler.join();
+
+  EXPECT_EQ(status, BtStatus::CANCELED);
+  EXPECT_GE(engine_->ticks.load(), 2);
+  EXPECT_LE(engine_->ticks.load(), 7);
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
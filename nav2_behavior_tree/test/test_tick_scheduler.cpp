@@ -0,0 +1,140 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "behaviortree_cpp/blackboard.h"
+#include "nav2_behavior_tree/utils/tick_scheduler.hpp"
+#include "nav2_ros_common/lifecycle_node.hpp"
+#include "std_srvs/srv/empty.hpp"
+
+using nav2_behavior_tree::TickScheduler;
+using namespace std::chrono_literals;  // NOLINT
+
+TEST(TickSchedulerTest, fromBlackboard)
+{
+  auto blackboard = BT::Blackboard::create();
+  EXPECT_EQ(TickScheduler::fromBlackboard(blackboard), nullptr);
+
+  auto scheduler = std::make_shared<TickScheduler>();
+  blackboard->set<TickScheduler::SharedPtr>("tick_scheduler", scheduler);
+  EXPECT_EQ(TickScheduler::fromBlackboard(blackboard), scheduler);
+}
+
+TEST(TickSchedulerTest, waitForTick)
+{
+  auto scheduler = std::make_shared<TickScheduler>();
+
+  // Nothing requested, the maximum period elapses
+  auto start = TickScheduler::Clock::now();
+  EXPECT_FALSE(scheduler->waitForTick(20ms));
+  EXPECT_GE(TickScheduler::Clock::now() - start, 20ms);
+
+  // A pending notification returns immediately and is consumed
+  scheduler->notify();
+  EXPECT_TRUE(scheduler->waitForTick(10s));
+  EXPECT_FALSE(scheduler->waitForTick(1ms));
+
+  // A notification from another thread wakes up the wait
+  start = TickScheduler::Clock::now();
+  std::thread notifier([&]() {
+      std::this_thread::sleep_for(20ms);
+      scheduler->notify();
+    });
+  EXPECT_TRUE(scheduler->waitForTick(10s));
+  EXPECT_LT(TickScheduler::Clock::now() - start, 5s);
+  notifier.join();
+
+  // Reset drops the pending requests
+  scheduler->notify();
+  scheduler->reset();
+  EXPECT_FALSE(scheduler->waitForTick(1ms));
+}
+
+TEST(TickSchedulerTest, requestTickWithin)
+{
+  auto scheduler = std::make_shared<TickScheduler>();
+
+  // The earliest request is kept
+  auto start = TickScheduler::Clock::now();
+  scheduler->requestTickWithin(20ms);
+  scheduler->requestTickWithin(10s);
+  EXPECT_TRUE(scheduler->waitForTick(10s));
+  auto elapsed = TickScheduler::Clock::now() - start;
+  EXPECT_GE(elapsed, 20ms);
+  EXPECT_LT(elapsed, 5s);
+
+  // The request is consumed once it is due
+  EXPECT_FALSE(scheduler->waitForTick(1ms));
+
+  // A request beyond the maximum period does not shorten the wait
+  scheduler->requestTickWithin(10s);
+  EXPECT_FALSE(scheduler->waitForTick(20ms));
+
+  // An earlier notification does not consume a pending request
+  scheduler->reset();
+  scheduler->requestTickWithin(20ms);
+  scheduler->notify();
+  EXPECT_TRUE(scheduler->waitForTick(10s));
+  EXPECT_TRUE(scheduler->waitForTick(10s));
+  EXPECT_GE(TickScheduler::Clock::now() - start, 20ms);
+}
+
+TEST(TickSchedulerTest, wakeOnServiceResponse)
+{
+  auto scheduler = std::make_shared<TickScheduler>();
+  auto node = std::make_shared<nav2::LifecycleNode>("tick_scheduler_test");
+
+  auto server_node = std::make_shared<rclcpp::Node>("tick_scheduler_test_server");
+  auto server = server_node->create_service<std_srvs::srv::Empty>(
+    "wake_on_service_response",
+    [](
+      const std::shared_ptr<std_srvs::srv::Empty::Request>,
+      std::shared_ptr<std_srvs::srv::Empty::Response>) {});
+  rclcpp::executors::SingleThreadedExecutor server_executor;
+  server_executor.add_node(server_node);
+  std::thread server_thread([&]() {server_executor.spin();});
+
+  auto client = node->create_client<std_srvs::srv::Empty>("wake_on_service_response", true);
+  ASSERT_TRUE(client->wait_for_service(5s));
+  scheduler->wakeOnServiceResponse(client);
+  EXPECT_FALSE(scheduler->waitForTick(1ms));
+
+  // The response wakes up the wait, while still being received by the client
+  auto request = std::make_shared<std_srvs::srv::Empty::Request>();
+  auto future = client->async_call(request);
+  auto start = TickScheduler::Clock::now();
+  EXPECT_TRUE(scheduler->waitForTick(10s));
+  EXPECT_LT(TickScheduler::Clock::now() - start, 5s);
+  EXPECT_EQ(client->spin_until_complete(future, 5s), rclcpp::FutureReturnCode::SUCCESS);
+
+  server_executor.cancel();
+  server_thread.join();
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
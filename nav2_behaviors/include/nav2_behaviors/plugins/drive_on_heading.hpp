@@ -21,6 +21,7 @@
 #include <string>
 #include <utility>
 #include <limits>
+#include <vector>
 
 #include "nav2_behaviors/timed_behavior.hpp"
 #include "nav2_msgs/action/drive_on_heading.hpp"
@@ -216,7 +217,7 @@ protected:
     const int max_cycle_count = static_cast<int>(this->cycle_frequency_ * simulate_ahead_time_);
     geometry_msgs::msg::Pose init_pose = pose;
     double init_theta = tf2::getYaw(init_pose.orientation);
-    bool fetch_data = true;
+    simulated_poses_.clear();
 
     while (cycle_count < max_cycle_count) {
       sim_position_change = cmd_vel.linear.x * (cycle_count / this->cycle_frequency_);
@@ -228,12 +229,12 @@ protected:
         break;
       }
 
-      if (!this->local_collision_checker_->isCollisionFree(pose, fetch_data)) {
-        return false;
-      }
-      fetch_data = false;
+      simulated_poses_.push_back(pose);
     }
-    return true;
+
+    // Check the footprint swept along the simulated poses at once
+    return simulated_poses_.empty() ||
+           this->local_collision_checker_->isTrajectoryCollisionFree(simulated_poses_);
   }
 
   /**
@@ -285,6 +286,7 @@ protected:
   double deceleration_limit_;
   double minimum_speed_;
   double last_vel_ = std::numeric_limits<double>::max();
+  std::vector<geometry_msgs::msg::Pose> simulated_poses_;
 };
 
 }  // namespace nav2_behaviors
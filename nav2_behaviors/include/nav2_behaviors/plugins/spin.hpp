@@ -18,6 +18,7 @@
 #include <chrono>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "nav2_behaviors/timed_behavior.hpp"
 #include "nav2_msgs/action/spin.hpp"
@@ -95,6 +96,7 @@ protected:
   double simulate_ahead_time_;
   rclcpp::Duration command_time_allowance_{0, 0};
   rclcpp::Time end_time_;
+  std::vector<geometry_msgs::msg::Pose> simulated_poses_;
 };
 
 }  // namespace nav2_behaviors
@@ -173,7 +173,7 @@ bool Spin::isCollisionFree(
   const int max_cycle_count = static_cast<int>(cycle_frequency_ * simulate_ahead_time_);
   geometry_msgs::msg::Pose init_pose = pose;
   double init_theta = tf2::getYaw(init_pose.orientation);
-  bool fetch_data = true;
+  simulated_poses_.clear();
 
   while (cycle_count < max_cycle_count) {
     sim_position_change = cmd_vel.angular.z * (cycle_count / cycle_frequency_);
@@ -185,12 +185,12 @@ bool Spin::isCollisionFree(
       break;
     }
 
-    if (!local_collision_checker_->isCollisionFree(pose, fetch_data)) {
-      return false;
-    }
-    fetch_data = false;
+    simulated_poses_.push_back(pose);
   }
-  return true;
+
+  // Check the footprint swept along the simulated poses at once
+  return simulated_poses_.empty() ||
+         local_collision_checker_->isTrajectoryCollisionFree(simulated_poses_);
 }
 
 }  // namespace nav2_behaviors
@@ -24,6 +24,7 @@
 #include "geometry_msgs/msg/twist.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
 #include "geometry_msgs/msg/twist_stamped.hpp"
+#include "std_msgs/msg/float64.hpp"
 
 #include "tf2/time.hpp"
 #include "tf2_ros/buffer.h"
@@ -103,6 +104,14 @@ protected:
    */
   void cmdVelInCallbackStamped(geometry_msgs::msg::TwistStamped::SharedPtr msg);
   void cmdVelInCallbackUnstamped(geometry_msgs::msg::Twist::SharedPtr msg);
+  /**
+   * @brief Callback executed when any of data sources receives new data.
+   * In event-driven mode re-evaluates the latest input cmd_vel against the new data,
+   * to apply a new restriction without waiting for the next input cmd_vel.
+   * @param source_name Name of the source which received the data
+   * @param stamp Timestamp of received source data
+   */
+  void sourceDataCallback(const std::string & source_name, const rclcpp::Time & stamp);
   /**
    * @brief Publishes output cmd_vel. If robot was stopped more than stop_pub_timeout_ seconds,
    * quit to publish 0-velocity.
@@ -154,8 +163,21 @@ protected:
    * @brief Main processing routine
    * @param cmd_vel_in Input desired robot velocity
    * @param header Twist header
+   * @param source_event Whether re-evaluating the latest input cmd_vel on new source data.
+   * Then the output cmd_vel is only published when a new restriction is to be applied,
+   * never passing the input cmd_vel through again.
+   */
+  void process(
+    const Velocity & cmd_vel_in, const std_msgs::msg::Header & header,
+    const bool source_event = false);
+
+  /**
+   * @brief Sets the union bounding box of all enabled polygons as the region of interest
+   * for all data sources. If there is an APPROACH polygon enabled or an enabled polygon
+   * whose shape is not set yet, the region of interest is being reset, since any source point
+   * might be relevant.
    */
-  void process(const Velocity & cmd_vel_in, const std_msgs::msg::Header & header);
+  void updateSourcesBounds();
 
   /**
    * @brief Processes the polygon of STOP, SLOWDOWN and LIMIT action type
@@ -164,13 +186,16 @@ protected:
    * array of source's 2D obstacle points as value
    * @param velocity Desired robot velocity
    * @param robot_action Output processed robot action
+   * @param action_stamp Output timestamp of the source data which caused the robot action,
+   * set for STOP action only
    * @return True if returned action is caused by current polygon, otherwise false
    */
   bool processStopSlowdownLimit(
     const std::shared_ptr<Polygon> polygon,
     const std::unordered_map<std::string, std::vector<Point>> & sources_collision_points_map,
     const Velocity & velocity,
-    Action & robot_action) const;
+    Action & robot_action,
+    rclcpp::Time & action_stamp) const;
 
   /**
    * @brief Processes APPROACH action type
@@ -200,6 +225,26 @@ protected:
    */
   void publishPolygons() const;
 
+  /**
+   * @brief Gets the latest timestamp of the data of the sources having points inside the polygon
+   * @param polygon Polygon to check
+   * @param sources_collision_points_map Map containing source name as key and
+   * array of source's 2D obstacle points as value
+   * @return Timestamp of the data, zero time if no source data is inside the polygon
+   */
+  rclcpp::Time getPolygonDataStamp(
+    const std::shared_ptr<Polygon> polygon,
+    const std::unordered_map<std::string, std::vector<Point>> & sources_collision_points_map)
+  const;
+
+  /**
+   * @brief Publishes the time passed from the stamp of the source data which caused
+   * the robot stop till the moment when the stop has been published
+   * @param curr_time Current node time
+   * @param stop_source_stamp Timestamp of the source data which caused the stop
+   */
+  void publishStopLatency(const rclcpp::Time & curr_time, const rclcpp::Time & stop_source_stamp);
+
   // ----- Variables -----
 
   /// @brief TF buffer
@@ -212,6 +257,11 @@ protected:
 
   /// @brief Data sources array
   std::vector<std::shared_ptr<Source>> sources_;
+  /// @brief Points arrays collected from data sources in a robot base frame.
+  /// Kept between processing cycles to avoid memory reallocations.
+  std::unordered_map<std::string, std::vector<Point>> sources_collision_points_map_;
+  /// @brief Whether to drop source points outside of the polygons bounding box
+  bool filter_sources_by_polygons_;
 
   // Input/output speed controls
   /// @brief Input cmd_vel subscriber
@@ -227,9 +277,25 @@ protected:
   nav2::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr
     collision_points_marker_pub_;
 
+  /// @brief Sensor stamp to published stop latency publisher
+  nav2::Publisher<std_msgs::msg::Float64>::SharedPtr stop_latency_pub_;
+
   /// @brief Whether main routine is active
   bool process_active_;
 
+  /// @brief Whether to re-evaluate latest input cmd_vel each time new source data arrives
+  bool event_driven_processing_;
+  /// @brief Time interval during which latest input cmd_vel is re-evaluated in event-driven mode
+  rclcpp::Duration event_driven_cmd_vel_timeout_;
+  /// @brief Latest input cmd_vel
+  Velocity cmd_vel_in_prev_;
+  /// @brief Header of latest input cmd_vel
+  std_msgs::msg::Header cmd_vel_in_header_prev_;
+  /// @brief Node time when latest input cmd_vel was received
+  rclcpp::Time cmd_vel_in_stamp_;
+  /// @brief Timestamp of the most recent data received by each source
+  std::unordered_map<std::string, rclcpp::Time> source_stamps_;
+
   /// @brief Previous robot action
   Action robot_action_prev_;
   /// @brief Latest timestamp when robot has 0-velocity
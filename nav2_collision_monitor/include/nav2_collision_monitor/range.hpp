@@ -76,6 +76,16 @@ public:
     std::vector<Point> & data);
 
 protected:
+  /**
+   * @brief Transforms the range point at given angle to base frame
+   * and adds it to the data array, if it is inside the region of interest
+   * @param tf_transform Source->base frame transform
+   * @param angle Angle of the point in source frame
+   * @param data Array where the point to be added
+   */
+  void addPoint(
+    const tf2::Transform & tf_transform, const float angle, std::vector<Point> & data) const;
+
   /**
    * @brief Getting sensor-specific ROS-parameters
    * @param source_topic Output name of source subscription topic
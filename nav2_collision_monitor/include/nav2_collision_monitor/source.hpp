@@ -15,6 +15,7 @@
 #ifndef NAV2_COLLISION_MONITOR__SOURCE_HPP_
 #define NAV2_COLLISION_MONITOR__SOURCE_HPP_
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include <string>
@@ -93,6 +94,25 @@ public:
    */
   rclcpp::Duration getSourceTimeout() const;
 
+  /**
+   * @brief Sets the region of interest in base frame. Source points falling outside of it
+   * are being dropped right after transformation and are not added to the data array.
+   * @param min_point Lower-left corner of the region of interest
+   * @param max_point Upper-right corner of the region of interest
+   */
+  void setPointsBounds(const Point & min_point, const Point & max_point);
+
+  /**
+   * @brief Disables region of interest: all source points are added to the data array
+   */
+  void resetPointsBounds();
+
+  /**
+   * @brief Sets the callback to be called each time new data arrives to the source
+   * @param callback Callback taking the timestamp of received data
+   */
+  void setDataReceivedCallback(std::function<void(const rclcpp::Time &)> callback);
+
 protected:
   /**
    * @brief Source configuration routine.
@@ -138,6 +158,25 @@ protected:
     const std_msgs::msg::Header & data_header,
     tf2::Transform & tf_transform) const;
 
+  /**
+   * @brief Checks whether the point in base frame is inside the region of interest
+   * @param x X-coordinate of the point in base frame
+   * @param y Y-coordinate of the point in base frame
+   * @return True if the point is inside the region of interest or region is not set
+   */
+  inline bool inPointsBounds(const double x, const double y) const
+  {
+    return !points_bounds_set_ ||
+           (x >= points_bounds_min_.x && x <= points_bounds_max_.x &&
+           y >= points_bounds_min_.y && y <= points_bounds_max_.y);
+  }
+
+  /**
+   * @brief Notifies the subscriber set by setDataReceivedCallback() about new source data
+   * @param stamp Timestamp of received data
+   */
+  void notifyDataReceived(const rclcpp::Time & stamp) const;
+
   // ----- Variables -----
 
   /// @brief Collision Monitor node
@@ -167,6 +206,16 @@ protected:
   bool base_shift_correction_;
   /// @brief Whether source is enabled
   bool enabled_;
+
+  /// @brief Whether the region of interest for source points is set
+  bool points_bounds_set_;
+  /// @brief Lower-left corner of the region of interest in base frame
+  Point points_bounds_min_;
+  /// @brief Upper-right corner of the region of interest in base frame
+  Point points_bounds_max_;
+
+  /// @brief Callback to be called on new source data
+  std::function<void(const rclcpp::Time &)> data_received_callback_;
 };  // class Source
 
 }  // namespace nav2_collision_monitor
@@ -14,6 +14,7 @@
 
 #include "nav2_collision_monitor/collision_monitor_node.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <utility>
 #include <functional>
@@ -30,7 +31,11 @@ namespace nav2_collision_monitor
 
 CollisionMonitor::CollisionMonitor(const rclcpp::NodeOptions & options)
 : nav2::LifecycleNode("collision_monitor", options),
-  process_active_(false), robot_action_prev_{DO_NOTHING, {-1.0, -1.0, -1.0}, ""},
+  filter_sources_by_polygons_(false), process_active_(false),
+  event_driven_processing_(false), event_driven_cmd_vel_timeout_(0, 500000000),
+  cmd_vel_in_prev_{0.0, 0.0, 0.0},
+  cmd_vel_in_stamp_{0, 0, get_clock()->get_clock_type()},
+  robot_action_prev_{DO_NOTHING, {-1.0, -1.0, -1.0}, ""},
   stop_stamp_{0, 0, get_clock()->get_clock_type()}, stop_pub_timeout_(1.0, 0.0)
 {
 }
@@ -81,6 +86,8 @@ CollisionMonitor::on_configure(const rclcpp_lifecycle::State & state)
   collision_points_marker_pub_ = this->create_publisher<visualization_msgs::msg::MarkerArray>(
     "~/collision_points_marker");
 
+  stop_latency_pub_ = this->create_publisher<std_msgs::msg::Float64>("~/stop_latency");
+
   nav2::declare_parameter_if_not_declared(
     node, "use_realtime_priority", rclcpp::ParameterValue(false));
   bool use_realtime_priority = false;
@@ -109,6 +116,7 @@ CollisionMonitor::on_activate(const rclcpp_lifecycle::State & /*state*/)
     state_pub_->on_activate();
   }
   collision_points_marker_pub_->on_activate();
+  stop_latency_pub_->on_activate();
 
   // Activating polygons
   for (std::shared_ptr<Polygon> polygon : polygons_) {
@@ -139,6 +147,11 @@ CollisionMonitor::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
   // Reset action type to default after worker deactivating
   robot_action_prev_ = {DO_NOTHING, {-1.0, -1.0, -1.0}, ""};
 
+  // Forget the source data stamps, not to measure the latency against stale data on reactivation
+  for (auto & source_stamp : source_stamps_) {
+    source_stamp.second = rclcpp::Time(0, 0, get_clock()->get_clock_type());
+  }
+
   // Deactivating polygons
   for (std::shared_ptr<Polygon> polygon : polygons_) {
     polygon->deactivate();
@@ -150,6 +163,7 @@ CollisionMonitor::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
     state_pub_->on_deactivate();
   }
   collision_points_marker_pub_->on_deactivate();
+  stop_latency_pub_->on_deactivate();
 
   // Destroying bond connection
   destroyBond();
@@ -166,9 +180,12 @@ CollisionMonitor::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   cmd_vel_out_pub_.reset();
   state_pub_.reset();
   collision_points_marker_pub_.reset();
+  stop_latency_pub_.reset();
 
   polygons_.clear();
   sources_.clear();
+  sources_collision_points_map_.clear();
+  source_stamps_.clear();
 
   tf_listener_.reset();
   tf_buffer_.reset();
@@ -192,7 +209,11 @@ void CollisionMonitor::cmdVelInCallbackStamped(geometry_msgs::msg::TwistStamped:
     return;
   }
 
-  process({msg->twist.linear.x, msg->twist.linear.y, msg->twist.angular.z}, msg->header);
+  cmd_vel_in_prev_ = {msg->twist.linear.x, msg->twist.linear.y, msg->twist.angular.z};
+  cmd_vel_in_header_prev_ = msg->header;
+  cmd_vel_in_stamp_ = this->now();
+
+  process(cmd_vel_in_prev_, msg->header);
 }
 
 void CollisionMonitor::cmdVelInCallbackUnstamped(geometry_msgs::msg::Twist::SharedPtr msg)
@@ -202,6 +223,33 @@ void CollisionMonitor::cmdVelInCallbackUnstamped(geometry_msgs::msg::Twist::Shar
   cmdVelInCallbackStamped(twist_stamped);
 }
 
+void CollisionMonitor::sourceDataCallback(
+  const std::string & source_name, const rclcpp::Time & stamp)
+{
+  auto source_stamp = source_stamps_.find(source_name);
+  if (source_stamp != source_stamps_.end() &&
+    stamp.nanoseconds() > source_stamp->second.nanoseconds())
+  {
+    source_stamp->second = rclcpp::Time(stamp.nanoseconds(), get_clock()->get_clock_type());
+  }
+
+  if (!event_driven_processing_ || !process_active_) {
+    return;
+  }
+
+  // Re-evaluate only the command the robot is still supposed to execute:
+  // for zero-velocity one there is nothing to be restricted
+  if (cmd_vel_in_prev_.isZero() ||
+    this->now() - cmd_vel_in_stamp_ > event_driven_cmd_vel_timeout_)
+  {
+    return;
+  }
+
+  std_msgs::msg::Header header = cmd_vel_in_header_prev_;
+  header.stamp = this->now();
+  process(cmd_vel_in_prev_, header, true);
+}
+
 void CollisionMonitor::publishVelocity(
   const Action & robot_action, const std_msgs::msg::Header & header)
 {
@@ -271,6 +319,18 @@ bool CollisionMonitor::getParameters(
   stop_pub_timeout_ =
     rclcpp::Duration::from_seconds(get_parameter("stop_pub_timeout").as_double());
 
+  nav2::declare_parameter_if_not_declared(
+    node, "filter_sources_by_polygons", rclcpp::ParameterValue(false));
+  filter_sources_by_polygons_ = get_parameter("filter_sources_by_polygons").as_bool();
+
+  nav2::declare_parameter_if_not_declared(
+    node, "event_driven_processing", rclcpp::ParameterValue(false));
+  event_driven_processing_ = get_parameter("event_driven_processing").as_bool();
+  nav2::declare_parameter_if_not_declared(
+    node, "event_driven_cmd_vel_timeout", rclcpp::ParameterValue(0.5));
+  event_driven_cmd_vel_timeout_ =
+    rclcpp::Duration::from_seconds(get_parameter("event_driven_cmd_vel_timeout").as_double());
+
   if (
     !configureSources(
       base_frame_id, odom_frame_id, transform_tolerance, source_timeout, base_shift_correction))
@@ -394,6 +454,16 @@ bool CollisionMonitor::configureSources(
         return false;
       }
     }
+
+    // Track incoming source data for event-driven processing and latency measurement
+    for (std::shared_ptr<Source> source : sources_) {
+      const std::string source_name = source->getSourceName();
+      source_stamps_.emplace(source_name, rclcpp::Time(0, 0, get_clock()->get_clock_type()));
+      source->setDataReceivedCallback(
+        [this, source_name](const rclcpp::Time & stamp) {
+          sourceDataCallback(source_name, stamp);
+        });
+    }
   } catch (const std::exception & ex) {
     RCLCPP_ERROR(get_logger(), "Error while getting parameters: %s", ex.what());
     return false;
@@ -402,7 +472,8 @@ bool CollisionMonitor::configureSources(
   return true;
 }
 
-void CollisionMonitor::process(const Velocity & cmd_vel_in, const std_msgs::msg::Header & header)
+void CollisionMonitor::process(
+  const Velocity & cmd_vel_in, const std_msgs::msg::Header & header, const bool source_event)
 {
   // Current timestamp for all inner routines prolongation
   rclcpp::Time curr_time = this->now();
@@ -412,18 +483,35 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in, const std_msgs::msg:
     return;
   }
 
-  // Points array collected from different data sources in a robot base frame
-  std::unordered_map<std::string, std::vector<Point>> sources_collision_points_map;
+  // Points arrays collected from different data sources in a robot base frame are
+  // kept between the cycles: only clearing them to reuse already allocated memory
+  for (auto & source_points : sources_collision_points_map_) {
+    source_points.second.clear();
+  }
 
   // By default - there is no action
   Action robot_action{DO_NOTHING, cmd_vel_in, ""};
   // Polygon causing robot action (if any)
   std::shared_ptr<Polygon> action_polygon;
+  // Timestamp of the source data causing robot stop (if any)
+  rclcpp::Time stop_source_stamp(0, 0, get_clock()->get_clock_type());
+
+  // Update polygons coordinates
+  for (std::shared_ptr<Polygon> polygon : polygons_) {
+    if (polygon->getEnabled()) {
+      polygon->updatePolygon(cmd_vel_in);
+    }
+  }
+
+  // Limit source points to the area covered by the polygons
+  if (filter_sources_by_polygons_) {
+    updateSourcesBounds();
+  }
 
   // Fill collision points array from different data sources
   auto marker_array = std::make_unique<visualization_msgs::msg::MarkerArray>();
   for (std::shared_ptr<Source> source : sources_) {
-    auto iter = sources_collision_points_map.insert(
+    auto iter = sources_collision_points_map_.insert(
       {source->getSourceName(), std::vector<Point>()});
 
     if (source->getEnabled()) {
@@ -456,6 +544,7 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in, const std_msgs::msg:
       marker.lifetime = rclcpp::Duration(0, 0);
       marker.frame_locked = true;
 
+      marker.points.reserve(iter.first->second.size());
       for (const auto & point : iter.first->second) {
         geometry_msgs::msg::Point p;
         p.x = point.x;
@@ -480,20 +569,17 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in, const std_msgs::msg:
       break;
     }
 
-    // Update polygon coordinates
-    polygon->updatePolygon(cmd_vel_in);
-
     const ActionType at = polygon->getActionType();
     if (at == STOP || at == SLOWDOWN || at == LIMIT) {
       // Process STOP/SLOWDOWN for the selected polygon
       if (processStopSlowdownLimit(
-          polygon, sources_collision_points_map, cmd_vel_in, robot_action))
+          polygon, sources_collision_points_map_, cmd_vel_in, robot_action, stop_source_stamp))
       {
         action_polygon = polygon;
       }
     } else if (at == APPROACH) {
       // Process APPROACH for the selected polygon
-      if (processApproach(polygon, sources_collision_points_map, cmd_vel_in, robot_action)) {
+      if (processApproach(polygon, sources_collision_points_map_, cmd_vel_in, robot_action)) {
         action_polygon = polygon;
       }
     }
@@ -504,8 +590,21 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in, const std_msgs::msg:
     notifyActionState(robot_action, action_polygon);
   }
 
-  // Publish required robot velocity
-  publishVelocity(robot_action, header);
+  // Publish required robot velocity. On new source data, only a changed restriction is
+  // published: the input cmd_vel might be stale, e.g. if its publisher stopped, so it is
+  // never passed through again, and released restrictions wait for the next input cmd_vel.
+  if (!source_event ||
+    (robot_action.action_type != DO_NOTHING &&
+    (robot_action.action_type != robot_action_prev_.action_type ||
+    robot_action.polygon_name != robot_action_prev_.polygon_name)))
+  {
+    publishVelocity(robot_action, header);
+  }
+
+  if (robot_action.action_type == STOP && robot_action_prev_.action_type != STOP) {
+    // Report the reaction time for the robot stop
+    publishStopLatency(curr_time, stop_source_stamp);
+  }
 
   // Publish polygons for better visualization
   publishPolygons();
@@ -513,11 +612,58 @@ void CollisionMonitor::process(const Velocity & cmd_vel_in, const std_msgs::msg:
   robot_action_prev_ = robot_action;
 }
 
+void CollisionMonitor::updateSourcesBounds()
+{
+  bool bounds_set = false;
+  Point min_point{0.0, 0.0}, max_point{0.0, 0.0};
+  std::vector<Point> poly;
+
+  for (std::shared_ptr<Polygon> polygon : polygons_) {
+    if (!polygon->getEnabled()) {
+      continue;
+    }
+    if (polygon->getActionType() == APPROACH) {
+      // APPROACH polygons are being moved along the simulated trajectory,
+      // so any source point could become a collision one
+      bounds_set = false;
+      break;
+    }
+    if (!polygon->isShapeSet()) {
+      // The shape of the polygon is not received yet, so the area it will cover is unknown
+      bounds_set = false;
+      break;
+    }
+
+    polygon->getPolygon(poly);
+    for (const Point & p : poly) {
+      if (!bounds_set) {
+        min_point = p;
+        max_point = p;
+        bounds_set = true;
+        continue;
+      }
+      min_point.x = std::min(min_point.x, p.x);
+      min_point.y = std::min(min_point.y, p.y);
+      max_point.x = std::max(max_point.x, p.x);
+      max_point.y = std::max(max_point.y, p.y);
+    }
+  }
+
+  for (std::shared_ptr<Source> source : sources_) {
+    if (bounds_set) {
+      source->setPointsBounds(min_point, max_point);
+    } else {
+      source->resetPointsBounds();
+    }
+  }
+}
+
 bool CollisionMonitor::processStopSlowdownLimit(
   const std::shared_ptr<Polygon> polygon,
   const std::unordered_map<std::string, std::vector<Point>> & sources_collision_points_map,
   const Velocity & velocity,
-  Action & robot_action) const
+  Action & robot_action,
+  rclcpp::Time & action_stamp) const
 {
   if (!polygon->isShapeSet()) {
     return false;
@@ -531,6 +677,7 @@ bool CollisionMonitor::processStopSlowdownLimit(
       robot_action.req_vel.x = 0.0;
       robot_action.req_vel.y = 0.0;
       robot_action.req_vel.tw = 0.0;
+      action_stamp = getPolygonDataStamp(polygon, sources_collision_points_map);
       return true;
     } else if (polygon->getActionType() == SLOWDOWN) {
       const Velocity safe_vel = velocity * polygon->getSlowdownRatio();
@@ -649,6 +796,39 @@ void CollisionMonitor::notifyActionState(
   }
 }
 
+rclcpp::Time CollisionMonitor::getPolygonDataStamp(
+  const std::shared_ptr<Polygon> polygon,
+  const std::unordered_map<std::string, std::vector<Point>> & sources_collision_points_map) const
+{
+  rclcpp::Time data_stamp(0, 0, get_clock()->get_clock_type());
+  for (const auto & source_name : polygon->getSourcesNames()) {
+    const auto & points = sources_collision_points_map.find(source_name);
+    const auto & source_stamp = source_stamps_.find(source_name);
+    if (points == sources_collision_points_map.end() || source_stamp == source_stamps_.end() ||
+      polygon->getPointsInside(points->second) == 0)
+    {
+      continue;
+    }
+    if (source_stamp->second.nanoseconds() > data_stamp.nanoseconds()) {
+      data_stamp = source_stamp->second;
+    }
+  }
+  return data_stamp;
+}
+
+void CollisionMonitor::publishStopLatency(
+  const rclcpp::Time & curr_time, const rclcpp::Time & stop_source_stamp)
+{
+  // No source data caused the stop, e.g. when stopping due to an invalid source
+  if (stop_source_stamp.nanoseconds() == 0) {
+    return;
+  }
+
+  auto latency_msg = std::make_unique<std_msgs::msg::Float64>();
+  latency_msg->data = (curr_time - stop_source_stamp).seconds();
+  stop_latency_pub_->publish(std::move(latency_msg));
+}
+
 void CollisionMonitor::publishPolygons() const
 {
   for (std::shared_ptr<Polygon> polygon : polygons_) {
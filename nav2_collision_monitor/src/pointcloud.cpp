@@ -88,26 +88,45 @@ bool PointCloud::getData(
     return false;
   }
 
+  // Source -> base frame transform split into rows, so that height filtering could be made
+  // before computing the planar coordinates of each point
+  const tf2::Matrix3x3 & basis = tf_transform.getBasis();
+  const tf2::Vector3 & origin = tf_transform.getOrigin();
+  const tf2::Vector3 row_x = basis.getRow(0);
+  const tf2::Vector3 row_y = basis.getRow(1);
+  const tf2::Vector3 row_z = basis.getRow(2);
+  const double min_range_sq = min_range_ * min_range_;
+
   sensor_msgs::PointCloud2ConstIterator<float> iter_x(*data_, "x");
   sensor_msgs::PointCloud2ConstIterator<float> iter_y(*data_, "y");
   sensor_msgs::PointCloud2ConstIterator<float> iter_z(*data_, "z");
 
+  data.reserve(data.size() + data_->width * data_->height);
+
   // Refill data array with PointCloud points in base frame
   for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
-    // Transform point coordinates from source frame -> to base frame
-    tf2::Vector3 p_v3_s(*iter_x, *iter_y, *iter_z);
+    const double p_x = *iter_x;
+    const double p_y = *iter_y;
+    const double p_z = *iter_z;
 
     // Check range from sensor origin before transformation
-    double range = p_v3_s.length();
-    if (range < min_range_) {
+    if (p_x * p_x + p_y * p_y + p_z * p_z < min_range_sq) {
+      continue;
+    }
+
+    // Transform point height from source frame -> to base frame and filter it out
+    // before transforming the rest of coordinates
+    const double p_z_b = row_z.x() * p_x + row_z.y() * p_y + row_z.z() * p_z + origin.z();
+    if (p_z_b < min_height_ || p_z_b > max_height_) {
       continue;
     }
 
-    tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
+    const double p_x_b = row_x.x() * p_x + row_x.y() * p_y + row_x.z() * p_z + origin.x();
+    const double p_y_b = row_y.x() * p_x + row_y.y() * p_y + row_y.z() * p_z + origin.y();
 
     // Refill data array
-    if (p_v3_b.z() >= min_height_ && p_v3_b.z() <= max_height_) {
-      data.push_back({p_v3_b.x(), p_v3_b.y()});
+    if (inPointsBounds(p_x_b, p_y_b)) {
+      data.push_back({p_x_b, p_y_b});
     }
   }
   return true;
@@ -136,6 +155,7 @@ void PointCloud::getParameters(std::string & source_topic)
 void PointCloud::dataCallback(sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)
 {
   data_ = msg;
+  notifyDataReceived(msg->header.stamp);
 }
 
 rcl_interfaces::msg::SetParametersResult
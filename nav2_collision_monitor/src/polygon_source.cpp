@@ -146,7 +146,9 @@ void PolygonSource::convertPolygonStampedToPoints(
       Point p;
       p.x = current_point.x + j * dx;
       p.y = current_point.y + j * dy;
-      data.push_back(p);
+      if (inPointsBounds(p.x, p.y)) {
+        data.push_back(p);
+      }
     }
   }
 }
@@ -174,13 +176,18 @@ void PolygonSource::dataCallback(geometry_msgs::msg::PolygonInstanceStamped::Con
   auto curr_time = node->now();
 
   // check if older similar polygon exists already and replace it with the new one
+  bool replaced = false;
   for (auto & polygon_stamped : data_) {
     if (msg->polygon.id == polygon_stamped.polygon.id) {
       polygon_stamped = *msg;
-      return;
+      replaced = true;
+      break;
     }
   }
-  data_.push_back(*msg);
+  if (!replaced) {
+    data_.push_back(*msg);
+  }
+  notifyDataReceived(msg->header.stamp);
 }
 
 }  // namespace nav2_collision_monitor
@@ -101,20 +101,19 @@ bool Range::getData(
     angle < data_->field_of_view / 2;
     angle += obstacles_angle_)
   {
-    // Transform point coordinates from source frame -> to base frame
-    tf2::Vector3 p_v3_s(
-      data_->range * std::cos(angle),
-      data_->range * std::sin(angle),
-      0.0);
-    tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
-
-    // Refill data array
-    data.push_back({p_v3_b.x(), p_v3_b.y()});
+    addPoint(tf_transform, angle, data);
   }
 
   // Make sure that last (field_of_view / 2) point will be in the data array
   angle = data_->field_of_view / 2;
+  addPoint(tf_transform, angle, data);
 
+  return true;
+}
+
+void Range::addPoint(
+  const tf2::Transform & tf_transform, const float angle, std::vector<Point> & data) const
+{
   // Transform point coordinates from source frame -> to base frame
   tf2::Vector3 p_v3_s(
     data_->range * std::cos(angle),
@@ -123,9 +122,9 @@ bool Range::getData(
   tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
 
   // Refill data array
-  data.push_back({p_v3_b.x(), p_v3_b.y()});
-
-  return true;
+  if (inPointsBounds(p_v3_b.x(), p_v3_b.y())) {
+    data.push_back({p_v3_b.x(), p_v3_b.y()});
+  }
 }
 
 void Range::getParameters(std::string & source_topic)
@@ -145,6 +144,7 @@ void Range::getParameters(std::string & source_topic)
 void Range::dataCallback(sensor_msgs::msg::Range::ConstSharedPtr msg)
 {
   data_ = msg;
+  notifyDataReceived(msg->header.stamp);
 }
 
 }  // namespace nav2_collision_monitor
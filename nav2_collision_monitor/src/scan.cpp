@@ -84,19 +84,29 @@ bool Scan::getData(
     return false;
   }
 
+  // Scan points are planar in source frame: only first two columns of the transform are needed
+  const tf2::Matrix3x3 & basis = tf_transform.getBasis();
+  const tf2::Vector3 & origin = tf_transform.getOrigin();
+  const double r_xx = basis[0][0], r_xy = basis[0][1];
+  const double r_yx = basis[1][0], r_yy = basis[1][1];
+
+  data.reserve(data.size() + data_->ranges.size());
+
   // Calculate poses and refill data array
   float angle = data_->angle_min;
   for (size_t i = 0; i < data_->ranges.size(); i++) {
-    if (data_->ranges[i] >= data_->range_min && data_->ranges[i] <= data_->range_max) {
+    const float range = data_->ranges[i];
+    if (range >= data_->range_min && range <= data_->range_max) {
       // Transform point coordinates from source frame -> to base frame
-      tf2::Vector3 p_v3_s(
-        data_->ranges[i] * std::cos(angle),
-        data_->ranges[i] * std::sin(angle),
-        0.0);
-      tf2::Vector3 p_v3_b = tf_transform * p_v3_s;
+      const double p_x = range * std::cos(angle);
+      const double p_y = range * std::sin(angle);
+      const double p_x_b = r_xx * p_x + r_xy * p_y + origin.x();
+      const double p_y_b = r_yx * p_x + r_yy * p_y + origin.y();
 
       // Refill data array
-      data.push_back({p_v3_b.x(), p_v3_b.y()});
+      if (inPointsBounds(p_x_b, p_y_b)) {
+        data.push_back({p_x_b, p_y_b});
+      }
     }
     angle += data_->angle_increment;
   }
@@ -106,6 +116,7 @@ bool Scan::getData(
 void Scan::dataCallback(sensor_msgs::msg::LaserScan::ConstSharedPtr msg)
 {
   data_ = msg;
+  notifyDataReceived(msg->header.stamp);
 }
 
 }  // namespace nav2_collision_monitor
@@ -36,7 +36,8 @@ Source::Source(
 : node_(node), source_name_(source_name), tf_buffer_(tf_buffer),
   base_frame_id_(base_frame_id), global_frame_id_(global_frame_id),
   transform_tolerance_(transform_tolerance), source_timeout_(source_timeout),
-  base_shift_correction_(base_shift_correction)
+  base_shift_correction_(base_shift_correction), points_bounds_set_(false),
+  points_bounds_min_{0.0, 0.0}, points_bounds_max_{0.0, 0.0}
 {
 }
 
@@ -112,6 +113,30 @@ rclcpp::Duration Source::getSourceTimeout() const
   return source_timeout_;
 }
 
+void Source::setPointsBounds(const Point & min_point, const Point & max_point)
+{
+  points_bounds_min_ = min_point;
+  points_bounds_max_ = max_point;
+  points_bounds_set_ = true;
+}
+
+void Source::resetPointsBounds()
+{
+  points_bounds_set_ = false;
+}
+
+void Source::setDataReceivedCallback(std::function<void(const rclcpp::Time &)> callback)
+{
+  data_received_callback_ = callback;
+}
+
+void Source::notifyDataReceived(const rclcpp::Time & stamp) const
+{
+  if (data_received_callback_) {
+    data_received_callback_(stamp);
+  }
+}
+
 rcl_interfaces::msg::SetParametersResult
 Source::dynamicParametersCallback(
   std::vector<rclcpp::Parameter> parameters)
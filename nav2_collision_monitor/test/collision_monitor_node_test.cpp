@@ -32,6 +32,7 @@
 #include "sensor_msgs/point_cloud2_iterator.hpp"
 #include "geometry_msgs/msg/twist.hpp"
 #include "geometry_msgs/msg/polygon_stamped.hpp"
+#include "std_msgs/msg/float64.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
 
 #include "tf2_ros/transform_broadcaster.h"
@@ -50,6 +51,7 @@ static const char CMD_VEL_IN_TOPIC[]{"cmd_vel_in"};
 static const char CMD_VEL_OUT_TOPIC[]{"cmd_vel_out"};
 static const char STATE_TOPIC[]{"collision_monitor_state"};
 static const char COLLISION_POINTS_MARKERS_TOPIC[]{"/collision_monitor/collision_points_marker"};
+static const char STOP_LATENCY_TOPIC[]{"~/stop_latency"};
 static const char FOOTPRINT_TOPIC[]{"footprint"};
 static const char SCAN_NAME[]{"Scan"};
 static const char POINTCLOUD_NAME[]{"PointCloud"};
@@ -131,6 +133,16 @@ public:
     }
     return false;
   }
+
+  bool isPolygonShapeSet(const std::string & polygon_name)
+  {
+    for (std::shared_ptr<nav2_collision_monitor::Polygon> polygon : polygons_) {
+      if (polygon->getName() == polygon_name) {
+        return polygon->isShapeSet();
+      }
+    }
+    return false;
+  }
 };  // CollisionMonitorWrapper
 
 class Tester : public ::testing::Test
@@ -180,11 +192,13 @@ public:
     const std::chrono::nanoseconds & timeout);
   bool waitActionState(const std::chrono::nanoseconds & timeout);
   bool waitCollisionPointsMarker(const std::chrono::nanoseconds & timeout);
+  bool waitStopLatency(const std::chrono::nanoseconds & timeout);
 
 protected:
   void cmdVelOutCallback(geometry_msgs::msg::Twist::SharedPtr msg);
   void actionStateCallback(nav2_msgs::msg::CollisionMonitorState::SharedPtr msg);
   void collisionPointsMarkerCallback(visualization_msgs::msg::MarkerArray::SharedPtr msg);
+  void stopLatencyCallback(std_msgs::msg::Float64::SharedPtr msg);
 
   // CollisionMonitor node
   std::shared_ptr<CollisionMonitorWrapper> cm_;
@@ -215,6 +229,10 @@ protected:
     collision_points_marker_sub_;
   visualization_msgs::msg::MarkerArray::SharedPtr collision_points_marker_msg_;
 
+  // CollisionMonitor stop latency
+  nav2::Subscription<std_msgs::msg::Float64>::SharedPtr stop_latency_sub_;
+  std_msgs::msg::Float64::SharedPtr stop_latency_;
+
   // Service client for setting CollisionMonitor parameters
   nav2::ServiceClient<rcl_interfaces::srv::SetParameters>::SharedPtr parameters_client_;
 };  // Tester
@@ -254,6 +272,9 @@ Tester::Tester()
   collision_points_marker_sub_ = cm_->create_subscription<visualization_msgs::msg::MarkerArray>(
     COLLISION_POINTS_MARKERS_TOPIC,
     std::bind(&Tester::collisionPointsMarkerCallback, this, std::placeholders::_1));
+  stop_latency_sub_ = cm_->create_subscription<std_msgs::msg::Float64>(
+    STOP_LATENCY_TOPIC,
+    std::bind(&Tester::stopLatencyCallback, this, std::placeholders::_1));
   parameters_client_ =
     cm_->create_client<rcl_interfaces::srv::SetParameters>(
     std::string(
@@ -785,6 +806,19 @@ bool Tester::waitCollisionPointsMarker(const std::chrono::nanoseconds & timeout)
   return false;
 }
 
+bool Tester::waitStopLatency(const std::chrono::nanoseconds & timeout)
+{
+  rclcpp::Time start_time = cm_->now();
+  while (rclcpp::ok() && cm_->now() - start_time <= rclcpp::Duration(timeout)) {
+    if (stop_latency_) {
+      return true;
+    }
+    rclcpp::spin_some(cm_->get_node_base_interface());
+    std::this_thread::sleep_for(10ms);
+  }
+  return false;
+}
+
 void Tester::cmdVelOutCallback(geometry_msgs::msg::Twist::SharedPtr msg)
 {
   cmd_vel_out_ = msg;
@@ -800,6 +834,11 @@ void Tester::collisionPointsMarkerCallback(visualization_msgs::msg::MarkerArray:
   collision_points_marker_msg_ = msg;
 }
 
+void Tester::stopLatencyCallback(std_msgs::msg::Float64::SharedPtr msg)
+{
+  stop_latency_ = msg;
+}
+
 TEST_F(Tester, testProcessStopSlowdownLimit)
 {
   rclcpp::Time curr_time = cm_->now();
@@ -884,6 +923,151 @@ TEST_F(Tester, testProcessStopSlowdownLimit)
   cm_->stop();
 }
 
+TEST_F(Tester, testEventDrivenProcessing)
+{
+  rclcpp::Time curr_time = cm_->now();
+
+  // Set Collision Monitor parameters.
+  // Making stop polygon and enabling event-driven mode.
+  setCommonParameters();
+  addPolygon("Stop", POLYGON, 1.0, "stop");
+  addSource(SCAN_NAME, SCAN);
+  setVectors({"Stop"}, {SCAN_NAME});
+  cm_->declare_parameter(
+    "event_driven_processing", rclcpp::ParameterValue(true));
+  cm_->set_parameter(
+    rclcpp::Parameter("event_driven_processing", true));
+  cm_->declare_parameter(
+    "event_driven_cmd_vel_timeout", rclcpp::ParameterValue(5.0));
+  cm_->set_parameter(
+    rclcpp::Parameter("event_driven_cmd_vel_timeout", 5.0));
+
+  // Start Collision Monitor node
+  cm_->start();
+
+  // Share TF
+  sendTransforms(curr_time);
+
+  // 1. Obstacle is far away from robot
+  publishScan(4.5, curr_time);
+  ASSERT_TRUE(waitData(4.5, 500ms, curr_time));
+  publishCmdVel(0.5, 0.2, 0.1);
+  ASSERT_TRUE(waitCmdVel(500ms));
+  ASSERT_NEAR(cmd_vel_out_->linear.x, 0.5, EPSILON);
+  ASSERT_NEAR(cmd_vel_out_->linear.y, 0.2, EPSILON);
+  ASSERT_NEAR(cmd_vel_out_->angular.z, 0.1, EPSILON);
+
+  // 2. Obstacle appears inside stop zone: robot should be stopped
+  // by new scan data only, without new cmd_vel_in being received
+  cmd_vel_out_ = nullptr;
+  action_state_ = nullptr;
+  stop_latency_ = nullptr;
+  publishScan(0.5, curr_time);
+  ASSERT_TRUE(waitCmdVel(500ms));
+  ASSERT_NEAR(cmd_vel_out_->linear.x, 0.0, EPSILON);
+  ASSERT_NEAR(cmd_vel_out_->linear.y, 0.0, EPSILON);
+  ASSERT_NEAR(cmd_vel_out_->angular.z, 0.0, EPSILON);
+  ASSERT_TRUE(waitActionState(500ms));
+  ASSERT_EQ(action_state_->action_type, STOP);
+  ASSERT_EQ(action_state_->polygon_name, "Stop");
+  // Stop latency is measured from the stamp of the scan that triggered the stop,
+  // so it could not exceed the time elapsed since that stamp
+  ASSERT_TRUE(waitStopLatency(500ms));
+  ASSERT_GE(stop_latency_->data, 0.0);
+  ASSERT_LE(stop_latency_->data, (cm_->now() - curr_time).seconds());
+
+  // 3. Obstacle goes away: the stop is only released by a new cmd_vel_in,
+  // the previous one is never passed through again on new scan data
+  cmd_vel_out_ = nullptr;
+  publishScan(4.5, curr_time);
+  ASSERT_TRUE(waitData(4.5, 500ms, curr_time));
+  ASSERT_FALSE(waitCmdVel(100ms));
+  publishCmdVel(0.5, 0.2, 0.1);
+  ASSERT_TRUE(waitCmdVel(500ms));
+  ASSERT_NEAR(cmd_vel_out_->linear.x, 0.5, EPSILON);
+  ASSERT_NEAR(cmd_vel_out_->linear.y, 0.2, EPSILON);
+  ASSERT_NEAR(cmd_vel_out_->angular.z, 0.1, EPSILON);
+
+  // Stop Collision Monitor node
+  cm_->stop();
+}
+
+TEST_F(Tester, testPointsBounds)
+{
+  rclcpp::Time curr_time = cm_->now();
+
+  // Set Collision Monitor parameters.
+  // Making stop polygon and dynamic stop polygon, whose shape is received from a topic,
+  // and filtering sources by polygons.
+  setCommonParameters();
+  addPolygon("Stop", POLYGON, 1.0, "stop");
+  cm_->declare_parameter("Dynamic.type", rclcpp::ParameterValue("polygon"));
+  cm_->declare_parameter(
+    "Dynamic.polygon_sub_topic", rclcpp::ParameterValue("dynamic_polygon"));
+  cm_->declare_parameter("Dynamic.action_type", rclcpp::ParameterValue("stop"));
+  cm_->declare_parameter("Dynamic.min_points", rclcpp::ParameterValue(MIN_POINTS));
+  addSource(SCAN_NAME, SCAN);
+  setVectors({"Stop", "Dynamic"}, {SCAN_NAME});
+  cm_->declare_parameter(
+    "filter_sources_by_polygons", rclcpp::ParameterValue(true));
+  cm_->set_parameter(
+    rclcpp::Parameter("filter_sources_by_polygons", true));
+
+  // Start Collision Monitor node
+  cm_->start();
+
+  auto dynamic_polygon_pub = cm_->create_publisher<geometry_msgs::msg::PolygonStamped>(
+    "dynamic_polygon", rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable());
+  dynamic_polygon_pub->on_activate();
+
+  // Share TF
+  sendTransforms(curr_time);
+
+  // 1. Dynamic polygon shape is not set yet: the region of interest is reset,
+  // so the obstacle far away from the stop polygon is still kept
+  publishScan(4.5, curr_time);
+  ASSERT_TRUE(waitData(4.5, 500ms, curr_time));
+  publishCmdVel(0.5, 0.2, 0.1);
+  ASSERT_TRUE(waitCmdVel(500ms));
+  ASSERT_NEAR(cmd_vel_out_->linear.x, 0.5, EPSILON);
+  ASSERT_TRUE(cm_->correctDataReceived(4.5, curr_time));
+
+  // 2. Dynamic polygon shape is received: the region of interest is set to the polygons,
+  // so the obstacle far away from both polygons is filtered out
+  auto polygon_msg = std::make_unique<geometry_msgs::msg::PolygonStamped>();
+  polygon_msg->header.frame_id = BASE_FRAME_ID;
+  polygon_msg->header.stamp = curr_time;
+  geometry_msgs::msg::Point32 p;
+  p.x = 2.0;
+  p.y = 2.0;
+  polygon_msg->polygon.points.push_back(p);
+  p.y = -2.0;
+  polygon_msg->polygon.points.push_back(p);
+  p.x = -2.0;
+  polygon_msg->polygon.points.push_back(p);
+  p.y = 2.0;
+  polygon_msg->polygon.points.push_back(p);
+  dynamic_polygon_pub->publish(std::move(polygon_msg));
+
+  rclcpp::Time start_time = cm_->now();
+  while (
+    !cm_->isPolygonShapeSet("Dynamic") &&
+    cm_->now() - start_time <= rclcpp::Duration(500ms))
+  {
+    rclcpp::spin_some(cm_->get_node_base_interface());
+    std::this_thread::sleep_for(10ms);
+  }
+  ASSERT_TRUE(cm_->isPolygonShapeSet("Dynamic"));
+  cmd_vel_out_ = nullptr;
+  publishCmdVel(0.5, 0.2, 0.1);
+  ASSERT_TRUE(waitCmdVel(500ms));
+  ASSERT_NEAR(cmd_vel_out_->linear.x, 0.5, EPSILON);
+  ASSERT_FALSE(cm_->correctDataReceived(4.5, curr_time));
+
+  // Stop Collision Monitor node
+  cm_->stop();
+}
+
 TEST_F(Tester, testPolygonSource)
 {
   rclcpp::Time curr_time = cm_->now();
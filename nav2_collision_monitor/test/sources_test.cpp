@@ -853,6 +853,53 @@ TEST_F(Tester, testPointCloudMinRange)
   EXPECT_NEAR(data[2].y, 0.1, EPSILON);
 }
 
+TEST_F(Tester, testPointsBounds)
+{
+  rclcpp::Time curr_time = test_node_->now();
+
+  createSources();
+
+  sendTransforms(curr_time);
+
+  // Publish data for sources
+  test_node_->publishScan(curr_time, 1.0);
+  test_node_->publishPointCloud(curr_time);
+
+  // Wait until all sources will receive the data
+  ASSERT_TRUE(waitScan(500ms));
+  ASSERT_TRUE(waitPointCloud(500ms));
+
+  // Region of interest covering only positive quadrant in base frame
+  scan_->setPointsBounds({0.0, 0.0}, {2.0, 2.0});
+  pointcloud_->setPointsBounds({0.0, 0.0}, {2.0, 2.0});
+
+  // Only Scan points 0: (1.1, 0.1) and 1: (0.1, 1.1) should remain
+  std::vector<nav2_collision_monitor::Point> data;
+  scan_->getData(curr_time, data);
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_NEAR(data[0].x, 1.1, EPSILON);
+  EXPECT_NEAR(data[0].y, 0.1, EPSILON);
+  EXPECT_NEAR(data[1].x, 0.1, EPSILON);
+  EXPECT_NEAR(data[1].y, 1.1, EPSILON);
+
+  // Only PointCloud point 0: (0.6, 0.6) should remain
+  data.clear();
+  pointcloud_->getData(curr_time, data);
+  ASSERT_EQ(data.size(), 1u);
+  EXPECT_NEAR(data[0].x, 0.6, EPSILON);
+  EXPECT_NEAR(data[0].y, 0.6, EPSILON);
+
+  // After region of interest reset, all points are back
+  scan_->resetPointsBounds();
+  pointcloud_->resetPointsBounds();
+  data.clear();
+  scan_->getData(curr_time, data);
+  checkScan(data);
+  data.clear();
+  pointcloud_->getData(curr_time, data);
+  checkPointCloud(data);
+}
+
 int main(int argc, char ** argv)
 {
   // Initialize the system
@@ -41,6 +41,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <limits.h>
+#include <cstdlib>
 #include <algorithm>
 #include <cmath>
 #include <string>
@@ -311,6 +312,28 @@ public:
     return default_value_;
   }
 
+  /**
+   * @brief Set whether to use sparse storage for the costmap, taking effect on the next
+   * map allocation (e.g. resizeMap). Sparse storage is backed by anonymous memory mapping,
+   * so pages of cells which were never written or were reset to FREE_SPACE share the zero
+   * page and are only allocated on demand. Useful for large, mostly free maps, whereas
+   * maps defaulting to NO_INFORMATION (e.g. tracking unknown space) do not benefit from it.
+   * @param sparse_storage Whether to use sparse storage
+   */
+  void setSparseStorage(bool sparse_storage)
+  {
+    sparse_storage_ = sparse_storage;
+  }
+
+  /**
+   * @brief Get whether sparse storage is used for the costmap
+   * @return True if sparse storage is used
+   */
+  bool isSparseStorage() const
+  {
+    return sparse_storage_;
+  }
+
   /**
    * @brief  Sets the cost of a convex polygon to a desired value
    * @param polygon The polygon to perform the operation on
@@ -444,6 +467,54 @@ protected:
     }
   }
 
+  /**
+   * @brief  Shift the contents of a map in place, so that the cell (x + shift_x, y + shift_y)
+   * moves to (x, y), and fill the newly exposed cells. Used to move the origin of a rolling map
+   * without copying the overlapping region through a temporary buffer and resetting the map
+   * @param map The map to shift
+   * @param size_x The x size of the map
+   * @param size_y The y size of the map
+   * @param shift_x The number of cells to shift the contents by in x
+   * @param shift_y The number of cells to shift the contents by in y
+   * @param fill_value The value to set the newly exposed cells to
+   */
+  template<typename data_type>
+  void shiftMapRegion(
+    data_type * map, unsigned int size_x, unsigned int size_y,
+    int shift_x, int shift_y, data_type fill_value)
+  {
+    const int sx = static_cast<int>(size_x);
+    const int sy = static_cast<int>(size_y);
+    if (std::abs(shift_x) >= sx || std::abs(shift_y) >= sy) {
+      // No overlap between the old and new windows
+      std::fill_n(map, size_x * size_y, fill_value);
+      return;
+    }
+
+    const unsigned int overlap_x = sx - std::abs(shift_x);
+    const unsigned int overlap_y = sy - std::abs(shift_y);
+    const unsigned int src_x = std::max(shift_x, 0);
+    const unsigned int dst_x = std::max(-shift_x, 0);
+    const unsigned int dst_y = std::max(-shift_y, 0);
+    const unsigned int fill_x = shift_x > 0 ? overlap_x : 0;
+    const unsigned int fill_size_x = size_x - overlap_x;
+
+    // Rows are moved in the order which never overwrites a source row before it is read
+    for (unsigned int i = 0; i < overlap_y; ++i) {
+      const unsigned int y = shift_y > 0 ? dst_y + i : dst_y + overlap_y - 1 - i;
+      data_type * dest_row = map + y * size_x;
+      const data_type * source_row = map + (y + shift_y) * size_x;
+      if (shift_x != 0 || shift_y != 0) {
+        memmove(dest_row + dst_x, source_row + src_x, overlap_x * sizeof(data_type));
+      }
+      std::fill_n(dest_row + fill_x, fill_size_x, fill_value);
+    }
+
+    // Rows entirely outside of the old window
+    const unsigned int fill_y = shift_y > 0 ? overlap_y : 0;
+    std::fill_n(map + fill_y * size_x, (size_y - overlap_y) * size_x, fill_value);
+  }
+
   /**
    * @brief  Deletes the costmap, static_map, and markers data structures
    */
@@ -560,7 +631,57 @@ private:
     return x > 0 ? 1.0 : -1.0;
   }
 
+  /**
+   * @brief  Allocates the costmap data, memory-mapped if sparse storage is enabled
+   * @param size The number of cells to allocate
+   * @return Pointer to the allocated data
+   */
+  unsigned char * allocateMap(size_t size);
+
+  /**
+   * @brief  Frees the costmap data
+   */
+  void freeMap();
+
+  /**
+   * @brief  Sets a contiguous range of the memory-mapped costmap data to FREE_SPACE,
+   * releasing the whole pages within the range back to the shared zero page
+   * @param begin Index of the first cell of the range
+   * @param end Index past the last cell of the range
+   */
+  void releaseMapRange(size_t begin, size_t end);
+
+  /**
+   * @brief  Sets a contiguous range of the memory-mapped costmap data to a value, only
+   * writing the pages holding other values, so that the others are not committed
+   * @param begin Index of the first cell of the range
+   * @param end Index past the last cell of the range
+   * @param value Value to set
+   */
+  void fillMapRange(size_t begin, size_t end, unsigned char value);
+
+  /**
+   * @brief  Copies data into a contiguous range of the memory-mapped costmap data, only
+   * writing the pages whose values change, so that the others are not committed
+   * @param begin Index of the first cell of the range
+   * @param end Index past the last cell of the range
+   * @param source Data to copy, of the size of the range
+   */
+  void writeMapRange(size_t begin, size_t end, const unsigned char * source);
+
+  /**
+   * @brief  Copies a region of a map into the costmap, as copyMapRegion, only writing
+   * the pages whose values change if the costmap data is memory-mapped
+   */
+  void copyMapRegionToCostmap(
+    unsigned char * source_map, unsigned int sm_lower_left_x,
+    unsigned int sm_lower_left_y, unsigned int sm_size_x, unsigned int dm_lower_left_x,
+    unsigned int dm_lower_left_y, unsigned int region_size_x, unsigned int region_size_y);
+
   mutex_t * access_;
+  bool sparse_storage_{false};
+  bool mapped_storage_{false};
+  size_t mapped_size_{0};
 
 protected:
   unsigned int size_x_;
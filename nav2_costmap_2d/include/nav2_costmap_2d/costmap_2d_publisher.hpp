@@ -40,8 +40,10 @@
 #define NAV2_COSTMAP_2D__COSTMAP_2D_PUBLISHER_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 #include "nav2_costmap_2d/costmap_2d.hpp"
@@ -49,7 +51,9 @@
 #include "map_msgs/msg/occupancy_grid_update.hpp"
 #include "nav2_msgs/msg/costmap.hpp"
 #include "nav2_msgs/msg/costmap_update.hpp"
+#include "nav2_msgs/msg/costmap_compressed_update.hpp"
 #include "nav2_msgs/srv/get_costmap.hpp"
+#include "std_srvs/srv/trigger.hpp"
 #include "tf2/transform_datatypes.hpp"
 #include "nav2_ros_common/lifecycle_node.hpp"
 #include "tf2/LinearMath/Quaternion.hpp"
@@ -67,6 +71,8 @@ class Costmap2DPublisher
 public:
   /**
    * @brief  Constructor for the Costmap2DPublisher
+   * @param vis_downsample_factor Number of costmap cells along each axis merged
+   * into a single cell of the visualization OccupancyGrid, keeping the highest cost
    */
   Costmap2DPublisher(
     const nav2::LifecycleNode::WeakPtr & parent,
@@ -74,7 +80,9 @@ public:
     std::string global_frame,
     std::string topic_name,
     bool always_send_full_costmap = false,
-    double map_vis_z = 0.0);
+    double map_vis_z = 0.0,
+    bool compress_updates = false,
+    unsigned int vis_downsample_factor = 1);
 
   /**
    * @brief  Destructor
@@ -95,6 +103,9 @@ public:
     costmap_update_pub_->on_activate();
     costmap_raw_pub_->on_activate();
     costmap_raw_update_pub_->on_activate();
+    if (costmap_raw_compressed_update_pub_) {
+      costmap_raw_compressed_update_pub_->on_activate();
+    }
   }
 
   /**
@@ -106,6 +117,9 @@ public:
     costmap_update_pub_->on_deactivate();
     costmap_raw_pub_->on_deactivate();
     costmap_raw_update_pub_->on_deactivate();
+    if (costmap_raw_compressed_update_pub_) {
+      costmap_raw_compressed_update_pub_->on_deactivate();
+    }
   }
 
   /**
@@ -122,6 +136,17 @@ public:
     yn_ = std::max(yn, yn_);
   }
 
+  /**
+   * @brief Set the costmap served by the GetCostmap service, by default the published one.
+   * Used when publishing a snapshot of a costmap, for the service to answer with the live
+   * costmap rather than the last published one
+   * @param costmap Costmap to serve, read under its mutex
+   */
+  void setServedCostmap(Costmap2D * costmap)
+  {
+    served_costmap_ = costmap;
+  }
+
   /**
    * @brief  Publishes the visualization data over ROS
    */
@@ -141,14 +166,39 @@ private:
   void prepareGrid();
   void prepareCostmap();
 
+  /**
+   * @brief Translate a window of the costmap into OccupancyGrid values, downsampled
+   * by the visualization downsample factor
+   * @param x0 Window minimum X in visualization grid cells
+   * @param y0 Window minimum Y in visualization grid cells
+   * @param xn Window maximum X (exclusive) in visualization grid cells
+   * @param yn Window maximum Y (exclusive) in visualization grid cells
+   * @param grid_data Output grid values of the window, in row-major order
+   */
+  void translateWindow(
+    unsigned int x0, unsigned int y0, unsigned int xn, unsigned int yn,
+    std::vector<int8_t> & grid_data);
+
   /** @brief Prepare OccupancyGridUpdate msg for publication. */
   std::unique_ptr<map_msgs::msg::OccupancyGridUpdate> createGridUpdateMsg();
   /** @brief Prepare CostmapUpdate msg for publication. */
   std::unique_ptr<nav2_msgs::msg::CostmapUpdate> createCostmapUpdateMsg();
+  /**
+   * @brief Prepare CostmapCompressedUpdate msg for publication, encoding only the cells
+   * changed since the last sent costmap
+   * @return The update msg, or nullptr if no cell has changed
+   */
+  std::unique_ptr<nav2_msgs::msg::CostmapCompressedUpdate> createCostmapCompressedUpdateMsg();
 
   /** @brief Publish the latest full costmap to the new subscriber. */
   // void onNewSubscription(const ros::SingleSubscriberPublisher& pub);
 
+  /**
+   * @brief Publish the full raw costmap if subscribed to, and encode the next compressed
+   * updates against it
+   */
+  void publishRawCostmap();
+
   void updateGridParams();
 
   /** @brief GetCostmap callback service */
@@ -157,10 +207,17 @@ private:
     const std::shared_ptr<nav2_msgs::srv::GetCostmap::Request> request,
     const std::shared_ptr<nav2_msgs::srv::GetCostmap::Response> response);
 
+  /** @brief Callback of the service requesting the full raw costmap to be sent again */
+  void resync_service_callback(
+    const std::shared_ptr<rmw_request_id_t> request_header,
+    const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+    const std::shared_ptr<std_srvs::srv::Trigger::Response> response);
+
   rclcpp::Clock::SharedPtr clock_;
   rclcpp::Logger logger_{rclcpp::get_logger("nav2_costmap_2d")};
 
   Costmap2D * costmap_;
+  Costmap2D * served_costmap_;
   std::string global_frame_;
   std::string topic_name_;
   unsigned int x0_, xn_, y0_, yn_;
@@ -169,6 +226,8 @@ private:
   bool active_;
   bool always_send_full_costmap_;
   double map_vis_z_;
+  bool compress_updates_;
+  unsigned int vis_downsample_factor_;
 
   // Publisher for translated costmap values as msg::OccupancyGrid used in visualization
   nav2::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr costmap_pub_;
@@ -180,6 +239,21 @@ private:
   nav2::Publisher<nav2_msgs::msg::CostmapUpdate>::SharedPtr
     costmap_raw_update_pub_;
 
+  // Publisher for raw costmap changes as msg::CostmapCompressedUpdate
+  nav2::Publisher<nav2_msgs::msg::CostmapCompressedUpdate>::SharedPtr
+    costmap_raw_compressed_update_pub_;
+  // Costmap data as last sent, which the compressed updates are encoded against
+  std::vector<unsigned char> sent_costmap_;
+  // Stamp of the full costmap the compressed updates are encoded against
+  builtin_interfaces::msg::Time sent_costmap_stamp_;
+  // Number of compressed updates sent since that full costmap
+  uint32_t compressed_update_sequence_{0};
+  // Number of compressed update subscriptions, late joiners being sent the full costmap
+  size_t compressed_update_subscription_count_{0};
+  // Whether a compressed update subscriber out of sequence requested the full costmap
+  std::atomic<bool> full_costmap_requested_{false};
+  nav2::ServiceServer<std_srvs::srv::Trigger>::SharedPtr resync_service_;
+
   // Service for getting the costmaps
   nav2::ServiceServer<nav2_msgs::srv::GetCostmap>::SharedPtr
     costmap_service_;
@@ -39,8 +39,12 @@
 #define NAV2_COSTMAP_2D__COSTMAP_2D_ROS_HPP_
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "geometry_msgs/msg/polygon.hpp"
@@ -51,8 +55,10 @@
 #include "nav2_costmap_2d/clear_costmap_service.hpp"
 #include "nav2_costmap_2d/layered_costmap.hpp"
 #include "nav2_costmap_2d/layer.hpp"
+#include "nav2_costmap_2d/shared_costmap.hpp"
 #include "nav2_ros_common/lifecycle_node.hpp"
 #include "nav2_msgs/srv/get_costs.hpp"
+#include "std_srvs/srv/trigger.hpp"
 #include "pluginlib/class_loader.hpp"
 #include "tf2/convert.hpp"
 #include "tf2/LinearMath/Transform.hpp"
@@ -183,6 +189,13 @@ public:
    */
   void resetLayers();
 
+  /**
+   * @brief Saves the costs of the non-clearable layers, e.g. static map and inflation,
+   * to the warm_start_file, to be restored on activation rather than computed again
+   * @return Whether the snapshot was saved
+   */
+  bool saveWarmStartSnapshot();
+
   /** @brief Same as getLayeredCostmap()->isCurrent(). */
   bool isCurrent()
   {
@@ -342,11 +355,22 @@ public:
     const std::shared_ptr<nav2_msgs::srv::GetCosts::Request> request,
     const std::shared_ptr<nav2_msgs::srv::GetCosts::Response> response);
 
+  /** @brief Save the warm start snapshot on request
+   * @param request Empty request
+   * @param response Whether the snapshot was saved
+  */
+  void saveWarmStartSnapshotCallback(
+    const std::shared_ptr<rmw_request_id_t>,
+    const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+    const std::shared_ptr<std_srvs::srv::Trigger::Response> response);
+
 protected:
   // Publishers and subscribers
   nav2::Publisher<geometry_msgs::msg::PolygonStamped>::SharedPtr
     footprint_pub_;
   std::unique_ptr<Costmap2DPublisher> costmap_publisher_;
+  std::shared_ptr<SharedCostmap> shared_costmap_;  ///< Costmap shared with the process nodes
+  std::string shared_costmap_topic_;
 
   std::vector<std::unique_ptr<Costmap2DPublisher>> layer_publishers_;
 
@@ -378,6 +402,53 @@ protected:
   std::unique_ptr<std::thread> map_update_thread_;  ///< @brief A thread for updating the map
   rclcpp::Time last_publish_{0, 0, RCL_ROS_TIME};
   rclcpp::Duration publish_cycle_{1, 0};
+
+  /**
+   * @brief Restores the loaded warm start snapshot once the non-clearable layers are current,
+   * if it was built from the same map and layer parameters
+   * @return False while waiting for the non-clearable layers to become current
+   */
+  bool applyWarmStartSnapshot();
+
+  /**
+   * @brief Gets the key of the inputs of the non-clearable layers costs: the costmap
+   * geometry, the footprint, the parameters of these layers and their own costmaps,
+   * e.g. the static map. The costmap mutex must be held.
+   */
+  uint64_t getWarmStartKey();
+
+  std::unique_ptr<Costmap2D> warm_start_costmap_;  ///< Loaded snapshot pending restoration
+  uint64_t warm_start_key_{0};
+  bool warm_started_{false};
+  bool startup_reported_{true};
+  std::chrono::steady_clock::time_point activation_time_;
+
+  /**
+   * @brief Snapshots the published costmaps and wakes up the publishing thread. Only the
+   * area updated since the last publication is copied, unless the costmaps were resized
+   * or reset.
+   * @return False if the previous publication is still in progress
+   */
+  bool requestPublish();
+
+  /**
+   * @brief Resets the bounds of the area updated since the last publication
+   */
+  void resetPublishBounds();
+
+  /**
+   * @brief Function of the publishing thread, publishing the costmap snapshots on request
+   */
+  void publishLoop();
+  std::unique_ptr<std::thread> publish_thread_;  ///< @brief A thread for publishing the maps
+  std::mutex publish_mutex_;
+  std::condition_variable publish_cv_;
+  bool publish_pending_{false};
+  bool publish_thread_shutdown_{false};
+  std::vector<Costmap2D *> published_costmaps_;  ///< Costmaps to publish from a snapshot
+  std::vector<std::unique_ptr<Costmap2D>> costmap_snapshots_;
+  unsigned int publish_x0_, publish_xn_, publish_y0_, publish_yn_;
+  std::atomic<bool> publish_full_snapshot_{true};  ///< Whether to snapshot the whole costmaps
   pluginlib::ClassLoader<Layer> plugin_loader_{"nav2_costmap_2d", "nav2_costmap_2d::Layer"};
 
   /**
@@ -385,11 +456,13 @@ protected:
    */
   void getParameters();
   bool always_send_full_costmap_{false};
+  bool compress_costmap_updates_{false};  ///< Whether to publish compressed costmap updates
   std::string footprint_;
   float footprint_padding_{0};
   std::string global_frame_;                ///< The global frame for the costmap
   int map_height_meters_{0};
   double map_publish_frequency_{0};
+  bool publish_in_separate_thread_{false};  ///< Whether to publish from a dedicated thread
   double map_update_frequency_{0};
   int map_width_meters_{0};
   double origin_x_{0};
@@ -405,11 +478,15 @@ protected:
   double robot_radius_;
   bool rolling_window_{false};          ///< Whether to use a rolling window version of the costmap
   bool track_unknown_space_{false};
+  bool sparse_storage_{false};
   double transform_tolerance_{0};           ///< The timeout before transform errors
   double initial_transform_timeout_{0};   ///< The timeout before activation of the node errors
   double map_vis_z_{0};                 ///< The height of map, allows to avoid flickering at -0.008
   /// If true, the footprint subscriber expects a PolygonStamped msg
   bool subscribe_to_stamped_footprint_{false};
+  int visualization_downsample_factor_{1};  ///< Cells merged per visualization grid cell
+  std::string warm_start_file_;  ///< Snapshot file of the non-clearable layers costs
+  bool share_in_process_{true};  ///< Whether to share the costmap with the process nodes
 
   bool is_lifecycle_follower_{true};   ///< whether is a child-LifecycleNode or an independent node
 
@@ -421,6 +498,7 @@ protected:
   // Services
   nav2::ServiceServer<nav2_msgs::srv::GetCosts>::SharedPtr get_cost_service_;
   std::unique_ptr<ClearCostmapService> clear_costmap_service_;
+  nav2::ServiceServer<std_srvs::srv::Trigger>::SharedPtr save_warm_start_service_;
 
   // Dynamic parameters handler
   OnSetParametersCallbackHandle::SharedPtr dyn_params_handler;
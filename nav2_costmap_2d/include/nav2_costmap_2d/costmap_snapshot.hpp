@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_2D__COSTMAP_SNAPSHOT_HPP_
+#define NAV2_COSTMAP_2D__COSTMAP_SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+
+namespace nav2_costmap_2d
+{
+
+/**
+ * Costmap snapshots store the costs and geometry of a costmap in a binary file,
+ * along with a key identifying the inputs the costs were computed from, so that
+ * they are only reused while these inputs are unchanged.
+ */
+
+/**
+ * @brief Initial value of a snapshot key
+ */
+constexpr uint64_t SNAPSHOT_INITIAL_KEY = 14695981039346656037ull;
+
+/**
+ * @brief Adds bytes to a snapshot key, FNV-1a style
+ * @param key Key to update
+ * @param data Bytes to add to the key
+ * @param size Number of bytes
+ */
+inline void hashSnapshotKey(uint64_t & key, const void * data, const size_t size)
+{
+  const unsigned char * bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    key = (key ^ bytes[i]) * 1099511628211ull;
+  }
+}
+
+/**
+ * @brief Stores a costmap snapshot, replacing the file atomically
+ * @param file_path Path of the snapshot file
+ * @param costmap Costmap to store
+ * @param key Key of the inputs the costs were computed from
+ * @return Whether the snapshot was stored
+ */
+bool saveCostmapSnapshot(
+  const std::string & file_path, const Costmap2D & costmap, const uint64_t key);
+
+/**
+ * @brief Loads a costmap snapshot stored by saveCostmapSnapshot()
+ * @param file_path Path of the snapshot file
+ * @param costmap Output costmap, resized to the geometry of the snapshot
+ * @param key Output key of the inputs the costs were computed from
+ * @return Whether a valid snapshot was found
+ */
+bool loadCostmapSnapshot(const std::string & file_path, Costmap2D & costmap, uint64_t & key);
+
+}  // namespace nav2_costmap_2d
+
+#endif  // NAV2_COSTMAP_2D__COSTMAP_SNAPSHOT_HPP_
@@ -15,20 +15,29 @@
 #ifndef NAV2_COSTMAP_2D__COSTMAP_SUBSCRIBER_HPP_
 #define NAV2_COSTMAP_2D__COSTMAP_SUBSCRIBER_HPP_
 
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <string>
 #include <memory>
+#include <mutex>
 
 #include "rclcpp/rclcpp.hpp"
 #include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/shared_costmap.hpp"
 #include "nav2_msgs/msg/costmap.hpp"
 #include "nav2_msgs/msg/costmap_update.hpp"
+#include "nav2_msgs/msg/costmap_compressed_update.hpp"
 #include "nav2_ros_common/lifecycle_node.hpp"
+#include "std_srvs/srv/trigger.hpp"
 
 namespace nav2_costmap_2d
 {
 /**
  * @class CostmapSubscriber
- * @brief Subscribes to the costmap via a ros topic
+ * @brief Subscribes to the costmap via a ros topic, or reads it directly if shared
+ * in-process by a Costmap2DROS publishing it
  */
 class CostmapSubscriber
 {
@@ -40,25 +49,67 @@ public:
     const nav2::LifecycleNode::WeakPtr & parent,
     const std::string & topic_name);
 
+  /**
+   * @brief A constructor
+   * @param parent Node to create the subscriptions on
+   * @param topic_name Raw costmap topic to subscribe to
+   * @param use_compressed_updates Whether to subscribe to the compressed costmap updates
+   * rather than to the raw ones. Requires the publisher to send compressed updates
+   */
   template<typename NodeT>
   CostmapSubscriber(
     const NodeT & parent,
-    const std::string & topic_name)
+    const std::string & topic_name,
+    const bool use_compressed_updates = false)
   : topic_name_(topic_name)
   {
     logger_ = parent->get_logger();
 
-    // Could be using a user rclcpp::Node, so need to use the Nav2 factory to create the
-    // subscription to convert nav2::LifecycleNode, rclcpp::Node or rclcpp_lifecycle::LifecycleNode
-    costmap_sub_ = nav2::interfaces::create_subscription<nav2_msgs::msg::Costmap>(
-      parent, topic_name_,
-      std::bind(&CostmapSubscriber::costmapCallback, this, std::placeholders::_1),
-      nav2::qos::LatchedSubscriptionQoS());
-
-    costmap_update_sub_ = nav2::interfaces::create_subscription<nav2_msgs::msg::CostmapUpdate>(
-      parent, topic_name_ + "_updates",
-      std::bind(&CostmapSubscriber::costmapUpdateCallback, this, std::placeholders::_1),
-      nav2::qos::LatchedSubscriptionQoS());
+    // Subscriptions are created lazily, in case the costmap shared in-process goes away
+    std::weak_ptr<typename NodeT::element_type> weak_parent = parent;
+    subscribe_ = [this, weak_parent, use_compressed_updates]() {
+        auto parent = weak_parent.lock();
+        if (!parent) {
+          return;
+        }
+
+        // Could be using a user rclcpp::Node, so need to use the Nav2 factory to create the
+        // subscription to convert nav2::LifecycleNode, rclcpp::Node or
+        // rclcpp_lifecycle::LifecycleNode
+        costmap_sub_ = nav2::interfaces::create_subscription<nav2_msgs::msg::Costmap>(
+          parent, topic_name_,
+          std::bind(&CostmapSubscriber::costmapCallback, this, std::placeholders::_1),
+          nav2::qos::LatchedSubscriptionQoS());
+
+        if (use_compressed_updates) {
+          // Asks the publisher for the full costmap when missing compressed updates
+          resync_client_ = nav2::interfaces::create_client<std_srvs::srv::Trigger>(
+            parent, topic_name_ + "_resync");
+          costmap_compressed_update_sub_ =
+            nav2::interfaces::create_subscription<nav2_msgs::msg::CostmapCompressedUpdate>(
+            parent, topic_name_ + "_compressed_updates",
+            std::bind(
+              &CostmapSubscriber::costmapCompressedUpdateCallback, this, std::placeholders::_1),
+            nav2::qos::LatchedSubscriptionQoS());
+        } else {
+          costmap_update_sub_ =
+            nav2::interfaces::create_subscription<nav2_msgs::msg::CostmapUpdate>(
+            parent, topic_name_ + "_updates",
+            std::bind(&CostmapSubscriber::costmapUpdateCallback, this, std::placeholders::_1),
+            nav2::qos::LatchedSubscriptionQoS());
+        }
+      };
+
+    // Read the costmap directly, without serialization, if a Costmap2DROS of this
+    // process shares it, e.g. when composed in the same container
+    shared_costmap_topic_ = parent->get_node_topics_interface()->resolve_topic_name(topic_name_);
+    shared_costmap_ = SharedCostmap::find(shared_costmap_topic_);
+    use_shared_costmap_ = shared_costmap_ != nullptr;
+    if (shared_costmap_) {
+      RCLCPP_INFO(logger_, "Using the costmap of %s shared in-process", topic_name_.c_str());
+    } else {
+      subscribe_();
+    }
   }
 
   /**
@@ -67,9 +118,17 @@ public:
   ~CostmapSubscriber() {}
 
   /**
-   * @brief Get current costmap
+   * @brief Get current costmap. Costmaps are immutable snapshots built once per
+   * received update, so must be used read-only, and are obtained without locking.
    */
   std::shared_ptr<Costmap2D> getCostmap();
+
+  /**
+   * @brief Get current costmap along with its version, e.g. to skip the work
+   * already done for that version
+   * @param version Output version of the returned costmap
+   */
+  std::shared_ptr<Costmap2D> getCostmap(uint64_t & version);
   /**
    * @brief Callback for the costmap topic
    */
@@ -78,16 +137,114 @@ public:
    * @brief Callback for the costmap's update topic
    */
   void costmapUpdateCallback(const nav2_msgs::msg::CostmapUpdate::SharedPtr update_msg);
+  /**
+   * @brief Callback for the costmap's compressed update topic, decoding the changes
+   * directly into the costmap. Updates are applied in sequence on top of the full costmap
+   * they are encoded against, the full costmap being requested again if one is missed.
+   */
+  void costmapCompressedUpdateCallback(
+    const nav2_msgs::msg::CostmapCompressedUpdate::SharedPtr update_msg);
 
   std::string getFrameID() const
   {
-    return frame_id_;
+    auto snapshot = std::atomic_load(&snapshot_);
+    return snapshot ? snapshot->frame_id : std::string();
   }
 
+  /**
+   * @brief Get the version of the costmap data. It is increased each time the data
+   * of the costmap returned by getCostmap() is being updated. Costmaps shared in-process
+   * are only fetched by getCostmap(), so are the versions of these.
+   * @return Costmap version, 0 if no costmap was processed yet
+   */
+  uint64_t getCostmapVersion() const
+  {
+    auto snapshot = std::atomic_load(&snapshot_);
+    return snapshot ? snapshot->version : 0;
+  }
+
+  /**
+   * @brief Get the bounds of the costmap area updated after given version.
+   * Bounds are given in cells as [min_x, max_x) x [min_y, max_y) and are empty,
+   * if nothing was changed since that version.
+   * @param since_version Costmap version to obtain changes since
+   * @param min_x Output minimum X-bound of changed area
+   * @param min_y Output minimum Y-bound of changed area
+   * @param max_x Output maximum X-bound (exclusive) of changed area
+   * @param max_y Output maximum Y-bound (exclusive) of changed area
+   * @return False if changes could not be tracked since given version (costmap was
+   * resized or moved, or changes history is exhausted), thus whole costmap
+   * should be considered as changed
+   */
+  bool getUpdatedBounds(
+    const uint64_t since_version,
+    unsigned int & min_x, unsigned int & min_y,
+    unsigned int & max_x, unsigned int & max_y);
+
 protected:
+  /**
+   * @brief Area of the costmap updated in a given version
+   */
+  struct UpdatedBounds
+  {
+    uint64_t version;
+    bool full;
+    unsigned int min_x, min_y, max_x, max_y;
+  };
+
+  /**
+   * @brief Increases costmap version and stores the area updated in it
+   * @param full Whether the whole costmap should be considered as changed
+   * @param min_x Minimum X-bound of changed area
+   * @param min_y Minimum Y-bound of changed area
+   * @param max_x Maximum X-bound (exclusive) of changed area
+   * @param max_y Maximum Y-bound (exclusive) of changed area
+   */
+  void addUpdatedBounds(
+    const bool full,
+    const unsigned int min_x, const unsigned int min_y,
+    const unsigned int max_x, const unsigned int max_y);
+
+  /**
+   * @brief Costmap snapshot handed out to the consumers
+   */
+  struct CostmapSnapshot
+  {
+    std::shared_ptr<Costmap2D> costmap;
+    uint64_t version;
+    std::string frame_id;
+  };
+
   bool isCostmapReceived() {return costmap_ != nullptr;}
   void processCurrentCostmapMsg();
 
+  /**
+   * @brief Decodes a compressed update into the costmap if it is the next one of the
+   * sequence of the current full costmap. Requires costmap_msg_mutex_.
+   * @param update_msg Compressed update, not encoded against a costmap to come
+   */
+  void applyCompressedUpdate(
+    const nav2_msgs::msg::CostmapCompressedUpdate::SharedPtr & update_msg);
+
+  /**
+   * @brief Requests the publisher to send the full costmap again, once until received.
+   * Requires costmap_msg_mutex_.
+   */
+  void requestFullCostmap();
+
+  /**
+   * @brief Hands out a snapshot of the costmap as of the current version, reusing the
+   * previous snapshot once no consumer holds it anymore. Requires costmap_msg_mutex_.
+   */
+  void publishSnapshot();
+
+  /**
+   * @brief Hands out the latest snapshot of the costmap shared in-process, tracking its
+   * version and updated bounds. Falls back to the costmap topic if it went away.
+   * Requires shared_costmap_mutex_.
+   */
+  void updateSharedCostmap();
+
   bool haveCostmapParametersChanged();
   bool hasCostmapSizeChanged();
   bool hasCostmapResolutionChanged();
@@ -95,13 +252,42 @@ protected:
 
   nav2::Subscription<nav2_msgs::msg::Costmap>::SharedPtr costmap_sub_;
   nav2::Subscription<nav2_msgs::msg::CostmapUpdate>::SharedPtr costmap_update_sub_;
+  nav2::Subscription<nav2_msgs::msg::CostmapCompressedUpdate>::SharedPtr
+    costmap_compressed_update_sub_;
+  nav2::ServiceClient<std_srvs::srv::Trigger>::SharedPtr resync_client_;
 
+  // Costmap updated from the received messages, only handed out as snapshots
   std::shared_ptr<Costmap2D> costmap_;
   nav2_msgs::msg::Costmap::SharedPtr costmap_msg_;
 
+  std::shared_ptr<const CostmapSnapshot> snapshot_;  ///< Accessed atomically
+  std::shared_ptr<Costmap2D> spare_costmap_;  ///< Previous snapshot, to be reused
+  uint64_t spare_costmap_version_{0};
+  const Costmap2D * snapshot_source_{nullptr};  ///< Costmap the latest snapshot was built from
+
+  std::function<void()> subscribe_;
+  std::shared_ptr<SharedCostmap> shared_costmap_;
+  std::atomic<bool> use_shared_costmap_{false};
+  std::string shared_costmap_topic_;
+  uint64_t shared_costmap_version_{0};
+  std::mutex shared_costmap_mutex_;
+
   std::string topic_name_;
   std::string frame_id_;
-  std::mutex costmap_msg_mutex_;
+  std::mutex costmap_msg_mutex_;  ///< Serializes the updates of the costmap
+
+  // Stamp of the full costmap received last, which the compressed updates apply on top of
+  builtin_interfaces::msg::Time costmap_stamp_;
+  uint32_t compressed_update_sequence_{0};  ///< Sequence of the last compressed update applied
+  // Compressed updates received ahead of the full costmap they are encoded against
+  std::deque<nav2_msgs::msg::CostmapCompressedUpdate::SharedPtr> early_compressed_updates_;
+  static constexpr size_t max_early_compressed_updates_ = 16;
+  bool full_costmap_requested_{false};
+
+  std::atomic<uint64_t> costmap_version_{0};
+  std::deque<UpdatedBounds> updated_bounds_;
+  std::mutex updated_bounds_mutex_;
+  static constexpr size_t max_updated_bounds_history_ = 256;
   rclcpp::Logger logger_{rclcpp::get_logger("nav2_costmap_2d")};
 };
 
@@ -18,6 +18,7 @@
 #define NAV2_COSTMAP_2D__COSTMAP_TOPIC_COLLISION_CHECKER_HPP_
 
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -84,7 +85,43 @@ public:
     const geometry_msgs::msg::Pose & pose,
     bool fetch_costmap_and_footprint = true);
 
+  /**
+   * @brief Returns the obstacle footprint score of a trajectory, i.e. the highest one of
+   * its poses, checking the footprint swept along the trajectory at once. The footprint
+   * cells of all the poses are rasterized into a union mask, so that cells covered by
+   * several poses are only scored once, stopping at the first lethal cell.
+   *
+   * @param poses Poses of the trajectory, in the costmap frame
+   * @param fetch_costmap_and_footprint Defaults to true. Fetching can be skipped when the
+   * costmap and footprint were fetched by a previous check
+   */
+  double scoreTrajectory(
+    const std::vector<geometry_msgs::msg::Pose> & poses,
+    bool fetch_costmap_and_footprint = true);
+
+  /**
+   * @brief Returns if all the poses of a trajectory are collision free, e.g. when simulating
+   * ahead a motion, checking the swept footprint as scoreTrajectory() does
+   *
+   * @param poses Poses of the trajectory, in the costmap frame
+   * @param fetch_costmap_and_footprint Defaults to true. Fetching can be skipped when the
+   * costmap and footprint were fetched by a previous check
+   */
+  bool isTrajectoryCollisionFree(
+    const std::vector<geometry_msgs::msg::Pose> & poses,
+    bool fetch_costmap_and_footprint = true);
+
 protected:
+  /**
+   * @brief Fetches the latest costmap and footprint
+   */
+  void fetchCostmapAndFootprint();
+
+  /**
+   * @brief Fetches the latest footprint, in the robot frame
+   */
+  void fetchFootprint();
+
   /**
    * @brief Get a footprint at a set pose
    *
@@ -104,6 +141,9 @@ protected:
   rclcpp::Clock::SharedPtr clock_;
   Footprint footprint_;
   std::string footprint_string_;
+  // Cells of the footprint corners of the trajectory poses and their union mask
+  std::vector<std::pair<unsigned int, unsigned int>> swept_corners_;
+  std::vector<unsigned char> swept_mask_;
 };
 
 }  // namespace nav2_costmap_2d
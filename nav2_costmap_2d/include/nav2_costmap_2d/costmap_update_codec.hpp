@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_2D__COSTMAP_UPDATE_CODEC_HPP_
+#define NAV2_COSTMAP_2D__COSTMAP_UPDATE_CODEC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nav2_costmap_2d
+{
+
+/**
+ * Compressed costmap updates encode only the cells of an update window which
+ * differ from the values previously sent to the subscribers. The window is
+ * traversed in row-major order as a sequence of tokens, each made of:
+ *  - varint: number of unchanged cells to skip
+ *  - varint: (run length << 1) | literal flag
+ *  - literal runs: run length cost values, repeated runs: a single cost value
+ * Varints are unsigned LEB128.
+ */
+
+/**
+ * @brief Encodes the changes of a costmap window against the previously sent costmap
+ * and updates the previously sent costmap with the encoded changes
+ * @param costmap Current costmap data
+ * @param sent_costmap Costmap data as last sent to the subscribers, of the same size
+ * @param size_x Costmap size in cells along X
+ * @param x0 Window origin X in cells
+ * @param y0 Window origin Y in cells
+ * @param width Window width in cells
+ * @param height Window height in cells
+ * @param data Output encoded changes
+ * @return True if any cell of the window has changed
+ */
+bool encodeCostmapUpdate(
+  const unsigned char * costmap, unsigned char * sent_costmap, const unsigned int size_x,
+  const unsigned int x0, const unsigned int y0,
+  const unsigned int width, const unsigned int height,
+  std::vector<uint8_t> & data);
+
+/**
+ * @brief Applies encoded changes of a costmap window directly to the costmap data
+ * @param data Encoded changes
+ * @param data_size Size of the encoded changes
+ * @param costmap Costmap data to update
+ * @param size_x Costmap size in cells along X
+ * @param x0 Window origin X in cells
+ * @param y0 Window origin Y in cells
+ * @param width Window width in cells
+ * @param height Window height in cells
+ * @param min_x Output minimum X-bound of changed cells
+ * @param min_y Output minimum Y-bound of changed cells
+ * @param max_x Output maximum X-bound (exclusive) of changed cells
+ * @param max_y Output maximum Y-bound (exclusive) of changed cells
+ * @return False if the encoded data is malformed or exceeds the window
+ */
+bool decodeCostmapUpdate(
+  const uint8_t * data, const size_t data_size,
+  unsigned char * costmap, const unsigned int size_x,
+  const unsigned int x0, const unsigned int y0,
+  const unsigned int width, const unsigned int height,
+  unsigned int & min_x, unsigned int & min_y,
+  unsigned int & max_x, unsigned int & max_y);
+
+}  // namespace nav2_costmap_2d
+
+#endif  // NAV2_COSTMAP_2D__COSTMAP_UPDATE_CODEC_HPP_
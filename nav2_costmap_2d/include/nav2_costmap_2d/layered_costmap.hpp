@@ -38,6 +38,8 @@
 #ifndef NAV2_COSTMAP_2D__LAYERED_COSTMAP_HPP_
 #define NAV2_COSTMAP_2D__LAYERED_COSTMAP_HPP_
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -103,6 +105,29 @@ public:
    */
   bool isCurrent();
 
+  /**
+   * @brief If the non-clearable plugins, e.g. static map and inflation, are current
+   */
+  bool isNonClearableCurrent();
+
+  /**
+   * @brief Computes the costs of the non-clearable plugins, e.g. static map and inflation,
+   * over the whole costmap, leaving out the clearable plugins and the filters
+   * @param costmap Output costmap, resized to the master costmap
+   */
+  void buildNonClearableCostmap(Costmap2D & costmap);
+
+  /**
+   * @brief Restores the costs of the non-clearable plugins from a costmap built by
+   * buildNonClearableCostmap(), e.g. by a previous run, rather than computing them over
+   * the whole costmap. The next updateMap() starts from these costs and only updates the
+   * bounds of the clearable plugins and filters, inflation around the clearable plugins
+   * obstacles catching up on the following update.
+   * @param costmap Costmap of the non-clearable plugins
+   * @return False if the costmap does not have the geometry of the master costmap
+   */
+  bool restoreNonClearableCostmap(const Costmap2D & costmap);
+
   /**
    * @brief Get the costmap pointer to the master costmap
    */
@@ -111,6 +136,17 @@ public:
     return &combined_costmap_;
   }
 
+  /**
+   * @brief Set whether to use sparse storage for the costmap and its layers,
+   * taking effect on the next resizeMap
+   * @param sparse_storage Whether to use sparse storage
+   */
+  void setSparseStorage(bool sparse_storage)
+  {
+    primary_costmap_.setSparseStorage(sparse_storage);
+    combined_costmap_.setSparseStorage(sparse_storage);
+  }
+
   /**
    * @brief If this costmap is rolling or not
    */
@@ -174,6 +210,36 @@ public:
     *yn = byn_;
   }
 
+  /**
+   * @brief Get the number of changes of the master costmap recorded so far, to be
+   * passed to getChangedBoundsSince() later on. The costmap mutex must be held.
+   */
+  uint64_t getChangeCount() const
+  {
+    return change_count_;
+  }
+
+  /**
+   * @brief Get the bounds of the cells of the master costmap changed since a change count,
+   * the costmap mutex must be held
+   * @param change_count Change count returned by getChangeCount() previously
+   * @param x0 Output minimum X-bound of the changed cells
+   * @param xn Output maximum X-bound (exclusive) of the changed cells
+   * @param y0 Output minimum Y-bound of the changed cells
+   * @param yn Output maximum Y-bound (exclusive) of the changed cells
+   * @return False if the changes are older than the recorded ones, in which case
+   * the whole costmap must be considered changed
+   */
+  bool getChangedBoundsSince(
+    uint64_t change_count, unsigned int & x0, unsigned int & xn,
+    unsigned int & y0, unsigned int & yn) const;
+
+  /**
+   * @brief Records a change of the master costmap made outside of updateMap(),
+   * the costmap mutex must be held
+   */
+  void recordChange(unsigned int x0, unsigned int xn, unsigned int y0, unsigned int yn);
+
   /**
    * @brief if the costmap is initialized
    */
@@ -226,9 +292,21 @@ private:
   double minx_, miny_, maxx_, maxy_;
   unsigned int bx0_, bxn_, by0_, byn_;
 
+  // Bounds of the last changes of the master costmap, indexed by change count
+  struct ChangedBounds
+  {
+    unsigned int x0, xn, y0, yn;
+  };
+  static constexpr uint64_t CHANGE_HISTORY_SIZE = 16;
+  std::array<ChangedBounds, CHANGE_HISTORY_SIZE> change_history_{};
+  uint64_t change_count_{0};
+
   std::vector<std::shared_ptr<Layer>> plugins_;
   std::vector<std::shared_ptr<Layer>> filters_;
 
+  // Costs of the non-clearable plugins to restore on the next update
+  std::unique_ptr<Costmap2D> restored_costmap_;
+
   bool initialized_;
   bool size_locked_;
   std::atomic<double> circumscribed_radius_, inscribed_radius_;
@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_2D__SHARED_COSTMAP_HPP_
+#define NAV2_COSTMAP_2D__SHARED_COSTMAP_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+
+namespace nav2_costmap_2d
+{
+
+/**
+ * @class SharedCostmap
+ * @brief Exposes versioned snapshots of the master costmap of a LayeredCostmap to the
+ * other nodes of the same process, e.g. composed in a single container, so that they
+ * could use it without the costmap being serialized over the costmap topics.
+ *
+ * Snapshots are taken by the producer, calling update() after each update of the layered
+ * costmap, and published atomically, so that the consumers never lock the master costmap.
+ * No snapshot is taken until a consumer finds the shared costmap or asks for a snapshot,
+ * so that sharing costs nothing to the costmaps nobody consumes in-process.
+ *
+ * Shared costmaps are advertised in a process-wide registry under the fully resolved
+ * name of the raw costmap topic they are also published on, CostmapSubscriber looking
+ * them up there before subscribing to that topic.
+ */
+class SharedCostmap
+{
+public:
+  /**
+   * @brief A constructor
+   * @param layered_costmap Layered costmap to share, must outlive the shared costmap
+   * or be detached before being destroyed
+   * @param frame_id Global frame of the costmap
+   */
+  SharedCostmap(LayeredCostmap * layered_costmap, const std::string & frame_id);
+
+  /**
+   * @brief Takes a snapshot of the master costmap if it changed since the latest one,
+   * only copying the changed cells where possible, and publishes it to the consumers.
+   * Called by the producer after updating the layered costmap, does nothing until the
+   * shared costmap has a consumer.
+   */
+  void update();
+
+  /**
+   * @brief Get the latest snapshot of the master costmap. Snapshots are never modified
+   * once published, so must be used read-only.
+   * @param version Output version of the snapshot, increasing with each change of the
+   * master costmap
+   * @return Snapshot of the master costmap, nullptr if none was taken yet or the shared
+   * costmap was detached. The first call makes the producer start taking snapshots.
+   */
+  std::shared_ptr<Costmap2D> getSnapshot(uint64_t & version) const;
+
+  /**
+   * @brief Get the bounds of the cells changed between a snapshot version and the latest
+   * snapshot
+   * @param version Version of a snapshot returned by getSnapshot()
+   * @param x0 Output minimum X-bound of the changed cells
+   * @param xn Output maximum X-bound (exclusive) of the changed cells
+   * @param y0 Output minimum Y-bound of the changed cells
+   * @param yn Output maximum Y-bound (exclusive) of the changed cells
+   * @return False if the changes could not be tracked since that version, thus the
+   * whole costmap should be considered as changed
+   */
+  bool getChangedBoundsSince(
+    const uint64_t version, unsigned int & x0, unsigned int & xn,
+    unsigned int & y0, unsigned int & yn) const;
+
+  /**
+   * @brief Get the global frame of the costmap
+   */
+  std::string getFrameID() const
+  {
+    return frame_id_;
+  }
+
+  /**
+   * @brief Stops sharing the layered costmap, e.g. before it is destroyed.
+   * The snapshots already returned remain valid.
+   */
+  void detach();
+
+  /**
+   * @brief Whether the shared costmap is still attached to its layered costmap
+   */
+  bool isAttached() const;
+
+  /**
+   * @brief Makes a shared costmap available to the other nodes of the process
+   * @param topic_name Fully resolved name of the raw costmap topic
+   * @param shared_costmap Shared costmap, only weakly referenced by the registry
+   */
+  static void advertise(
+    const std::string & topic_name, const std::shared_ptr<SharedCostmap> & shared_costmap);
+
+  /**
+   * @brief Removes a shared costmap advertised by advertise()
+   * @param topic_name Fully resolved name of the raw costmap topic
+   * @param shared_costmap Shared costmap, only removed if still the advertised one
+   */
+  static void withdraw(const std::string & topic_name, const SharedCostmap * shared_costmap);
+
+  /**
+   * @brief Finds the shared costmap advertised for a raw costmap topic
+   * @param topic_name Fully resolved name of the raw costmap topic
+   * @return Shared costmap, nullptr if none is advertised in this process. A found
+   * shared costmap starts being snapshotted by its producer.
+   */
+  static std::shared_ptr<SharedCostmap> find(const std::string & topic_name);
+
+protected:
+  /**
+   * @struct nav2_costmap_2d::SharedCostmap::Change
+   * @brief Bounds of the cells changed from a snapshot version to the next one
+   */
+  struct Change
+  {
+    uint64_t version;
+    unsigned int x0, xn, y0, yn;
+  };
+
+  /**
+   * @struct nav2_costmap_2d::SharedCostmap::Snapshot
+   * @brief Published snapshot, with the changes made by the previous snapshots
+   */
+  struct Snapshot
+  {
+    std::shared_ptr<Costmap2D> costmap;
+    uint64_t version;
+    // Changes between the previous snapshots up to this one, oldest first
+    std::vector<Change> changes;
+  };
+
+  /**
+   * @brief Whether two costmaps have the same size, resolution and origin
+   */
+  static bool haveSameGeometry(const Costmap2D & a, const Costmap2D & b);
+
+  // Number of snapshots whose changes are tracked
+  static constexpr size_t CHANGE_HISTORY_SIZE = 16;
+
+  // Producer side, taking snapshots
+  std::mutex mutex_;
+  LayeredCostmap * layered_costmap_;
+  std::string frame_id_;
+  std::atomic<bool> attached_{true};
+  // Whether a consumer found the shared costmap or asked for a snapshot
+  mutable std::atomic<bool> consumed_{false};
+  // Previous snapshot, reused when no longer referenced elsewhere
+  std::shared_ptr<Costmap2D> spare_snapshot_;
+  uint64_t spare_snapshot_version_{0};
+
+  // Consumer side, only atomically loaded
+  std::shared_ptr<const Snapshot> snapshot_;
+};
+
+}  // namespace nav2_costmap_2d
+
+#endif  // NAV2_COSTMAP_2D__SHARED_COSTMAP_HPP_
@@ -38,8 +38,12 @@
 #ifndef NAV2_COSTMAP_2D__STATIC_LAYER_HPP_
 #define NAV2_COSTMAP_2D__STATIC_LAYER_HPP_
 
+#include <array>
+#include <cstdint>
+#include <map>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "map_msgs/msg/occupancy_grid_update.hpp"
@@ -48,6 +52,8 @@
 #include "nav2_costmap_2d/layered_costmap.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
 #include "nav2_costmap_2d/footprint.hpp"
+#include "nav2_msgs/srv/get_map_region.hpp"
+#include "nav2_ros_common/service_client.hpp"
 
 namespace nav2_costmap_2d
 {
@@ -147,6 +153,72 @@ protected:
    */
   void incomingUpdate(map_msgs::msg::OccupancyGridUpdate::ConstSharedPtr update);
 
+  /**
+   * @struct nav2_costmap_2d::StaticLayer::MapRegionRequest
+   * @brief Region of the map requested from the map server, sent again until answered
+   */
+  struct MapRegionRequest
+  {
+    /// @brief Region, in cells of the map. An empty region only gets the map metadata
+    unsigned int x0, y0, width, height;
+    /// @brief Number of times the request was sent
+    unsigned int attempts;
+    /// @brief Time to send the request again if not answered successfully by then
+    rclcpp::Time retry_time;
+  };
+
+  /**
+   * @brief Callback receiving the regions of the map requested from the map server
+   * @param request_id Identifier of the request answered
+   * @param response Response of the map server
+   */
+  void incomingMapRegion(
+    uint64_t request_id, nav2_msgs::srv::GetMapRegion::Response::SharedPtr response);
+
+  /**
+   * @brief Moves the window of the map held by the layer when the robot gets close to
+   * its border, and requests the regions of the map newly exposed by the moved window
+   * @param robot_x X pose of robot, in the global frame
+   * @param robot_y Y pose of robot, in the global frame
+   */
+  void updateMapTiles(double robot_x, double robot_y);
+
+  /**
+   * @brief Requests a region of the map from the map server, until answered successfully
+   * @param x0 X-coordinate of the region, in cells of the map
+   * @param y0 Y-coordinate of the region, in cells of the map
+   * @param width Width of the region, in cells
+   * @param height Height of the region, in cells
+   */
+  void addMapRegionRequest(
+    unsigned int x0, unsigned int y0, unsigned int width, unsigned int height);
+
+  /**
+   * @brief Sends the pending requests of map regions due for a retry, doubling the delay
+   * before their next retry up to 32 times map_tiles_retry_delay
+   */
+  void retryMapRegionRequests();
+
+  /**
+   * @brief Sends a request of a region of the map to the map server
+   * @param request_id Identifier of the request, given back with the response
+   * @param region Region requested
+   * @return False if the map server is not available
+   */
+  virtual bool sendMapRegionRequest(uint64_t request_id, const MapRegionRequest & region);
+
+  /**
+   * @brief Copies the cells of a region of the map overlapping the window held by the layer
+   * @param x0 X-coordinate of the region, in cells of the map
+   * @param y0 Y-coordinate of the region, in cells of the map
+   * @param width Width of the region, in cells
+   * @param height Height of the region, in cells
+   * @param data Occupancy values of the region
+   */
+  void applyMapRegion(
+    int x0, int y0, unsigned int width, unsigned int height,
+    const std::vector<int8_t> & data);
+
   /**
    * @brief Interpret the value in the static map given on the topic to
    * convert into costs for the costmap to utilize
@@ -194,10 +266,30 @@ protected:
   unsigned char lethal_threshold_;
   unsigned char unknown_cost_value_;
   bool trinary_costmap_;
+  /// @brief Costs of all the map values, as given by interpretValue()
+  std::array<unsigned char, 256> cost_translation_table_{};
   bool map_received_{false};
   bool map_received_in_update_bounds_{false};
   tf2::Duration transform_tolerance_;
   nav_msgs::msg::OccupancyGrid::SharedPtr map_buffer_;
+
+  // Streaming of the map in tiles around the robot
+  bool use_map_tiles_{false};
+  double map_tiles_window_size_;
+  std::string map_region_service_;
+  nav2::ServiceClient<nav2_msgs::srv::GetMapRegion>::SharedPtr map_region_client_;
+  std::vector<std::pair<uint64_t, nav2_msgs::srv::GetMapRegion::Response::SharedPtr>>
+  map_regions_buffer_;
+  double map_tiles_retry_delay_;
+  /// @brief Requests of map regions not answered successfully yet, by identifier
+  std::map<uint64_t, MapRegionRequest> pending_map_regions_;
+  uint64_t next_map_region_request_id_{0};
+  nav_msgs::msg::MapMetaData map_info_;
+  bool map_info_received_{false};
+  bool map_window_valid_{false};
+  /// @brief Cell of the map at the origin of the window held by the layer
+  int window_x_{0};
+  int window_y_{0};
   // Dynamic parameters handler
   rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr dyn_params_handler_;
 };
@@ -169,6 +169,7 @@ void PluginContainerLayer::matchSize()
 {
   std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
   Costmap2D * master = layered_costmap_->getCostmap();
+  setSparseStorage(master->isSparseStorage());
   resizeMap(
     master->getSizeInCellsX(), master->getSizeInCellsY(),
     master->getResolution(), master->getOriginX(), master->getOriginY());
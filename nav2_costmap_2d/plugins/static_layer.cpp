@@ -40,7 +40,10 @@
 #include "nav2_costmap_2d/static_layer.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "pluginlib/class_list_macros.hpp"
 #include "tf2/convert.hpp"
@@ -89,10 +92,29 @@ StaticLayer::onInitialize()
     throw std::runtime_error{"Failed to lock node"};
   }
 
-  map_sub_ = node->create_subscription<nav_msgs::msg::OccupancyGrid>(
-    map_topic_,
-    std::bind(&StaticLayer::incomingMap, this, std::placeholders::_1),
-    map_qos);
+  if (use_map_tiles_ && !layered_costmap_->isRolling()) {
+    RCLCPP_WARN(
+      logger_,
+      "StaticLayer: Map tiles can only be streamed in a rolling costmap. "
+      "Subscribing to the whole map instead.");
+    use_map_tiles_ = false;
+  }
+
+  if (use_map_tiles_) {
+    // Only the window of the map around the robot is held, and streamed in from the map server
+    map_region_service_ = joinWithParentNamespace(map_region_service_);
+    RCLCPP_INFO(
+      logger_,
+      "Streaming a %.1f m window of the map from the map region service (%s)",
+      map_tiles_window_size_, map_region_service_.c_str());
+    map_region_client_ = node->create_client<nav2_msgs::srv::GetMapRegion>(map_region_service_);
+    setDefaultValue(track_unknown_space_ ? NO_INFORMATION : FREE_SPACE);
+  } else {
+    map_sub_ = node->create_subscription<nav_msgs::msg::OccupancyGrid>(
+      map_topic_,
+      std::bind(&StaticLayer::incomingMap, this, std::placeholders::_1),
+      map_qos);
+  }
 
   if (subscribe_to_updates_) {
     RCLCPP_INFO(logger_, "Subscribing to updates");
@@ -137,6 +159,10 @@ StaticLayer::getParameters()
   declareParameter("map_topic", rclcpp::ParameterValue("map"));
   declareParameter("footprint_clearing_enabled", rclcpp::ParameterValue(false));
   declareParameter("restore_cleared_footprint", rclcpp::ParameterValue(true));
+  declareParameter("use_map_tiles", rclcpp::ParameterValue(false));
+  declareParameter("map_tiles_window_size", rclcpp::ParameterValue(100.0));
+  declareParameter("map_region_service", rclcpp::ParameterValue("map_server/map_region"));
+  declareParameter("map_tiles_retry_delay", rclcpp::ParameterValue(1.0));
 
   auto node = node_.lock();
   if (!node) {
@@ -152,6 +178,10 @@ StaticLayer::getParameters()
   node->get_parameter(
     name_ + "." + "map_subscribe_transient_local",
     map_subscribe_transient_local_);
+  node->get_parameter(name_ + "." + "use_map_tiles", use_map_tiles_);
+  node->get_parameter(name_ + "." + "map_tiles_window_size", map_tiles_window_size_);
+  node->get_parameter(name_ + "." + "map_region_service", map_region_service_);
+  node->get_parameter(name_ + "." + "map_tiles_retry_delay", map_tiles_retry_delay_);
   node->get_parameter("track_unknown_space", track_unknown_space_);
   node->get_parameter("use_maximum", use_maximum_);
   node->get_parameter("lethal_cost_threshold", temp_lethal_threshold);
@@ -161,6 +191,12 @@ StaticLayer::getParameters()
 
   // Enforce bounds
   lethal_threshold_ = std::max(std::min(temp_lethal_threshold, 100), 0);
+
+  // Map values only depend on the parameters above, so they are translated once
+  for (unsigned int value = 0; value < cost_translation_table_.size(); ++value) {
+    cost_translation_table_[value] = interpretValue(static_cast<unsigned char>(value));
+  }
+
   map_received_ = false;
   map_received_in_update_bounds_ = false;
 
@@ -226,11 +262,25 @@ StaticLayer::processMap(const nav_msgs::msg::OccupancyGrid & new_map)
   std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
 
   // initialize the costmap with static data
-  for (unsigned int i = 0; i < size_y; ++i) {
-    for (unsigned int j = 0; j < size_x; ++j) {
-      unsigned char value = new_map.data[index];
-      costmap_[index] = interpretValue(value);
-      ++index;
+  if (isSparseStorage()) {
+    // not writing the cells already holding their cost, e.g. the free space of a freshly
+    // reset sparse storage, not to commit its pages
+    for (unsigned int i = 0; i < size_y; ++i) {
+      for (unsigned int j = 0; j < size_x; ++j) {
+        unsigned char value = new_map.data[index];
+        if (costmap_[index] != cost_translation_table_[value]) {
+          costmap_[index] = cost_translation_table_[value];
+        }
+        ++index;
+      }
+    }
+  } else {
+    for (unsigned int i = 0; i < size_y; ++i) {
+      for (unsigned int j = 0; j < size_x; ++j) {
+        unsigned char value = new_map.data[index];
+        costmap_[index] = cost_translation_table_[value];
+        ++index;
+      }
     }
   }
 
@@ -251,6 +301,7 @@ StaticLayer::matchSize()
   //   unrelated to the size of the layered costmap
   if (!layered_costmap_->isRolling()) {
     Costmap2D * master = layered_costmap_->getCostmap();
+    setSparseStorage(master->isSparseStorage());
     resizeMap(
       master->getSizeInCellsX(), master->getSizeInCellsY(), master->getResolution(),
       master->getOriginX(), master->getOriginY());
@@ -295,6 +346,14 @@ void
 StaticLayer::incomingUpdate(map_msgs::msg::OccupancyGridUpdate::ConstSharedPtr update)
 {
   std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
+  if (use_map_tiles_) {
+    // Updates are given in cells of the whole map, only the window held is updated
+    if (map_window_valid_ && update->header.frame_id == map_frame_) {
+      applyMapRegion(update->x, update->y, update->width, update->height, update->data);
+    }
+    return;
+  }
+
   if (update->y < static_cast<int32_t>(y_) ||
     y_ + height_ < update->y + update->height ||
     update->x < static_cast<int32_t>(x_) ||
@@ -324,7 +383,7 @@ StaticLayer::incomingUpdate(map_msgs::msg::OccupancyGridUpdate::ConstSharedPtr u
     unsigned int index_base = (update->y + y) * size_x_;
     for (unsigned int x = 0; x < update->width; x++) {
       unsigned int index = index_base + x + update->x;
-      costmap_[index] = interpretValue(update->data[di++]);
+      costmap_[index] = cost_translation_table_[static_cast<unsigned char>(update->data[di++])];
     }
   }
 
@@ -332,6 +391,240 @@ StaticLayer::incomingUpdate(map_msgs::msg::OccupancyGridUpdate::ConstSharedPtr u
 }
 
 
+void
+StaticLayer::incomingMapRegion(
+  uint64_t request_id, nav2_msgs::srv::GetMapRegion::Response::SharedPtr response)
+{
+  std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
+  map_regions_buffer_.emplace_back(request_id, response);
+}
+
+void
+StaticLayer::addMapRegionRequest(
+  unsigned int x0, unsigned int y0, unsigned int width, unsigned int height)
+{
+  const uint64_t request_id = next_map_region_request_id_++;
+  pending_map_regions_[request_id] = MapRegionRequest{x0, y0, width, height, 0, clock_->now()};
+  retryMapRegionRequests();
+}
+
+void
+StaticLayer::retryMapRegionRequests()
+{
+  const rclcpp::Time now = clock_->now();
+  for (auto & [request_id, region] : pending_map_regions_) {
+    if (now < region.retry_time) {
+      continue;
+    }
+    // Requests unanswered, failed or not sent for the map server being unavailable,
+    // backing off not to flood a struggling map server
+    if (region.attempts > 0) {
+      RCLCPP_DEBUG(
+        logger_, "StaticLayer: Requesting the map region at (%u, %u) again, attempt %u",
+        region.x0, region.y0, region.attempts + 1);
+    }
+    sendMapRegionRequest(request_id, region);
+    const double delay = map_tiles_retry_delay_ * (1u << std::min(region.attempts, 5u));
+    region.retry_time = now + rclcpp::Duration::from_seconds(delay);
+    ++region.attempts;
+  }
+}
+
+bool
+StaticLayer::sendMapRegionRequest(uint64_t request_id, const MapRegionRequest & region)
+{
+  if (!map_region_client_->wait_for_service(std::chrono::seconds(0))) {
+    return false;
+  }
+
+  auto request = std::make_shared<nav2_msgs::srv::GetMapRegion::Request>();
+  request->x = region.x0;
+  request->y = region.y0;
+  request->width = region.width;
+  request->height = region.height;
+  map_region_client_->async_call(
+    request,
+    [this, request_id](rclcpp::Client<nav2_msgs::srv::GetMapRegion>::SharedFuture future) {
+      incomingMapRegion(request_id, future.get());
+    });
+  return true;
+}
+
+void
+StaticLayer::applyMapRegion(
+  const int x0, const int y0, const unsigned int width, const unsigned int height,
+  const std::vector<int8_t> & data)
+{
+  if (data.size() < static_cast<size_t>(width) * height) {
+    RCLCPP_WARN(logger_, "StaticLayer: Received map region is malformed. Rejecting.");
+    return;
+  }
+
+  const int begin_x = std::max(x0, window_x_);
+  const int begin_y = std::max(y0, window_y_);
+  const int end_x = std::min(x0 + static_cast<int>(width), window_x_ + static_cast<int>(size_x_));
+  const int end_y = std::min(y0 + static_cast<int>(height), window_y_ + static_cast<int>(size_y_));
+  for (int y = begin_y; y < end_y; ++y) {
+    const int8_t * value = data.data() + static_cast<size_t>(y - y0) * width + (begin_x - x0);
+    unsigned char * cost = costmap_ + getIndex(begin_x - window_x_, y - window_y_);
+    for (int x = begin_x; x < end_x; ++x) {
+      *cost++ = cost_translation_table_[static_cast<unsigned char>(*value++)];
+    }
+  }
+  has_updated_data_ = true;
+}
+
+void
+StaticLayer::updateMapTiles(double robot_x, double robot_y)
+{
+  std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
+
+  for (const auto & [request_id, response] : map_regions_buffer_) {
+    auto pending = pending_map_regions_.find(request_id);
+    if (pending == pending_map_regions_.end()) {
+      // Answered already by an earlier attempt, or dropped since
+      continue;
+    }
+    if (!response->success) {
+      // The map server has no map yet or failed to serve the region, retried after a delay
+      continue;
+    }
+    pending_map_regions_.erase(pending);
+
+    const rclcpp::Time load_time(response->map_info.map_load_time);
+    if (!map_info_received_ || load_time > rclcpp::Time(map_info_.map_load_time)) {
+      // A new map was loaded, stream it from scratch
+      map_info_ = response->map_info;
+      map_frame_ = response->region.header.frame_id;
+      map_info_received_ = true;
+      map_window_valid_ = false;
+      pending_map_regions_.clear();
+    } else if (load_time < rclcpp::Time(map_info_.map_load_time)) {
+      // Region of a map which has been replaced since
+      continue;
+    }
+
+    if (map_window_valid_) {
+      applyMapRegion(
+        response->x, response->y, response->region.info.width, response->region.info.height,
+        response->region.data);
+    }
+  }
+  map_regions_buffer_.clear();
+
+  if (!map_info_received_) {
+    if (pending_map_regions_.empty()) {
+      // An empty region only gets the map metadata
+      addMapRegionRequest(0, 0, 0, 0);
+    } else {
+      retryMapRegionRequests();
+    }
+    return;
+  }
+
+  // Robot position in the map frame
+  double robot_map_x = robot_x;
+  double robot_map_y = robot_y;
+  if (map_frame_ != global_frame_) {
+    geometry_msgs::msg::TransformStamped transform;
+    try {
+      transform = tf_->lookupTransform(
+        map_frame_, global_frame_, tf2::TimePointZero,
+        transform_tolerance_);
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR(logger_, "StaticLayer: %s", ex.what());
+      return;
+    }
+    tf2::Transform tf2_transform;
+    tf2::fromMsg(transform.transform, tf2_transform);
+    tf2::Vector3 p = tf2_transform * tf2::Vector3(robot_x, robot_y, 0);
+    robot_map_x = p.x();
+    robot_map_y = p.y();
+  }
+
+  // Window centered on the robot, moved once the robot is a quarter of the window off its center
+  const double resolution = map_info_.resolution;
+  const int window_size =
+    std::max(1, static_cast<int>(std::ceil(map_tiles_window_size_ / resolution)));
+  const int new_x = static_cast<int>(
+    std::floor((robot_map_x - map_info_.origin.position.x) / resolution)) - window_size / 2;
+  const int new_y = static_cast<int>(
+    std::floor((robot_map_y - map_info_.origin.position.y) / resolution)) - window_size / 2;
+  if (map_window_valid_ && std::abs(new_x - window_x_) <= window_size / 4 &&
+    std::abs(new_y - window_y_) <= window_size / 4)
+  {
+    retryMapRegionRequests();
+    return;
+  }
+
+  // Regions still pending which are out of the new window are no longer needed
+  const int new_xn = new_x + window_size;
+  const int new_yn = new_y + window_size;
+  for (auto it = pending_map_regions_.begin(); it != pending_map_regions_.end(); ) {
+    const MapRegionRequest & region = it->second;
+    if (static_cast<int>(region.x0) >= new_xn ||
+      static_cast<int>(region.x0 + region.width) <= new_x ||
+      static_cast<int>(region.y0) >= new_yn ||
+      static_cast<int>(region.y0 + region.height) <= new_y)
+    {
+      it = pending_map_regions_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // Requests the region of the map between the given cells, clipped to the map bounds
+  auto request_region = [&](int x0, int y0, int xn, int yn) {
+      x0 = std::max(x0, 0);
+      y0 = std::max(y0, 0);
+      xn = std::min(xn, static_cast<int>(map_info_.width));
+      yn = std::min(yn, static_cast<int>(map_info_.height));
+      if (x0 < xn && y0 < yn) {
+        addMapRegionRequest(x0, y0, xn - x0, yn - y0);
+      }
+    };
+
+  if (!map_window_valid_) {
+    resizeMap(
+      window_size, window_size, resolution,
+      map_info_.origin.position.x + new_x * resolution,
+      map_info_.origin.position.y + new_y * resolution);
+    request_region(new_x, new_y, new_xn, new_yn);
+  } else {
+    // Keep the cells shared by both windows, and only request the newly exposed ones
+    const int dx = new_x - window_x_;
+    const int dy = new_y - window_y_;
+    updateOrigin(
+      origin_x_ + (dx + std::copysign(0.5, dx)) * resolution,
+      origin_y_ + (dy + std::copysign(0.5, dy)) * resolution);
+
+    const int old_xn = window_x_ + window_size;
+    const int old_yn = window_y_ + window_size;
+    if (dx > 0) {
+      request_region(std::max(new_x, old_xn), new_y, new_xn, new_yn);
+    } else if (dx < 0) {
+      request_region(new_x, new_y, std::min(new_xn, window_x_), new_yn);
+    }
+    const int kept_x = std::max(new_x, window_x_);
+    const int kept_xn = std::min(new_xn, old_xn);
+    if (dy > 0) {
+      request_region(kept_x, std::max(new_y, old_yn), kept_xn, new_yn);
+    } else if (dy < 0) {
+      request_region(kept_x, new_y, kept_xn, std::min(new_yn, window_y_));
+    }
+  }
+
+  window_x_ = new_x;
+  window_y_ = new_y;
+  map_window_valid_ = true;
+  map_received_ = true;
+
+  x_ = y_ = 0;
+  width_ = size_x_;
+  height_ = size_y_;
+  has_updated_data_ = true;
+}
+
 void
 StaticLayer::updateBounds(
   double robot_x, double robot_y, double robot_yaw, double * min_x,
@@ -339,6 +632,10 @@ StaticLayer::updateBounds(
   double * max_x,
   double * max_y)
 {
+  if (use_map_tiles_) {
+    updateMapTiles(robot_x, robot_y);
+  }
+
   if (!map_received_) {
     map_received_in_update_bounds_ = false;
     return;
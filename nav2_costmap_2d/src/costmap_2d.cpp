@@ -37,7 +37,11 @@
  *********************************************************************/
 #include "nav2_costmap_2d/costmap_2d.hpp"
 
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -46,6 +50,18 @@
 
 namespace nav2_costmap_2d
 {
+
+namespace
+{
+
+size_t pageSize()
+{
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+}  // namespace
+
 Costmap2D::Costmap2D(
   unsigned int cells_size_x, unsigned int cells_size_y, double resolution,
   double origin_x, double origin_y, unsigned char default_value)
@@ -94,17 +110,112 @@ void Costmap2D::deleteMaps()
 {
   // clean up data
   std::unique_lock<mutex_t> lock(*access_);
-  delete[] costmap_;
-  costmap_ = NULL;
+  freeMap();
 }
 
 void Costmap2D::initMaps(unsigned int size_x, unsigned int size_y)
 {
   std::unique_lock<mutex_t> lock(*access_);
-  delete[] costmap_;
+  freeMap();
   size_x_ = size_x;
   size_y_ = size_y;
-  costmap_ = new unsigned char[size_x * size_y];
+  costmap_ = allocateMap(static_cast<size_t>(size_x) * size_y);
+}
+
+unsigned char * Costmap2D::allocateMap(size_t size)
+{
+  if (sparse_storage_ && size > 0) {
+    void * map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map != MAP_FAILED) {
+      mapped_storage_ = true;
+      mapped_size_ = size;
+      return static_cast<unsigned char *>(map);
+    }
+  }
+
+  mapped_storage_ = false;
+  mapped_size_ = 0;
+  return new unsigned char[size];
+}
+
+void Costmap2D::freeMap()
+{
+  if (mapped_storage_) {
+    munmap(costmap_, mapped_size_);
+  } else {
+    delete[] costmap_;
+  }
+  costmap_ = NULL;
+  mapped_storage_ = false;
+  mapped_size_ = 0;
+}
+
+void Costmap2D::releaseMapRange(size_t begin, size_t end)
+{
+  const size_t page_size = pageSize();
+  const auto base = reinterpret_cast<uintptr_t>(costmap_);
+  size_t page_begin = ((base + begin + page_size - 1) / page_size) * page_size - base;
+  size_t page_end = ((base + end) / page_size) * page_size - base;
+  if (page_begin >= page_end) {
+    fillMapRange(begin, end, FREE_SPACE);
+    return;
+  }
+
+  // Private anonymous pages read back as zeros after being released
+  fillMapRange(begin, page_begin, FREE_SPACE);
+  madvise(costmap_ + page_begin, page_end - page_begin, MADV_DONTNEED);
+  fillMapRange(page_end, end, FREE_SPACE);
+}
+
+void Costmap2D::fillMapRange(size_t begin, size_t end, unsigned char value)
+{
+  // Reading pages never written maps the shared zero page, without committing them
+  const size_t page_size = pageSize();
+  const auto base = reinterpret_cast<uintptr_t>(costmap_);
+  while (begin < end) {
+    const size_t chunk_end = std::min(end, ((base + begin) / page_size + 1) * page_size - base);
+    if (std::any_of(
+        costmap_ + begin, costmap_ + chunk_end,
+        [value](unsigned char cost) {return cost != value;}))
+    {
+      memset(costmap_ + begin, value, chunk_end - begin);
+    }
+    begin = chunk_end;
+  }
+}
+
+void Costmap2D::writeMapRange(size_t begin, size_t end, const unsigned char * source)
+{
+  const size_t page_size = pageSize();
+  const auto base = reinterpret_cast<uintptr_t>(costmap_);
+  while (begin < end) {
+    const size_t chunk_end = std::min(end, ((base + begin) / page_size + 1) * page_size - base);
+    if (memcmp(costmap_ + begin, source, chunk_end - begin) != 0) {
+      memcpy(costmap_ + begin, source, chunk_end - begin);
+    }
+    source += chunk_end - begin;
+    begin = chunk_end;
+  }
+}
+
+void Costmap2D::copyMapRegionToCostmap(
+  unsigned char * source_map, unsigned int sm_lower_left_x,
+  unsigned int sm_lower_left_y, unsigned int sm_size_x, unsigned int dm_lower_left_x,
+  unsigned int dm_lower_left_y, unsigned int region_size_x, unsigned int region_size_y)
+{
+  if (!mapped_storage_) {
+    copyMapRegion(
+      source_map, sm_lower_left_x, sm_lower_left_y, sm_size_x,
+      costmap_, dm_lower_left_x, dm_lower_left_y, size_x_, region_size_x, region_size_y);
+    return;
+  }
+
+  for (unsigned int i = 0; i < region_size_y; ++i) {
+    const size_t dm_index = static_cast<size_t>(dm_lower_left_y + i) * size_x_ + dm_lower_left_x;
+    writeMapRange(
+      dm_index, dm_index + region_size_x,
+      source_map + static_cast<size_t>(sm_lower_left_y + i) * sm_size_x + sm_lower_left_x);
+  }
 }
 
 void Costmap2D::resizeMap(
@@ -124,6 +235,13 @@ void Costmap2D::resizeMap(
 void Costmap2D::resetMaps()
 {
   std::unique_lock<mutex_t> lock(*access_);
+  if (mapped_storage_ && default_value_ == FREE_SPACE) {
+    releaseMapRange(0, mapped_size_);
+    return;
+  } else if (mapped_storage_) {
+    fillMapRange(0, mapped_size_, default_value_);
+    return;
+  }
   memset(costmap_, default_value_, size_x_ * size_y_ * sizeof(unsigned char));
 }
 
@@ -136,9 +254,18 @@ void Costmap2D::resetMapToValue(
   unsigned int x0, unsigned int y0, unsigned int xn, unsigned int yn, unsigned char value)
 {
   std::unique_lock<mutex_t> lock(*(access_));
+  if (mapped_storage_ && value == FREE_SPACE && x0 == 0 && xn == size_x_ && yn > y0) {
+    // Full width rows are contiguous
+    releaseMapRange(static_cast<size_t>(y0) * size_x_, static_cast<size_t>(yn) * size_x_);
+    return;
+  }
   unsigned int len = xn - x0;
   for (unsigned int y = y0 * size_x_ + x0; y < yn * size_x_ + x0; y += size_x_) {
-    memset(costmap_ + y, value, len * sizeof(unsigned char));
+    if (mapped_storage_) {
+      fillMapRange(y, y + len, value);
+    } else {
+      memset(costmap_ + y, value, len * sizeof(unsigned char));
+    }
   }
 }
 
@@ -174,10 +301,8 @@ bool Costmap2D::copyCostmapWindow(
   initMaps(upper_right_x - lower_left_x, upper_right_y - lower_left_y);
 
   // copy the window of the static map and the costmap that we're taking
-  copyMapRegion(
-    map.costmap_, lower_left_x, lower_left_y, map.size_x_, costmap_, 0, 0, size_x_,
-    size_x_,
-    size_y_);
+  copyMapRegionToCostmap(
+    map.costmap_, lower_left_x, lower_left_y, map.size_x_, 0, 0, size_x_, size_y_);
   return true;
 }
 
@@ -197,10 +322,7 @@ bool Costmap2D::copyWindow(
     return false;
   }
 
-  copyMapRegion(
-    source.costmap_, sx0, sy0, source.size_x_,
-    costmap_, dx0, dy0, size_x_,
-    sz_x, sz_y);
+  copyMapRegionToCostmap(source.costmap_, sx0, sy0, source.size_x_, dx0, dy0, sz_x, sz_y);
   return true;
 }
 
@@ -220,12 +342,17 @@ Costmap2D & Costmap2D::operator=(const Costmap2D & map)
   origin_x_ = map.origin_x_;
   origin_y_ = map.origin_y_;
   default_value_ = map.default_value_;
+  sparse_storage_ = map.sparse_storage_;
 
   // initialize our various maps
   initMaps(size_x_, size_y_);
 
   // copy the cost map
-  memcpy(costmap_, map.costmap_, size_x_ * size_y_ * sizeof(unsigned char));
+  if (mapped_storage_) {
+    writeMapRange(0, mapped_size_, map.costmap_);
+  } else {
+    memcpy(costmap_, map.costmap_, size_x_ * size_y_ * sizeof(unsigned char));
+  }
 
   return *this;
 }
@@ -359,47 +486,13 @@ void Costmap2D::updateOrigin(double new_origin_x, double new_origin_y)
   new_grid_ox = origin_x_ + cell_ox * resolution_;
   new_grid_oy = origin_y_ + cell_oy * resolution_;
 
-  // To save casting from unsigned int to int a bunch of times
-  int size_x = size_x_;
-  int size_y = size_y_;
-
-  // we need to compute the overlap of the new and existing windows
-  int lower_left_x, lower_left_y, upper_right_x, upper_right_y;
-  lower_left_x = std::min(std::max(cell_ox, 0), size_x);
-  lower_left_y = std::min(std::max(cell_oy, 0), size_y);
-  upper_right_x = std::min(std::max(cell_ox + size_x, 0), size_x);
-  upper_right_y = std::min(std::max(cell_oy + size_y, 0), size_y);
-
-  unsigned int cell_size_x = upper_right_x - lower_left_x;
-  unsigned int cell_size_y = upper_right_y - lower_left_y;
-
-  // we need a map to store the obstacles in the window temporarily
-  unsigned char * local_map = new unsigned char[cell_size_x * cell_size_y];
-
-  // copy the local window in the costmap to the local map
-  copyMapRegion(
-    costmap_, lower_left_x, lower_left_y, size_x_, local_map, 0, 0, cell_size_x,
-    cell_size_x,
-    cell_size_y);
-
-  // now we'll set the costmap to be completely unknown if we track unknown space
-  resetMaps();
+  // shift the data in place, only clearing the cells newly exposed by the moved window
+  std::unique_lock<mutex_t> lock(*access_);
+  shiftMapRegion(costmap_, size_x_, size_y_, cell_ox, cell_oy, default_value_);
 
   // update the origin with the appropriate world coordinates
   origin_x_ = new_grid_ox;
   origin_y_ = new_grid_oy;
-
-  // compute the starting cell location for copying data back in
-  int start_x = lower_left_x - cell_ox;
-  int start_y = lower_left_y - cell_oy;
-
-  // now we want to copy the overlapping information back into the map, but in its new location
-  copyMapRegion(
-    local_map, 0, 0, cell_size_x, costmap_, start_x, start_y, size_x_, cell_size_x,
-    cell_size_y);
-
-  // make sure to clean up
-  delete[] local_map;
 }
 
 bool Costmap2D::setConvexPolygonCost(
@@ -43,6 +43,7 @@
 #include <utility>
 
 #include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/costmap_update_codec.hpp"
 
 namespace nav2_costmap_2d
 {
@@ -55,13 +56,18 @@ Costmap2DPublisher::Costmap2DPublisher(
   std::string global_frame,
   std::string topic_name,
   bool always_send_full_costmap,
-  double map_vis_z)
+  double map_vis_z,
+  bool compress_updates,
+  unsigned int vis_downsample_factor)
 : costmap_(costmap),
+  served_costmap_(costmap),
   global_frame_(global_frame),
   topic_name_(topic_name),
   active_(false),
   always_send_full_costmap_(always_send_full_costmap),
-  map_vis_z_(map_vis_z)
+  map_vis_z_(map_vis_z),
+  compress_updates_(compress_updates),
+  vis_downsample_factor_(std::max(vis_downsample_factor, 1u))
 {
   auto node = parent.lock();
   clock_ = node->get_clock();
@@ -78,6 +84,16 @@ Costmap2DPublisher::Costmap2DPublisher(
     topic_name + "_updates", nav2::qos::LatchedPublisherQoS());
   costmap_raw_update_pub_ = node->create_publisher<nav2_msgs::msg::CostmapUpdate>(
     topic_name + "_raw_updates", nav2::qos::LatchedPublisherQoS());
+  if (compress_updates_) {
+    costmap_raw_compressed_update_pub_ =
+      node->create_publisher<nav2_msgs::msg::CostmapCompressedUpdate>(
+      topic_name + "_raw_compressed_updates", nav2::qos::LatchedPublisherQoS());
+    resync_service_ = node->create_service<std_srvs::srv::Trigger>(
+      topic_name + "_raw_resync",
+      std::bind(
+        &Costmap2DPublisher::resync_service_callback, this,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  }
 
   // Create a service that will use the callback function to handle requests.
   costmap_service_ = node->create_service<nav2_msgs::srv::GetCostmap>(
@@ -137,10 +153,10 @@ void Costmap2DPublisher::prepareGrid()
   grid_->header.frame_id = global_frame_;
   grid_->header.stamp = clock_->now();
 
-  grid_->info.resolution = grid_resolution_;
+  grid_->info.resolution = grid_resolution_ * vis_downsample_factor_;
 
-  grid_->info.width = grid_width_;
-  grid_->info.height = grid_height_;
+  grid_->info.width = (grid_width_ + vis_downsample_factor_ - 1) / vis_downsample_factor_;
+  grid_->info.height = (grid_height_ + vis_downsample_factor_ - 1) / vis_downsample_factor_;
 
   double wx, wy;
   costmap_->mapToWorld(0, 0, wx, wy);
@@ -149,11 +165,48 @@ void Costmap2DPublisher::prepareGrid()
   grid_->info.origin.position.z = map_vis_z_;
   grid_->info.origin.orientation.w = 1.0;
 
-  grid_->data.resize(grid_->info.width * grid_->info.height);
+  translateWindow(0, 0, grid_->info.width, grid_->info.height, grid_->data);
+}
 
-  unsigned char * data = costmap_->getCharMap();
-  std::transform(data, data + grid_->data.size(), grid_->data.begin(),
-    [](unsigned char c) {return cost_translation_table_[c];});
+void Costmap2DPublisher::translateWindow(
+  unsigned int x0, unsigned int y0, unsigned int xn, unsigned int yn,
+  std::vector<int8_t> & grid_data)
+{
+  const unsigned int width = xn - x0;
+  const unsigned int map_width = costmap_->getSizeInCellsX();
+  const unsigned char * costmap_data = costmap_->getCharMap();
+  grid_data.resize(width * (yn - y0));
+
+  if (vis_downsample_factor_ == 1) {
+    std::uint32_t i = 0;
+    for (std::uint32_t y = y0; y < yn; y++) {
+      const unsigned char * row = costmap_data + y * map_width + x0;
+      std::transform(row, row + width, grid_data.begin() + i,
+        [](unsigned char c) {return cost_translation_table_[c];});
+      i += width;
+    }
+    return;
+  }
+
+  // Keep the highest translated value of each block, so that obstacles stay visible.
+  // Unknown space (-1) is then only shown for the blocks without any known cell.
+  const unsigned int factor = vis_downsample_factor_;
+  const unsigned int map_height = costmap_->getSizeInCellsY();
+  auto grid_row = grid_data.begin();
+  for (std::uint32_t y = y0; y < yn; y++, grid_row += width) {
+    std::fill(grid_row, grid_row + width, static_cast<int8_t>(-1));
+    const unsigned int map_yn = std::min((y + 1) * factor, map_height);
+    for (unsigned int map_y = y * factor; map_y < map_yn; map_y++) {
+      const unsigned char * row = costmap_data + map_y * map_width;
+      for (std::uint32_t x = x0; x < xn; x++) {
+        const unsigned int map_xn = std::min((x + 1) * factor, map_width);
+        int8_t & value = grid_row[x - x0];
+        for (unsigned int map_x = x * factor; map_x < map_xn; map_x++) {
+          value = std::max(value, static_cast<int8_t>(cost_translation_table_[row[map_x]]));
+        }
+      }
+    }
+  }
 }
 
 void Costmap2DPublisher::prepareCostmap()
@@ -189,23 +242,20 @@ std::unique_ptr<map_msgs::msg::OccupancyGridUpdate> Costmap2DPublisher::createGr
 {
   auto update = std::make_unique<map_msgs::msg::OccupancyGridUpdate>();
 
+  // Update window in the visualization grid cells
+  const unsigned int factor = vis_downsample_factor_;
+  const unsigned int x0 = x0_ / factor;
+  const unsigned int y0 = y0_ / factor;
+  const unsigned int xn = (xn_ + factor - 1) / factor;
+  const unsigned int yn = (yn_ + factor - 1) / factor;
+
   update->header.stamp = clock_->now();
   update->header.frame_id = global_frame_;
-  update->x = x0_;
-  update->y = y0_;
-  update->width = xn_ - x0_;
-  update->height = yn_ - y0_;
-  update->data.resize(update->width * update->height);
-  const std::uint32_t map_width = costmap_->getSizeInCellsX();
-  unsigned char * costmap_data = costmap_->getCharMap();
-  std::uint32_t i = 0;
-  for (std::uint32_t y = y0_; y < yn_; y++) {
-    std::uint32_t row_start = y * map_width + x0_;
-    std::transform(costmap_data + row_start, costmap_data + row_start + update->width,
-        update->data.begin() + i,
-      [](unsigned char c) {return cost_translation_table_[c];});
-    i += update->width;
-  }
+  update->x = x0;
+  update->y = y0;
+  update->width = xn - x0;
+  update->height = yn - y0;
+  translateWindow(x0, y0, xn, yn, update->data);
   return update;
 }
 
@@ -232,8 +282,63 @@ std::unique_ptr<nav2_msgs::msg::CostmapUpdate> Costmap2DPublisher::createCostmap
   return msg;
 }
 
+std::unique_ptr<nav2_msgs::msg::CostmapCompressedUpdate>
+Costmap2DPublisher::createCostmapCompressedUpdateMsg()
+{
+  auto msg = std::make_unique<nav2_msgs::msg::CostmapCompressedUpdate>();
+  if (!encodeCostmapUpdate(
+      costmap_->getCharMap(), sent_costmap_.data(), costmap_->getSizeInCellsX(),
+      x0_, y0_, xn_ - x0_, yn_ - y0_, msg->data))
+  {
+    return nullptr;
+  }
+
+  msg->header.stamp = clock_->now();
+  msg->header.frame_id = global_frame_;
+  msg->costmap_stamp = sent_costmap_stamp_;
+  msg->sequence = ++compressed_update_sequence_;
+  msg->x = x0_;
+  msg->y = y0_;
+  msg->size_x = xn_ - x0_;
+  msg->size_y = yn_ - y0_;
+  return msg;
+}
+
+void Costmap2DPublisher::publishRawCostmap()
+{
+  if (costmap_raw_pub_->get_subscription_count() > 0) {
+    prepareCostmap();
+    if (compress_updates_) {
+      // Compressed updates are encoded against the last full costmap sent
+      sent_costmap_ = costmap_raw_->data;
+      sent_costmap_stamp_ = costmap_raw_->header.stamp;
+      compressed_update_sequence_ = 0;
+    }
+    costmap_raw_pub_->publish(std::move(costmap_raw_));
+  } else if (compress_updates_) {
+    // Subscribers to come request the full costmap, not knowing this one
+    std::unique_lock<Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
+    unsigned char * data = costmap_->getCharMap();
+    sent_costmap_.assign(
+      data, data + costmap_->getSizeInCellsX() * costmap_->getSizeInCellsY());
+    sent_costmap_stamp_ = clock_->now();
+    compressed_update_sequence_ = 0;
+  }
+}
+
 void Costmap2DPublisher::publishCostmap()
 {
+  // Compressed updates only apply in sequence on top of the full costmap they are encoded
+  // against, which is sent again to late joiners and to the subscribers missing updates
+  bool resync = false;
+  if (compress_updates_) {
+    const size_t subscription_count =
+      costmap_raw_compressed_update_pub_->get_subscription_count();
+    resync = full_costmap_requested_.exchange(false) ||
+      subscription_count > compressed_update_subscription_count_;
+    compressed_update_subscription_count_ = subscription_count;
+  }
+
   float resolution = costmap_->getResolution();
   if (always_send_full_costmap_ || grid_resolution_ != resolution ||
     grid_width_ != costmap_->getSizeInCellsX() ||
@@ -246,18 +351,39 @@ void Costmap2DPublisher::publishCostmap()
       prepareGrid();
       costmap_pub_->publish(std::move(grid_));
     }
-    if (costmap_raw_pub_->get_subscription_count() > 0) {
-      prepareCostmap();
-      costmap_raw_pub_->publish(std::move(costmap_raw_));
-    }
-  } else if (x0_ < xn_) {
-    // Publish just update msgs
-    std::unique_lock<Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
-    if (costmap_update_pub_->get_subscription_count() > 0) {
-      costmap_update_pub_->publish(createGridUpdateMsg());
+    publishRawCostmap();
+  } else {
+    if (resync) {
+      // Holds the changes of the update window already, leaving no compressed update to send
+      publishRawCostmap();
     }
-    if (costmap_raw_update_pub_->get_subscription_count() > 0) {
-      costmap_raw_update_pub_->publish(createCostmapUpdateMsg());
+    if (x0_ < xn_) {
+      // Publish just update msgs
+      std::unique_lock<Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
+      if (costmap_update_pub_->get_subscription_count() > 0) {
+        costmap_update_pub_->publish(createGridUpdateMsg());
+      }
+      if (costmap_raw_update_pub_->get_subscription_count() > 0) {
+        costmap_raw_update_pub_->publish(createCostmapUpdateMsg());
+      }
+      if (compress_updates_ && sent_costmap_.size() ==
+        static_cast<size_t>(costmap_->getSizeInCellsX()) * costmap_->getSizeInCellsY())
+      {
+        if (costmap_raw_compressed_update_pub_->get_subscription_count() > 0) {
+          auto msg = createCostmapCompressedUpdateMsg();
+          if (msg) {
+            costmap_raw_compressed_update_pub_->publish(std::move(msg));
+          }
+        } else {
+          // Keep the sent costmap in sync for the subscribers to come
+          const std::uint32_t map_width = costmap_->getSizeInCellsX();
+          unsigned char * costmap_data = costmap_->getCharMap();
+          for (std::uint32_t y = y0_; y < yn_; y++) {
+            std::uint32_t row_start = y * map_width + x0_;
+            std::copy_n(costmap_data + row_start, xn_ - x0_, sent_costmap_.begin() + row_start);
+          }
+        }
+      }
     }
   }
 
@@ -278,26 +404,40 @@ Costmap2DPublisher::costmap_service_callback(
   tf2::Quaternion quaternion;
   quaternion.setRPY(0.0, 0.0, 0.0);
 
-  auto size_x = costmap_->getSizeInCellsX();
-  auto size_y = costmap_->getSizeInCellsY();
+  std::unique_lock<Costmap2D::mutex_t> lock(*(served_costmap_->getMutex()));
+  auto size_x = served_costmap_->getSizeInCellsX();
+  auto size_y = served_costmap_->getSizeInCellsY();
   auto data_length = size_x * size_y;
-  unsigned char * data = costmap_->getCharMap();
+  unsigned char * data = served_costmap_->getCharMap();
   auto current_time = clock_->now();
 
   response->map.header.stamp = current_time;
   response->map.header.frame_id = global_frame_;
   response->map.metadata.size_x = size_x;
   response->map.metadata.size_y = size_y;
-  response->map.metadata.resolution = costmap_->getResolution();
+  response->map.metadata.resolution = served_costmap_->getResolution();
   response->map.metadata.layer = "master";
   response->map.metadata.map_load_time = current_time;
   response->map.metadata.update_time = current_time;
-  response->map.metadata.origin.position.x = costmap_->getOriginX();
-  response->map.metadata.origin.position.y = costmap_->getOriginY();
+  response->map.metadata.origin.position.x = served_costmap_->getOriginX();
+  response->map.metadata.origin.position.y = served_costmap_->getOriginY();
   response->map.metadata.origin.position.z = 0.0;
   response->map.metadata.origin.orientation = tf2::toMsg(quaternion);
   response->map.data.resize(data_length);
   response->map.data.assign(data, data + data_length);
 }
 
+void
+Costmap2DPublisher::resync_service_callback(
+  const std::shared_ptr<rmw_request_id_t>/*request_header*/,
+  const std::shared_ptr<std_srvs::srv::Trigger::Request>/*request*/,
+  const std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+{
+  RCLCPP_DEBUG(logger_, "Received request for the full costmap");
+
+  // Sent along with the next updates
+  full_costmap_requested_ = true;
+  response->success = true;
+}
+
 }  // end namespace nav2_costmap_2d
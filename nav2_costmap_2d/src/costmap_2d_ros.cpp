@@ -38,12 +38,15 @@
 
 #include "nav2_costmap_2d/costmap_2d_ros.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <chrono>
+#include <limits>
 #include <string>
 #include <vector>
 #include <utility>
 
+#include "nav2_costmap_2d/costmap_snapshot.hpp"
 #include "nav2_costmap_2d/layered_costmap.hpp"
 #include "nav2_util/execution_timer.hpp"
 #include "nav2_ros_common/node_utils.hpp"
@@ -51,6 +54,7 @@
 #include "tf2_ros/create_timer_ros.h"
 #include "nav2_util/robot_utils.hpp"
 #include "rcl_interfaces/msg/set_parameters_result.hpp"
+#include "rcl_interfaces/srv/list_parameters.hpp"
 
 using namespace std::chrono_literals;
 using std::placeholders::_1;
@@ -109,6 +113,7 @@ void Costmap2DROS::init()
   RCLCPP_INFO(get_logger(), "Creating Costmap");
 
   declare_parameter("always_send_full_costmap", rclcpp::ParameterValue(false));
+  declare_parameter("compress_costmap_updates", rclcpp::ParameterValue(false));
   declare_parameter("map_vis_z", rclcpp::ParameterValue(0.0));
   declare_parameter("footprint_padding", rclcpp::ParameterValue(0.01f));
   declare_parameter("footprint", rclcpp::ParameterValue(std::string("[]")));
@@ -122,10 +127,12 @@ void Costmap2DROS::init()
   declare_parameter("plugins", rclcpp::ParameterValue(default_plugins_));
   declare_parameter("filters", rclcpp::ParameterValue(std::vector<std::string>()));
   declare_parameter("publish_frequency", rclcpp::ParameterValue(1.0));
+  declare_parameter("publish_in_separate_thread", rclcpp::ParameterValue(false));
   declare_parameter("resolution", rclcpp::ParameterValue(0.1));
   declare_parameter("robot_base_frame", rclcpp::ParameterValue(std::string("base_link")));
   declare_parameter("robot_radius", rclcpp::ParameterValue(0.1));
   declare_parameter("rolling_window", rclcpp::ParameterValue(false));
+  declare_parameter("sparse_storage", rclcpp::ParameterValue(false));
   declare_parameter("track_unknown_space", rclcpp::ParameterValue(false));
   declare_parameter("transform_tolerance", rclcpp::ParameterValue(0.3));
   declare_parameter("initial_transform_timeout", rclcpp::ParameterValue(60.0));
@@ -133,17 +140,27 @@ void Costmap2DROS::init()
   declare_parameter("unknown_cost_value", rclcpp::ParameterValue(static_cast<unsigned char>(0xff)));
   declare_parameter("update_frequency", rclcpp::ParameterValue(5.0));
   declare_parameter("use_maximum", rclcpp::ParameterValue(false));
+  declare_parameter("visualization_downsample_factor", rclcpp::ParameterValue(1));
   declare_parameter("subscribe_to_stamped_footprint", rclcpp::ParameterValue(false));
+  declare_parameter("warm_start_file", rclcpp::ParameterValue(std::string("")));
+  declare_parameter("share_in_process", rclcpp::ParameterValue(true));
 }
 
 Costmap2DROS::~Costmap2DROS()
 {
+  // The shared costmap may outlive this node in its readers
+  if (shared_costmap_) {
+    SharedCostmap::withdraw(shared_costmap_topic_, shared_costmap_.get());
+    shared_costmap_->detach();
+  }
 }
 
 nav2::CallbackReturn
 Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
 {
   RCLCPP_INFO(get_logger(), "Configuring");
+  nav2_util::ExecutionTimer configure_timer;
+  configure_timer.start();
   try {
     getParameters();
   } catch (const std::exception & e) {
@@ -158,6 +175,7 @@ Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
   // Create the costmap itself
   layered_costmap_ = std::make_unique<LayeredCostmap>(
     global_frame_, rolling_window_, track_unknown_space_);
+  layered_costmap_->setSparseStorage(sparse_storage_);
 
   if (!layered_costmap_->isSizeLocked()) {
     layered_costmap_->resizeMap(
@@ -178,6 +196,8 @@ Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
   for (unsigned int i = 0; i < plugin_names_.size(); ++i) {
     RCLCPP_INFO(get_logger(), "Using plugin \"%s\"", plugin_names_[i].c_str());
 
+    nav2_util::ExecutionTimer plugin_timer;
+    plugin_timer.start();
     std::shared_ptr<Layer> plugin = plugin_loader_.createSharedInstance(plugin_types_[i]);
 
     // lock the costmap because no update is allowed until the plugin is initialized
@@ -195,8 +215,11 @@ Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
     }
 
     lock.unlock();
+    plugin_timer.end();
 
-    RCLCPP_INFO(get_logger(), "Initialized plugin \"%s\"", plugin_names_[i].c_str());
+    RCLCPP_INFO(
+      get_logger(), "Initialized plugin \"%s\" in %.3f s", plugin_names_[i].c_str(),
+      plugin_timer.elapsed_time_in_seconds());
   }
   // and costmap filters as well
   for (unsigned int i = 0; i < filter_names_.size(); ++i) {
@@ -232,10 +255,31 @@ Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
   footprint_pub_ = create_publisher<geometry_msgs::msg::PolygonStamped>(
     "published_footprint");
 
+  // When publishing in a separate thread, the publishers work on snapshots of the costmaps,
+  // so that the map updates are not blocked while the messages are being prepared
+  auto published_costmap = [this](Costmap2D * costmap) {
+      if (!publish_in_separate_thread_) {
+        return costmap;
+      }
+      published_costmaps_.push_back(costmap);
+      costmap_snapshots_.push_back(std::make_unique<Costmap2D>());
+      return costmap_snapshots_.back().get();
+    };
+
   costmap_publisher_ = std::make_unique<Costmap2DPublisher>(
     shared_from_this(),
-    layered_costmap_->getCostmap(), global_frame_,
-    "costmap", always_send_full_costmap_, map_vis_z_);
+    published_costmap(layered_costmap_->getCostmap()), global_frame_,
+    "costmap", always_send_full_costmap_, map_vis_z_, compress_costmap_updates_,
+    visualization_downsample_factor_);
+  // The GetCostmap services answer with the live costmaps, not the last published snapshots
+  costmap_publisher_->setServedCostmap(layered_costmap_->getCostmap());
+
+  // Nodes of the same process read the costmap directly rather than from the raw topic
+  if (share_in_process_) {
+    shared_costmap_ = std::make_shared<SharedCostmap>(layered_costmap_.get(), global_frame_);
+    shared_costmap_topic_ = get_node_topics_interface()->resolve_topic_name("costmap_raw");
+    SharedCostmap::advertise(shared_costmap_topic_, shared_costmap_);
+  }
 
   auto layers = layered_costmap_->getPlugins();
 
@@ -245,9 +289,11 @@ Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
       layer_publishers_.emplace_back(
         std::make_unique<Costmap2DPublisher>(
           shared_from_this(),
-          costmap_layer.get(), global_frame_,
-          layer->getName(), always_send_full_costmap_, map_vis_z_)
+          published_costmap(costmap_layer.get()), global_frame_,
+          layer->getName(), always_send_full_costmap_, map_vis_z_, compress_costmap_updates_,
+          visualization_downsample_factor_)
       );
+      layer_publishers_.back()->setServedCostmap(costmap_layer.get());
     }
   }
 
@@ -269,9 +315,18 @@ Costmap2DROS::on_configure(const rclcpp_lifecycle::State & /*state*/)
   // Add cleaning service
   clear_costmap_service_ = std::make_unique<ClearCostmapService>(shared_from_this(), *this);
 
+  // Service to save the warm start snapshot on demand
+  save_warm_start_service_ = create_service<std_srvs::srv::Trigger>(
+    std::string("save_warm_start_") + get_name(),
+    std::bind(&Costmap2DROS::saveWarmStartSnapshotCallback, this, std::placeholders::_1,
+      std::placeholders::_2, std::placeholders::_3));
+
   executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
   executor_->add_callback_group(callback_group_, get_node_base_interface());
   executor_thread_ = std::make_unique<nav2::NodeThread>(executor_);
+
+  configure_timer.end();
+  RCLCPP_INFO(get_logger(), "Configured in %.3f s", configure_timer.elapsed_time_in_seconds());
   return nav2::CallbackReturn::SUCCESS;
 }
 
@@ -279,6 +334,7 @@ nav2::CallbackReturn
 Costmap2DROS::on_activate(const rclcpp_lifecycle::State & /*state*/)
 {
   RCLCPP_INFO(get_logger(), "Activating");
+  activation_time_ = std::chrono::steady_clock::now();
 
   // First, make sure that the transform between the robot base frame
   // and the global frame is available
@@ -315,6 +371,30 @@ Costmap2DROS::on_activate(const rclcpp_lifecycle::State & /*state*/)
     tf_error.clear();
     r.sleep();
   }
+  RCLCPP_INFO(
+    get_logger(), "Transform available after %.3f s",
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - activation_time_).count());
+
+  // Restore the non-clearable layers costs on the first build of the costmap only,
+  // as it would otherwise discard the data of the clearable layers
+  warm_started_ = false;
+  if (!warm_start_file_.empty() && !layered_costmap_->isInitialized()) {
+    nav2_util::ExecutionTimer load_timer;
+    load_timer.start();
+    warm_start_costmap_ = std::make_unique<Costmap2D>();
+    if (loadCostmapSnapshot(warm_start_file_, *warm_start_costmap_, warm_start_key_)) {
+      load_timer.end();
+      RCLCPP_INFO(
+        get_logger(), "Loaded warm start snapshot %s in %.3f s", warm_start_file_.c_str(),
+        load_timer.elapsed_time_in_seconds());
+    } else {
+      RCLCPP_INFO(
+        get_logger(), "No valid warm start snapshot %s, building the costmap from scratch",
+        warm_start_file_.c_str());
+      warm_start_costmap_.reset();
+    }
+  }
+  startup_reported_ = false;
 
   // Activate publishers
   footprint_pub_->on_activate();
@@ -331,6 +411,15 @@ Costmap2DROS::on_activate(const rclcpp_lifecycle::State & /*state*/)
   map_update_thread_ = std::make_unique<std::thread>(
     std::bind(&Costmap2DROS::mapUpdateLoop, this, map_update_frequency_));
 
+  if (publish_in_separate_thread_) {
+    publish_thread_shutdown_ = false;
+    publish_pending_ = false;
+    publish_full_snapshot_ = true;
+    resetPublishBounds();
+    publish_thread_ = std::make_unique<std::thread>(
+      std::bind(&Costmap2DROS::publishLoop, this));
+  }
+
   start();
 
   // Add callback for dynamic parameters
@@ -357,6 +446,24 @@ Costmap2DROS::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
     map_update_thread_->join();
   }
 
+  if (publish_thread_) {
+    {
+      std::lock_guard<std::mutex> lock(publish_mutex_);
+      publish_thread_shutdown_ = true;
+    }
+    publish_cv_.notify_all();
+    if (publish_thread_->joinable()) {
+      publish_thread_->join();
+    }
+    publish_thread_.reset();
+  }
+
+  // Save the costmap of this run for the next one to start from
+  if (!warm_start_file_.empty()) {
+    saveWarmStartSnapshot();
+  }
+  warm_start_costmap_.reset();
+
   footprint_pub_->on_deactivate();
   costmap_publisher_->on_deactivate();
 
@@ -375,8 +482,17 @@ Costmap2DROS::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   get_cost_service_.reset();
   costmap_publisher_.reset();
   clear_costmap_service_.reset();
+  save_warm_start_service_.reset();
 
   layer_publishers_.clear();
+  published_costmaps_.clear();
+  costmap_snapshots_.clear();
+
+  if (shared_costmap_) {
+    SharedCostmap::withdraw(shared_costmap_topic_, shared_costmap_.get());
+    shared_costmap_->detach();
+    shared_costmap_.reset();
+  }
 
   layered_costmap_.reset();
 
@@ -403,6 +519,7 @@ Costmap2DROS::getParameters()
 
   // Get all of the required parameters
   get_parameter("always_send_full_costmap", always_send_full_costmap_);
+  get_parameter("compress_costmap_updates", compress_costmap_updates_);
   get_parameter("map_vis_z", map_vis_z_);
   get_parameter("footprint", footprint_);
   get_parameter("footprint_padding", footprint_padding_);
@@ -411,10 +528,12 @@ Costmap2DROS::getParameters()
   get_parameter("origin_x", origin_x_);
   get_parameter("origin_y", origin_y_);
   get_parameter("publish_frequency", map_publish_frequency_);
+  get_parameter("publish_in_separate_thread", publish_in_separate_thread_);
   get_parameter("resolution", resolution_);
   get_parameter("robot_base_frame", robot_base_frame_);
   get_parameter("robot_radius", robot_radius_);
   get_parameter("rolling_window", rolling_window_);
+  get_parameter("sparse_storage", sparse_storage_);
   get_parameter("track_unknown_space", track_unknown_space_);
   get_parameter("transform_tolerance", transform_tolerance_);
   get_parameter("initial_transform_timeout", initial_transform_timeout_);
@@ -423,6 +542,9 @@ Costmap2DROS::getParameters()
   get_parameter("plugins", plugin_names_);
   get_parameter("filters", filter_names_);
   get_parameter("subscribe_to_stamped_footprint", subscribe_to_stamped_footprint_);
+  get_parameter("visualization_downsample_factor", visualization_downsample_factor_);
+  get_parameter("warm_start_file", warm_start_file_);
+  get_parameter("share_in_process", share_in_process_);
 
   auto node = shared_from_this();
 
@@ -478,6 +600,30 @@ Costmap2DROS::getParameters()
       get_logger(), "You try to set height of map to be negative or zero,"
       " this isn't allowed, please give a positive value.");
   }
+
+  // 5. The visualization downsample factor must be positive
+  if (visualization_downsample_factor_ < 1) {
+    RCLCPP_ERROR(
+      get_logger(), "The visualization downsample factor must be positive, using 1 instead.");
+    visualization_downsample_factor_ = 1;
+  }
+
+  // 6. Rolling costmaps move with the robot, so they cannot be warm started
+  if (rolling_window_ && !warm_start_file_.empty()) {
+    RCLCPP_WARN(
+      get_logger(), "Warm start snapshots are not supported by rolling costmaps, ignoring %s.",
+      warm_start_file_.c_str());
+    warm_start_file_.clear();
+  }
+
+  // 7. Sparse storage only leaves the free space uncommitted, whereas costmaps tracking
+  // unknown space default to NO_INFORMATION, so would commit all their pages anyway
+  if (sparse_storage_ && track_unknown_space_) {
+    RCLCPP_WARN(
+      get_logger(), "Sparse storage only saves memory on free space, it is not supported "
+      "together with track_unknown_space, disabling it.");
+    sparse_storage_ = false;
+  }
 }
 
 void
@@ -538,7 +684,26 @@ Costmap2DROS::mapUpdateLoop(double frequency)
       timer.end();
 
       RCLCPP_DEBUG(get_logger(), "Map update time: %.9f", timer.elapsed_time_in_seconds());
-      if (publish_cycle_ > rclcpp::Duration(0s) && layered_costmap_->isInitialized()) {
+      if (publish_cycle_ > rclcpp::Duration(0s) && layered_costmap_->isInitialized() &&
+        publish_in_separate_thread_)
+      {
+        unsigned int x0, y0, xn, yn;
+        layered_costmap_->getBounds(&x0, &xn, &y0, &yn);
+        publish_x0_ = std::min(publish_x0_, x0);
+        publish_xn_ = std::max(publish_xn_, xn);
+        publish_y0_ = std::min(publish_y0_, y0);
+        publish_yn_ = std::max(publish_yn_, yn);
+
+        auto current_time = now();
+        if ((last_publish_ + publish_cycle_ < current_time) ||  // publish_cycle_ is due
+          (current_time < last_publish_))  // time has moved backwards
+        {
+          // Skipped, if the previous publication is still in progress
+          if (requestPublish()) {
+            last_publish_ = current_time;
+          }
+        }
+      } else if (publish_cycle_ > rclcpp::Duration(0s) && layered_costmap_->isInitialized()) {
         unsigned int x0, y0, xn, yn;
         layered_costmap_->getBounds(&x0, &xn, &y0, &yn);
         costmap_publisher_->updateBounds(x0, xn, y0, yn);
@@ -579,6 +744,96 @@ Costmap2DROS::mapUpdateLoop(double frequency)
   }
 }
 
+bool
+Costmap2DROS::requestPublish()
+{
+  std::unique_lock<std::mutex> lock(publish_mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || publish_pending_) {
+    return false;
+  }
+
+  // The publishing thread is idle: it's safe to refresh the snapshots and the publishers bounds
+  const bool full_snapshot = publish_full_snapshot_.exchange(false);
+  if (full_snapshot) {
+    // The costmaps changed out of the updated bounds, e.g. were reset, so are published whole
+    Costmap2D * master = layered_costmap_->getCostmap();
+    publish_x0_ = publish_y0_ = 0;
+    publish_xn_ = master->getSizeInCellsX();
+    publish_yn_ = master->getSizeInCellsY();
+  }
+  for (size_t i = 0; i < published_costmaps_.size(); ++i) {
+    Costmap2D * costmap = published_costmaps_[i];
+    Costmap2D * snapshot = costmap_snapshots_[i].get();
+    std::scoped_lock costmap_lock(*(costmap->getMutex()), *(snapshot->getMutex()));
+    bool copy_whole = full_snapshot;
+    if (snapshot->getSizeInCellsX() != costmap->getSizeInCellsX() ||
+      snapshot->getSizeInCellsY() != costmap->getSizeInCellsY() ||
+      snapshot->getResolution() != costmap->getResolution() ||
+      snapshot->getOriginX() != costmap->getOriginX() ||
+      snapshot->getOriginY() != costmap->getOriginY())
+    {
+      snapshot->resizeMap(
+        costmap->getSizeInCellsX(), costmap->getSizeInCellsY(), costmap->getResolution(),
+        costmap->getOriginX(), costmap->getOriginY());
+      copy_whole = true;
+    }
+
+    // Otherwise, only the cells updated since the previous snapshot have changed
+    if (!copy_whole && publish_x0_ < publish_xn_ && publish_y0_ < publish_yn_) {
+      copy_whole = !snapshot->copyWindow(
+        *costmap, publish_x0_, publish_y0_, publish_xn_, publish_yn_, publish_x0_, publish_y0_);
+    }
+    if (copy_whole) {
+      std::copy_n(
+        costmap->getCharMap(),
+        static_cast<size_t>(costmap->getSizeInCellsX()) * costmap->getSizeInCellsY(),
+        snapshot->getCharMap());
+    }
+  }
+
+  if (publish_x0_ < publish_xn_ && publish_y0_ < publish_yn_) {
+    costmap_publisher_->updateBounds(publish_x0_, publish_xn_, publish_y0_, publish_yn_);
+    for (auto & layer_pub : layer_publishers_) {
+      layer_pub->updateBounds(publish_x0_, publish_xn_, publish_y0_, publish_yn_);
+    }
+  }
+  resetPublishBounds();
+
+  publish_pending_ = true;
+  lock.unlock();
+  publish_cv_.notify_one();
+  return true;
+}
+
+void
+Costmap2DROS::resetPublishBounds()
+{
+  publish_x0_ = publish_y0_ = std::numeric_limits<unsigned int>::max();
+  publish_xn_ = publish_yn_ = 0;
+}
+
+void
+Costmap2DROS::publishLoop()
+{
+  std::unique_lock<std::mutex> lock(publish_mutex_);
+  while (true) {
+    publish_cv_.wait(lock, [this] {return publish_pending_ || publish_thread_shutdown_;});
+    if (publish_thread_shutdown_) {
+      return;
+    }
+
+    // Publish the snapshots without blocking the map update thread
+    lock.unlock();
+    RCLCPP_DEBUG(get_logger(), "Publish costmap at %s", name_.c_str());
+    costmap_publisher_->publishCostmap();
+    for (auto & layer_pub : layer_publishers_) {
+      layer_pub->publishCostmap();
+    }
+    lock.lock();
+    publish_pending_ = false;
+  }
+}
+
 void
 Costmap2DROS::updateMap()
 {
@@ -591,7 +846,29 @@ Costmap2DROS::updateMap()
       const double & x = pose.pose.position.x;
       const double & y = pose.pose.position.y;
       const double yaw = tf2::getYaw(pose.pose.orientation);
-      layered_costmap_->updateMap(x, y, yaw);
+
+      // Hold off building the costmap until the warm start snapshot can be checked against
+      // the non-clearable layers, e.g. once the static map was received
+      if (!warm_start_costmap_ || applyWarmStartSnapshot()) {
+        nav2_util::ExecutionTimer update_timer;
+        update_timer.start();
+        layered_costmap_->updateMap(x, y, yaw);
+        update_timer.end();
+
+        // Publish the snapshot shared in-process, sparing its consumers the costmap lock
+        if (shared_costmap_) {
+          shared_costmap_->update();
+        }
+
+        if (!startup_reported_ && layered_costmap_->isCurrent()) {
+          RCLCPP_INFO(
+            get_logger(), "Costmap current %.3f s after activation, last update took %.3f s%s",
+            std::chrono::duration<double>(
+              std::chrono::steady_clock::now() - activation_time_).count(),
+            update_timer.elapsed_time_in_seconds(), warm_started_ ? " (warm started)" : "");
+          startup_reported_ = true;
+        }
+      }
 
       auto footprint = std::make_unique<geometry_msgs::msg::PolygonStamped>();
       footprint->header = pose.header;
@@ -688,6 +965,7 @@ Costmap2DROS::resetLayers()
 {
   Costmap2D * top = layered_costmap_->getCostmap();
   top->resetMap(0, 0, top->getSizeInCellsX(), top->getSizeInCellsY());
+  layered_costmap_->recordChange(0, top->getSizeInCellsX(), 0, top->getSizeInCellsY());
 
   // Reset each of the plugins
   std::vector<std::shared_ptr<Layer>> * plugins = layered_costmap_->getPlugins();
@@ -702,6 +980,9 @@ Costmap2DROS::resetLayers()
   {
     (*filter)->reset();
   }
+
+  // The whole costmap was reset, not only the bounds of its next update
+  publish_full_snapshot_ = true;
 }
 
 bool
@@ -894,4 +1175,126 @@ void Costmap2DROS::getCostsCallback(
   }
 }
 
+bool
+Costmap2DROS::saveWarmStartSnapshot()
+{
+  if (warm_start_file_.empty() || !layered_costmap_) {
+    return false;
+  }
+
+  // Only snapshot the non-clearable layers once built from their own data, e.g. the static map
+  Costmap2D snapshot;
+  uint64_t key;
+  {
+    std::unique_lock<Costmap2D::mutex_t> lock(*(layered_costmap_->getCostmap()->getMutex()));
+    if (!layered_costmap_->isInitialized() || !layered_costmap_->isNonClearableCurrent()) {
+      RCLCPP_WARN(
+        get_logger(), "Not saving the warm start snapshot, the costmap is not built yet");
+      return false;
+    }
+    layered_costmap_->buildNonClearableCostmap(snapshot);
+    key = getWarmStartKey();
+  }
+
+  if (!saveCostmapSnapshot(warm_start_file_, snapshot, key)) {
+    RCLCPP_ERROR(
+      get_logger(), "Failed to save the warm start snapshot to %s", warm_start_file_.c_str());
+    return false;
+  }
+  RCLCPP_INFO(get_logger(), "Saved the warm start snapshot to %s", warm_start_file_.c_str());
+  return true;
+}
+
+void Costmap2DROS::saveWarmStartSnapshotCallback(
+  const std::shared_ptr<rmw_request_id_t>,
+  const std::shared_ptr<std_srvs::srv::Trigger::Request>,
+  const std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+{
+  if (warm_start_file_.empty()) {
+    response->success = false;
+    response->message = "No warm_start_file set";
+    return;
+  }
+  response->success = saveWarmStartSnapshot();
+  response->message = response->success ?
+    "Saved to " + warm_start_file_ : "Failed to save to " + warm_start_file_;
+}
+
+bool
+Costmap2DROS::applyWarmStartSnapshot()
+{
+  std::unique_lock<Costmap2D::mutex_t> lock(*(layered_costmap_->getCostmap()->getMutex()));
+  if (!layered_costmap_->isNonClearableCurrent()) {
+    RCLCPP_DEBUG(get_logger(), "Waiting for the non-clearable layers to restore the snapshot");
+    return false;
+  }
+
+  nav2_util::ExecutionTimer key_timer;
+  key_timer.start();
+  const bool matching = getWarmStartKey() == warm_start_key_ &&
+    layered_costmap_->restoreNonClearableCostmap(*warm_start_costmap_);
+  key_timer.end();
+  warm_start_costmap_.reset();
+
+  if (matching) {
+    RCLCPP_INFO(
+      get_logger(), "Warm starting from the snapshot, checked in %.3f s",
+      key_timer.elapsed_time_in_seconds());
+    warm_started_ = true;
+  } else {
+    RCLCPP_INFO(
+      get_logger(), "The warm start snapshot was built from another map or parameters, "
+      "building the costmap from scratch");
+  }
+  return true;
+}
+
+uint64_t
+Costmap2DROS::getWarmStartKey()
+{
+  uint64_t key = SNAPSHOT_INITIAL_KEY;
+  Costmap2D * costmap = layered_costmap_->getCostmap();
+  const unsigned int size[2] = {costmap->getSizeInCellsX(), costmap->getSizeInCellsY()};
+  const double geometry[3] =
+  {costmap->getResolution(), costmap->getOriginX(), costmap->getOriginY()};
+  const unsigned char default_value = costmap->getDefaultValue();
+  hashSnapshotKey(key, size, sizeof(size));
+  hashSnapshotKey(key, geometry, sizeof(geometry));
+  hashSnapshotKey(key, &default_value, sizeof(default_value));
+
+  for (const auto & point : layered_costmap_->getFootprint()) {
+    const double coordinates[2] = {point.x, point.y};
+    hashSnapshotKey(key, coordinates, sizeof(coordinates));
+  }
+
+  for (const auto & plugin : *(layered_costmap_->getPlugins())) {
+    if (plugin->isClearable()) {
+      continue;
+    }
+    const std::string name = plugin->getName();
+    hashSnapshotKey(key, name.data(), name.size());
+
+    // The parameters of the layer, e.g. the inflation radius
+    std::vector<std::string> parameter_names = list_parameters(
+      {name}, rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE).names;
+    std::sort(parameter_names.begin(), parameter_names.end());
+    for (const auto & parameter : get_parameters(parameter_names)) {
+      const std::string value = parameter.get_name() + "=" + parameter.value_to_string();
+      hashSnapshotKey(key, value.data(), value.size() + 1);
+    }
+
+    // The data of the layer, e.g. the static map
+    auto costmap_layer = std::dynamic_pointer_cast<CostmapLayer>(plugin);
+    if (costmap_layer) {
+      const unsigned int layer_size[2] =
+      {costmap_layer->getSizeInCellsX(), costmap_layer->getSizeInCellsY()};
+      hashSnapshotKey(key, layer_size, sizeof(layer_size));
+      hashSnapshotKey(
+        key, costmap_layer->getCharMap(),
+        static_cast<size_t>(layer_size[0]) * layer_size[1]);
+    }
+  }
+  return key;
+}
+
 }  // namespace nav2_costmap_2d
@@ -57,6 +57,7 @@ void CostmapLayer::matchSize()
 {
   std::lock_guard<Costmap2D::mutex_t> guard(*getMutex());
   Costmap2D * master = layered_costmap_->getCostmap();
+  setSparseStorage(master->isSparseStorage());
   resizeMap(
     master->getSizeInCellsX(), master->getSizeInCellsY(), master->getResolution(),
     master->getOriginX(), master->getOriginY());
@@ -191,6 +192,20 @@ void CostmapLayer::updateWithTrueOverwrite(
   unsigned char * master = master_grid.getCharMap();
   unsigned int span = master_grid.getSizeInCellsX();
 
+  if (master_grid.isSparseStorage()) {
+    // Unchanged cells are not written, not to commit the pages of sparse storage
+    for (int j = min_j; j < max_j; j++) {
+      unsigned int it = span * j + min_i;
+      for (int i = min_i; i < max_i; i++) {
+        if (master[it] != costmap_[it]) {
+          master[it] = costmap_[it];
+        }
+        it++;
+      }
+    }
+    return;
+  }
+
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = span * j + min_i;
     for (int i = min_i; i < max_i; i++) {
@@ -210,6 +225,20 @@ void CostmapLayer::updateWithOverwrite(
   unsigned char * master = master_grid.getCharMap();
   unsigned int span = master_grid.getSizeInCellsX();
 
+  if (master_grid.isSparseStorage()) {
+    // Unchanged cells are not written, not to commit the pages of sparse storage
+    for (int j = min_j; j < max_j; j++) {
+      unsigned int it = span * j + min_i;
+      for (int i = min_i; i < max_i; i++) {
+        if (costmap_[it] != NO_INFORMATION && master[it] != costmap_[it]) {
+          master[it] = costmap_[it];
+        }
+        it++;
+      }
+    }
+    return;
+  }
+
   for (int j = min_j; j < max_j; j++) {
     unsigned int it = span * j + min_i;
     for (int i = min_i; i < max_i; i++) {
@@ -0,0 +1,128 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_2d/costmap_snapshot.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace nav2_costmap_2d
+{
+
+namespace
+{
+
+// Header of the snapshot files, followed by the costs in row-major order
+struct SnapshotHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t size_x;
+  uint32_t size_y;
+  uint32_t reserved;
+  double resolution;
+  double origin_x;
+  double origin_y;
+  uint64_t key;
+};
+
+constexpr char MAGIC[8] = "NAV2CMS";
+constexpr uint32_t VERSION = 1;
+
+}  // namespace
+
+bool saveCostmapSnapshot(
+  const std::string & file_path, const Costmap2D & costmap, const uint64_t key)
+{
+  std::error_code error;
+  const std::filesystem::path parent = std::filesystem::path(file_path).parent_path();
+  if (!parent.empty()) {
+    std::filesystem::create_directories(parent, error);
+    if (error) {
+      return false;
+    }
+  }
+
+  // Write to a temporary file then rename it, so that a snapshot is never
+  // read partially written, e.g. if shut down while saving
+  const std::string tmp_path = file_path + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    SnapshotHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.size_x = costmap.getSizeInCellsX();
+    header.size_y = costmap.getSizeInCellsY();
+    header.resolution = costmap.getResolution();
+    header.origin_x = costmap.getOriginX();
+    header.origin_y = costmap.getOriginY();
+    header.key = key;
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(
+      reinterpret_cast<const char *>(costmap.getCharMap()),
+      static_cast<std::streamsize>(header.size_x) * header.size_y);
+    if (!file) {
+      file.close();
+      std::filesystem::remove(tmp_path, error);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmp_path, file_path, error);
+  if (error) {
+    std::filesystem::remove(tmp_path, error);
+    return false;
+  }
+  return true;
+}
+
+bool loadCostmapSnapshot(const std::string & file_path, Costmap2D & costmap, uint64_t & key)
+{
+  std::ifstream file(file_path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  SnapshotHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+    header.size_x == 0 || header.size_y == 0 || !(header.resolution > 0.0))
+  {
+    return false;
+  }
+
+  // Only use a snapshot of the expected size in full
+  file.seekg(0, std::ios::end);
+  const std::streamsize size = static_cast<std::streamsize>(header.size_x) * header.size_y;
+  if (file.tellg() != static_cast<std::streamoff>(sizeof(header)) + size) {
+    return false;
+  }
+  file.seekg(sizeof(header));
+
+  costmap.resizeMap(
+    header.size_x, header.size_y, header.resolution, header.origin_x, header.origin_y);
+  if (!file.read(reinterpret_cast<char *>(costmap.getCharMap()), size)) {
+    return false;
+  }
+  key = header.key;
+  return true;
+}
+
+}  // namespace nav2_costmap_2d
@@ -12,24 +12,94 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <memory>
 #include <mutex>
 
 #include "nav2_costmap_2d/costmap_subscriber.hpp"
+#include "nav2_costmap_2d/costmap_update_codec.hpp"
 
 namespace nav2_costmap_2d
 {
 
 std::shared_ptr<Costmap2D> CostmapSubscriber::getCostmap()
 {
-  if (!isCostmapReceived()) {
+  uint64_t version;
+  return getCostmap(version);
+}
+
+std::shared_ptr<Costmap2D> CostmapSubscriber::getCostmap(uint64_t & version)
+{
+  if (use_shared_costmap_) {
+    std::lock_guard<std::mutex> lock(shared_costmap_mutex_);
+    if (shared_costmap_) {
+      updateSharedCostmap();
+    }
+  }
+
+  auto snapshot = std::atomic_load(&snapshot_);
+  if (!snapshot) {
     throw std::runtime_error("Costmap is not available");
   }
-  if (costmap_msg_) {
-    processCurrentCostmapMsg();
+  version = snapshot->version;
+  return snapshot->costmap;
+}
+
+void CostmapSubscriber::updateSharedCostmap()
+{
+  uint64_t version = 0;
+  auto costmap = shared_costmap_->getSnapshot(version);
+  if (!costmap) {
+    if (!shared_costmap_->isAttached()) {
+      // Follow the costmap shared anew, e.g. after its Costmap2DROS was reconfigured
+      auto shared_costmap = SharedCostmap::find(shared_costmap_topic_);
+      if (shared_costmap && shared_costmap != shared_costmap_) {
+        shared_costmap_ = shared_costmap;
+        shared_costmap_version_ = 0;
+        updateSharedCostmap();
+        return;
+      }
+
+      RCLCPP_WARN(
+        logger_, "Costmap of %s is no longer shared in-process, subscribing to it",
+        topic_name_.c_str());
+      shared_costmap_.reset();
+      use_shared_costmap_ = false;
+      // Keep handing out the last costmap until updated from the topic
+      auto snapshot = std::atomic_load(&snapshot_);
+      std::lock_guard<std::mutex> lock(costmap_msg_mutex_);
+      if (snapshot) {
+        costmap_ = std::make_shared<Costmap2D>(*snapshot->costmap);
+        snapshot_source_ = costmap_.get();
+        frame_id_ = snapshot->frame_id;
+      }
+      subscribe_();
+    }
+    return;
   }
-  return costmap_;
+
+  if (version == shared_costmap_version_) {
+    return;
+  }
+
+  unsigned int x0, xn, y0, yn;
+  if (shared_costmap_version_ == 0 ||
+    !shared_costmap_->getChangedBoundsSince(shared_costmap_version_, x0, xn, y0, yn))
+  {
+    addUpdatedBounds(true, 0, 0, costmap->getSizeInCellsX(), costmap->getSizeInCellsY());
+  } else if (x0 < xn && y0 < yn) {
+    addUpdatedBounds(false, x0, y0, xn, yn);
+  }
+  shared_costmap_version_ = version;
+
+  // Shared snapshots are immutable already
+  std::atomic_store(
+    &snapshot_, std::make_shared<const CostmapSnapshot>(
+      CostmapSnapshot{costmap, costmap_version_, shared_costmap_->getFrameID()}));
 }
 
 void CostmapSubscriber::costmapCallback(const nav2_msgs::msg::Costmap::SharedPtr msg)
@@ -38,27 +108,23 @@ void CostmapSubscriber::costmapCallback(const nav2_msgs::msg::Costmap::SharedPtr
     std::lock_guard<std::mutex> lock(costmap_msg_mutex_);
     costmap_msg_ = msg;
     frame_id_ = costmap_msg_->header.frame_id;
+    if (!isCostmapReceived()) {
+      costmap_ = std::make_shared<Costmap2D>(
+        msg->metadata.size_x, msg->metadata.size_y,
+        msg->metadata.resolution, msg->metadata.origin.position.x,
+        msg->metadata.origin.position.y);
+    }
   }
-  if (!isCostmapReceived()) {
-    costmap_ = std::make_shared<Costmap2D>(
-      msg->metadata.size_x, msg->metadata.size_y,
-      msg->metadata.resolution, msg->metadata.origin.position.x,
-      msg->metadata.origin.position.y);
 
-    processCurrentCostmapMsg();
-  }
+  // Build the costmap snapshot once, rather than in each consumer call
+  processCurrentCostmapMsg();
 }
 
 void CostmapSubscriber::costmapUpdateCallback(
   const nav2_msgs::msg::CostmapUpdate::SharedPtr update_msg)
 {
+  std::lock_guard<std::mutex> lock(costmap_msg_mutex_);
   if (isCostmapReceived()) {
-    if (costmap_msg_) {
-      processCurrentCostmapMsg();
-    }
-
-    std::lock_guard<Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
-
     auto map_cell_size_x = costmap_->getSizeInCellsX();
     auto map_call_size_y = costmap_->getSizeInCellsY();
 
@@ -81,15 +147,107 @@ void CostmapSubscriber::costmapUpdateCallback(
         update_msg->data.begin() + (y * update_msg->size_x),
         update_msg->size_x, &master_array[starting_index_of_row_update_in_costmap]);
     }
+
+    addUpdatedBounds(
+      false, update_msg->x, update_msg->y,
+      update_msg->x + update_msg->size_x, update_msg->y + update_msg->size_y);
+    publishSnapshot();
   } else {
     RCLCPP_WARN(logger_, "No costmap received.");
   }
 }
 
+void CostmapSubscriber::costmapCompressedUpdateCallback(
+  const nav2_msgs::msg::CostmapCompressedUpdate::SharedPtr update_msg)
+{
+  std::lock_guard<std::mutex> lock(costmap_msg_mutex_);
+  if (!isCostmapReceived() ||
+    rclcpp::Time(update_msg->costmap_stamp) > rclcpp::Time(costmap_stamp_))
+  {
+    // Encoded against a full costmap not received yet, which is published on another topic
+    early_compressed_updates_.push_back(update_msg);
+    if (early_compressed_updates_.size() > max_early_compressed_updates_) {
+      // That costmap got lost, e.g. replaced by a newer one before being delivered
+      early_compressed_updates_.pop_front();
+      full_costmap_requested_ = false;
+      requestFullCostmap();
+    }
+    return;
+  }
+
+  applyCompressedUpdate(update_msg);
+}
+
+void CostmapSubscriber::applyCompressedUpdate(
+  const nav2_msgs::msg::CostmapCompressedUpdate::SharedPtr & update_msg)
+{
+  if (rclcpp::Time(update_msg->costmap_stamp) != rclcpp::Time(costmap_stamp_) ||
+    update_msg->sequence <= compressed_update_sequence_)
+  {
+    // Encoded against a replaced costmap, or applied already
+    return;
+  }
+  if (update_msg->sequence != compressed_update_sequence_ + 1) {
+    // Missed updates, e.g. when joining late or replaced in the history before delivery
+    if (!full_costmap_requested_) {
+      RCLCPP_WARN(
+        logger_, "Missed compressed updates of %s, requesting the full costmap.",
+        topic_name_.c_str());
+    }
+    requestFullCostmap();
+    return;
+  }
+  compressed_update_sequence_ = update_msg->sequence;
+
+  auto map_cell_size_x = costmap_->getSizeInCellsX();
+  auto map_cell_size_y = costmap_->getSizeInCellsY();
+
+  if (map_cell_size_x < update_msg->x + update_msg->size_x ||
+    map_cell_size_y < update_msg->y + update_msg->size_y)
+  {
+    RCLCPP_WARN(
+      logger_, "Update area outside of original map area. Costmap bounds: %d X %d, "
+      "Update origin: %d, %d  bounds: %d X %d", map_cell_size_x, map_cell_size_y,
+      update_msg->x, update_msg->y, update_msg->size_x, update_msg->size_y);
+    requestFullCostmap();
+    return;
+  }
+
+  unsigned int min_x, min_y, max_x, max_y;
+  if (!decodeCostmapUpdate(
+      update_msg->data.data(), update_msg->data.size(),
+      costmap_->getCharMap(), map_cell_size_x,
+      update_msg->x, update_msg->y, update_msg->size_x, update_msg->size_y,
+      min_x, min_y, max_x, max_y))
+  {
+    RCLCPP_WARN(logger_, "Received a malformed compressed costmap update.");
+    // Changes were possibly partially applied
+    addUpdatedBounds(
+      false, update_msg->x, update_msg->y,
+      update_msg->x + update_msg->size_x, update_msg->y + update_msg->size_y);
+    publishSnapshot();
+    requestFullCostmap();
+    return;
+  }
+
+  if (min_x < max_x) {
+    addUpdatedBounds(false, min_x, min_y, max_x, max_y);
+    publishSnapshot();
+  }
+}
+
 void CostmapSubscriber::processCurrentCostmapMsg()
 {
-  std::scoped_lock lock(*(costmap_->getMutex()), costmap_msg_mutex_);
-  if (haveCostmapParametersChanged()) {
+  std::lock_guard<std::mutex> lock(costmap_msg_mutex_);
+  if (!costmap_msg_) {
+    // Already processed along with a concurrent message
+    return;
+  }
+
+  // Costmaps replaced since the latest snapshot are taken as new ones
+  const bool first_costmap = costmap_version_ == 0 || costmap_.get() != snapshot_source_;
+  const bool parameters_changed = haveCostmapParametersChanged();
+  if (parameters_changed) {
     costmap_->resizeMap(
       costmap_msg_->metadata.size_x, costmap_msg_->metadata.size_y,
       costmap_msg_->metadata.resolution,
@@ -98,8 +256,149 @@ void CostmapSubscriber::processCurrentCostmapMsg()
   }
 
   unsigned char * master_array = costmap_->getCharMap();
-  std::copy(costmap_msg_->data.begin(), costmap_msg_->data.end(), master_array);
+  const unsigned int size_x = costmap_->getSizeInCellsX();
+  const unsigned int size_y = costmap_->getSizeInCellsY();
+  if (first_costmap || parameters_changed ||
+    costmap_msg_->data.size() != static_cast<size_t>(size_x) * size_y)
+  {
+    std::copy(costmap_msg_->data.begin(), costmap_msg_->data.end(), master_array);
+    addUpdatedBounds(true, 0, 0, size_x, size_y);
+    publishSnapshot();
+  } else {
+    // Same geometry: find the window of cells actually differing from the current data,
+    // so that the consumers could only refresh the changed area
+    unsigned int min_x = size_x, min_y = size_y, max_x = 0, max_y = 0;
+    auto msg_row = costmap_msg_->data.begin();
+    for (unsigned int y = 0; y < size_y; ++y, msg_row += size_x) {
+      unsigned char * map_row = master_array + static_cast<size_t>(y) * size_x;
+      auto first = std::mismatch(map_row, map_row + size_x, msg_row);
+      if (first.first == map_row + size_x) {
+        continue;
+      }
+      auto last = std::mismatch(
+        std::make_reverse_iterator(map_row + size_x), std::make_reverse_iterator(map_row),
+        std::make_reverse_iterator(msg_row + size_x));
+      min_x = std::min(min_x, static_cast<unsigned int>(first.first - map_row));
+      max_x = std::max(max_x, static_cast<unsigned int>(last.first.base() - map_row));
+      min_y = std::min(min_y, y);
+      max_y = y + 1;
+      std::copy(msg_row, msg_row + size_x, map_row);
+    }
+    if (min_x < max_x) {
+      addUpdatedBounds(false, min_x, min_y, max_x, max_y);
+      publishSnapshot();
+    }
+  }
+
+  // Compressed updates now apply on top of this costmap, including those received ahead
+  costmap_stamp_ = costmap_msg_->header.stamp;
+  compressed_update_sequence_ = 0;
+  full_costmap_requested_ = false;
   costmap_msg_.reset();
+  std::deque<nav2_msgs::msg::CostmapCompressedUpdate::SharedPtr> early_updates;
+  early_updates.swap(early_compressed_updates_);
+  for (const auto & update_msg : early_updates) {
+    if (rclcpp::Time(update_msg->costmap_stamp) > rclcpp::Time(costmap_stamp_)) {
+      early_compressed_updates_.push_back(update_msg);
+    } else {
+      applyCompressedUpdate(update_msg);
+    }
+  }
+}
+
+void CostmapSubscriber::requestFullCostmap()
+{
+  if (full_costmap_requested_ || !resync_client_ ||
+    !resync_client_->wait_for_service(std::chrono::seconds(0)))
+  {
+    return;
+  }
+
+  // Sent by the publisher along with its next updates, on the costmap topic
+  resync_client_->async_call(
+    std::make_shared<std_srvs::srv::Trigger::Request>(),
+    [](rclcpp::Client<std_srvs::srv::Trigger>::SharedFuture) {});
+  full_costmap_requested_ = true;
+}
+
+void CostmapSubscriber::publishSnapshot()
+{
+  const uint64_t version = costmap_version_;
+  auto previous = std::atomic_load(&snapshot_);
+  if (previous && previous->version == version) {
+    return;
+  }
+
+  // The previous snapshot is only reused once no consumer holds it anymore, refreshing the
+  // cells changed since. Geometry changes are always tracked as full changes.
+  std::shared_ptr<Costmap2D> costmap;
+  unsigned int min_x, min_y, max_x, max_y;
+  if (spare_costmap_ && spare_costmap_.use_count() == 1 &&
+    getUpdatedBounds(spare_costmap_version_, min_x, min_y, max_x, max_y))
+  {
+    if (min_x < max_x && min_y < max_y) {
+      spare_costmap_->copyWindow(*costmap_, min_x, min_y, max_x, max_y, min_x, min_y);
+    }
+    costmap = std::move(spare_costmap_);
+  } else {
+    costmap = std::make_shared<Costmap2D>(*costmap_);
+  }
+
+  snapshot_source_ = costmap_.get();
+  spare_costmap_.reset();
+  if (previous) {
+    spare_costmap_ = previous->costmap;
+    spare_costmap_version_ = previous->version;
+  }
+  std::atomic_store(
+    &snapshot_, std::make_shared<const CostmapSnapshot>(
+      CostmapSnapshot{costmap, version, frame_id_}));
+}
+
+void CostmapSubscriber::addUpdatedBounds(
+  const bool full,
+  const unsigned int min_x, const unsigned int min_y,
+  const unsigned int max_x, const unsigned int max_y)
+{
+  std::lock_guard<std::mutex> lock(updated_bounds_mutex_);
+  updated_bounds_.push_back({costmap_version_ + 1, full, min_x, min_y, max_x, max_y});
+  if (updated_bounds_.size() > max_updated_bounds_history_) {
+    updated_bounds_.pop_front();
+  }
+  costmap_version_++;
+}
+
+bool CostmapSubscriber::getUpdatedBounds(
+  const uint64_t since_version,
+  unsigned int & min_x, unsigned int & min_y,
+  unsigned int & max_x, unsigned int & max_y)
+{
+  std::lock_guard<std::mutex> lock(updated_bounds_mutex_);
+  min_x = min_y = std::numeric_limits<unsigned int>::max();
+  max_x = max_y = 0;
+
+  if (since_version >= costmap_version_) {
+    min_x = min_y = max_x = max_y = 0;
+    return true;
+  }
+  if (updated_bounds_.empty() || updated_bounds_.front().version > since_version + 1) {
+    // Changes history does not reach given version
+    return false;
+  }
+
+  for (const UpdatedBounds & bounds : updated_bounds_) {
+    if (bounds.version <= since_version) {
+      continue;
+    }
+    if (bounds.full) {
+      return false;
+    }
+    min_x = std::min(min_x, bounds.min_x);
+    min_y = std::min(min_y, bounds.min_y);
+    max_x = std::max(max_x, bounds.max_x);
+    max_y = std::max(max_y, bounds.max_y);
+  }
+  return true;
 }
 
 bool CostmapSubscriber::haveCostmapParametersChanged()
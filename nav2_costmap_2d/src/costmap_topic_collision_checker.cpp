@@ -14,11 +14,13 @@
 //
 // Modified by: Shivang Patel (shivaan14@gmail.com)
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <limits>
 
 #include "tf2/utils.hpp"
 
@@ -83,11 +85,7 @@ double CostmapTopicCollisionChecker::scorePose(
   bool fetch_costmap_and_footprint)
 {
   if (fetch_costmap_and_footprint) {
-    try {
-      collision_checker_.setCostmap(costmap_sub_.getCostmap());
-    } catch (const std::runtime_error & e) {
-      throw CollisionCheckerException(e.what());
-    }
+    fetchCostmapAndFootprint();
   }
 
   unsigned int cell_x, cell_y;
@@ -96,7 +94,140 @@ double CostmapTopicCollisionChecker::scorePose(
     throw IllegalPoseException(name_, "Pose Goes Off Grid.");
   }
 
-  return collision_checker_.footprintCost(getFootprint(pose, fetch_costmap_and_footprint));
+  return collision_checker_.footprintCost(getFootprint(pose, false));
+}
+
+bool CostmapTopicCollisionChecker::isTrajectoryCollisionFree(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  bool fetch_costmap_and_footprint)
+{
+  try {
+    if (scoreTrajectory(poses, fetch_costmap_and_footprint) >= LETHAL_OBSTACLE) {
+      return false;
+    }
+    return true;
+  } catch (const IllegalPoseException & e) {
+    RCLCPP_ERROR(rclcpp::get_logger(name_), "%s", e.what());
+    return false;
+  } catch (const CollisionCheckerException & e) {
+    RCLCPP_ERROR(rclcpp::get_logger(name_), "%s", e.what());
+    return false;
+  } catch (...) {
+    RCLCPP_ERROR(rclcpp::get_logger(name_), "Failed to check trajectory score!");
+    return false;
+  }
+}
+
+double CostmapTopicCollisionChecker::scoreTrajectory(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  bool fetch_costmap_and_footprint)
+{
+  if (fetch_costmap_and_footprint) {
+    fetchCostmapAndFootprint();
+  }
+  if (poses.empty() || footprint_.empty()) {
+    return 0.0;
+  }
+
+  const std::shared_ptr<Costmap2D> costmap = collision_checker_.getCostmap();
+  const size_t corners = footprint_.size();
+
+  // Cells of the footprint corners at each pose. The footprint cells only depend on these,
+  // so poses with the same corner cells as the previous one, e.g. moving less than a cell,
+  // are left out
+  swept_corners_.clear();
+  unsigned int min_x = std::numeric_limits<unsigned int>::max(), max_x = 0;
+  unsigned int min_y = std::numeric_limits<unsigned int>::max(), max_y = 0;
+  for (const auto & pose : poses) {
+    unsigned int cell_x, cell_y;
+    if (!costmap->worldToMap(pose.position.x, pose.position.y, cell_x, cell_y)) {
+      RCLCPP_DEBUG(rclcpp::get_logger(name_), "Map Cell: [%d, %d]", cell_x, cell_y);
+      throw IllegalPoseException(name_, "Pose Goes Off Grid.");
+    }
+
+    const double theta = tf2::getYaw(pose.orientation);
+    const double cos_th = cos(theta);
+    const double sin_th = sin(theta);
+    const size_t first = swept_corners_.size();
+    for (const auto & point : footprint_) {
+      unsigned int mx, my;
+      if (!costmap->worldToMap(
+          pose.position.x + (point.x * cos_th - point.y * sin_th),
+          pose.position.y + (point.x * sin_th + point.y * cos_th), mx, my))
+      {
+        return static_cast<double>(LETHAL_OBSTACLE);
+      }
+      swept_corners_.emplace_back(mx, my);
+    }
+
+    if (first != 0 &&
+      std::equal(
+        swept_corners_.begin() + (first - corners), swept_corners_.begin() + first,
+        swept_corners_.begin() + first))
+    {
+      swept_corners_.resize(first);
+      continue;
+    }
+    for (size_t i = first; i < swept_corners_.size(); ++i) {
+      min_x = std::min(min_x, swept_corners_[i].first);
+      max_x = std::max(max_x, swept_corners_[i].first);
+      min_y = std::min(min_y, swept_corners_[i].second);
+      max_y = std::max(max_y, swept_corners_[i].second);
+    }
+  }
+
+  // Rasterize the footprint outline of each pose in order, scoring the cells not yet covered
+  // by the previous poses only
+  const unsigned int mask_size_x = max_x - min_x + 1;
+  swept_mask_.assign(static_cast<size_t>(mask_size_x) * (max_y - min_y + 1), 0);
+  double trajectory_cost = 0.0;
+  for (size_t first = 0; first < swept_corners_.size(); first += corners) {
+    for (size_t i = 0; i < corners; ++i) {
+      // The outline is closed from the first corner to the last one, as footprintCost() does,
+      // lines not being rasterized the same both ways
+      const auto & start = swept_corners_[first + (i + 1 < corners ? i : 0)];
+      const auto & end = swept_corners_[first + (i + 1 < corners ? i + 1 : i)];
+      for (nav2_util::LineIterator line(start.first, start.second, end.first, end.second);
+        line.isValid(); line.advance())
+      {
+        unsigned char & checked = swept_mask_[
+          static_cast<size_t>(line.getY() - min_y) * mask_size_x + (line.getX() - min_x)];
+        if (checked) {
+          continue;
+        }
+        checked = 1;
+
+        const double cost = static_cast<double>(costmap->getCost(line.getX(), line.getY()));
+        if (cost >= static_cast<double>(LETHAL_OBSTACLE)) {
+          return cost;
+        }
+        trajectory_cost = std::max(trajectory_cost, cost);
+      }
+    }
+  }
+
+  return trajectory_cost;
+}
+
+void CostmapTopicCollisionChecker::fetchCostmapAndFootprint()
+{
+  try {
+    collision_checker_.setCostmap(costmap_sub_.getCostmap());
+  } catch (const std::runtime_error & e) {
+    throw CollisionCheckerException(e.what());
+  }
+  fetchFootprint();
+}
+
+void CostmapTopicCollisionChecker::fetchFootprint()
+{
+  std_msgs::msg::Header header;
+
+  // if footprint_sub_ was not initialized (alternative constructor), we are using the
+  // footprint built from the footprint_string alternative constructor argument.
+  if (footprint_sub_ && !footprint_sub_->getFootprintInRobotFrame(footprint_, header)) {
+    throw CollisionCheckerException("Current footprint not available.");
+  }
 }
 
 Footprint CostmapTopicCollisionChecker::getFootprint(
@@ -104,13 +235,7 @@ Footprint CostmapTopicCollisionChecker::getFootprint(
   bool fetch_latest_footprint)
 {
   if (fetch_latest_footprint) {
-    std_msgs::msg::Header header;
-
-    // if footprint_sub_ was not initialized (alternative constructor), we are using the
-    // footprint built from the footprint_string alternative constructor argument.
-    if (footprint_sub_ && !footprint_sub_->getFootprintInRobotFrame(footprint_, header)) {
-      throw CollisionCheckerException("Current footprint not available.");
-    }
+    fetchFootprint();
   }
 
   Footprint footprint;
@@ -0,0 +1,190 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_2d/costmap_update_codec.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace nav2_costmap_2d
+{
+
+namespace
+{
+
+// Shorter runs of equal values are cheaper to send as a part of a literal run
+constexpr unsigned int MIN_REPEATED_RUN = 4;
+
+void appendVarint(std::vector<uint8_t> & data, uint64_t value)
+{
+  while (value >= 0x80) {
+    data.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+bool readVarint(const uint8_t * data, const size_t data_size, size_t & pos, uint64_t & value)
+{
+  value = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7) {
+    if (pos >= data_size) {
+      return false;
+    }
+    const uint8_t byte = data[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool encodeCostmapUpdate(
+  const unsigned char * costmap, unsigned char * sent_costmap, const unsigned int size_x,
+  const unsigned int x0, const unsigned int y0,
+  const unsigned int width, const unsigned int height,
+  std::vector<uint8_t> & data)
+{
+  data.clear();
+  uint64_t skip = 0;
+  bool changed = false;
+
+  auto append_run = [&](const unsigned char * run, const unsigned int length, const bool literal) {
+      appendVarint(data, skip);
+      appendVarint(data, (static_cast<uint64_t>(length) << 1) | (literal ? 1u : 0u));
+      if (literal) {
+        data.insert(data.end(), run, run + length);
+      } else {
+        data.push_back(run[0]);
+      }
+      skip = 0;
+    };
+
+  for (unsigned int y = y0; y < y0 + height; ++y) {
+    const size_t row_start = static_cast<size_t>(y) * size_x + x0;
+    const unsigned char * row = costmap + row_start;
+    unsigned char * sent_row = sent_costmap + row_start;
+
+    unsigned int i = 0;
+    while (i < width) {
+      if (row[i] == sent_row[i]) {
+        skip++;
+        i++;
+        continue;
+      }
+
+      // Span of changed cells, split into repeated and literal runs
+      unsigned int end = i + 1;
+      while (end < width && row[end] != sent_row[end]) {
+        end++;
+      }
+      unsigned int literal_start = i;
+      unsigned int j = i;
+      while (j < end) {
+        unsigned int k = j + 1;
+        while (k < end && row[k] == row[j]) {
+          k++;
+        }
+        if (k - j >= MIN_REPEATED_RUN) {
+          if (literal_start < j) {
+            append_run(row + literal_start, j - literal_start, true);
+          }
+          append_run(row + j, k - j, false);
+          literal_start = k;
+        }
+        j = k;
+      }
+      if (literal_start < end) {
+        append_run(row + literal_start, end - literal_start, true);
+      }
+
+      std::memcpy(sent_row + i, row + i, end - i);
+      changed = true;
+      i = end;
+    }
+  }
+
+  return changed;
+}
+
+bool decodeCostmapUpdate(
+  const uint8_t * data, const size_t data_size,
+  unsigned char * costmap, const unsigned int size_x,
+  const unsigned int x0, const unsigned int y0,
+  const unsigned int width, const unsigned int height,
+  unsigned int & min_x, unsigned int & min_y,
+  unsigned int & max_x, unsigned int & max_y)
+{
+  min_x = min_y = std::numeric_limits<unsigned int>::max();
+  max_x = max_y = 0;
+  if (width == 0) {
+    return data_size == 0;
+  }
+
+  const uint64_t num_cells = static_cast<uint64_t>(width) * height;
+  uint64_t cell = 0;
+  size_t pos = 0;
+  while (pos < data_size) {
+    uint64_t skip, run;
+    if (!readVarint(data, data_size, pos, skip) || !readVarint(data, data_size, pos, run)) {
+      return false;
+    }
+    const bool literal = (run & 1u) != 0;
+    uint64_t length = run >> 1;
+    if (length == 0 || skip > num_cells - cell || length > num_cells - cell - skip) {
+      return false;
+    }
+    if (literal ? length > data_size - pos : pos >= data_size) {
+      return false;
+    }
+    cell += skip;
+
+    const uint8_t * values = data + pos;
+    pos += literal ? length : 1;
+
+    // Write the run row by row, as it may wrap over the window rows
+    while (length > 0) {
+      const unsigned int row = static_cast<unsigned int>(cell / width);
+      const unsigned int col = static_cast<unsigned int>(cell % width);
+      const unsigned int count =
+        static_cast<unsigned int>(std::min<uint64_t>(length, width - col));
+      unsigned char * dst = costmap + static_cast<size_t>(y0 + row) * size_x + x0 + col;
+      if (literal) {
+        std::memcpy(dst, values, count);
+        values += count;
+      } else {
+        std::memset(dst, values[0], count);
+      }
+
+      min_x = std::min(min_x, x0 + col);
+      max_x = std::max(max_x, x0 + col + count);
+      min_y = std::min(min_y, y0 + row);
+      max_y = std::max(max_y, y0 + row + 1);
+      cell += count;
+      length -= count;
+    }
+  }
+
+  if (min_x > max_x) {
+    min_x = min_y = max_x = max_y = 0;
+  }
+  return true;
+}
+
+}  // namespace nav2_costmap_2d
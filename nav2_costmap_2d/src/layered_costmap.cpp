@@ -52,6 +52,22 @@ using std::vector;
 namespace nav2_costmap_2d
 {
 
+namespace
+{
+
+// Whether two costmaps have the same size, resolution and origin
+bool haveSameGeometry(const Costmap2D & a, const Costmap2D & b)
+{
+  return a.getSizeInCellsX() == b.getSizeInCellsX() &&
+         a.getSizeInCellsY() == b.getSizeInCellsY() &&
+         a.getResolution() == b.getResolution() &&
+         a.getOriginX() == b.getOriginX() &&
+         a.getOriginY() == b.getOriginY();
+}
+
+}  // namespace
+
+
 LayeredCostmap::LayeredCostmap(std::string global_frame, bool rolling_window, bool track_unknown)
 : primary_costmap_(), combined_costmap_(),
   global_frame_(global_frame),
@@ -112,6 +128,7 @@ void LayeredCostmap::resizeMap(
   size_locked_ = size_locked;
   primary_costmap_.resizeMap(size_x, size_y, resolution, origin_x, origin_y);
   combined_costmap_.resizeMap(size_x, size_y, resolution, origin_x, origin_y);
+  recordChange(0, size_x, 0, size_y);
   for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
     plugin != plugins_.end(); ++plugin)
   {
@@ -141,8 +158,17 @@ void LayeredCostmap::updateMap(double robot_x, double robot_y, double robot_yaw)
   if (rolling_window_) {
     double new_origin_x = robot_x - combined_costmap_.getSizeInMetersX() / 2;
     double new_origin_y = robot_y - combined_costmap_.getSizeInMetersY() / 2;
+    const double prev_origin_x = combined_costmap_.getOriginX();
+    const double prev_origin_y = combined_costmap_.getOriginY();
     primary_costmap_.updateOrigin(new_origin_x, new_origin_y);
     combined_costmap_.updateOrigin(new_origin_x, new_origin_y);
+    // Shifting the costmap moves all of its cells
+    if (combined_costmap_.getOriginX() != prev_origin_x ||
+      combined_costmap_.getOriginY() != prev_origin_y)
+    {
+      recordChange(
+        0, combined_costmap_.getSizeInCellsX(), 0, combined_costmap_.getSizeInCellsY());
+    }
   }
 
   if (isOutofBounds(robot_x, robot_y)) {
@@ -158,9 +184,31 @@ void LayeredCostmap::updateMap(double robot_x, double robot_y, double robot_yaw)
   minx_ = miny_ = std::numeric_limits<double>::max();
   maxx_ = maxy_ = std::numeric_limits<double>::lowest();
 
+  // When restoring the costs of the non-clearable plugins, their bounds are left out
+  // of the update, unless the costmap is resized and the restored costs discarded
+  bool restoring = restored_costmap_ != nullptr;
+  double restored_minx = std::numeric_limits<double>::max();
+  double restored_miny = std::numeric_limits<double>::max();
+  double restored_maxx = std::numeric_limits<double>::lowest();
+  double restored_maxy = std::numeric_limits<double>::lowest();
+
   for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
     plugin != plugins_.end(); ++plugin)
   {
+    if (restoring && !(*plugin)->isClearable()) {
+      double plugin_minx = minx_;
+      double plugin_miny = miny_;
+      double plugin_maxx = maxx_;
+      double plugin_maxy = maxy_;
+      (*plugin)->updateBounds(
+        robot_x, robot_y, robot_yaw, &plugin_minx, &plugin_miny, &plugin_maxx, &plugin_maxy);
+      restored_minx = std::min(restored_minx, plugin_minx);
+      restored_miny = std::min(restored_miny, plugin_miny);
+      restored_maxx = std::max(restored_maxx, plugin_maxx);
+      restored_maxy = std::max(restored_maxy, plugin_maxy);
+      continue;
+    }
+
     double prev_minx = minx_;
     double prev_miny = miny_;
     double prev_maxx = maxx_;
@@ -195,6 +243,18 @@ void LayeredCostmap::updateMap(double robot_x, double robot_y, double robot_yaw)
     }
   }
 
+  if (restoring && !haveSameGeometry(combined_costmap_, *restored_costmap_)) {
+    RCLCPP_WARN(
+      rclcpp::get_logger("nav2_costmap_2d"),
+      "The costmap was resized, discarding the restored costs");
+    restored_costmap_.reset();
+    restoring = false;
+    minx_ = std::min(minx_, restored_minx);
+    miny_ = std::min(miny_, restored_miny);
+    maxx_ = std::max(maxx_, restored_maxx);
+    maxy_ = std::max(maxy_, restored_maxy);
+  }
+
   int x0, xn, y0, yn;
   combined_costmap_.worldToMapEnforceBounds(minx_, miny_, x0, y0);
   combined_costmap_.worldToMapEnforceBounds(maxx_, maxy_, xn, yn);
@@ -208,26 +268,54 @@ void LayeredCostmap::updateMap(double robot_x, double robot_y, double robot_yaw)
     rclcpp::get_logger(
       "nav2_costmap_2d"), "Updating area x: [%d, %d] y: [%d, %d]", x0, xn, y0, yn);
 
+  bool update_plugins = true;
   if (xn < x0 || yn < y0) {
-    return;
+    if (!restoring) {
+      return;
+    }
+    update_plugins = false;
+  }
+
+  if (restoring) {
+    // Start from the restored costs, then the whole costmap is updated
+    Costmap2D & costmap = filters_.size() == 0 ? combined_costmap_ : primary_costmap_;
+    std::copy_n(
+      restored_costmap_->getCharMap(),
+      static_cast<size_t>(costmap.getSizeInCellsX()) * costmap.getSizeInCellsY(),
+      costmap.getCharMap());
+    restored_costmap_.reset();
   }
 
   if (filters_.size() == 0) {
     // If there are no filters enabled just update costmap sequentially by each plugin
-    combined_costmap_.resetMap(x0, y0, xn, yn);
-    for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
-      plugin != plugins_.end(); ++plugin)
-    {
-      (*plugin)->updateCosts(combined_costmap_, x0, y0, xn, yn);
+    if (update_plugins) {
+      combined_costmap_.resetMap(x0, y0, xn, yn);
+      for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
+        plugin != plugins_.end(); ++plugin)
+      {
+        (*plugin)->updateCosts(combined_costmap_, x0, y0, xn, yn);
+      }
+    }
+    if (restoring) {
+      x0 = y0 = 0;
+      xn = static_cast<int>(combined_costmap_.getSizeInCellsX());
+      yn = static_cast<int>(combined_costmap_.getSizeInCellsY());
     }
   } else {
     // Costmap Filters enabled
     // 1. Update costmap by plugins
-    primary_costmap_.resetMap(x0, y0, xn, yn);
-    for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
-      plugin != plugins_.end(); ++plugin)
-    {
-      (*plugin)->updateCosts(primary_costmap_, x0, y0, xn, yn);
+    if (update_plugins) {
+      primary_costmap_.resetMap(x0, y0, xn, yn);
+      for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
+        plugin != plugins_.end(); ++plugin)
+      {
+        (*plugin)->updateCosts(primary_costmap_, x0, y0, xn, yn);
+      }
+    }
+    if (restoring) {
+      x0 = y0 = 0;
+      xn = static_cast<int>(primary_costmap_.getSizeInCellsX());
+      yn = static_cast<int>(primary_costmap_.getSizeInCellsY());
     }
 
     // 2. Copy processed costmap window to a final costmap.
@@ -253,10 +341,81 @@ void LayeredCostmap::updateMap(double robot_x, double robot_y, double robot_yaw)
   bxn_ = xn;
   by0_ = y0;
   byn_ = yn;
+  recordChange(x0, xn, y0, yn);
 
   initialized_ = true;
 }
 
+void LayeredCostmap::recordChange(
+  unsigned int x0, unsigned int xn, unsigned int y0, unsigned int yn)
+{
+  change_history_[change_count_ % CHANGE_HISTORY_SIZE] = ChangedBounds{x0, xn, y0, yn};
+  change_count_++;
+}
+
+bool LayeredCostmap::getChangedBoundsSince(
+  uint64_t change_count, unsigned int & x0, unsigned int & xn,
+  unsigned int & y0, unsigned int & yn) const
+{
+  x0 = y0 = std::numeric_limits<unsigned int>::max();
+  xn = yn = 0;
+  if (change_count > change_count_ || change_count_ - change_count > CHANGE_HISTORY_SIZE) {
+    return false;
+  }
+
+  for (uint64_t i = change_count; i < change_count_; ++i) {
+    const ChangedBounds & bounds = change_history_[i % CHANGE_HISTORY_SIZE];
+    x0 = std::min(x0, bounds.x0);
+    xn = std::max(xn, bounds.xn);
+    y0 = std::min(y0, bounds.y0);
+    yn = std::max(yn, bounds.yn);
+  }
+  if (x0 > xn) {
+    x0 = xn = y0 = yn = 0;
+  }
+  return true;
+}
+
+bool LayeredCostmap::isNonClearableCurrent()
+{
+  for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
+    plugin != plugins_.end(); ++plugin)
+  {
+    if (!(*plugin)->isClearable() && (*plugin)->isEnabled() && !(*plugin)->isCurrent()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LayeredCostmap::buildNonClearableCostmap(Costmap2D & costmap)
+{
+  std::unique_lock<Costmap2D::mutex_t> lock(*(combined_costmap_.getMutex()));
+  const unsigned int size_x = combined_costmap_.getSizeInCellsX();
+  const unsigned int size_y = combined_costmap_.getSizeInCellsY();
+  costmap.setDefaultValue(combined_costmap_.getDefaultValue());
+  costmap.resizeMap(
+    size_x, size_y, combined_costmap_.getResolution(),
+    combined_costmap_.getOriginX(), combined_costmap_.getOriginY());
+  for (vector<std::shared_ptr<Layer>>::iterator plugin = plugins_.begin();
+    plugin != plugins_.end(); ++plugin)
+  {
+    if (!(*plugin)->isClearable()) {
+      (*plugin)->updateCosts(costmap, 0, 0, size_x, size_y);
+    }
+  }
+}
+
+bool LayeredCostmap::restoreNonClearableCostmap(const Costmap2D & costmap)
+{
+  std::unique_lock<Costmap2D::mutex_t> lock(*(combined_costmap_.getMutex()));
+  if (!haveSameGeometry(combined_costmap_, costmap)) {
+    return false;
+  }
+  restored_costmap_ = std::make_unique<Costmap2D>(costmap);
+  return true;
+}
+
 bool LayeredCostmap::isCurrent()
 {
   current_ = true;
@@ -0,0 +1,211 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_2d/shared_costmap.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace nav2_costmap_2d
+{
+
+namespace
+{
+
+// Shared costmaps of the process, by raw costmap topic
+std::mutex & registryMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, std::weak_ptr<SharedCostmap>> & registry()
+{
+  static std::map<std::string, std::weak_ptr<SharedCostmap>> shared_costmaps;
+  return shared_costmaps;
+}
+
+}  // namespace
+
+SharedCostmap::SharedCostmap(LayeredCostmap * layered_costmap, const std::string & frame_id)
+: layered_costmap_(layered_costmap), frame_id_(frame_id)
+{
+}
+
+void SharedCostmap::update()
+{
+  if (!consumed_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!layered_costmap_) {
+    return;
+  }
+
+  Costmap2D * master = layered_costmap_->getCostmap();
+  std::unique_lock<Costmap2D::mutex_t> costmap_lock(*(master->getMutex()));
+  if (!layered_costmap_->isInitialized()) {
+    return;
+  }
+
+  const uint64_t version = layered_costmap_->getChangeCount();
+  auto previous = std::atomic_load(&snapshot_);
+  if (previous && previous->version == version) {
+    return;
+  }
+
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->version = version;
+
+  // Track the cells changed since the previous snapshot, for the consumers to only
+  // process those
+  Change change;
+  if (previous &&
+    layered_costmap_->getChangedBoundsSince(
+      previous->version, change.x0, change.xn, change.y0, change.yn))
+  {
+    change.version = previous->version;
+    snapshot->changes.reserve(CHANGE_HISTORY_SIZE);
+    const size_t first = previous->changes.size() < CHANGE_HISTORY_SIZE ?
+      0 : previous->changes.size() - CHANGE_HISTORY_SIZE + 1;
+    snapshot->changes.assign(previous->changes.begin() + first, previous->changes.end());
+    snapshot->changes.push_back(change);
+  }
+
+  // Refresh the previous snapshot with the cells changed since, if nobody uses it anymore
+  unsigned int x0, xn, y0, yn;
+  if (spare_snapshot_ && spare_snapshot_.use_count() == 1 &&
+    haveSameGeometry(*spare_snapshot_, *master) &&
+    layered_costmap_->getChangedBoundsSince(spare_snapshot_version_, x0, xn, y0, yn))
+  {
+    if (x0 < xn && y0 < yn) {
+      spare_snapshot_->copyWindow(*master, x0, y0, xn, yn, x0, y0);
+    }
+    snapshot->costmap = std::move(spare_snapshot_);
+  } else {
+    snapshot->costmap = std::make_shared<Costmap2D>(*master);
+  }
+  costmap_lock.unlock();
+
+  if (previous) {
+    spare_snapshot_ = previous->costmap;
+    spare_snapshot_version_ = previous->version;
+  }
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+std::shared_ptr<Costmap2D> SharedCostmap::getSnapshot(uint64_t & version) const
+{
+  consumed_ = true;
+  auto snapshot = std::atomic_load(&snapshot_);
+  if (!snapshot) {
+    return nullptr;
+  }
+  version = snapshot->version;
+  return snapshot->costmap;
+}
+
+bool SharedCostmap::getChangedBoundsSince(
+  const uint64_t version, unsigned int & x0, unsigned int & xn,
+  unsigned int & y0, unsigned int & yn) const
+{
+  auto snapshot = std::atomic_load(&snapshot_);
+  if (!snapshot) {
+    return false;
+  }
+
+  x0 = y0 = std::numeric_limits<unsigned int>::max();
+  xn = yn = 0;
+  auto change = std::find_if(
+    snapshot->changes.begin(), snapshot->changes.end(),
+    [version](const Change & c) {return c.version == version;});
+  if (change == snapshot->changes.end() && version != snapshot->version) {
+    return false;
+  }
+  for (; change != snapshot->changes.end(); ++change) {
+    x0 = std::min(x0, change->x0);
+    xn = std::max(xn, change->xn);
+    y0 = std::min(y0, change->y0);
+    yn = std::max(yn, change->yn);
+  }
+  if (x0 > xn) {
+    x0 = xn = y0 = yn = 0;
+  }
+  return true;
+}
+
+void SharedCostmap::detach()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  layered_costmap_ = nullptr;
+  attached_ = false;
+  spare_snapshot_.reset();
+  std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>());
+}
+
+bool SharedCostmap::isAttached() const
+{
+  return attached_;
+}
+
+void SharedCostmap::advertise(
+  const std::string & topic_name, const std::shared_ptr<SharedCostmap> & shared_costmap)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  registry()[topic_name] = shared_costmap;
+}
+
+void SharedCostmap::withdraw(const std::string & topic_name, const SharedCostmap * shared_costmap)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  auto it = registry().find(topic_name);
+  if (it == registry().end()) {
+    return;
+  }
+  auto advertised = it->second.lock();
+  if (!advertised || advertised.get() == shared_costmap) {
+    registry().erase(it);
+  }
+}
+
+std::shared_ptr<SharedCostmap> SharedCostmap::find(const std::string & topic_name)
+{
+  std::lock_guard<std::mutex> lock(registryMutex());
+  auto it = registry().find(topic_name);
+  if (it == registry().end()) {
+    return nullptr;
+  }
+  auto shared_costmap = it->second.lock();
+  if (shared_costmap) {
+    shared_costmap->consumed_ = true;
+  }
+  return shared_costmap;
+}
+
+bool SharedCostmap::haveSameGeometry(const Costmap2D & a, const Costmap2D & b)
+{
+  return a.getSizeInCellsX() == b.getSizeInCellsX() &&
+         a.getSizeInCellsY() == b.getSizeInCellsY() &&
+         a.getResolution() == b.getResolution() &&
+         a.getOriginX() == b.getOriginX() &&
+         a.getOriginY() == b.getOriginY();
+}
+
+}  // namespace nav2_costmap_2d
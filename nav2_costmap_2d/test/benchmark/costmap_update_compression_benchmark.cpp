@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/costmap_update_codec.hpp"
+
+// This is a script to benchmark the bandwidth and latency of the compressed costmap updates
+// against the raw ones, for a 0.05 m, 1000 x 1000 cells global costmap updated at 5 Hz in
+// a 200 x 200 cells window around the robot, where a few inflated obstacles are moving
+
+const unsigned int SIZE = 1000;
+const unsigned int WINDOW = 200;
+const unsigned int NUM_OBSTACLES = 10;
+const int INFLATION_RADIUS = 8;
+const double UPDATE_FREQUENCY = 5.0;
+const unsigned int NUM_UPDATES = 1000;
+
+void drawObstacle(std::vector<unsigned char> & costmap, int cx, int cy)
+{
+  for (int dy = -INFLATION_RADIUS; dy <= INFLATION_RADIUS; ++dy) {
+    for (int dx = -INFLATION_RADIUS; dx <= INFLATION_RADIUS; ++dx) {
+      const int x = cx + dx;
+      const int y = cy + dy;
+      if (x < 0 || y < 0 || x >= static_cast<int>(SIZE) || y >= static_cast<int>(SIZE)) {
+        continue;
+      }
+      const double dist = std::hypot(dx, dy);
+      if (dist > INFLATION_RADIUS) {
+        continue;
+      }
+      unsigned char cost = dist < 1.0 ? nav2_costmap_2d::LETHAL_OBSTACLE :
+        static_cast<unsigned char>(252.0 * std::exp(-0.5 * dist));
+      unsigned char & cell = costmap[y * SIZE + x];
+      cell = std::max(cell, cost);
+    }
+  }
+}
+
+int main(int /*argc*/, char ** /*argv*/)
+{
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> step(-2, 2);
+
+  std::vector<unsigned char> costmap(SIZE * SIZE, nav2_costmap_2d::FREE_SPACE);
+  std::vector<unsigned char> sent_costmap(costmap);
+  std::vector<unsigned char> received_costmap(costmap);
+  std::vector<unsigned char> raw_update(WINDOW * WINDOW);
+  std::vector<uint8_t> compressed_update;
+
+  const unsigned int x0 = (SIZE - WINDOW) / 2;
+  const unsigned int y0 = (SIZE - WINDOW) / 2;
+  std::vector<std::pair<int, int>> obstacles;
+  for (unsigned int i = 0; i < NUM_OBSTACLES; ++i) {
+    obstacles.emplace_back(
+      x0 + INFLATION_RADIUS + rng() % (WINDOW - 2 * INFLATION_RADIUS),
+      y0 + INFLATION_RADIUS + rng() % (WINDOW - 2 * INFLATION_RADIUS));
+  }
+
+  size_t raw_bytes = 0, compressed_bytes = 0;
+  std::chrono::nanoseconds raw_time{0}, compressed_time{0};
+  bool consistent = true;
+  for (unsigned int i = 0; i < NUM_UPDATES; ++i) {
+    // Clear and re-inflate the window as the obstacle layers and the inflation layer would do
+    for (unsigned int y = y0; y < y0 + WINDOW; ++y) {
+      std::fill_n(costmap.begin() + y * SIZE + x0, WINDOW, nav2_costmap_2d::FREE_SPACE);
+    }
+    for (auto & obstacle : obstacles) {
+      // Keep the inflated obstacles within the updated window
+      obstacle.first = std::clamp<int>(
+        obstacle.first + step(rng), x0 + INFLATION_RADIUS, x0 + WINDOW - INFLATION_RADIUS - 1);
+      obstacle.second = std::clamp<int>(
+        obstacle.second + step(rng), y0 + INFLATION_RADIUS, y0 + WINDOW - INFLATION_RADIUS - 1);
+      drawObstacle(costmap, obstacle.first, obstacle.second);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int y = 0; y < WINDOW; ++y) {
+      std::copy_n(
+        costmap.begin() + (y0 + y) * SIZE + x0, WINDOW, raw_update.begin() + y * WINDOW);
+    }
+    for (unsigned int y = 0; y < WINDOW; ++y) {
+      std::copy_n(
+        raw_update.begin() + y * WINDOW, WINDOW, received_costmap.begin() + (y0 + y) * SIZE + x0);
+    }
+    raw_time += std::chrono::steady_clock::now() - start;
+    raw_bytes += raw_update.size();
+
+    start = std::chrono::steady_clock::now();
+    nav2_costmap_2d::encodeCostmapUpdate(
+      costmap.data(), sent_costmap.data(), SIZE, x0, y0, WINDOW, WINDOW, compressed_update);
+    unsigned int min_x, min_y, max_x, max_y;
+    consistent &= nav2_costmap_2d::decodeCostmapUpdate(
+      compressed_update.data(), compressed_update.size(), received_costmap.data(), SIZE,
+      x0, y0, WINDOW, WINDOW, min_x, min_y, max_x, max_y);
+    compressed_time += std::chrono::steady_clock::now() - start;
+    compressed_bytes += compressed_update.size();
+    consistent &= received_costmap == costmap;
+  }
+
+  auto report = [](const char * name, size_t bytes, std::chrono::nanoseconds time) {
+      printf(
+        "%s updates: %.1f bytes/update, %.1f kB/s at %.0f Hz, %.3f ms/update\n", name,
+        static_cast<double>(bytes) / NUM_UPDATES,
+        static_cast<double>(bytes) / NUM_UPDATES * UPDATE_FREQUENCY / 1000.0,
+        UPDATE_FREQUENCY,
+        std::chrono::duration<double, std::milli>(time).count() / NUM_UPDATES);
+    };
+  report("Raw", raw_bytes, raw_time);
+  report("Compressed", compressed_bytes, compressed_time);
+  printf(
+    "Compression ratio: %.1f, decoded costmap %s\n",
+    static_cast<double>(raw_bytes) / compressed_bytes,
+    consistent ? "matches" : "DOES NOT match");
+  return consistent ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+
+// This is a script to benchmark moving the origin of a rolling costmap for a robot
+// driving at 2 m/s with a 0.05 m, 1000 x 1000 cells local costmap updated at 5 Hz
+
+const unsigned int SIZE = 1000;
+const double RESOLUTION = 0.05;
+const double SPEED = 2.0;
+const double UPDATE_FREQUENCY = 5.0;
+const unsigned int NUM_UPDATES = 1000;
+
+/**
+ * @class CopyingCostmap
+ * @brief Costmap moving its origin by copying the overlapping region through
+ * a temporary buffer and resetting the whole map, for comparison
+ */
+class CopyingCostmap : public nav2_costmap_2d::Costmap2D
+{
+public:
+  using Costmap2D::Costmap2D;
+
+  void updateOrigin(double new_origin_x, double new_origin_y) override
+  {
+    int cell_ox = static_cast<int>((new_origin_x - origin_x_) / resolution_);
+    int cell_oy = static_cast<int>((new_origin_y - origin_y_) / resolution_);
+    double new_grid_ox = origin_x_ + cell_ox * resolution_;
+    double new_grid_oy = origin_y_ + cell_oy * resolution_;
+
+    int size_x = size_x_;
+    int size_y = size_y_;
+    int lower_left_x = std::min(std::max(cell_ox, 0), size_x);
+    int lower_left_y = std::min(std::max(cell_oy, 0), size_y);
+    int upper_right_x = std::min(std::max(cell_ox + size_x, 0), size_x);
+    int upper_right_y = std::min(std::max(cell_oy + size_y, 0), size_y);
+    unsigned int cell_size_x = upper_right_x - lower_left_x;
+    unsigned int cell_size_y = upper_right_y - lower_left_y;
+
+    unsigned char * local_map = new unsigned char[cell_size_x * cell_size_y];
+    copyMapRegion(
+      costmap_, lower_left_x, lower_left_y, size_x_, local_map, 0, 0, cell_size_x,
+      cell_size_x, cell_size_y);
+    resetMaps();
+    origin_x_ = new_grid_ox;
+    origin_y_ = new_grid_oy;
+    copyMapRegion(
+      local_map, 0, 0, cell_size_x, costmap_, lower_left_x - cell_ox, lower_left_y - cell_oy,
+      size_x_, cell_size_x, cell_size_y);
+    delete[] local_map;
+  }
+};
+
+double benchmark(nav2_costmap_2d::Costmap2D & costmap)
+{
+  const double step = SPEED / UPDATE_FREQUENCY / std::sqrt(2.0);
+  double x = costmap.getOriginX();
+  double y = costmap.getOriginY();
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i != NUM_UPDATES; i++) {
+    // Drive diagonally, so that both a row and a column strip are exposed
+    x += step;
+    y += step;
+    costmap.updateOrigin(x, y);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         static_cast<double>(NUM_UPDATES);
+}
+
+int main()
+{
+  nav2_costmap_2d::Costmap2D costmap(SIZE, SIZE, RESOLUTION, 0.0, 0.0);
+  CopyingCostmap copying_costmap(SIZE, SIZE, RESOLUTION, 0.0, 0.0);
+
+  const double copying_time = benchmark(copying_costmap);
+  const double shifting_time = benchmark(costmap);
+  printf(
+    "Moving the origin took %0.4f ms copying through a buffer and %0.4f ms shifting in place "
+    "(%0.2fx speedup).\n", copying_time, shifting_time, copying_time / shifting_time);
+  return 0;
+}
@@ -14,9 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <thread>
+
 #include "rclcpp/rclcpp.hpp"
 #include "nav2_costmap_2d/costmap_2d_publisher.hpp"
 #include "nav2_costmap_2d/costmap_subscriber.hpp"
+#include "nav2_costmap_2d/costmap_update_codec.hpp"
+#include "std_srvs/srv/trigger.hpp"
 #include "map_msgs/msg/occupancy_grid_update.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
 
@@ -88,9 +93,10 @@ public:
     }
     receivedGrids.push_back(data);
   }
-  void costmapRawCallback(const nav2_msgs::msg::Costmap::SharedPtr)
+  void costmapRawCallback(const nav2_msgs::msg::Costmap::SharedPtr msg)
   {
     this->fullCostmapRawMsgCount++;
+    lastCostmapRawStamp = msg->header.stamp;
   }
   void costmapUpdateCallback(const map_msgs::msg::OccupancyGridUpdate::SharedPtr update_msg)
   {
@@ -153,6 +159,14 @@ protected:
     return updatedCostmap;
   }
 
+  std::vector<uint8_t> getCharMap(nav2_costmap_2d::CostmapSubscriber & subscriber)
+  {
+    auto costmap = subscriber.getCostmap();
+    return std::vector<uint8_t>(
+      costmap->getCharMap(),
+      costmap->getCharMap() + costmap->getSizeInCellsX() * costmap->getSizeInCellsY());
+  }
+
   std::vector<uint8_t> getCurrentCharMapToSend()
   {
     return std::vector<uint8_t>(
@@ -178,6 +192,7 @@ protected:
   int fullCostmapRawMsgCount;
   int updateCostmapMsgCount;
   int updateCostmapRawMsgCount;
+  builtin_interfaces::msg::Time lastCostmapRawStamp;
   std::string topicName;
   char * cost_translation_table_ = NULL;
 
@@ -288,6 +303,243 @@ TEST_F(TestCostmapSubscriberShould, handleCostmapUpdateMsgs)
   costmapPublisher->on_deactivate();
 }
 
+TEST_F(TestCostmapSubscriberShould, trackUpdatedBoundsOfFullCostmapMsgs)
+{
+  bool always_send_full_costmap = true;
+
+  auto costmapPublisher = std::make_shared<nav2_costmap_2d::Costmap2DPublisher>(
+    node, costmapToSend.get(), "", topicName, always_send_full_costmap);
+  costmapPublisher->on_activate();
+
+  unsigned int min_x, min_y, max_x, max_y;
+  bool first_iteration = true;
+  for (const auto & mapChange : mapChanges) {
+    for (const auto & observation : mapChange.observations) {
+      costmapToSend->setCost(observation.x, observation.y, observation.cost);
+    }
+    const uint64_t version = costmapSubscriber->getCostmapVersion();
+    costmapPublisher->updateBounds(mapChange.x0, mapChange.xn, mapChange.y0, mapChange.yn);
+    costmapPublisher->publishCostmap();
+    rclcpp::spin_some(node->get_node_base_interface());
+    costmapSubscriber->getCostmap();
+
+    ASSERT_GT(costmapSubscriber->getCostmapVersion(), version);
+    if (first_iteration) {
+      // First costmap received: the whole map is new
+      ASSERT_FALSE(costmapSubscriber->getUpdatedBounds(version, min_x, min_y, max_x, max_y));
+    } else {
+      // Only the changed cells are reported, though the full costmap was sent
+      ASSERT_TRUE(costmapSubscriber->getUpdatedBounds(version, min_x, min_y, max_x, max_y));
+      ASSERT_EQ(min_x, mapChange.x0);
+      ASSERT_EQ(max_x, mapChange.xn);
+      ASSERT_EQ(min_y, mapChange.y0);
+      ASSERT_EQ(max_y, mapChange.yn);
+    }
+    first_iteration = false;
+  }
+
+  // Nothing has changed since the latest version
+  ASSERT_TRUE(
+    costmapSubscriber->getUpdatedBounds(
+      costmapSubscriber->getCostmapVersion(), min_x, min_y, max_x, max_y));
+  ASSERT_EQ(min_x, max_x);
+
+  costmapPublisher->on_deactivate();
+}
+
+TEST_F(TestCostmapSubscriberShould, handleCompressedCostmapUpdateMsgs)
+{
+  bool always_send_full_costmap = false;
+  bool compress_updates = true;
+
+  auto compressedCostmapSubscriber =
+    std::make_unique<nav2_costmap_2d::CostmapSubscriber>(node, topicName + "_raw", true);
+  auto costmapPublisher = std::make_shared<nav2_costmap_2d::Costmap2DPublisher>(
+    node, costmapToSend.get(), "", topicName, always_send_full_costmap, 0.0, compress_updates);
+  costmapPublisher->on_activate();
+
+  unsigned int min_x, min_y, max_x, max_y;
+  bool first_iteration = true;
+  for (const auto & mapChange : mapChanges) {
+    for (const auto & observation : mapChange.observations) {
+      costmapToSend->setCost(observation.x, observation.y, observation.cost);
+    }
+    const uint64_t version = compressedCostmapSubscriber->getCostmapVersion();
+    costmapPublisher->updateBounds(mapChange.x0, mapChange.xn, mapChange.y0, mapChange.yn);
+    costmapPublisher->publishCostmap();
+    rclcpp::spin_some(node->get_node_base_interface());
+
+    auto costmap = compressedCostmapSubscriber->getCostmap();
+    ASSERT_EQ(
+      getCurrentCharMapToSend(),
+      std::vector<uint8_t>(
+        costmap->getCharMap(),
+        costmap->getCharMap() + costmap->getSizeInCellsX() * costmap->getSizeInCellsY()));
+
+    ASSERT_GT(compressedCostmapSubscriber->getCostmapVersion(), version);
+    if (!first_iteration) {
+      ASSERT_TRUE(
+        compressedCostmapSubscriber->getUpdatedBounds(version, min_x, min_y, max_x, max_y));
+      ASSERT_EQ(min_x, mapChange.x0);
+      ASSERT_EQ(max_x, mapChange.xn);
+      ASSERT_EQ(min_y, mapChange.y0);
+      ASSERT_EQ(max_y, mapChange.yn);
+    }
+    first_iteration = false;
+  }
+
+  // Nothing is sent if no cell of the updated window has changed
+  const uint64_t version = compressedCostmapSubscriber->getCostmapVersion();
+  costmapPublisher->updateBounds(0, 10, 0, 10);
+  costmapPublisher->publishCostmap();
+  rclcpp::spin_some(node->get_node_base_interface());
+  ASSERT_EQ(compressedCostmapSubscriber->getCostmapVersion(), version);
+
+  costmapPublisher->on_deactivate();
+}
+
+TEST_F(TestCostmapSubscriberShould, resyncCompressedCostmapUpdatesOutOfSequence)
+{
+  bool always_send_full_costmap = false;
+  bool compress_updates = true;
+
+  auto compressedCostmapSubscriber =
+    std::make_unique<nav2_costmap_2d::CostmapSubscriber>(node, topicName + "_raw", true);
+  auto costmapPublisher = std::make_shared<nav2_costmap_2d::Costmap2DPublisher>(
+    node, costmapToSend.get(), "", topicName, always_send_full_costmap, 0.0, compress_updates);
+  costmapPublisher->on_activate();
+
+  // Let the subscriber and the resync service be discovered first
+  auto resyncClient = node->create_client<std_srvs::srv::Trigger>(topicName + "_raw_resync");
+  ASSERT_TRUE(resyncClient->wait_for_service(std::chrono::seconds(5)));
+  for (int i = 0; i < 500 && node->count_subscribers(topicName + "_raw_compressed_updates") == 0;
+    ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  costmapPublisher->publishCostmap();
+  rclcpp::spin_some(node->get_node_base_interface());
+  ASSERT_EQ(getCharMap(*compressedCostmapSubscriber), getCurrentCharMapToSend());
+  const int fullCostmapRawMsgCountBefore = fullCostmapRawMsgCount;
+
+  // An update following a missed one is not applied
+  auto update = std::make_shared<nav2_msgs::msg::CostmapCompressedUpdate>();
+  update->costmap_stamp = lastCostmapRawStamp;
+  update->sequence = 2;
+  update->size_x = 10;
+  update->size_y = 10;
+  std::vector<unsigned char> sent = getCurrentCharMapToSend();
+  std::vector<unsigned char> changed = sent;
+  changed[0] = 254;
+  ASSERT_TRUE(
+    nav2_costmap_2d::encodeCostmapUpdate(
+      changed.data(), sent.data(), 10, 0, 0, 10, 10, update->data));
+  const uint64_t version = compressedCostmapSubscriber->getCostmapVersion();
+  compressedCostmapSubscriber->costmapCompressedUpdateCallback(update);
+  ASSERT_EQ(compressedCostmapSubscriber->getCostmapVersion(), version);
+  ASSERT_EQ(getCharMap(*compressedCostmapSubscriber), getCurrentCharMapToSend());
+
+  // The full costmap is requested instead, and sent again by the publisher
+  for (int i = 0; i < 100 && fullCostmapRawMsgCount == fullCostmapRawMsgCountBefore; ++i) {
+    rclcpp::spin_some(node->get_node_base_interface());
+    costmapPublisher->publishCostmap();
+    rclcpp::spin_some(node->get_node_base_interface());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_GT(fullCostmapRawMsgCount, fullCostmapRawMsgCountBefore);
+
+  // Updates apply in sequence on top of it again
+  costmapToSend->setCost(5, 5, 254);
+  costmapPublisher->updateBounds(5, 6, 5, 6);
+  costmapPublisher->publishCostmap();
+  rclcpp::spin_some(node->get_node_base_interface());
+  ASSERT_EQ(getCharMap(*compressedCostmapSubscriber), getCurrentCharMapToSend());
+
+  // A late joiner is sent the full costmap, rather than only the latest latched update
+  costmapToSend->setCost(6, 6, 254);
+  costmapPublisher->updateBounds(6, 7, 6, 7);
+  costmapPublisher->publishCostmap();
+  auto lateCostmapSubscriber =
+    std::make_unique<nav2_costmap_2d::CostmapSubscriber>(node, topicName + "_raw", true);
+  for (int i = 0; i < 100 &&
+    (lateCostmapSubscriber->getCostmapVersion() == 0 ||
+    getCharMap(*lateCostmapSubscriber) != getCurrentCharMapToSend()); ++i)
+  {
+    rclcpp::spin_some(node->get_node_base_interface());
+    costmapPublisher->publishCostmap();
+    rclcpp::spin_some(node->get_node_base_interface());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(getCharMap(*lateCostmapSubscriber), getCurrentCharMapToSend());
+  ASSERT_EQ(getCharMap(*compressedCostmapSubscriber), getCurrentCharMapToSend());
+
+  costmapPublisher->on_deactivate();
+}
+
+TEST_F(TestCostmapSubscriberShould, handOutImmutableVersionedSnapshots)
+{
+  bool always_send_full_costmap = false;
+
+  auto costmapPublisher = std::make_shared<nav2_costmap_2d::Costmap2DPublisher>(
+    node, costmapToSend.get(), "", topicName, always_send_full_costmap);
+  costmapPublisher->on_activate();
+  costmapPublisher->publishCostmap();
+  rclcpp::spin_some(node->get_node_base_interface());
+
+  uint64_t first_version;
+  auto first = costmapSubscriber->getCostmap(first_version);
+  ASSERT_EQ(first_version, costmapSubscriber->getCostmapVersion());
+
+  // Nothing changed, the same snapshot is handed out
+  uint64_t version;
+  ASSERT_EQ(costmapSubscriber->getCostmap(version), first);
+  ASSERT_EQ(version, first_version);
+
+  // Updates give a new snapshot, leaving the handed out one untouched
+  costmapToSend->setCost(7, 7, nav2_costmap_2d::LETHAL_OBSTACLE);
+  costmapPublisher->updateBounds(7, 8, 7, 8);
+  costmapPublisher->publishCostmap();
+  rclcpp::spin_some(node->get_node_base_interface());
+
+  auto second = costmapSubscriber->getCostmap(version);
+  ASSERT_GT(version, first_version);
+  ASSERT_NE(second, first);
+  ASSERT_EQ(second->getCost(7, 7), nav2_costmap_2d::LETHAL_OBSTACLE);
+  ASSERT_EQ(first->getCost(7, 7), 0);
+
+  costmapPublisher->on_deactivate();
+}
+
+TEST_F(TestCostmapSubscriberShould, downsampleVisualizationGrid)
+{
+  bool always_send_full_costmap = true;
+  unsigned int vis_downsample_factor = 4;
+
+  auto costmapPublisher = std::make_shared<nav2_costmap_2d::Costmap2DPublisher>(
+    node, costmapToSend.get(), "", topicName, always_send_full_costmap, 0.0, false,
+    vis_downsample_factor);
+  costmapPublisher->on_activate();
+
+  costmapToSend->setCost(5, 6, nav2_costmap_2d::LETHAL_OBSTACLE);
+  costmapToSend->setCost(9, 9, nav2_costmap_2d::NO_INFORMATION);
+  costmapPublisher->publishCostmap();
+  rclcpp::spin_some(node->get_node_base_interface());
+
+  // 10 x 10 cells are downsampled to 3 x 3 cells, keeping the highest cost of each block
+  ASSERT_EQ(fullCostmapMsgCount, 1);
+  ASSERT_EQ(receivedGrids.size(), 1u);
+  std::vector<uint8_t> expectedGrid(9, 0);
+  expectedGrid[1 * 3 + 1] = 100;
+  ASSERT_EQ(receivedGrids[0], expectedGrid);
+
+  // The full-resolution costmap is still sent on the raw topic
+  ASSERT_EQ(fullCostmapRawMsgCount, 1);
+  ASSERT_EQ(getCurrentCharMapFromSubscriber(), getCurrentCharMapToSend());
+
+  costmapPublisher->on_deactivate();
+}
+
 TEST_F(
   TestCostmapSubscriberShould,
   throwExceptionIfGetCostmapMethodIsCalledBeforeAnyCostmapMsgReceived)
@@ -197,6 +197,38 @@ public:
     return collision_checker_->isCollisionFree(pose);
   }
 
+  bool testTrajectory(
+    double x, double y, double end_x, double end_y, double theta,
+    bool & poses_collision_free)
+  {
+    rclcpp::Time stamp = now();
+    publishPose(x, y, theta, stamp);
+
+    std::vector<geometry_msgs::msg::Pose> poses;
+    const int steps = 20;
+    for (int i = 0; i <= steps; ++i) {
+      geometry_msgs::msg::Pose pose;
+      pose.position.x = x + (end_x - x) * i / steps;
+      pose.position.y = y + (end_y - y) * i / steps;
+      pose.position.z = 0.0;
+      pose.orientation = nav2_util::geometry_utils::orientationAroundZAxis(theta);
+      poses.push_back(pose);
+    }
+
+    setPose(x, y, theta, stamp);
+    publishFootprint();
+    publishCostmap();
+    rclcpp::sleep_for(std::chrono::milliseconds(1000));
+    const bool collision_free = collision_checker_->isTrajectoryCollisionFree(poses);
+
+    // Check each pose on its own with the same costmap and footprint
+    poses_collision_free = true;
+    for (const auto & pose : poses) {
+      poses_collision_free &= collision_checker_->isCollisionFree(pose, false);
+    }
+    return collision_free;
+  }
+
   void setFootprint(double footprint_padding, double robot_radius)
   {
     std::vector<geometry_msgs::msg::Point> new_footprint;
@@ -357,6 +389,24 @@ TEST_F(TestNode, CollisionSpace)
   ASSERT_EQ(collision_checker_->testPose(4.5, 4.5, 0), false);
 }
 
+TEST_F(TestNode, Trajectory)
+{
+  collision_checker_->setFootprint(0, 1);
+  bool poses_collision_free;
+
+  // Within free space
+  ASSERT_EQ(collision_checker_->testTrajectory(2, 8.5, 2.5, 7, 0, poses_collision_free), true);
+  ASSERT_EQ(poses_collision_free, true);
+
+  // Ending in an obstacle
+  ASSERT_EQ(collision_checker_->testTrajectory(2, 8.5, 8.5, 6.5, 0, poses_collision_free), false);
+  ASSERT_EQ(poses_collision_free, false);
+
+  // Going off map
+  ASSERT_EQ(collision_checker_->testTrajectory(2, 8.5, 5, 13, 0, poses_collision_free), false);
+  ASSERT_EQ(poses_collision_free, false);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
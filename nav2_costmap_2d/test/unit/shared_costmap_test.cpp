@@ -0,0 +1,215 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+#include "nav2_costmap_2d/shared_costmap.hpp"
+
+using nav2_costmap_2d::LETHAL_OBSTACLE;
+
+// Marks the cell under the robot
+class FakeMarkingLayer : public nav2_costmap_2d::Layer
+{
+public:
+  FakeMarkingLayer()
+  {
+    current_ = true;
+    enabled_ = true;
+  }
+
+  void reset() override {}
+  bool isClearable() override {return true;}
+
+  void updateBounds(
+    double robot_x, double robot_y, double, double * min_x, double * min_y, double * max_x,
+    double * max_y) override
+  {
+    *min_x = std::min(*min_x, robot_x);
+    *min_y = std::min(*min_y, robot_y);
+    *max_x = std::max(*max_x, robot_x + 1.0);
+    *max_y = std::max(*max_y, robot_y + 1.0);
+  }
+
+  void updateCosts(
+    nav2_costmap_2d::Costmap2D & master_grid, int min_i, int min_j, int, int) override
+  {
+    master_grid.setCost(min_i, min_j, LETHAL_OBSTACLE);
+  }
+};
+
+TEST(SharedCostmap, snapshots)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", false, false);
+  layered_costmap.resizeMap(100, 100, 1.0, 0.0, 0.0);
+  layered_costmap.addPlugin(std::make_shared<FakeMarkingLayer>());
+  nav2_costmap_2d::SharedCostmap shared_costmap(&layered_costmap, "map");
+  EXPECT_EQ(shared_costmap.getFrameID(), "map");
+
+  // Nothing to share until the costmap is built
+  uint64_t version = 0;
+  shared_costmap.update();
+  EXPECT_EQ(shared_costmap.getSnapshot(version), nullptr);
+
+  // Nor until the producer publishes a snapshot of it
+  layered_costmap.updateMap(10.0, 10.0, 0.0);
+  EXPECT_EQ(shared_costmap.getSnapshot(version), nullptr);
+  shared_costmap.update();
+  auto first = shared_costmap.getSnapshot(version);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->getCost(10, 10), LETHAL_OBSTACLE);
+  const uint64_t first_version = version;
+
+  // Unchanged costmaps give the same snapshot
+  shared_costmap.update();
+  EXPECT_EQ(shared_costmap.getSnapshot(version), first);
+  EXPECT_EQ(version, first_version);
+
+  // Snapshots are not modified by later updates
+  layered_costmap.updateMap(20.0, 30.0, 0.0);
+  EXPECT_EQ(shared_costmap.getSnapshot(version), first);
+  shared_costmap.update();
+  auto second = shared_costmap.getSnapshot(version);
+  ASSERT_NE(second, first);
+  EXPECT_GT(version, first_version);
+  const uint64_t second_version = version;
+  EXPECT_EQ(second->getCost(20, 30), LETHAL_OBSTACLE);
+  EXPECT_EQ(second->getCost(10, 10), LETHAL_OBSTACLE);
+  EXPECT_EQ(first->getCost(20, 30), 0);
+
+  unsigned int x0, xn, y0, yn;
+  ASSERT_TRUE(shared_costmap.getChangedBoundsSince(first_version, x0, xn, y0, yn));
+  EXPECT_EQ(x0, 20u);
+  EXPECT_EQ(xn, 22u);
+  EXPECT_EQ(y0, 30u);
+  EXPECT_EQ(yn, 32u);
+  ASSERT_TRUE(shared_costmap.getChangedBoundsSince(second_version, x0, xn, y0, yn));
+  EXPECT_EQ(x0, xn);
+  EXPECT_FALSE(shared_costmap.getChangedBoundsSince(second_version + 1, x0, xn, y0, yn));
+
+  // The previous snapshot is refreshed in place once no longer used
+  nav2_costmap_2d::Costmap2D * first_buffer = first.get();
+  first.reset();
+  layered_costmap.updateMap(40.0, 50.0, 0.0);
+  shared_costmap.update();
+  auto third = shared_costmap.getSnapshot(version);
+  EXPECT_EQ(third.get(), first_buffer);
+  EXPECT_EQ(third->getCost(10, 10), LETHAL_OBSTACLE);
+  EXPECT_EQ(third->getCost(20, 30), LETHAL_OBSTACLE);
+  EXPECT_EQ(third->getCost(40, 50), LETHAL_OBSTACLE);
+
+  // Changes are tracked across several snapshots
+  ASSERT_TRUE(shared_costmap.getChangedBoundsSince(first_version, x0, xn, y0, yn));
+  EXPECT_EQ(x0, 20u);
+  EXPECT_EQ(xn, 42u);
+  EXPECT_EQ(y0, 30u);
+  EXPECT_EQ(yn, 52u);
+
+  // Consumers never take the costmap lock, even while the producer holds it
+  {
+    std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(
+      *(layered_costmap.getCostmap()->getMutex()));
+    auto snapshot = std::async(
+      std::launch::async, [&]() {
+        uint64_t snapshot_version;
+        return shared_costmap.getSnapshot(snapshot_version);
+      });
+    ASSERT_EQ(snapshot.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(snapshot.get(), third);
+  }
+
+  // Snapshots outlive the detached costmap
+  shared_costmap.detach();
+  EXPECT_FALSE(shared_costmap.isAttached());
+  shared_costmap.update();
+  EXPECT_EQ(shared_costmap.getSnapshot(version), nullptr);
+  EXPECT_FALSE(shared_costmap.getChangedBoundsSince(first_version, x0, xn, y0, yn));
+  EXPECT_EQ(third->getCost(40, 50), LETHAL_OBSTACLE);
+}
+
+TEST(SharedCostmap, onDemand)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", false, false);
+  layered_costmap.resizeMap(100, 100, 1.0, 0.0, 0.0);
+  layered_costmap.addPlugin(std::make_shared<FakeMarkingLayer>());
+  layered_costmap.updateMap(10.0, 10.0, 0.0);
+
+  // No snapshot is taken until a consumer asks for one
+  uint64_t version = 0;
+  nav2_costmap_2d::SharedCostmap unused(&layered_costmap, "map");
+  unused.update();
+  EXPECT_EQ(unused.getSnapshot(version), nullptr);
+  unused.update();
+  EXPECT_NE(unused.getSnapshot(version), nullptr);
+
+  // Nor until a consumer finds the shared costmap
+  auto shared_costmap =
+    std::make_shared<nav2_costmap_2d::SharedCostmap>(&layered_costmap, "map");
+  nav2_costmap_2d::SharedCostmap::advertise("/global_costmap/costmap_raw", shared_costmap);
+  ASSERT_EQ(
+    nav2_costmap_2d::SharedCostmap::find("/global_costmap/costmap_raw"), shared_costmap);
+  shared_costmap->update();
+  auto snapshot = shared_costmap->getSnapshot(version);
+  ASSERT_NE(snapshot, nullptr);
+  EXPECT_EQ(snapshot->getCost(10, 10), LETHAL_OBSTACLE);
+  nav2_costmap_2d::SharedCostmap::withdraw(
+    "/global_costmap/costmap_raw", shared_costmap.get());
+}
+
+TEST(SharedCostmap, registry)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", false, false);
+  auto shared_costmap =
+    std::make_shared<nav2_costmap_2d::SharedCostmap>(&layered_costmap, "map");
+  EXPECT_EQ(nav2_costmap_2d::SharedCostmap::find("/global_costmap/costmap_raw"), nullptr);
+
+  nav2_costmap_2d::SharedCostmap::advertise("/global_costmap/costmap_raw", shared_costmap);
+  EXPECT_EQ(
+    nav2_costmap_2d::SharedCostmap::find("/global_costmap/costmap_raw"), shared_costmap);
+  EXPECT_EQ(nav2_costmap_2d::SharedCostmap::find("/local_costmap/costmap_raw"), nullptr);
+
+  // Only the advertised costmap is withdrawn
+  nav2_costmap_2d::SharedCostmap other(&layered_costmap, "map");
+  nav2_costmap_2d::SharedCostmap::withdraw("/global_costmap/costmap_raw", &other);
+  EXPECT_EQ(
+    nav2_costmap_2d::SharedCostmap::find("/global_costmap/costmap_raw"), shared_costmap);
+  nav2_costmap_2d::SharedCostmap::withdraw("/global_costmap/costmap_raw", shared_costmap.get());
+  EXPECT_EQ(nav2_costmap_2d::SharedCostmap::find("/global_costmap/costmap_raw"), nullptr);
+
+  // The registry does not keep the shared costmaps alive
+  nav2_costmap_2d::SharedCostmap::advertise("/global_costmap/costmap_raw", shared_costmap);
+  shared_costmap.reset();
+  EXPECT_EQ(nav2_costmap_2d::SharedCostmap::find("/global_costmap/costmap_raw"), nullptr);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
@@ -0,0 +1,146 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <fstream>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+
+using nav2_costmap_2d::FREE_SPACE;
+using nav2_costmap_2d::LETHAL_OBSTACLE;
+using nav2_costmap_2d::NO_INFORMATION;
+
+// Resident memory of the process, in bytes
+int64_t residentBytes()
+{
+  int64_t size_pages = 0, resident_pages = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> size_pages >> resident_pages;
+  return resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+TEST(SparseStorage, behavesAsDenseStorage)
+{
+  const unsigned int size_x = 3000, size_y = 2000;
+  nav2_costmap_2d::Costmap2D costmap;
+  costmap.setSparseStorage(true);
+  costmap.setDefaultValue(FREE_SPACE);
+  costmap.resizeMap(size_x, size_y, 0.05, 0.0, 0.0);
+  EXPECT_TRUE(costmap.isSparseStorage());
+
+  EXPECT_EQ(costmap.getCost(0, 0), FREE_SPACE);
+  EXPECT_EQ(costmap.getCost(size_x - 1, size_y - 1), FREE_SPACE);
+
+  costmap.setCost(10, 10, LETHAL_OBSTACLE);
+  costmap.setCost(size_x - 1, 1500, LETHAL_OBSTACLE);
+  costmap.setCost(5, 1999, LETHAL_OBSTACLE);
+
+  // Full width rows are released, leaving the other rows untouched
+  costmap.resetMap(0, 1000, size_x, 1800);
+  EXPECT_EQ(costmap.getCost(10, 10), LETHAL_OBSTACLE);
+  EXPECT_EQ(costmap.getCost(size_x - 1, 1500), FREE_SPACE);
+  EXPECT_EQ(costmap.getCost(5, 1999), LETHAL_OBSTACLE);
+
+  // Partial rows are reset as usual
+  costmap.resetMap(0, 0, 11, 11);
+  EXPECT_EQ(costmap.getCost(10, 10), FREE_SPACE);
+  EXPECT_EQ(costmap.getCost(5, 1999), LETHAL_OBSTACLE);
+
+  // Full width single row, not aligned to pages
+  costmap.setCost(7, 1999, LETHAL_OBSTACLE);
+  costmap.setCost(7, 1998, LETHAL_OBSTACLE);
+  costmap.resetMap(0, 1999, size_x, 2000);
+  EXPECT_EQ(costmap.getCost(5, 1999), FREE_SPACE);
+  EXPECT_EQ(costmap.getCost(7, 1999), FREE_SPACE);
+  EXPECT_EQ(costmap.getCost(7, 1998), LETHAL_OBSTACLE);
+
+  // Copies keep the storage mode and contents
+  nav2_costmap_2d::Costmap2D copy(costmap);
+  EXPECT_TRUE(copy.isSparseStorage());
+  EXPECT_EQ(copy.getCost(7, 1998), LETHAL_OBSTACLE);
+
+  costmap.resetMap(0, 0, size_x, size_y);
+  for (unsigned int i = 0; i < size_x * size_y; i += 997) {
+    EXPECT_EQ(costmap.getCharMap()[i], FREE_SPACE);
+  }
+}
+
+TEST(SparseStorage, unknownDefaultValue)
+{
+  nav2_costmap_2d::Costmap2D costmap;
+  costmap.setSparseStorage(true);
+  costmap.setDefaultValue(NO_INFORMATION);
+  costmap.resizeMap(100, 100, 0.05, 0.0, 0.0);
+  EXPECT_EQ(costmap.getCost(50, 50), NO_INFORMATION);
+
+  costmap.setCost(50, 50, FREE_SPACE);
+  costmap.resetMap(0, 0, 100, 100);
+  EXPECT_EQ(costmap.getCost(50, 50), NO_INFORMATION);
+
+  costmap.updateOrigin(1.0, 1.0);
+  EXPECT_EQ(costmap.getCost(99, 99), NO_INFORMATION);
+}
+
+TEST(SparseStorage, commitsOnlyWrittenPages)
+{
+  // 64 MB of cells, mostly free
+  const unsigned int size_x = 8000, size_y = 8000;
+  const int64_t map_bytes = static_cast<int64_t>(size_x) * size_y;
+  const int64_t resident_start = residentBytes();
+
+  nav2_costmap_2d::Costmap2D costmap;
+  costmap.setSparseStorage(true);
+  costmap.setDefaultValue(FREE_SPACE);
+  costmap.resizeMap(size_x, size_y, 0.05, 0.0, 0.0);
+  for (unsigned int i = 0; i < 100; ++i) {
+    costmap.setCost(4000 + i, 4000, LETHAL_OBSTACLE);
+  }
+
+  // Copies, partial resets and window copies only write the pages holding costs
+  nav2_costmap_2d::Costmap2D copy(costmap);
+  costmap.resetMap(1000, 1000, 7000, 7000);
+  EXPECT_EQ(costmap.getCost(4000, 4000), FREE_SPACE);
+  copy.copyWindow(costmap, 0, 0, size_x, size_y, 0, 0);
+  EXPECT_EQ(copy.getCost(4000, 4000), FREE_SPACE);
+  costmap.copyWindow(copy, 0, 0, 2000, 2000, 2000, 2000);
+  costmap.resetMapToValue(0, 0, 100, 100, FREE_SPACE);
+  for (int64_t i = 0; i < map_bytes; i += 4096) {
+    EXPECT_EQ(copy.getCharMap()[i], FREE_SPACE);
+  }
+  EXPECT_LT(residentBytes() - resident_start, map_bytes / 8);
+
+  // Whereas a dense storage commits all of them, confirming the measure
+  nav2_costmap_2d::Costmap2D dense;
+  dense.setDefaultValue(FREE_SPACE);
+  dense.resizeMap(size_x, size_y, 0.05, 0.0, 0.0);
+  EXPECT_GT(residentBytes() - resident_start, map_bytes / 2);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
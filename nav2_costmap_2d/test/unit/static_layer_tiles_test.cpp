@@ -0,0 +1,189 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+#include "nav2_costmap_2d/static_layer.hpp"
+
+using nav2_costmap_2d::FREE_SPACE;
+using nav2_costmap_2d::LETHAL_OBSTACLE;
+using GetMapRegion = nav2_msgs::srv::GetMapRegion;
+
+// Streams a 10 m x 10 m map at 0.1 m, recording the map regions requested
+// instead of calling the map server
+class TiledStaticLayer : public nav2_costmap_2d::StaticLayer
+{
+public:
+  explicit TiledStaticLayer(nav2_costmap_2d::LayeredCostmap * layered_costmap)
+  {
+    layered_costmap_ = layered_costmap;
+    clock_ = std::make_shared<rclcpp::Clock>(RCL_STEADY_TIME);
+    global_frame_ = "map";
+    use_map_tiles_ = true;
+    map_tiles_window_size_ = 2.0;
+    map_tiles_retry_delay_ = 0.1;
+    track_unknown_space_ = false;
+    trinary_costmap_ = true;
+    lethal_threshold_ = 100;
+    unknown_cost_value_ = 255;
+    for (unsigned int value = 0; value < cost_translation_table_.size(); ++value) {
+      cost_translation_table_[value] = interpretValue(static_cast<unsigned char>(value));
+    }
+  }
+
+  bool sendMapRegionRequest(uint64_t request_id, const MapRegionRequest & region) override
+  {
+    sent.emplace_back(request_id, region);
+    return service_available;
+  }
+
+  // Answers a request, the region being fully occupied
+  void respond(uint64_t request_id, bool success)
+  {
+    const MapRegionRequest & region = sentRegion(request_id);
+    auto response = std::make_shared<GetMapRegion::Response>();
+    response->success = success;
+    response->map_info.resolution = 0.1;
+    response->map_info.width = 100;
+    response->map_info.height = 100;
+    response->map_info.map_load_time.sec = 1;
+    response->x = region.x0;
+    response->y = region.y0;
+    response->region.header.frame_id = "map";
+    response->region.info.width = region.width;
+    response->region.info.height = region.height;
+    response->region.data.assign(region.width * region.height, 100);
+    incomingMapRegion(request_id, response);
+  }
+
+  const MapRegionRequest & sentRegion(uint64_t request_id)
+  {
+    for (const auto & request : sent) {
+      if (request.first == request_id) {
+        return request.second;
+      }
+    }
+    throw std::runtime_error("Region not requested");
+  }
+
+  using nav2_costmap_2d::StaticLayer::updateMapTiles;
+  using nav2_costmap_2d::StaticLayer::pending_map_regions_;
+
+  std::vector<std::pair<uint64_t, MapRegionRequest>> sent;
+  bool service_available{false};
+};
+
+TEST(StaticLayerTiles, retriesMapRegions)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", true, false);
+  TiledStaticLayer layer(&layered_costmap);
+
+  // The map metadata is requested again while the map server is unavailable, backing off
+  layer.updateMapTiles(5.0, 5.0);
+  ASSERT_EQ(layer.sent.size(), 1u);
+  EXPECT_EQ(layer.sent[0].second.width, 0u);
+  layer.updateMapTiles(5.0, 5.0);
+  EXPECT_EQ(layer.sent.size(), 1u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  layer.updateMapTiles(5.0, 5.0);
+  ASSERT_EQ(layer.sent.size(), 2u);
+  EXPECT_EQ(layer.sent[1].first, layer.sent[0].first);
+  // Each retry doubles the delay before the next one
+  const auto & metadata_request = layer.pending_map_regions_.at(layer.sent[0].first);
+  EXPECT_EQ(metadata_request.attempts, 2u);
+  EXPECT_GE((metadata_request.retry_time - layer.sent[1].second.retry_time).seconds(), 0.2);
+
+  // Once known, the window around the robot is requested
+  layer.service_available = true;
+  layer.respond(layer.sent[0].first, true);
+  layer.updateMapTiles(5.0, 5.0);
+  ASSERT_EQ(layer.sent.size(), 3u);
+  const uint64_t window_request = layer.sent[2].first;
+  EXPECT_EQ(layer.sent[2].second.x0, 40u);
+  EXPECT_EQ(layer.sent[2].second.y0, 40u);
+  EXPECT_EQ(layer.sent[2].second.width, 20u);
+  EXPECT_EQ(layer.sent[2].second.height, 20u);
+  EXPECT_EQ(layer.getSizeInCellsX(), 20u);
+  EXPECT_EQ(layer.getCost(10, 10), FREE_SPACE);
+
+  // A failed region is not applied, and requested again after the retry delay
+  layer.respond(window_request, false);
+  layer.updateMapTiles(5.0, 5.0);
+  EXPECT_EQ(layer.sent.size(), 3u);
+  EXPECT_EQ(layer.getCost(10, 10), FREE_SPACE);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  layer.updateMapTiles(5.0, 5.0);
+  ASSERT_EQ(layer.sent.size(), 4u);
+  EXPECT_EQ(layer.sent[3].first, window_request);
+
+  // Then applied once answered, later answers of earlier attempts being ignored
+  layer.respond(window_request, true);
+  layer.updateMapTiles(5.0, 5.0);
+  EXPECT_EQ(layer.getCost(10, 10), LETHAL_OBSTACLE);
+  EXPECT_TRUE(layer.pending_map_regions_.empty());
+  layer.respond(window_request, true);
+  layer.updateMapTiles(5.0, 5.0);
+  EXPECT_TRUE(layer.pending_map_regions_.empty());
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  layer.updateMapTiles(5.0, 5.0);
+  EXPECT_EQ(layer.sent.size(), 4u);
+}
+
+TEST(StaticLayerTiles, dropsRegionsOutOfTheWindow)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", true, false);
+  TiledStaticLayer layer(&layered_costmap);
+  layer.service_available = true;
+  layer.updateMapTiles(5.0, 5.0);
+  layer.respond(layer.sent[0].first, true);
+  layer.updateMapTiles(5.0, 5.0);
+  ASSERT_EQ(layer.sent.size(), 2u);
+  ASSERT_EQ(layer.pending_map_regions_.size(), 1u);
+
+  // Moving away, the unanswered region of the previous window is no longer requested
+  layer.updateMapTiles(8.0, 8.0);
+  ASSERT_EQ(layer.pending_map_regions_.size(), 1u);
+  EXPECT_EQ(layer.pending_map_regions_.begin()->second.x0, 70u);
+  EXPECT_EQ(layer.pending_map_regions_.begin()->second.y0, 70u);
+
+  // Its late answer is dropped, while the new window is filled
+  layer.respond(layer.sent[1].first, true);
+  layer.respond(layer.pending_map_regions_.begin()->first, true);
+  layer.updateMapTiles(8.0, 8.0);
+  EXPECT_TRUE(layer.pending_map_regions_.empty());
+  EXPECT_EQ(layer.getCost(0, 0), LETHAL_OBSTACLE);
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+
+TEST(UpdateOrigin, keepsOverlappingCells)
+{
+  const unsigned int size = 7;
+  // Check all shifts, including ones moving the window completely away
+  for (int shift_x = -8; shift_x <= 8; shift_x++) {
+    for (int shift_y = -8; shift_y <= 8; shift_y++) {
+      nav2_costmap_2d::Costmap2D costmap(
+        size, size, 1.0, 0.0, 0.0, nav2_costmap_2d::NO_INFORMATION);
+      for (unsigned int y = 0; y < size; y++) {
+        for (unsigned int x = 0; x < size; x++) {
+          costmap.setCost(x, y, y * size + x);
+        }
+      }
+
+      costmap.updateOrigin(shift_x, shift_y);
+      EXPECT_DOUBLE_EQ(costmap.getOriginX(), shift_x);
+      EXPECT_DOUBLE_EQ(costmap.getOriginY(), shift_y);
+
+      for (unsigned int y = 0; y < size; y++) {
+        for (unsigned int x = 0; x < size; x++) {
+          const int old_x = x + shift_x;
+          const int old_y = y + shift_y;
+          if (old_x >= 0 && old_x < static_cast<int>(size) &&
+            old_y >= 0 && old_y < static_cast<int>(size))
+          {
+            EXPECT_EQ(costmap.getCost(x, y), old_y * size + old_x);
+          } else {
+            EXPECT_EQ(costmap.getCost(x, y), nav2_costmap_2d::NO_INFORMATION);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(UpdateOrigin, keepsWorldPositions)
+{
+  nav2_costmap_2d::Costmap2D costmap(100, 50, 0.5, -25.0, -12.5);
+  unsigned int mx, my;
+  ASSERT_TRUE(costmap.worldToMap(5.1, 2.6, mx, my));
+  costmap.setCost(mx, my, nav2_costmap_2d::LETHAL_OBSTACLE);
+
+  costmap.updateOrigin(-20.0, -10.0);
+  ASSERT_TRUE(costmap.worldToMap(5.1, 2.6, mx, my));
+  EXPECT_EQ(costmap.getCost(mx, my), nav2_costmap_2d::LETHAL_OBSTACLE);
+
+  costmap.updateOrigin(-30.0, -20.0);
+  ASSERT_TRUE(costmap.worldToMap(5.1, 2.6, mx, my));
+  EXPECT_EQ(costmap.getCost(mx, my), nav2_costmap_2d::LETHAL_OBSTACLE);
+  EXPECT_EQ(costmap.getCost(0, 0), nav2_costmap_2d::FREE_SPACE);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
@@ -0,0 +1,205 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/costmap_snapshot.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+
+using nav2_costmap_2d::LETHAL_OBSTACLE;
+
+// Writes a fixed map over the whole costmap once, counting the cells it updates
+class FakeStaticLayer : public nav2_costmap_2d::Layer
+{
+public:
+  FakeStaticLayer()
+  {
+    current_ = true;
+    enabled_ = true;
+  }
+
+  void reset() override {}
+  bool isClearable() override {return false;}
+
+  void updateBounds(
+    double, double, double, double * min_x, double * min_y, double * max_x,
+    double * max_y) override
+  {
+    if (has_updated_data_) {
+      *min_x = std::min(*min_x, 0.0);
+      *min_y = std::min(*min_y, 0.0);
+      *max_x = std::max(*max_x, 100.0);
+      *max_y = std::max(*max_y, 100.0);
+      has_updated_data_ = false;
+    }
+  }
+
+  void updateCosts(
+    nav2_costmap_2d::Costmap2D & master_grid, int min_i, int min_j, int max_i,
+    int max_j) override
+  {
+    for (int j = min_j; j < max_j; ++j) {
+      for (int i = min_i; i < max_i; ++i) {
+        master_grid.setCost(i, j, static_cast<unsigned char>((i + j) % 200));
+        ++updated_cells;
+      }
+    }
+  }
+
+  bool has_updated_data_{true};
+  unsigned int updated_cells{0};
+};
+
+// Marks an obstacle next to the robot
+class FakeObstacleLayer : public nav2_costmap_2d::Layer
+{
+public:
+  FakeObstacleLayer()
+  {
+    current_ = true;
+    enabled_ = true;
+  }
+
+  void reset() override {}
+  bool isClearable() override {return true;}
+
+  void updateBounds(
+    double robot_x, double robot_y, double, double * min_x, double * min_y, double * max_x,
+    double * max_y) override
+  {
+    *min_x = std::min(*min_x, robot_x);
+    *min_y = std::min(*min_y, robot_y);
+    *max_x = std::max(*max_x, robot_x + 2.0);
+    *max_y = std::max(*max_y, robot_y + 2.0);
+  }
+
+  void updateCosts(
+    nav2_costmap_2d::Costmap2D & master_grid, int, int, int, int) override
+  {
+    master_grid.setCost(21, 21, LETHAL_OBSTACLE);
+  }
+};
+
+std::unique_ptr<nav2_costmap_2d::LayeredCostmap> makeCostmap(
+  std::shared_ptr<FakeStaticLayer> & static_layer)
+{
+  auto layered_costmap = std::make_unique<nav2_costmap_2d::LayeredCostmap>("map", false, false);
+  layered_costmap->resizeMap(100, 100, 1.0, 0.0, 0.0);
+  static_layer = std::make_shared<FakeStaticLayer>();
+  layered_costmap->addPlugin(static_layer);
+  layered_costmap->addPlugin(std::make_shared<FakeObstacleLayer>());
+  return layered_costmap;
+}
+
+TEST(WarmStart, restoreNonClearableCostmap)
+{
+  std::shared_ptr<FakeStaticLayer> static_layer;
+  auto layered_costmap = makeCostmap(static_layer);
+  EXPECT_TRUE(layered_costmap->isNonClearableCurrent());
+  layered_costmap->updateMap(20.0, 20.0, 0.0);
+  EXPECT_EQ(static_layer->updated_cells, 100u * 100u);
+  auto costmap = layered_costmap->getCostmap();
+  EXPECT_EQ(costmap->getCost(21, 21), LETHAL_OBSTACLE);
+
+  // The snapshot only has the costs of the non-clearable layers
+  nav2_costmap_2d::Costmap2D snapshot;
+  layered_costmap->buildNonClearableCostmap(snapshot);
+  ASSERT_EQ(snapshot.getSizeInCellsX(), 100u);
+  ASSERT_EQ(snapshot.getSizeInCellsY(), 100u);
+  EXPECT_EQ(snapshot.getCost(21, 21), 42);
+  EXPECT_EQ(snapshot.getCost(99, 50), 149);
+
+  // Restoring it only updates the bounds of the clearable layers
+  std::shared_ptr<FakeStaticLayer> restored_static_layer;
+  auto restored_costmap = makeCostmap(restored_static_layer);
+  ASSERT_TRUE(restored_costmap->restoreNonClearableCostmap(snapshot));
+  restored_costmap->updateMap(20.0, 20.0, 0.0);
+  EXPECT_LT(restored_static_layer->updated_cells, 100u);
+  EXPECT_TRUE(restored_costmap->isInitialized());
+  for (unsigned int i = 0; i < 100u * 100u; ++i) {
+    ASSERT_EQ(restored_costmap->getCostmap()->getCharMap()[i], costmap->getCharMap()[i]) << i;
+  }
+
+  // The whole costmap is reported as changed
+  unsigned int x0, xn, y0, yn;
+  restored_costmap->getBounds(&x0, &xn, &y0, &yn);
+  EXPECT_EQ(x0, 0u);
+  EXPECT_EQ(xn, 100u);
+  EXPECT_EQ(y0, 0u);
+  EXPECT_EQ(yn, 100u);
+
+  // Snapshots of another geometry are rejected
+  nav2_costmap_2d::Costmap2D other_snapshot(50, 100, 1.0, 0.0, 0.0);
+  EXPECT_FALSE(restored_costmap->restoreNonClearableCostmap(other_snapshot));
+}
+
+TEST(WarmStart, saveAndLoadSnapshot)
+{
+  const std::string file_path =
+    (std::filesystem::temp_directory_path() / "nav2_warm_start_test" / "snapshot.bin").string();
+  std::filesystem::remove_all(std::filesystem::path(file_path).parent_path());
+
+  nav2_costmap_2d::Costmap2D costmap(30, 20, 0.05, -1.0, 2.0);
+  costmap.setCost(3, 4, LETHAL_OBSTACLE);
+  costmap.setCost(29, 19, 128);
+  uint64_t key = nav2_costmap_2d::SNAPSHOT_INITIAL_KEY;
+  nav2_costmap_2d::hashSnapshotKey(key, "map", 3);
+  ASSERT_TRUE(nav2_costmap_2d::saveCostmapSnapshot(file_path, costmap, key));
+
+  nav2_costmap_2d::Costmap2D loaded;
+  uint64_t loaded_key = 0;
+  ASSERT_TRUE(nav2_costmap_2d::loadCostmapSnapshot(file_path, loaded, loaded_key));
+  EXPECT_EQ(loaded_key, key);
+  EXPECT_EQ(loaded.getSizeInCellsX(), 30u);
+  EXPECT_EQ(loaded.getSizeInCellsY(), 20u);
+  EXPECT_DOUBLE_EQ(loaded.getResolution(), 0.05);
+  EXPECT_DOUBLE_EQ(loaded.getOriginX(), -1.0);
+  EXPECT_DOUBLE_EQ(loaded.getOriginY(), 2.0);
+  EXPECT_EQ(loaded.getCost(3, 4), LETHAL_OBSTACLE);
+  EXPECT_EQ(loaded.getCost(29, 19), 128);
+  EXPECT_EQ(loaded.getCost(0, 0), 0);
+
+  // Truncated or missing snapshots are rejected
+  std::filesystem::resize_file(file_path, std::filesystem::file_size(file_path) - 1);
+  EXPECT_FALSE(nav2_costmap_2d::loadCostmapSnapshot(file_path, loaded, loaded_key));
+  std::filesystem::remove(file_path);
+  EXPECT_FALSE(nav2_costmap_2d::loadCostmapSnapshot(file_path, loaded, loaded_key));
+  {
+    std::ofstream file(file_path);
+    file << "not a snapshot";
+  }
+  EXPECT_FALSE(nav2_costmap_2d::loadCostmapSnapshot(file_path, loaded, loaded_key));
+
+  std::filesystem::remove_all(std::filesystem::path(file_path).parent_path());
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
@@ -46,6 +46,7 @@
 #include "dwb_core/trajectory_generator.hpp"
 #include "geometry_msgs/msg/pose_stamped.hpp"
 #include "nav_2d_msgs/msg/twist2_d_stamped.hpp"
+#include "nav2_util/path_tracker.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 #include "pluginlib/class_loader.hpp"
@@ -195,7 +196,7 @@ protected:
    */
   virtual nav_msgs::msg::Path transformGlobalPlan(
     const geometry_msgs::msg::PoseStamped & pose);
-  nav_msgs::msg::Path global_plan_;  ///< Saved Global Plan
+  nav2_util::PathTracker global_plan_;  ///< Saved Global Plan, pruned in place
   bool prune_plan_;
   double prune_distance_;
   bool debug_trajectory_details_;
@@ -45,7 +45,6 @@
 #include "nav_2d_msgs/msg/twist2_d.hpp"
 #include "nav_2d_utils/conversions.hpp"
 #include "nav_2d_utils/tf_help.hpp"
-#include "nav2_util/geometry_utils.hpp"
 #include "nav2_ros_common/lifecycle_node.hpp"
 #include "nav2_ros_common/node_utils.hpp"
 #include "nav2_core/controller_exceptions.hpp"
@@ -54,7 +53,6 @@
 #include "geometry_msgs/msg/twist_stamped.hpp"
 
 using nav2::declare_parameter_if_not_declared;
-using nav2_util::geometry_utils::euclidean_distance;
 
 namespace dwb_core
 {
@@ -244,7 +242,7 @@ DWBLocalPlanner::setPlan(const nav_msgs::msg::Path & path)
   traj_generator_->reset();
 
   pub_->publishGlobalPlan(path);
-  global_plan_ = path;
+  global_plan_.setPlan(path);
 }
 
 geometry_msgs::msg::TwistStamped
@@ -291,8 +289,8 @@ DWBLocalPlanner::prepareGlobalPlan(
     pub_->publishTransformedPlan(transformed_plan);
   }
 
-  goal_pose.header.frame_id = global_plan_.header.frame_id;
-  goal_pose.pose = global_plan_.poses.back().pose;
+  goal_pose.header.frame_id = global_plan_.getFrameId();
+  goal_pose.pose = global_plan_.getPose(global_plan_.end() - 1).pose;
   nav_2d_utils::transformPose(
     tf_, costmap_ros_->getGlobalFrameID(), goal_pose,
     goal_pose, transform_tolerance_);
@@ -464,19 +462,21 @@ nav_msgs::msg::Path
 DWBLocalPlanner::transformGlobalPlan(
   const geometry_msgs::msg::PoseStamped & pose)
 {
-  if (global_plan_.poses.empty()) {
+  if (global_plan_.empty()) {
     throw nav2_core::InvalidPath("Received plan with zero length");
   }
 
   // let's get the pose of the robot in the frame of the plan
   geometry_msgs::msg::PoseStamped robot_pose;
   if (!nav_2d_utils::transformPose(
-      tf_, global_plan_.header.frame_id, pose,
+      tf_, global_plan_.getFrameId(), pose,
       robot_pose, transform_tolerance_))
   {
     throw nav2_core::
           ControllerTFError("Unable to transform robot pose into global plan's frame");
   }
+  const double robot_x = robot_pose.pose.position.x;
+  const double robot_y = robot_pose.pose.position.y;
 
   // we'll discard points on the plan that are outside the local costmap
   nav2_costmap_2d::Costmap2D * costmap = costmap_ros_->getCostmap();
@@ -510,50 +510,35 @@ DWBLocalPlanner::transformGlobalPlan(
 
   // Find the first pose in the global plan that's further than forward prune distance
   // from the robot using integrated distance
-  auto prune_point = nav2_util::geometry_utils::first_after_integrated_distance(
-    global_plan_.poses.begin(), global_plan_.poses.end(), forward_prune_distance_);
+  const size_t prune_point = global_plan_.firstAfterIntegratedDistance(
+    global_plan_.begin(), forward_prune_distance_);
 
   // Find the first pose in the plan (up to prune_point) that's less than transform_start_threshold
   // from the robot.
-  auto transformation_begin = std::find_if(
-    begin(global_plan_.poses), prune_point,
-    [&](const auto & global_plan_pose) {
-      return euclidean_distance(robot_pose, global_plan_pose) < transform_start_threshold;
-    });
+  const size_t transformation_begin = global_plan_.findFirstCloserThan(
+    global_plan_.begin(), prune_point, robot_x, robot_y, transform_start_threshold);
 
   // Find the first pose in the end of the plan that's further than transform_end_threshold
   // from the robot using integrated distance
-  auto transformation_end = std::find_if(
-    transformation_begin, global_plan_.poses.end(),
-    [&](const auto & global_plan_pose) {
-      return euclidean_distance(global_plan_pose, robot_pose) > transform_end_threshold;
-    });
+  const size_t transformation_end = global_plan_.findFirstFurtherThan(
+    transformation_begin, global_plan_.end(), robot_x, robot_y, transform_end_threshold);
 
-  // Transform the near part of the global plan into the robot's frame of reference.
+  // Transform the near part of the global plan into the robot's frame of reference,
+  // looking up the transform once for all the poses
   nav_msgs::msg::Path transformed_plan;
-  transformed_plan.header.frame_id = costmap_ros_->getGlobalFrameID();
-  transformed_plan.header.stamp = pose.header.stamp;
-
-  // Helper function for the transform below. Converts a pose2D from global
-  // frame to local
-  auto transformGlobalPoseToLocal = [&](const auto & global_plan_pose) {
-      geometry_msgs::msg::PoseStamped transformed_pose;
-      nav_2d_utils::transformPose(
-        tf_, transformed_plan.header.frame_id,
-        global_plan_pose, transformed_pose, transform_tolerance_);
-      return transformed_pose;
-    };
-
-  std::transform(
-    transformation_begin, transformation_end,
-    std::back_inserter(transformed_plan.poses),
-    transformGlobalPoseToLocal);
+  if (!global_plan_.transformPoses(
+      transformation_begin, transformation_end, *tf_, costmap_ros_->getGlobalFrameID(),
+      pose.header.stamp, transform_tolerance_.to_chrono<tf2::Duration>(), transformed_plan,
+      nav2_util::PathTracker::TransformTolerance::LATEST_TRANSFORM_AGE))
+  {
+    throw nav2_core::ControllerTFError("Unable to transform plan pose into local frame");
+  }
 
   // Remove the portion of the global plan that we've already passed so we don't
   // process it on the next iteration.
   if (prune_plan_) {
-    global_plan_.poses.erase(begin(global_plan_.poses), transformation_begin);
-    pub_->publishGlobalPlan(global_plan_);
+    global_plan_.prune(transformation_begin);
+    pub_->publishGlobalPlan(global_plan_.getRemainingPlan());
   }
 
   if (transformed_plan.poses.empty()) {
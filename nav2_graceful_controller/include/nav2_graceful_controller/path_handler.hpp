@@ -20,6 +20,7 @@
 #include "rclcpp/rclcpp.hpp"
 #include "nav2_costmap_2d/costmap_2d_ros.hpp"
 #include "nav2_util/geometry_utils.hpp"
+#include "nav2_util/path_tracker.hpp"
 
 namespace nav2_graceful_controller
 {
@@ -68,13 +69,13 @@ public:
    *
    * @return The global plan
    */
-  nav_msgs::msg::Path getPlan() {return global_plan_;}
+  nav_msgs::msg::Path getPlan() {return path_tracker_.getRemainingPlan();}
 
 protected:
   rclcpp::Duration transform_tolerance_{0, 0};
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
   std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
-  nav_msgs::msg::Path global_plan_;
+  nav2_util::PathTracker path_tracker_;
   rclcpp::Logger logger_ {rclcpp::get_logger("GracefulPathHandler")};
 };
 
@@ -28,8 +28,6 @@
 namespace nav2_graceful_controller
 {
 
-using nav2_util::geometry_utils::euclidean_distance;
-
 PathHandler::PathHandler(
   tf2::Duration transform_tolerance,
   std::shared_ptr<tf2_ros::Buffer> tf,
@@ -43,73 +41,55 @@ nav_msgs::msg::Path PathHandler::transformGlobalPlan(
   double max_robot_pose_search_dist)
 {
   // Check first if the plan is empty
-  if (global_plan_.poses.empty()) {
+  if (path_tracker_.empty()) {
     throw nav2_core::InvalidPath("Received plan with zero length");
   }
 
   // Let's get the pose of the robot in the frame of the plan
   geometry_msgs::msg::PoseStamped robot_pose;
   if (!nav_2d_utils::transformPose(
-      tf_buffer_, global_plan_.header.frame_id, pose, robot_pose,
+      tf_buffer_, path_tracker_.getFrameId(), pose, robot_pose,
       transform_tolerance_))
   {
     throw nav2_core::ControllerTFError("Unable to transform robot pose into global plan's frame");
   }
+  const double robot_x = robot_pose.pose.position.x;
+  const double robot_y = robot_pose.pose.position.y;
 
   // Find the first pose in the global plan that's further than max_robot_pose_search_dist
   // from the robot using integrated distance
-  auto closest_pose_upper_bound =
-    nav2_util::geometry_utils::first_after_integrated_distance(
-    global_plan_.poses.begin(), global_plan_.poses.end(), max_robot_pose_search_dist);
+  const size_t closest_pose_upper_bound =
+    path_tracker_.firstAfterIntegratedDistance(path_tracker_.begin(), max_robot_pose_search_dist);
 
   // First find the closest pose on the path to the robot
   // bounded by when the path turns around (if it does) so we don't get a pose from a later
   // portion of the path
-  auto transformation_begin =
-    nav2_util::geometry_utils::min_by(
-    global_plan_.poses.begin(), closest_pose_upper_bound,
-    [&robot_pose](const geometry_msgs::msg::PoseStamped & ps) {
-      return euclidean_distance(robot_pose, ps);
-    });
+  const size_t transformation_begin = path_tracker_.findClosestPose(
+    path_tracker_.begin(), closest_pose_upper_bound, robot_x, robot_y);
 
   // We'll discard points on the plan that are outside the local costmap
   double dist_threshold = std::max(
     costmap_ros_->getCostmap()->getSizeInMetersX(),
     costmap_ros_->getCostmap()->getSizeInMetersY()) / 2.0;
-  auto transformation_end = std::find_if(
-    transformation_begin, global_plan_.poses.end(),
-    [&](const auto & global_plan_pose) {
-      return euclidean_distance(global_plan_pose, robot_pose) > dist_threshold;
-    });
-
-  // Lambda to transform a PoseStamped from global frame to local
-  auto transformGlobalPoseToLocal = [&](const auto & global_plan_pose) {
-      geometry_msgs::msg::PoseStamped stamped_pose, transformed_pose;
-      stamped_pose.header.frame_id = global_plan_.header.frame_id;
-      stamped_pose.header.stamp = robot_pose.header.stamp;
-      stamped_pose.pose = global_plan_pose.pose;
-      if (!nav_2d_utils::transformPose(
-          tf_buffer_, costmap_ros_->getBaseFrameID(), stamped_pose,
-          transformed_pose, transform_tolerance_))
-      {
-        throw nav2_core::ControllerTFError("Unable to transform plan pose into local frame");
-      }
-      transformed_pose.pose.position.z = 0.0;
-      return transformed_pose;
-    };
+  const size_t transformation_end = path_tracker_.findFirstFurtherThan(
+    transformation_begin, path_tracker_.end(), robot_x, robot_y, dist_threshold);
 
   // Transform the near part of the global plan into the robot's frame of reference.
   nav_msgs::msg::Path transformed_plan;
-  transformed_plan.header.frame_id = costmap_ros_->getBaseFrameID();
-  transformed_plan.header.stamp = robot_pose.header.stamp;
-  std::transform(
-    transformation_begin, transformation_end,
-    std::back_inserter(transformed_plan.poses),
-    transformGlobalPoseToLocal);
+  if (!path_tracker_.transformPoses(
+      transformation_begin, transformation_end, *tf_buffer_, costmap_ros_->getBaseFrameID(),
+      robot_pose.header.stamp, transform_tolerance_.to_chrono<tf2::Duration>(),
+      transformed_plan, nav2_util::PathTracker::TransformTolerance::LATEST_TRANSFORM_AGE))
+  {
+    throw nav2_core::ControllerTFError("Unable to transform plan pose into local frame");
+  }
+  for (auto & transformed_pose : transformed_plan.poses) {
+    transformed_pose.pose.position.z = 0.0;
+  }
 
   // Remove the portion of the global plan that we've already passed so we don't
   // process it on the next iteration (this is called path pruning)
-  global_plan_.poses.erase(begin(global_plan_.poses), transformation_begin);
+  path_tracker_.prune(transformation_begin);
 
   if (transformed_plan.poses.empty()) {
     throw nav2_core::InvalidPath("Resulting plan has 0 poses in it.");
@@ -120,7 +100,7 @@ nav_msgs::msg::Path PathHandler::transformGlobalPlan(
 
 void PathHandler::setPlan(const nav_msgs::msg::Path & path)
 {
-  global_plan_ = path;
+  path_tracker_.setPlan(path);
 }
 
 }  // namespace nav2_graceful_controller
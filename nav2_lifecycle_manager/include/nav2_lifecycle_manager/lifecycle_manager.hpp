@@ -16,8 +16,10 @@
 #ifndef NAV2_LIFECYCLE_MANAGER__LIFECYCLE_MANAGER_HPP_
 #define NAV2_LIFECYCLE_MANAGER__LIFECYCLE_MANAGER_HPP_
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -210,6 +212,32 @@ protected:
    */
   bool changeStateForAllNodes(std::uint8_t transition, bool hard_change = false);
 
+  /**
+   * @brief For each node in the map, transition to the new target state, one after another in
+   * the order of the map, or in the reverse order when bringing down
+   */
+  bool changeStateForAllNodesInOrder(std::uint8_t transition, bool hard_change = false);
+
+  /**
+   * @brief For each node in the map, transition to the new target state, concurrently for the
+   * nodes which do not depend on each other. Nodes transition after their dependencies when
+   * bringing up and before them when bringing down.
+   */
+  bool changeStateForAllNodesInParallel(std::uint8_t transition, bool hard_change = false);
+
+  /**
+   * @brief Reads the dependencies between the managed nodes, disabling parallel transitions
+   * if they are cyclic
+   */
+  void loadNodeDependencies();
+
+  /**
+   * @brief Records the duration of a transition, for diagnostics
+   */
+  void recordTransitionDuration(
+    const std::string & name, std::uint8_t transition,
+    const std::chrono::steady_clock::duration & duration);
+
   // Convenience function to highlight the output on the console
   /**
    * @brief Helper function to highlight the output on the console
@@ -244,6 +272,7 @@ protected:
 
   // A map of all nodes to check bond connection
   std::map<std::string, std::shared_ptr<bond::Bond>> bond_map_;
+  std::mutex bond_map_mutex_;
 
   // A map of all nodes to be controlled
   std::map<std::string, std::shared_ptr<nav2_util::LifecycleServiceClient>> node_map_;
@@ -256,6 +285,17 @@ protected:
   // The names of the nodes to be managed, in the order of desired bring-up
   std::vector<std::string> node_names_;
 
+  // Whether to transition the nodes which do not depend on each other concurrently
+  bool parallel_transitions_;
+
+  // The managed nodes that each node depends on, and that depend on each node
+  std::map<std::string, std::vector<std::string>> node_dependencies_;
+  std::map<std::string, std::vector<std::string>> node_dependents_;
+
+  // Durations in seconds of the last transitions of each node and of all the nodes
+  std::map<std::string, double> transition_durations_;
+  std::mutex transition_durations_mutex_;
+
   // Whether to automatically start up the system
   bool autostart_;
   bool attempt_respawn_reconnection_;
@@ -16,8 +16,12 @@
 #include "nav2_lifecycle_manager/lifecycle_manager.hpp"
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "rclcpp/rclcpp.hpp"
@@ -45,6 +49,7 @@ LifecycleManager::LifecycleManager(const rclcpp::NodeOptions & options)
   declare_parameter("service_timeout", 5.0);
   declare_parameter("bond_respawn_max_duration", 10.0);
   declare_parameter("attempt_respawn_reconnection", true);
+  declare_parameter("parallel_transitions", false);
 
   registerRclPreshutdownCallback();
 
@@ -66,6 +71,9 @@ LifecycleManager::LifecycleManager(const rclcpp::NodeOptions & options)
 
   get_parameter("attempt_respawn_reconnection", attempt_respawn_reconnection_);
 
+  get_parameter("parallel_transitions", parallel_transitions_);
+  loadNodeDependencies();
+
   callback_group_ = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive, false);
 
   transition_state_map_[Transition::TRANSITION_CONFIGURE] = State::PRIMARY_STATE_INACTIVE;
@@ -185,6 +193,79 @@ LifecycleManager::CreateDiagnostic(diagnostic_updater::DiagnosticStatusWrapper &
       break;
   }
   stat.summary(error_level, message);
+
+  std::lock_guard<std::mutex> lock(transition_durations_mutex_);
+  for (const auto & [name, duration] : transition_durations_) {
+    stat.addf(name, "%.3f s", duration);
+  }
+}
+
+void
+LifecycleManager::loadNodeDependencies()
+{
+  // The dependencies of each node are given as node_dependencies.<node name>
+  for (auto & node_name : node_names_) {
+    node_dependencies_[node_name];
+    node_dependents_[node_name];
+  }
+  for (auto & node_name : node_names_) {
+    declare_parameter(
+      "node_dependencies." + node_name, rclcpp::ParameterValue(std::vector<std::string>()));
+    for (auto & dependency : get_parameter("node_dependencies." + node_name).as_string_array()) {
+      if (node_dependencies_.find(dependency) == node_dependencies_.end()) {
+        RCLCPP_WARN(
+          get_logger(), "Node %s depends on %s, which is not managed. Ignoring it.",
+          node_name.c_str(), dependency.c_str());
+        continue;
+      }
+      node_dependencies_[node_name].push_back(dependency);
+      node_dependents_[dependency].push_back(node_name);
+    }
+  }
+
+  if (!parallel_transitions_) {
+    return;
+  }
+
+  // Nodes without remaining dependencies are removed until none is left, else there is a cycle
+  std::map<std::string, size_t> num_dependencies;
+  std::vector<std::string> independent_nodes;
+  for (auto & [node_name, dependencies] : node_dependencies_) {
+    num_dependencies[node_name] = dependencies.size();
+    if (dependencies.empty()) {
+      independent_nodes.push_back(node_name);
+    }
+  }
+  size_t num_sorted = 0;
+  while (!independent_nodes.empty()) {
+    const std::string node_name = independent_nodes.back();
+    independent_nodes.pop_back();
+    num_sorted++;
+    for (auto & dependent : node_dependents_[node_name]) {
+      if (--num_dependencies[dependent] == 0) {
+        independent_nodes.push_back(dependent);
+      }
+    }
+  }
+  if (num_sorted != node_dependencies_.size()) {
+    RCLCPP_ERROR(
+      get_logger(), "The dependencies between the managed nodes are cyclic. "
+      "Transitioning the nodes one after another in the order of node_names instead.");
+    parallel_transitions_ = false;
+  }
+}
+
+void
+LifecycleManager::recordTransitionDuration(
+  const std::string & name, std::uint8_t transition,
+  const std::chrono::steady_clock::duration & duration)
+{
+  // Labels end with a space, to be followed by the node name in messages
+  std::string label = transition_label_map_.at(transition);
+  label.pop_back();
+  std::lock_guard<std::mutex> lock(transition_durations_mutex_);
+  transition_durations_[name + ": " + label] =
+    std::chrono::duration<double>(duration).count();
 }
 
 void
@@ -233,14 +314,21 @@ LifecycleManager::createBondConnection(const std::string & node_name)
     std::chrono::duration_cast<std::chrono::nanoseconds>(bond_timeout_).count();
   const double timeout_s = timeout_ns / 1e9;
 
-  if (bond_map_.find(node_name) == bond_map_.end() && bond_timeout_.count() > 0.0) {
-    bond_map_[node_name] =
-      std::make_shared<bond::Bond>("bond", node_name, shared_from_this());
-    bond_map_[node_name]->setHeartbeatTimeout(timeout_s);
-    bond_map_[node_name]->setHeartbeatPeriod(0.10);
-    bond_map_[node_name]->start();
+  std::shared_ptr<bond::Bond> bond;
+  {
+    std::lock_guard<std::mutex> lock(bond_map_mutex_);
+    if (bond_map_.find(node_name) == bond_map_.end() && bond_timeout_.count() > 0.0) {
+      bond = std::make_shared<bond::Bond>("bond", node_name, shared_from_this());
+      bond_map_[node_name] = bond;
+    }
+  }
+
+  if (bond) {
+    bond->setHeartbeatTimeout(timeout_s);
+    bond->setHeartbeatPeriod(0.10);
+    bond->start();
     if (
-      !bond_map_[node_name]->waitUntilFormed(
+      !bond->waitUntilFormed(
         rclcpp::Duration(rclcpp::Duration::from_nanoseconds(timeout_ns / 2))))
     {
       RCLCPP_ERROR(
@@ -259,19 +347,22 @@ LifecycleManager::createBondConnection(const std::string & node_name)
 bool
 LifecycleManager::changeStateForNode(const std::string & node_name, std::uint8_t transition)
 {
-  message(transition_label_map_[transition] + node_name);
+  message(transition_label_map_.at(transition) + node_name);
 
-  if (!node_map_[node_name]->change_state(transition, std::chrono::milliseconds(-1),
-      service_timeout_) ||
-    !(node_map_[node_name]->get_state(service_timeout_) == transition_state_map_[transition]))
+  const auto start_time = std::chrono::steady_clock::now();
+  auto & node = node_map_.at(node_name);
+  if (!node->change_state(transition, std::chrono::milliseconds(-1), service_timeout_) ||
+    !(node->get_state(service_timeout_) == transition_state_map_.at(transition)))
   {
     RCLCPP_ERROR(get_logger(), "Failed to change state for node: %s", node_name.c_str());
     return false;
   }
+  recordTransitionDuration(node_name, transition, std::chrono::steady_clock::now() - start_time);
 
   if (transition == Transition::TRANSITION_ACTIVATE) {
     return createBondConnection(node_name);
   } else if (transition == Transition::TRANSITION_DEACTIVATE) {
+    std::lock_guard<std::mutex> lock(bond_map_mutex_);
     bond_map_.erase(node_name);
   }
 
@@ -280,6 +371,20 @@ LifecycleManager::changeStateForNode(const std::string & node_name, std::uint8_t
 
 bool
 LifecycleManager::changeStateForAllNodes(std::uint8_t transition, bool hard_change)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  bool success;
+  if (parallel_transitions_) {
+    success = changeStateForAllNodesInParallel(transition, hard_change);
+  } else {
+    success = changeStateForAllNodesInOrder(transition, hard_change);
+  }
+  recordTransitionDuration("All nodes", transition, std::chrono::steady_clock::now() - start_time);
+  return success;
+}
+
+bool
+LifecycleManager::changeStateForAllNodesInOrder(std::uint8_t transition, bool hard_change)
 {
   // Hard change will continue even if a node fails
   if (transition == Transition::TRANSITION_CONFIGURE ||
@@ -315,6 +420,73 @@ LifecycleManager::changeStateForAllNodes(std::uint8_t transition, bool hard_chan
   return true;
 }
 
+bool
+LifecycleManager::changeStateForAllNodesInParallel(std::uint8_t transition, bool hard_change)
+{
+  // Nodes wait for their dependencies when bringing up, and for their dependents when bringing
+  // down. Hard change will continue even if a node fails
+  const bool bringup = transition == Transition::TRANSITION_CONFIGURE ||
+    transition == Transition::TRANSITION_ACTIVATE;
+  const auto & predecessors = bringup ? node_dependencies_ : node_dependents_;
+  const auto & successors = bringup ? node_dependents_ : node_dependencies_;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<std::pair<std::string, bool>> finished_nodes;
+  std::vector<std::future<void>> transitions;
+  auto start_transition = [&](const std::string & node_name) {
+      transitions.push_back(
+        std::async(
+          std::launch::async, [&, node_name]() {
+            bool success = false;
+            try {
+              success = changeStateForNode(node_name, transition);
+            } catch (const std::runtime_error & e) {
+              RCLCPP_ERROR(
+                get_logger(),
+                "Failed to change state for node: %s. Exception: %s.", node_name.c_str(),
+                e.what());
+            }
+            {
+              std::lock_guard<std::mutex> lock(mutex);
+              finished_nodes.emplace_back(node_name, success);
+            }
+            cv.notify_one();
+          }));
+    };
+
+  std::map<std::string, size_t> num_waiting_for;
+  for (auto & node_name : node_names_) {
+    num_waiting_for[node_name] = predecessors.at(node_name).size();
+    if (num_waiting_for[node_name] == 0) {
+      start_transition(node_name);
+    }
+  }
+
+  // Start the transitions of the nodes once those they wait for are done
+  bool success = true;
+  for (size_t num_running = transitions.size(); num_running > 0; num_running--) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() {return !finished_nodes.empty();});
+    const auto [node_name, node_success] = finished_nodes.front();
+    finished_nodes.pop_front();
+    lock.unlock();
+
+    success = success && node_success;
+    if (!success && !hard_change) {
+      continue;
+    }
+    for (auto & successor : successors.at(node_name)) {
+      if (--num_waiting_for[successor] == 0) {
+        start_transition(successor);
+        num_running++;
+      }
+    }
+  }
+
+  return success;
+}
+
 void
 LifecycleManager::shutdownAllNodes()
 {
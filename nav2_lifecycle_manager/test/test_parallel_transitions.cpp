@@ -0,0 +1,146 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_ros_common/lifecycle_node.hpp"
+#include "nav2_ros_common/node_thread.hpp"
+#include "nav2_lifecycle_manager/lifecycle_manager.hpp"
+
+using namespace std::chrono_literals;  // NOLINT
+using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+using Clock = std::chrono::steady_clock;
+
+// Takes a while to configure and clean up, recording when it did
+class SlowLifecycleNode : public nav2::LifecycleNode
+{
+public:
+  explicit SlowLifecycleNode(const std::string & name)
+  : nav2::LifecycleNode(name) {}
+
+  CallbackReturn on_configure(const rclcpp_lifecycle::State & /*state*/) override
+  {
+    configure_start = Clock::now();
+    std::this_thread::sleep_for(200ms);
+    configure_end = Clock::now();
+    return CallbackReturn::SUCCESS;
+  }
+
+  CallbackReturn on_cleanup(const rclcpp_lifecycle::State & /*state*/) override
+  {
+    cleanup_start = Clock::now();
+    std::this_thread::sleep_for(200ms);
+    cleanup_end = Clock::now();
+    return CallbackReturn::SUCCESS;
+  }
+
+  Clock::time_point configure_start, configure_end, cleanup_start, cleanup_end;
+};
+
+class LifecycleManagerShim : public nav2_lifecycle_manager::LifecycleManager
+{
+public:
+  explicit LifecycleManagerShim(const std::vector<rclcpp::Parameter> & parameters)
+  : nav2_lifecycle_manager::LifecycleManager(
+      rclcpp::NodeOptions().parameter_overrides(parameters))
+  {
+  }
+
+  using nav2_lifecycle_manager::LifecycleManager::createLifecycleServiceClients;
+  using nav2_lifecycle_manager::LifecycleManager::configure;
+  using nav2_lifecycle_manager::LifecycleManager::cleanup;
+  using nav2_lifecycle_manager::LifecycleManager::CreateDiagnostic;
+
+  bool parallelTransitions() {return parallel_transitions_;}
+};
+
+TEST(ParallelTransitionsTest, dependencies)
+{
+  std::vector<std::shared_ptr<SlowLifecycleNode>> nodes;
+  std::vector<std::unique_ptr<nav2::NodeThread>> threads;
+  for (const std::string name : {"node_a", "node_b", "node_c"}) {
+    nodes.push_back(std::make_shared<SlowLifecycleNode>(name));
+    threads.push_back(std::make_unique<nav2::NodeThread>(nodes.back()->get_node_base_interface()));
+  }
+  auto & node_a = *nodes[0];
+  auto & node_b = *nodes[1];
+  auto & node_c = *nodes[2];
+
+  // node_c depends on node_a, node_b is independent
+  auto manager = std::make_shared<LifecycleManagerShim>(
+    std::vector<rclcpp::Parameter>{
+      rclcpp::Parameter("node_names", std::vector<std::string>{"node_a", "node_b", "node_c"}),
+      rclcpp::Parameter("bond_timeout", 0.0),
+      rclcpp::Parameter("parallel_transitions", true),
+      rclcpp::Parameter("node_dependencies.node_c", std::vector<std::string>{"node_a"})});
+  ASSERT_TRUE(manager->parallelTransitions());
+  manager->createLifecycleServiceClients();
+
+  ASSERT_TRUE(manager->configure());
+  EXPECT_LT(node_b.configure_start, node_a.configure_end);
+  EXPECT_LT(node_a.configure_start, node_b.configure_end);
+  EXPECT_GE(node_c.configure_start, node_a.configure_end);
+
+  // Dependents are brought down first
+  ASSERT_TRUE(manager->cleanup());
+  EXPECT_GE(node_a.cleanup_start, node_c.cleanup_end);
+  EXPECT_LT(node_b.cleanup_start, node_c.cleanup_end);
+
+  // The durations of the transitions are reported
+  diagnostic_updater::DiagnosticStatusWrapper stat;
+  manager->CreateDiagnostic(stat);
+  std::vector<std::string> keys;
+  for (const auto & value : stat.values) {
+    keys.push_back(value.key);
+  }
+  for (const std::string key : {"node_a: Configuring", "node_c: Cleaning up",
+      "All nodes: Configuring", "All nodes: Cleaning up"})
+  {
+    EXPECT_NE(std::find(keys.begin(), keys.end(), key), keys.end()) << key;
+  }
+}
+
+TEST(ParallelTransitionsTest, cyclicDependencies)
+{
+  // Cyclic dependencies fall back to transitioning the nodes one after another
+  auto manager = std::make_shared<LifecycleManagerShim>(
+    std::vector<rclcpp::Parameter>{
+      rclcpp::Parameter("node_names", std::vector<std::string>{"node_a", "node_b"}),
+      rclcpp::Parameter("parallel_transitions", true),
+      rclcpp::Parameter("node_dependencies.node_a", std::vector<std::string>{"node_b"}),
+      rclcpp::Parameter("node_dependencies.node_b", std::vector<std::string>{"node_a"})});
+  EXPECT_FALSE(manager->parallelTransitions());
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  // initialize ROS
+  rclcpp::init(argc, argv);
+
+  int result = RUN_ALL_TESTS();
+
+  // shutdown ROS
+  rclcpp::shutdown();
+
+  return result;
+}
@@ -22,6 +22,7 @@
 #include "nav2_ros_common/service_server.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
 #include "nav_msgs/srv/get_map.hpp"
+#include "nav2_msgs/srv/get_map_region.hpp"
 #include "nav2_msgs/srv/load_map.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp_lifecycle/state.hpp"
@@ -108,6 +109,17 @@ protected:
     const std::shared_ptr<nav_msgs::srv::GetMap::Request> request,
     std::shared_ptr<nav_msgs::srv::GetMap::Response> response);
 
+  /**
+   * @brief Map region getting service callback, serving tiles of the map
+   * @param request_header Service request header
+   * @param request Service request
+   * @param response Service response
+   */
+  void getMapRegionCallback(
+    const std::shared_ptr<rmw_request_id_t> request_header,
+    const std::shared_ptr<nav2_msgs::srv::GetMapRegion::Request> request,
+    std::shared_ptr<nav2_msgs::srv::GetMapRegion::Response> response);
+
   /**
    * @brief Map loading service callback
    * @param request_header Service request header
@@ -125,18 +137,27 @@ protected:
   // The name of the service for loading a map
   const std::string load_map_service_name_{"load_map"};
 
+  // The name of the service for getting a region of the map
+  const std::string map_region_service_name_{"map_region"};
+
   // A service to provide the occupancy grid (GetMap) and the message to return
   nav2::ServiceServer<nav_msgs::srv::GetMap>::SharedPtr occ_service_;
 
   // A service to load the occupancy grid from file at run time (LoadMap)
   nav2::ServiceServer<nav2_msgs::srv::LoadMap>::SharedPtr load_map_service_;
 
+  // A service to provide regions of the occupancy grid (GetMapRegion)
+  nav2::ServiceServer<nav2_msgs::srv::GetMapRegion>::SharedPtr map_region_service_;
+
   // A topic on which the occupancy grid will be published
   nav2::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr occ_pub_;
 
   // The frame ID used in the returned OccupancyGrid message
   std::string frame_id_;
 
+  // Whether the whole map is published on the topic, or only served in regions
+  bool publish_full_map_{true};
+
   // The message to publish on the occupancy grid topic
   nav_msgs::msg::OccupancyGrid msg_;
 
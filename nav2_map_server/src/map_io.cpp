@@ -35,10 +35,18 @@
 #include <libgen.h>
 #endif
 
-#include <Eigen/Dense>
-
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <fstream>
 #include <stdexcept>
@@ -102,6 +110,23 @@ namespace nav2_map_server
 {
 using nav2_util::geometry_utils::orientationAroundZAxis;
 
+/**
+ * Native map format, written by map_saver with the "nav2map" image format.
+ * It stores the OccupancyGrid values as they are published, so loading it requires
+ * no decoding nor thresholding. The file is made of the header below followed by
+ * width * height occupancy values in the OccupancyGrid row order (origin at bottom-left).
+ */
+const char NATIVE_MAP_FORMAT[] = "nav2map";
+
+struct NativeMapHeader
+{
+  char magic[8]{'N', 'A', 'V', '2', 'M', 'A', 'P', '\0'};
+  uint32_t version{1};
+  uint32_t byte_order_mark{0x01020304};
+  uint32_t width{0};
+  uint32_t height{0};
+};
+
 // === Map input part ===
 
 /// Get the given subnode value.
@@ -203,131 +228,280 @@ LoadParameters loadMapYaml(const std::string & yaml_filename)
   return load_parameters;
 }
 
-void loadMapFromFile(
-  const LoadParameters & load_parameters,
-  nav_msgs::msg::OccupancyGrid & map)
+/**
+ * @brief Builds the lookup table from the grayscale pixel values to the OccupancyGrid values,
+ * as each cell only depends on its pixel value in every map mode
+ * @param load_parameters Parameters of loading map
+ * @return The lookup table
+ * @throw std::runtime_error in case of invalid map mode
+ */
+std::array<int8_t, 256> makeOccupancyLookupTable(const LoadParameters & load_parameters)
 {
-  Magick::InitializeMagick(nullptr);
-  nav_msgs::msg::OccupancyGrid msg;
-
-  RCLCPP_INFO_STREAM(
-    rclcpp::get_logger("map_io"), "Loading image_file: " <<
-      load_parameters.image_file_name);
-  Magick::Image img(load_parameters.image_file_name);
-
-  // Copy the image data into the map structure
-  msg.info.width = img.size().width();
-  msg.info.height = img.size().height();
-
-  msg.info.resolution = load_parameters.resolution;
-  msg.info.origin.position.x = load_parameters.origin[0];
-  msg.info.origin.position.y = load_parameters.origin[1];
-  msg.info.origin.position.z = 0.0;
-  msg.info.origin.orientation = orientationAroundZAxis(load_parameters.origin[2]);
+  std::array<int8_t, 256> table;
+  if (load_parameters.mode == MapMode::Raw) {
+    // Raw mode: interpret raw image pixel values directly as occupancy values,
+    // clamping out-of-bound values (outside [-1, 100]) to UNKNOWN (-1)
+    for (int value = 0; value < 256; value++) {
+      const int8_t occupancy = static_cast<int8_t>(value);
+      table[value] = (occupancy < nav2_util::OCC_GRID_FREE ||
+        occupancy > nav2_util::OCC_GRID_OCCUPIED) ? nav2_util::OCC_GRID_UNKNOWN : occupancy;
+    }
+    return table;
+  }
 
-  // Allocate space to hold the data
-  msg.data.resize(msg.info.width * msg.info.height);
+  if (load_parameters.mode != MapMode::Trinary && load_parameters.mode != MapMode::Scale) {
+    // If the map mode is not recognized, throw an error
+    throw std::runtime_error("Invalid map mode");
+  }
 
-  // Convert the image to grayscale
-  Magick::Image gray = img;
-  gray.type(Magick::GrayscaleType);
+  const float free_thresh = static_cast<float>(load_parameters.free_thresh);
+  const float occupied_thresh = static_cast<float>(load_parameters.occupied_thresh);
+  const float thresh_range =
+    static_cast<float>(load_parameters.occupied_thresh - load_parameters.free_thresh);
+  for (int value = 0; value < 256; value++) {
+    // Convert grayscale to float in range [0.0, 1.0]
+    float normalized = static_cast<float>(value) / 255.0f;
 
-  // Prepare grayscale matrix from image
-  size_t width = gray.columns();
-  size_t height = gray.rows();
+    // Negate the image if specified (e.g. for black=occupied vs. white=occupied convention)
+    if (!load_parameters.negate) {
+      normalized = 1.0f - normalized;
+    }
 
-  std::vector<uint8_t> buffer(width * height);
-  gray.write(0, 0, width, height, "I", Magick::CharPixel, buffer.data());
+    int8_t occupancy = nav2_util::OCC_GRID_UNKNOWN;
+    if (normalized >= occupied_thresh) {
+      occupancy = nav2_util::OCC_GRID_OCCUPIED;
+    }
+    if (normalized <= free_thresh) {
+      occupancy = nav2_util::OCC_GRID_FREE;
+    }
 
-  // Map the grayscale buffer to an Eigen matrix (row-major layout)
-  Eigen::Map<Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>
-  gray_matrix(buffer.data(), height, width);
+    // Scale intermediate (gray) values to [0,100] range in Scale mode
+    if (load_parameters.mode == MapMode::Scale &&
+      normalized > free_thresh && normalized < occupied_thresh)
+    {
+      occupancy = static_cast<int8_t>(
+        std::round((normalized - free_thresh) / thresh_range * 100.0f));
+    }
+    table[value] = occupancy;
+  }
+  return table;
+}
 
-  bool has_alpha = img.matte();
+/**
+ * @brief Runs the given function over the rows of an image, split between the hardware
+ * threads for large images
+ * @param height Number of rows
+ * @param width Number of pixels in a row
+ * @param function Function processing the rows in [begin, end) range
+ */
+void forEachRowRange(
+  const size_t height, const size_t width,
+  const std::function<void(size_t, size_t)> & function)
+{
+  // Not worth spawning a thread for less than a megapixel
+  constexpr size_t min_pixels_per_thread = 1 << 20;
+  const size_t max_threads =
+    std::max<size_t>(1, width * height / min_pixels_per_thread);
+  const size_t num_threads =
+    std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), max_threads);
+  if (num_threads == 1) {
+    function(0, height);
+    return;
+  }
 
-  // Handle different map modes with if else condition
-  // Trinary and Scale modes are handled together
-  // because they share a lot of code
-  // Raw mode is handled separately in else if block
-  Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> result(height, width);
+  const size_t rows_per_thread = (height + num_threads - 1) / num_threads;
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t begin = rows_per_thread; begin < height; begin += rows_per_thread) {
+    threads.emplace_back(function, begin, std::min(begin + rows_per_thread, height));
+  }
+  function(0, std::min(rows_per_thread, height));
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
 
-  if (load_parameters.mode == MapMode::Trinary || load_parameters.mode == MapMode::Scale) {
-    // Convert grayscale to float in range [0.0, 1.0]
-    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic,
-      Eigen::RowMajor> normalized = gray_matrix.cast<float>() / 255.0f;
+/**
+ * @brief Reads the header of a binary 8-bit PGM file
+ * @param file Input file, positioned at the start of the pixel data on success
+ * @param width Output image width
+ * @param height Output image height
+ * @return False if the file is not a binary PGM file with 8-bit pixels
+ */
+bool readPgmHeader(std::ifstream & file, size_t & width, size_t & height)
+{
+  char magic[2];
+  if (!file.read(magic, 2) || magic[0] != 'P' || magic[1] != '5') {
+    return false;
+  }
 
-    // Negate the image if specified (e.g. for black=occupied vs. white=occupied convention)
-    if (!load_parameters.negate) {
-      normalized = (1.0f - normalized.array()).matrix();
+  // Width, height and maximum value, separated by whitespaces and comments
+  size_t fields[3];
+  for (size_t & field : fields) {
+    int c = file.get();
+    while (std::isspace(c) || c == '#') {
+      if (c == '#') {
+        file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      }
+      c = file.get();
+    }
+    if (!std::isdigit(c)) {
+      return false;
+    }
+    field = 0;
+    while (std::isdigit(c)) {
+      field = field * 10 + static_cast<size_t>(c - '0');
+      c = file.get();
     }
+    // A single whitespace ends the header
+    if (!std::isspace(c)) {
+      return false;
+    }
+  }
 
-    // Compute binary occupancy masks
-    Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> occupied =
-      (normalized.array() >= load_parameters.occupied_thresh).cast<uint8_t>();
+  width = fields[0];
+  height = fields[1];
+  return fields[2] == 255 && width > 0 && height > 0;
+}
 
-    Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> free =
-      (normalized.array() <= load_parameters.free_thresh).cast<uint8_t>();
+/**
+ * @brief Fast path loading a binary 8-bit PGM file, streaming its rows directly into
+ * the OccupancyGrid data, without decoding the whole image through GraphicsMagick
+ * @param load_parameters Parameters of loading map
+ * @param msg Output map, filled with the image size and data
+ * @return False if the file is not a binary 8-bit PGM file
+ * @throw std::runtime_error in case of truncated image data
+ */
+bool loadPgmFile(const LoadParameters & load_parameters, nav_msgs::msg::OccupancyGrid & msg)
+{
+  std::ifstream file(load_parameters.image_file_name, std::ios::binary);
+  size_t width, height;
+  if (!file || !readPgmHeader(file, width, height)) {
+    return false;
+  }
 
-    // Initialize occupancy grid with UNKNOWN values (-1)
-    result.setConstant(nav2_util::OCC_GRID_UNKNOWN);
+  const std::array<int8_t, 256> table = makeOccupancyLookupTable(load_parameters);
+  msg.info.width = width;
+  msg.info.height = height;
+  msg.data.resize(width * height);
 
-    // Apply occupied and free cell updates
-    result = (occupied.array() > 0).select(nav2_util::OCC_GRID_OCCUPIED, result);
-    result = (free.array() > 0).select(nav2_util::OCC_GRID_FREE, result);
+  // Flip image vertically (as ROS expects origin at bottom-left) while reading the rows
+  char * data = reinterpret_cast<char *>(msg.data.data());
+  for (size_t row = 0; row < height; row++) {
+    if (!file.read(data + (height - row - 1) * width, width)) {
+      throw std::runtime_error("Image data is truncated");
+    }
+  }
 
-    // Handle intermediate (gray) values if in Scale mode
-    if (load_parameters.mode == MapMode::Scale) {
-      // Create in-between mask
-      auto in_between_mask = (normalized.array() > load_parameters.free_thresh) &&
-        (normalized.array() < load_parameters.occupied_thresh);
+  forEachRowRange(
+    height, width, [&](size_t begin, size_t end) {
+      for (size_t i = begin * width; i < end * width; i++) {
+        msg.data[i] = table[static_cast<uint8_t>(msg.data[i])];
+      }
+    });
+  return true;
+}
 
-      if (in_between_mask.any()) {
-        // Scale in-between values to [0,100] range
-        Eigen::ArrayXXf scaled_float = ((normalized.array() - load_parameters.free_thresh) /
-          (load_parameters.occupied_thresh - load_parameters.free_thresh)) * 100.0f;
+/**
+ * @brief Loads a map file in the native map format, reading its occupancy values
+ * directly into the OccupancyGrid data. Map mode, thresholds and negate are not applied,
+ * as the values were already interpreted when the map was saved
+ * @param load_parameters Parameters of loading map
+ * @param msg Output map, filled with the map size and data
+ * @return False if the file is not in the native map format
+ * @throw std::runtime_error in case of unsupported or truncated map file
+ */
+bool loadNativeMapFile(
+  const LoadParameters & load_parameters, nav_msgs::msg::OccupancyGrid & msg)
+{
+  std::ifstream file(load_parameters.image_file_name, std::ios::binary);
+  const NativeMapHeader reference;
+  NativeMapHeader header;
+  if (!file || !file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    std::memcmp(header.magic, reference.magic, sizeof(header.magic)) != 0)
+  {
+    return false;
+  }
+  if (header.version != reference.version) {
+    throw std::runtime_error(
+            "Unsupported native map version " + std::to_string(header.version));
+  }
+  if (header.byte_order_mark != reference.byte_order_mark) {
+    throw std::runtime_error("Native map was saved with a different byte order");
+  }
 
-        // Round and cast to int8_t
-        Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> scaled_int =
-          scaled_float.array().round().cast<int8_t>();
+  msg.info.width = header.width;
+  msg.info.height = header.height;
+  msg.data.resize(static_cast<size_t>(header.width) * header.height);
+  if (!file.read(reinterpret_cast<char *>(msg.data.data()), msg.data.size())) {
+    throw std::runtime_error("Map data is truncated");
+  }
+  return true;
+}
 
-        result = in_between_mask.select(scaled_int, result);
-      }
-    }
+void loadMapFromFile(
+  const LoadParameters & load_parameters,
+  nav_msgs::msg::OccupancyGrid & map)
+{
+  nav_msgs::msg::OccupancyGrid msg;
 
-    // Apply alpha transparency mask: mark transparent cells as UNKNOWN
-    if (has_alpha) {
-      // Allocate buffer only once and map directly to Eigen without extra copy
-      std::vector<uint8_t> alpha_buf(width * height);
-      img.write(0, 0, width, height, "A", Magick::CharPixel, alpha_buf.data());
+  RCLCPP_INFO_STREAM(
+    rclcpp::get_logger("map_io"), "Loading image_file: " <<
+      load_parameters.image_file_name);
 
-      // Map alpha buffer as Eigen::Array for efficient elementwise ops
-      Eigen::Map<Eigen::Array<uint8_t, Eigen::Dynamic, Eigen::Dynamic,
-        Eigen::RowMajor>> alpha_array(
-        alpha_buf.data(), height, width);
+  if (!loadNativeMapFile(load_parameters, msg) && !loadPgmFile(load_parameters, msg)) {
+    // Any other format is decoded through GraphicsMagick
+    Magick::InitializeMagick(nullptr);
+    Magick::Image img(load_parameters.image_file_name);
 
-      // Apply mask directly with Eigen::select
-      result = (alpha_array < 255).select(nav2_util::OCC_GRID_UNKNOWN, result);
-    }
+    // Convert the image to grayscale
+    Magick::Image gray = img;
+    gray.type(Magick::GrayscaleType);
 
-  } else if (load_parameters.mode == MapMode::Raw) {
-    // Raw mode: interpret raw image pixel values directly as occupancy values
-    result = gray_matrix.cast<int8_t>();
+    // Prepare grayscale buffer from image
+    size_t width = gray.columns();
+    size_t height = gray.rows();
 
-    // Clamp out-of-bound values (outside [-1, 100]) to UNKNOWN (-1)
-    auto out_of_bounds = (result.array() < nav2_util::OCC_GRID_FREE) ||
-      (result.array() > nav2_util::OCC_GRID_OCCUPIED);
+    std::vector<uint8_t> buffer(width * height);
+    gray.write(0, 0, width, height, "I", Magick::CharPixel, buffer.data());
 
-    result = out_of_bounds.select(nav2_util::OCC_GRID_UNKNOWN, result);
+    // Transparent cells are marked as UNKNOWN, except in Raw mode
+    std::vector<uint8_t> alpha;
+    if (img.matte() && load_parameters.mode != MapMode::Raw) {
+      alpha.resize(width * height);
+      img.write(0, 0, width, height, "A", Magick::CharPixel, alpha.data());
+    }
 
-  } else {
-    // If the map mode is not recognized, throw an error
-    throw std::runtime_error("Invalid map mode");
+    const std::array<int8_t, 256> table = makeOccupancyLookupTable(load_parameters);
+    msg.info.width = width;
+    msg.info.height = height;
+    msg.data.resize(width * height);
+
+    forEachRowRange(
+      height, width, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; row++) {
+          // Flip image vertically (as ROS expects origin at bottom-left)
+          auto map_row = msg.data.begin() + (height - row - 1) * width;
+          const size_t image_row = row * width;
+          for (size_t col = 0; col < width; col++) {
+            map_row[col] = table[buffer[image_row + col]];
+          }
+          if (!alpha.empty()) {
+            for (size_t col = 0; col < width; col++) {
+              if (alpha[image_row + col] < 255) {
+                map_row[col] = nav2_util::OCC_GRID_UNKNOWN;
+              }
+            }
+          }
+        }
+      });
   }
 
-  // Flip image vertically (as ROS expects origin at bottom-left)
-  Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic,
-    Eigen::RowMajor> flipped = result.colwise().reverse();
-  std::memcpy(msg.data.data(), flipped.data(), width * height);
+  msg.info.resolution = load_parameters.resolution;
+  msg.info.origin.position.x = load_parameters.origin[0];
+  msg.info.origin.position.y = load_parameters.origin[1];
+  msg.info.origin.position.z = 0.0;
+  msg.info.origin.orientation = orientationAroundZAxis(load_parameters.origin[2]);
 
   // Since loadMapFromFile() does not belong to any node, publishing in a system time.
   rclcpp::Clock clock(RCL_SYSTEM_TIME);
@@ -341,7 +515,7 @@ void loadMapFromFile(
                              << ": " << msg.info.width << " X " << msg.info.height << " map @ "
                              << msg.info.resolution << " m/cell");
 
-  map = msg;
+  map = std::move(msg);
 }
 
 LOAD_MAP_STATUS loadMapFromYaml(
@@ -447,6 +621,11 @@ void checkSaveParameters(SaveParameters & save_parameters)
     save_parameters.image_format.begin(),
     [](unsigned char c) {return std::tolower(c);});
 
+  if (save_parameters.image_format == NATIVE_MAP_FORMAT) {
+    // Written without GraphicsMagick, and supports all map values
+    return;
+  }
+
   const std::vector<std::string> BLESSED_FORMATS{"bmp", "pgm", "png"};
   if (
     std::find(BLESSED_FORMATS.begin(), BLESSED_FORMATS.end(), save_parameters.image_format) ==
@@ -513,7 +692,24 @@ void tryWriteMapToFile(
       map.info.resolution << " m/pix");
 
   std::string mapdatafile = save_parameters.map_file_name + "." + save_parameters.image_format;
-  {
+  if (save_parameters.image_format == NATIVE_MAP_FORMAT) {
+    if (map.data.size() != static_cast<size_t>(map.info.width) * map.info.height) {
+      throw std::runtime_error("Map data size does not match the map dimensions");
+    }
+    NativeMapHeader header;
+    header.width = map.info.width;
+    header.height = map.info.height;
+
+    RCLCPP_INFO_STREAM(
+      rclcpp::get_logger("map_io"),
+      "Writing map occupancy data to " << mapdatafile);
+    std::ofstream file(mapdatafile, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(map.data.data()), map.data.size());
+    if (!file) {
+      throw std::runtime_error("Failed to write " + mapdatafile);
+    }
+  } else {
     // should never see this color, so the initialization value is just for debugging
     Magick::Image image({map.info.width, map.info.height}, "red");
 
@@ -46,6 +46,7 @@
 
 #include "nav2_map_server/map_server.hpp"
 
+#include <algorithm>
 #include <string>
 #include <memory>
 #include <fstream>
@@ -71,6 +72,7 @@ MapServer::MapServer(const rclcpp::NodeOptions & options)
   declare_parameter("yaml_filename", rclcpp::PARAMETER_STRING);
   declare_parameter("topic_name", "map");
   declare_parameter("frame_id", "map");
+  declare_parameter("publish_full_map", true);
 }
 
 MapServer::~MapServer()
@@ -86,6 +88,7 @@ MapServer::on_configure(const rclcpp_lifecycle::State & /*state*/)
   std::string yaml_filename = get_parameter("yaml_filename").as_string();
   std::string topic_name = get_parameter("topic_name").as_string();
   frame_id_ = get_parameter("frame_id").as_string();
+  publish_full_map_ = get_parameter("publish_full_map").as_bool();
 
   // only try to load map if parameter was set
   if (!yaml_filename.empty()) {
@@ -122,6 +125,11 @@ MapServer::on_configure(const rclcpp_lifecycle::State & /*state*/)
     service_prefix + std::string(load_map_service_name_),
     std::bind(&MapServer::loadMapCallback, this, _1, _2, _3));
 
+  // Create a service that provides regions of the occupancy grid
+  map_region_service_ = create_service<nav2_msgs::srv::GetMapRegion>(
+    service_prefix + std::string(map_region_service_name_),
+    std::bind(&MapServer::getMapRegionCallback, this, _1, _2, _3));
+
   return nav2::CallbackReturn::SUCCESS;
 }
 
@@ -132,7 +140,7 @@ MapServer::on_activate(const rclcpp_lifecycle::State & /*state*/)
 
   // Publish the map using the latched topic
   occ_pub_->on_activate();
-  if (map_available_) {
+  if (map_available_ && publish_full_map_) {
     auto occ_grid = std::make_unique<nav_msgs::msg::OccupancyGrid>(msg_);
     occ_pub_->publish(std::move(occ_grid));
   }
@@ -164,6 +172,7 @@ MapServer::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   occ_pub_.reset();
   occ_service_.reset();
   load_map_service_.reset();
+  map_region_service_.reset();
   map_available_ = false;
   msg_ = nav_msgs::msg::OccupancyGrid();
 
@@ -193,6 +202,47 @@ void MapServer::getMapCallback(
   response->map = msg_;
 }
 
+void MapServer::getMapRegionCallback(
+  const std::shared_ptr<rmw_request_id_t>/*request_header*/,
+  const std::shared_ptr<nav2_msgs::srv::GetMapRegion::Request> request,
+  std::shared_ptr<nav2_msgs::srv::GetMapRegion::Response> response)
+{
+  // if not in ACTIVE state, ignore request
+  if (get_current_state().id() != lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE ||
+    !map_available_)
+  {
+    RCLCPP_WARN(
+      get_logger(),
+      "Received GetMapRegion request but not in ACTIVE state or no map loaded, ignoring!");
+    response->success = false;
+    return;
+  }
+  RCLCPP_DEBUG(get_logger(), "Handling GetMapRegion request");
+
+  // Clip the requested region to the map bounds
+  const nav_msgs::msg::MapMetaData & info = msg_.info;
+  const uint32_t x0 = std::min(request->x, info.width);
+  const uint32_t y0 = std::min(request->y, info.height);
+  const uint32_t width = std::min(request->width, info.width - x0);
+  const uint32_t height = std::min(request->height, info.height - y0);
+
+  response->map_info = info;
+  response->x = x0;
+  response->y = y0;
+  response->region.header = msg_.header;
+  response->region.info = info;
+  response->region.info.width = width;
+  response->region.info.height = height;
+  response->region.info.origin.position.x += x0 * info.resolution;
+  response->region.info.origin.position.y += y0 * info.resolution;
+  response->region.data.resize(static_cast<size_t>(width) * height);
+  for (uint32_t y = 0; y < height; y++) {
+    auto row = msg_.data.begin() + (static_cast<size_t>(y0 + y) * info.width + x0);
+    std::copy(row, row + width, response->region.data.begin() + static_cast<size_t>(y) * width);
+  }
+  response->success = true;
+}
+
 void MapServer::loadMapCallback(
   const std::shared_ptr<rmw_request_id_t>/*request_header*/,
   const std::shared_ptr<nav2_msgs::srv::LoadMap::Request> request,
@@ -208,7 +258,7 @@ void MapServer::loadMapCallback(
   }
   RCLCPP_INFO(get_logger(), "Handling LoadMap request");
   // Load from file
-  if (loadMapResponseFromYaml(request->map_url, response)) {
+  if (loadMapResponseFromYaml(request->map_url, response) && publish_full_map_) {
     auto occ_grid = std::make_unique<nav_msgs::msg::OccupancyGrid>(msg_);
     occ_pub_->publish(std::move(occ_grid));  // publish new map
   }
@@ -0,0 +1,90 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Magick++.h"
+#include "nav2_map_server/map_io.hpp"
+
+// This is a script to benchmark loading large maps: a binary PGM file, loaded by streaming
+// its rows into the OccupancyGrid, against the same map as a PNG file, decoded through
+// GraphicsMagick. Usage: map_loading_benchmark [size_in_pixels]
+
+void writeMaps(unsigned int size, const std::string & pgm_file, const std::string & png_file)
+{
+  // Free space with occupied walls every 50 pixels and unknown space around
+  std::vector<unsigned char> pixels(static_cast<size_t>(size) * size);
+  for (unsigned int y = 0; y < size; y++) {
+    for (unsigned int x = 0; x < size; x++) {
+      unsigned char value = 254;
+      if (x < size / 10 || y < size / 10) {
+        value = 205;
+      } else if (x % 50 == 0 || y % 50 == 0) {
+        value = 0;
+      }
+      pixels[static_cast<size_t>(y) * size + x] = value;
+    }
+  }
+
+  std::ofstream pgm(pgm_file, std::ios::binary);
+  pgm << "P5\n" << size << " " << size << "\n255\n";
+  pgm.write(reinterpret_cast<const char *>(pixels.data()), pixels.size());
+  pgm.close();
+
+  Magick::InitializeMagick(nullptr);
+  Magick::Image image(size, size, "I", Magick::CharPixel, pixels.data());
+  image.type(Magick::GrayscaleType);
+  image.write(png_file);
+}
+
+double loadMap(const std::string & image_file)
+{
+  nav2_map_server::LoadParameters load_parameters;
+  load_parameters.image_file_name = image_file;
+  load_parameters.resolution = 0.05;
+  load_parameters.free_thresh = 0.25;
+  load_parameters.occupied_thresh = 0.65;
+  load_parameters.mode = nav2_map_server::MapMode::Trinary;
+  load_parameters.negate = false;
+
+  nav_msgs::msg::OccupancyGrid map;
+  auto start = std::chrono::steady_clock::now();
+  nav2_map_server::loadMapFromFile(load_parameters, map);
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char ** argv)
+{
+  const unsigned int size = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const auto dir = std::filesystem::temp_directory_path();
+  const std::string pgm_file = dir / "map_loading_benchmark.pgm";
+  const std::string png_file = dir / "map_loading_benchmark.png";
+  writeMaps(size, pgm_file, png_file);
+
+  const double pgm_time = loadMap(pgm_file);
+  const double png_time = loadMap(png_file);
+  printf("Loading a %u x %u map\n", size, size);
+  printf("Binary PGM, streamed: %.3f s\n", pgm_time);
+  printf("PNG, decoded through GraphicsMagick: %.3f s\n", png_time);
+
+  std::filesystem::remove(pgm_file);
+  std::filesystem::remove(png_file);
+  return 0;
+}
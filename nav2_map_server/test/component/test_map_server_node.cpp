@@ -23,6 +23,7 @@
 #include "test_constants/test_constants.h"
 #include "nav2_map_server/map_server.hpp"
 #include "nav2_util/lifecycle_service_client.hpp"
+#include "nav2_msgs/srv/get_map_region.hpp"
 #include "nav2_msgs/srv/load_map.hpp"
 using namespace std::chrono_literals;
 using namespace rclcpp;  // NOLINT
@@ -113,6 +114,47 @@ TEST_F(MapServerTestFixture, GetMap)
   verifyMapMsg(resp->map);
 }
 
+// Send map region getting service requests and verify obtained regions of the map
+TEST_F(MapServerTestFixture, GetMapRegion)
+{
+  RCLCPP_INFO(node_->get_logger(), "Testing GetMapRegion service");
+  auto req = std::make_shared<nav2_msgs::srv::GetMapRegion::Request>();
+  auto client = node_->create_client<nav2_msgs::srv::GetMapRegion>(
+    "/map_server/map_region");
+
+  RCLCPP_INFO(node_->get_logger(), "Waiting for map_region service");
+  ASSERT_TRUE(client->wait_for_service());
+
+  // An empty region only gets the map metadata
+  auto resp = send_request<nav2_msgs::srv::GetMapRegion>(node_, client, req);
+  ASSERT_TRUE(resp->success);
+  ASSERT_EQ(resp->map_info.width, g_valid_image_width);
+  ASSERT_EQ(resp->map_info.height, g_valid_image_height);
+  ASSERT_TRUE(resp->region.data.empty());
+
+  // A region exceeding the map is clipped to its bounds
+  req->x = 3;
+  req->y = 2;
+  req->width = g_valid_image_width;
+  req->height = 4;
+  resp = send_request<nav2_msgs::srv::GetMapRegion>(node_, client, req);
+  ASSERT_TRUE(resp->success);
+  ASSERT_EQ(resp->x, 3u);
+  ASSERT_EQ(resp->y, 2u);
+  ASSERT_EQ(resp->region.info.width, g_valid_image_width - 3);
+  ASSERT_EQ(resp->region.info.height, 4u);
+  ASSERT_FLOAT_EQ(
+    resp->region.info.origin.position.x,
+    resp->map_info.origin.position.x + 3 * g_valid_image_res);
+  for (unsigned int y = 0; y < resp->region.info.height; y++) {
+    for (unsigned int x = 0; x < resp->region.info.width; x++) {
+      ASSERT_EQ(
+        resp->region.data[y * resp->region.info.width + x],
+        g_valid_image_content[(y + 2) * g_valid_image_width + x + 3]);
+    }
+  }
+}
+
 // Send map loading service request and verify obtained OccupancyGrid
 TEST_F(MapServerTestFixture, LoadMap)
 {
@@ -223,6 +223,94 @@ TEST_F(MapIOTester, loadSaveMapModes)
   verifyMapMsg(map_msg);
 }
 
+// Write the same gradient image as a binary PGM file, loaded through the streaming fast path,
+// and as an ASCII PGM file, decoded through GraphicsMagick. Load both in every map mode.
+// Succeeds if both ways of loading give the same OccupancyGrid.
+TEST_F(MapIOTester, loadBinaryPGMFastPath)
+{
+  const unsigned int width = 256;
+  const unsigned int height = 3;
+  const std::string binary_file = path(g_tmp_dir) / path("gradient_binary.pgm");
+  const std::string ascii_file = path(g_tmp_dir) / path("gradient_ascii.pgm");
+  {
+    std::ofstream binary(binary_file, std::ios::binary);
+    std::ofstream ascii(ascii_file);
+    binary << "P5\n# gradient\n" << width << " " << height << "\n255\n";
+    ascii << "P2\n" << width << " " << height << "\n255\n";
+    for (unsigned int y = 0; y < height; y++) {
+      for (unsigned int x = 0; x < width; x++) {
+        const unsigned char value = static_cast<unsigned char>((x + y * 85) % 256);
+        binary.put(static_cast<char>(value));
+        ascii << static_cast<int>(value) << "\n";
+      }
+    }
+  }
+
+  for (auto mode : {MapMode::Trinary, MapMode::Scale, MapMode::Raw}) {
+    for (bool negate : {false, true}) {
+      LoadParameters loadParameters;
+      fillLoadParameters(binary_file, loadParameters);
+      loadParameters.mode = mode;
+      loadParameters.negate = negate;
+      nav_msgs::msg::OccupancyGrid binary_map;
+      ASSERT_NO_THROW(loadMapFromFile(loadParameters, binary_map));
+
+      loadParameters.image_file_name = ascii_file;
+      nav_msgs::msg::OccupancyGrid ascii_map;
+      ASSERT_NO_THROW(loadMapFromFile(loadParameters, ascii_map));
+
+      ASSERT_EQ(binary_map.info.width, width);
+      ASSERT_EQ(binary_map.info.height, height);
+      ASSERT_EQ(binary_map.data, ascii_map.data);
+    }
+  }
+
+  // Truncated image data is rejected
+  std::filesystem::resize_file(binary_file, std::filesystem::file_size(binary_file) - 1);
+  LoadParameters loadParameters;
+  fillLoadParameters(binary_file, loadParameters);
+  nav_msgs::msg::OccupancyGrid map_msg;
+  ASSERT_ANY_THROW(loadMapFromFile(loadParameters, map_msg));
+
+  std::filesystem::remove(binary_file);
+  std::filesystem::remove(ascii_file);
+}
+
+// Save a map in the native map format and load it back.
+// Succeeds if all the occupancy values are kept as they are, whatever the map mode,
+// and if a truncated file is rejected.
+TEST_F(MapIOTester, loadSaveNativeMap)
+{
+  nav_msgs::msg::OccupancyGrid map_msg;
+  map_msg.info.width = 102;
+  map_msg.info.height = 2;
+  map_msg.info.resolution = g_valid_image_res;
+  for (unsigned int i = 0; i < map_msg.info.width * map_msg.info.height; i++) {
+    map_msg.data.push_back(static_cast<int8_t>(i % 102) - 1);
+  }
+
+  SaveParameters saveParameters;
+  fillSaveParameters(path(g_tmp_dir) / path(g_valid_map_name), "nav2map", saveParameters);
+  saveParameters.mode = MapMode::Scale;
+  ASSERT_TRUE(saveMapToFile(map_msg, saveParameters));
+
+  nav_msgs::msg::OccupancyGrid loaded_map;
+  LOAD_MAP_STATUS status = loadMapFromYaml(path(g_tmp_dir) / path(g_valid_yaml_file), loaded_map);
+  ASSERT_EQ(status, LOAD_MAP_SUCCESS);
+  ASSERT_EQ(loaded_map.info.width, map_msg.info.width);
+  ASSERT_EQ(loaded_map.info.height, map_msg.info.height);
+  ASSERT_FLOAT_EQ(loaded_map.info.resolution, g_valid_image_res);
+  ASSERT_EQ(loaded_map.data, map_msg.data);
+
+  const std::string native_file =
+    path(g_tmp_dir) / path(std::string(g_valid_map_name) + ".nav2map");
+  std::filesystem::resize_file(native_file, std::filesystem::file_size(native_file) - 1);
+  LoadParameters loadParameters;
+  fillLoadParameters(native_file, loadParameters);
+  ASSERT_ANY_THROW(loadMapFromFile(loadParameters, loaded_map));
+  std::filesystem::remove(native_file);
+}
+
 // Try to load an invalid file with different ways.
 // Succeeds if all cases are got expected fail behaviours.
 TEST_F(MapIOTester, loadInvalidFile)
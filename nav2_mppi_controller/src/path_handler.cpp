@@ -17,6 +17,7 @@
 #include "nav2_mppi_controller/tools/path_handler.hpp"
 #include "nav2_mppi_controller/tools/utils.hpp"
 #include "nav2_costmap_2d/costmap_2d_ros.hpp"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
 namespace mppi
 {
@@ -74,6 +75,21 @@ PathHandler::getGlobalPlanConsideringBoundsInCostmapFrame(
     nav2_util::geometry_utils::first_after_integrated_distance(
     closest_point, global_plan_up_to_inversion_.poses.end(), prune_distance_);
 
+  // Look up the transform from the global plan frame to the costmap frame once,
+  // rather than for every pose of the path
+  geometry_msgs::msg::TransformStamped plan_to_costmap;
+  const bool same_frame = global_plan_.header.frame_id == costmap_->getGlobalFrameID();
+  if (!same_frame) {
+    try {
+      plan_to_costmap = tf_buffer_->lookupTransform(
+        costmap_->getGlobalFrameID(), global_plan_.header.frame_id,
+        tf2_ros::fromMsg(global_pose.header.stamp), tf2::durationFromSec(transform_tolerance_));
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR(logger_, "Exception in transformPose: %s", ex.what());
+      return {transformed_plan, closest_point};
+    }
+  }
+
   unsigned int mx, my;
   // Find the furthest relevant pose on the path to consider within costmap
   // bounds
@@ -83,9 +99,12 @@ PathHandler::getGlobalPlanConsideringBoundsInCostmapFrame(
   {
     // Transform from global plan frame to costmap frame
     geometry_msgs::msg::PoseStamped costmap_plan_pose;
-    global_plan_pose->header.stamp = global_pose.header.stamp;
-    global_plan_pose->header.frame_id = global_plan_.header.frame_id;
-    transformPose(costmap_->getGlobalFrameID(), *global_plan_pose, costmap_plan_pose);
+    costmap_plan_pose.header = transformed_plan.header;
+    if (same_frame) {
+      costmap_plan_pose.pose = global_plan_pose->pose;
+    } else {
+      tf2::doTransform(global_plan_pose->pose, costmap_plan_pose.pose, plan_to_costmap);
+    }
 
     // Check if pose is inside the costmap
     if (!costmap_->getCostmap()->worldToMap(
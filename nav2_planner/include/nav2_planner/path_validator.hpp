@@ -0,0 +1,167 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_PLANNER__PATH_VALIDATOR_HPP_
+#define NAV2_PLANNER__PATH_VALIDATOR_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry_msgs/msg/pose.hpp"
+#include "nav_msgs/msg/path.hpp"
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/footprint.hpp"
+#include "nav2_costmap_2d/footprint_collision_checker.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+
+namespace nav2_planner
+{
+
+/**
+ * @class nav2_planner::PathValidator
+ * @brief Checks paths against the costmap with the same outcome as checking the footprint
+ * of the robot at each pose with FootprintCollisionChecker, but faster:
+ * - The footprint outline is rasterized once for a set of orientations, into masks of
+ *   cell offsets covering the outline for any position within the pose cell and any
+ *   orientation within the orientation bin. The cost of a mask bounds the exact footprint
+ *   cost from above, so that the exact footprint cost is only computed near costly cells.
+ * - Consecutive poses in the same cell and orientation bin are checked once, and the path
+ *   is subsampled with wider masks also covering the next poses within a fraction of the
+ *   footprint radius, which are only checked one by one near costly cells.
+ * - The mask costs of the last path checked are kept along with the costmap change count,
+ *   so that checking the same path again only checks the poses near the costmap changes.
+ */
+class PathValidator
+{
+public:
+  /**
+   * @brief Constructor for nav2_planner::PathValidator
+   * @param orientation_bins Number of orientations to rasterize the footprint for
+   */
+  explicit PathValidator(unsigned int orientation_bins = 72);
+
+  /**
+   * @brief Checks whether the poses of a path are collision free, the costmap mutex must be held
+   * @param path Path to check, in the costmap frame
+   * @param start_index Index of the first pose to check
+   * @param layered_costmap Costmap to check the path against
+   * @param footprint Footprint of the robot
+   * @param use_radius Whether to only check the cost at the center of the robot
+   * @param max_cost Cost from which a pose is in collision
+   * @param consider_unknown_as_obstacle Whether unknown costs are in collision
+   * @return False at the first pose in collision
+   */
+  bool isPathValid(
+    const nav_msgs::msg::Path & path, const unsigned int start_index,
+    nav2_costmap_2d::LayeredCostmap & layered_costmap,
+    const nav2_costmap_2d::Footprint & footprint, const bool use_radius,
+    const unsigned char max_cost, const bool consider_unknown_as_obstacle);
+
+protected:
+  /**
+   * @brief Offsets of the cells covering the footprint outline for an orientation bin
+   */
+  struct FootprintMask
+  {
+    std::vector<int> offsets;
+    int min_x, max_x, min_y, max_y;
+  };
+
+  /**
+   * @brief Mask cost of a path pose, for the cell and orientation bin identified by key
+   */
+  struct PoseCheck
+  {
+    uint64_t key;
+    unsigned char cost;
+    bool checked;
+  };
+
+  /**
+   * @brief Rasterizes the cells within a margin of the outline of a footprint
+   * @param vx X-coordinates of the footprint vertices, in cells from the pose cell center
+   * @param vy Y-coordinates of the footprint vertices, in cells from the pose cell center
+   * @param margin Margin around the outline, in cells
+   */
+  FootprintMask rasterizeMask(
+    const std::vector<double> & vx, const std::vector<double> & vy, const double margin) const;
+
+  /**
+   * @brief Rasterizes the footprint masks if the footprint or the costmap geometry
+   * has changed, and drops the cached pose checks in that case
+   */
+  void updateMasks(
+    const nav2_costmap_2d::Costmap2D & costmap, const nav2_costmap_2d::Footprint & footprint);
+
+  /**
+   * @brief Gets the key of the cell and orientation bin of a pose
+   * @param costmap Costmap to check against
+   * @param pose Pose to get the key of
+   * @param theta Output yaw of the pose
+   * @return Key of the pose, or NO_KEY if it is outside of the costmap
+   */
+  uint64_t getKey(
+    const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose & pose,
+    double & theta) const;
+
+  /**
+   * @brief Gets the highest cost under a mask placed at a pose
+   * @return Highest cost, or NO_INFORMATION if the mask is not within the costmap
+   */
+  unsigned char getMaskCost(
+    const FootprintMask & mask, const uint64_t key, const unsigned char * costs) const;
+
+  /**
+   * @brief Assigns the subsampling mask cost of a pose to the next poses it covers
+   */
+  void coverSubsampledPoses(
+    const nav2_costmap_2d::Costmap2D & costmap, const nav_msgs::msg::Path & path,
+    const unsigned int index, const unsigned char cost);
+
+  /**
+   * @brief Drops the cached pose checks whose mask overlaps cells changed since the last check
+   */
+  void invalidateChangedPoses(nav2_costmap_2d::LayeredCostmap & layered_costmap);
+
+  /**
+   * @brief Whether a cost puts a pose in collision, as in PlannerServer::isPathValid()
+   */
+  static bool isInCollision(
+    unsigned int cost, const bool use_radius, const unsigned char max_cost,
+    const bool consider_unknown_as_obstacle);
+
+  // Fraction of the footprint radius to subsample the path by
+  static constexpr double SUBSAMPLING_RATIO = 0.5;
+
+  unsigned int orientation_bins_;
+  std::vector<FootprintMask> masks_;
+  std::vector<FootprintMask> subsample_masks_;
+  double subsample_distance_{1.0};
+  nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *> collision_checker_;
+
+  // Footprint and costmap geometry the masks and pose checks were computed for
+  nav2_costmap_2d::Footprint footprint_;
+  unsigned int size_x_{0};
+  unsigned int size_y_{0};
+  double resolution_{0.0};
+  double origin_x_{0.0};
+  double origin_y_{0.0};
+
+  std::vector<PoseCheck> pose_checks_;
+  uint64_t change_count_{0};
+};
+
+}  // namespace nav2_planner
+
+#endif  // NAV2_PLANNER__PATH_VALIDATOR_HPP_
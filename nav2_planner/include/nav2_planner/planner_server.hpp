@@ -16,11 +16,13 @@
 #define NAV2_PLANNER__PLANNER_SERVER_HPP_
 
 #include <chrono>
+#include <exception>
 #include <string>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <set>
 
 #include "geometry_msgs/msg/point.hpp"
 #include "geometry_msgs/msg/pose_stamped.hpp"
@@ -39,8 +41,10 @@
 #include "pluginlib/class_list_macros.hpp"
 #include "nav2_core/global_planner.hpp"
 #include "nav2_msgs/srv/is_path_valid.hpp"
+#include "nav2_msgs/srv/compute_paths.hpp"
 #include "nav2_costmap_2d/footprint_collision_checker.hpp"
 #include "nav2_core/planner_exceptions.hpp"
+#include "nav2_planner/path_validator.hpp"
 
 namespace nav2_planner
 {
@@ -78,7 +82,79 @@ public:
     const std::string & planner_id,
     std::function<bool()> cancel_checker);
 
+  /**
+   * @struct nav2_planner::PlannerServer::PlanResult
+   * @brief Path planned between a pair of poses, or the exception thrown while planning it
+   */
+  struct PlanResult
+  {
+    nav_msgs::msg::Path path;
+    std::exception_ptr exception;
+  };
+
+  /**
+   * @brief Method to get plans between independent pairs of poses from the desired plugin,
+   * concurrently on the main planner instances and the pool instances not in use by another
+   * request. The caller must own the main planner instances
+   * @param starts starting poses, in the global frame
+   * @param goals goal poses, in the global frame
+   * @param planner_id The planner to plan with
+   * @param cancel_checker A function to check if the action has been canceled
+   * @param stop_on_failure Whether to stop planning the remaining pairs once one failed
+   * @return Results, in the order of the pairs. Pairs not planned after a failure have
+   * neither a path nor an exception, pairs not planned after a cancellation fail with
+   * PlannerCancelled
+   */
+  std::vector<PlanResult> getPlans(
+    const std::vector<geometry_msgs::msg::PoseStamped> & starts,
+    const std::vector<geometry_msgs::msg::PoseStamped> & goals,
+    const std::string & planner_id,
+    std::function<bool()> cancel_checker,
+    bool stop_on_failure = false);
+
 protected:
+  /**
+   * @brief Method to get plans between independent pairs of poses from the desired plugin,
+   * concurrently on the given planner instances
+   * @param planner_sets Planner instances to plan with, one worker each, owned by the caller
+   * @param starts starting poses, in the global frame
+   * @param goals goal poses, in the global frame
+   * @param planner_id The planner to plan with
+   * @param cancel_checker A function to check if the action has been canceled
+   * @param stop_on_failure Whether to stop planning the remaining pairs once one failed
+   * @return Results, in the order of the pairs
+   */
+  std::vector<PlanResult> getPlans(
+    const std::vector<PlannerMap *> & planner_sets,
+    const std::vector<geometry_msgs::msg::PoseStamped> & starts,
+    const std::vector<geometry_msgs::msg::PoseStamped> & goals,
+    const std::string & planner_id,
+    std::function<bool()> cancel_checker,
+    bool stop_on_failure = false);
+
+  /**
+   * @brief Check whether two poses are the same, up to numerical errors
+   * @param pose_a First pose
+   * @param pose_b Second pose
+   * @return True if the poses have the same position and orientation
+   */
+  static bool isSamePose(
+    const geometry_msgs::msg::Pose & pose_a,
+    const geometry_msgs::msg::Pose & pose_b);
+
+  /**
+   * @brief Take pool planner instances not in use by another request, for exclusive use
+   * @param max_instances Maximum number of instances to take
+   * @return Instances taken, possibly none, to give back with releasePoolPlanners
+   */
+  std::vector<PlannerMap *> acquirePoolPlanners(size_t max_instances);
+
+  /**
+   * @brief Give back pool planner instances taken with acquirePoolPlanners
+   * @param planner_sets Instances to give back
+   */
+  void releasePoolPlanners(const std::vector<PlannerMap *> & planner_sets);
+
   /**
    * @brief Configure member variables and initializes planner
    * @param state Reference to LifeCycle node state
@@ -187,6 +263,22 @@ protected:
     const nav_msgs::msg::Path & path,
     const std::string & planner_id);
 
+  /**
+   * @brief Method to get plan from the desired plugin, among a set of planner instances
+   * @param start starting pose
+   * @param goal goal request
+   * @param planner_id The planner to plan with
+   * @param cancel_checker A function to check if the action has been canceled
+   * @param planners The planner instances to plan with
+   * @return Path
+   */
+  nav_msgs::msg::Path getPlan(
+    const geometry_msgs::msg::PoseStamped & start,
+    const geometry_msgs::msg::PoseStamped & goal,
+    const std::string & planner_id,
+    std::function<bool()> cancel_checker,
+    PlannerMap & planners);
+
   /**
    * @brief The action server callback which calls planner to get the path
    * ComputePathToPose
@@ -209,6 +301,23 @@ protected:
     const std::shared_ptr<nav2_msgs::srv::IsPathValid::Request> request,
     std::shared_ptr<nav2_msgs::srv::IsPathValid::Response> response);
 
+  /**
+   * @brief The service callback to compute paths between independent pairs of poses
+   * @param request to the service
+   * @param response from the service
+   */
+  void computePaths(
+    const std::shared_ptr<rmw_request_id_t> request_header,
+    const std::shared_ptr<nav2_msgs::srv::ComputePaths::Request> request,
+    std::shared_ptr<nav2_msgs::srv::ComputePaths::Response> response);
+
+  /**
+   * @brief Get the error code of a planning failure
+   * @param ex Exception thrown while planning
+   * @return Error code, as in the result of ComputePathToPose
+   */
+  uint16_t getErrorCode(const std::exception & ex);
+
   /**
    * @brief Publish a path for visualization purposes
    * @param path Reference to Global Path
@@ -239,6 +348,12 @@ protected:
 
   // Planner
   PlannerMap planners_;
+  // Additional instances of the planners, to plan independent legs or requests concurrently
+  std::vector<PlannerMap> planner_pool_;
+  // Pool instances in use by a request, so that requests never share an instance
+  std::set<const PlannerMap *> busy_pool_planners_;
+  std::mutex planner_pool_lock_;
+  int planner_threads_;
   pluginlib::ClassLoader<nav2_core::GlobalPlanner> gp_loader_;
   std::vector<std::string> default_ids_;
   std::vector<std::string> default_types_;
@@ -255,14 +370,18 @@ protected:
   std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
   std::unique_ptr<nav2::NodeThread> costmap_thread_;
   nav2_costmap_2d::Costmap2D * costmap_;
-  std::unique_ptr<nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *>>
-  collision_checker_;
 
   // Publishers for the path
   nav2::Publisher<nav_msgs::msg::Path>::SharedPtr plan_publisher_;
 
   // Service to determine if the path is valid
   nav2::ServiceServer<nav2_msgs::srv::IsPathValid>::SharedPtr is_path_valid_service_;
+  PathValidator path_validator_;
+
+  // Service to compute paths between pairs of poses, on its own thread as it may take long
+  nav2::ServiceServer<nav2_msgs::srv::ComputePaths>::SharedPtr compute_paths_service_;
+  rclcpp::CallbackGroup::SharedPtr compute_paths_callback_group_;
+  std::unique_ptr<nav2::NodeThread> compute_paths_thread_;
 };
 
 }  // namespace nav2_planner
@@ -0,0 +1,346 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_planner/path_validator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "tf2/utils.hpp"
+
+namespace nav2_planner
+{
+
+namespace
+{
+
+constexpr uint64_t NO_KEY = std::numeric_limits<uint64_t>::max();
+
+double squaredDistanceToSegment(
+  const double px, const double py,
+  const double ax, const double ay, const double bx, const double by)
+{
+  const double dx = bx - ax;
+  const double dy = by - ay;
+  const double sq_length = dx * dx + dy * dy;
+  double t = 0.0;
+  if (sq_length > 0.0) {
+    t = std::clamp(((px - ax) * dx + (py - ay) * dy) / sq_length, 0.0, 1.0);
+  }
+  const double ex = ax + t * dx - px;
+  const double ey = ay + t * dy - py;
+  return ex * ex + ey * ey;
+}
+
+}  // namespace
+
+PathValidator::PathValidator(unsigned int orientation_bins)
+: orientation_bins_(std::max(1u, orientation_bins)),
+  collision_checker_(nullptr)
+{
+}
+
+bool PathValidator::isInCollision(
+  unsigned int cost, const bool use_radius, const unsigned char max_cost,
+  const bool consider_unknown_as_obstacle)
+{
+  if (cost == nav2_costmap_2d::NO_INFORMATION && consider_unknown_as_obstacle) {
+    cost = nav2_costmap_2d::LETHAL_OBSTACLE;
+  } else if (cost == nav2_costmap_2d::NO_INFORMATION) {
+    cost = nav2_costmap_2d::FREE_SPACE;
+  }
+
+  if (use_radius &&
+    (cost >= max_cost || cost == nav2_costmap_2d::LETHAL_OBSTACLE ||
+    cost == nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE))
+  {
+    return true;
+  }
+  return cost == nav2_costmap_2d::LETHAL_OBSTACLE || cost >= max_cost;
+}
+
+PathValidator::FootprintMask PathValidator::rasterizeMask(
+  const std::vector<double> & vx, const std::vector<double> & vy, const double margin) const
+{
+  const double sq_margin = margin * margin;
+  const int min_x = static_cast<int>(std::floor(*std::min_element(vx.begin(), vx.end()) - margin));
+  const int max_x = static_cast<int>(std::ceil(*std::max_element(vx.begin(), vx.end()) + margin));
+  const int min_y = static_cast<int>(std::floor(*std::min_element(vy.begin(), vy.end()) - margin));
+  const int max_y = static_cast<int>(std::ceil(*std::max_element(vy.begin(), vy.end()) + margin));
+  const int width = max_x - min_x + 1;
+  std::vector<bool> covered(static_cast<size_t>(width) * (max_y - min_y + 1), false);
+
+  FootprintMask mask;
+  mask.min_x = mask.min_y = std::numeric_limits<int>::max();
+  mask.max_x = mask.max_y = std::numeric_limits<int>::lowest();
+  for (size_t i = 0; i < vx.size(); ++i) {
+    const size_t j = (i + 1) % vx.size();
+    const int x0 = static_cast<int>(std::floor(std::min(vx[i], vx[j]) - margin));
+    const int x1 = static_cast<int>(std::ceil(std::max(vx[i], vx[j]) + margin));
+    const int y0 = static_cast<int>(std::floor(std::min(vy[i], vy[j]) - margin));
+    const int y1 = static_cast<int>(std::ceil(std::max(vy[i], vy[j]) + margin));
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        const size_t index = static_cast<size_t>(y - min_y) * width + (x - min_x);
+        if (covered[index] ||
+          squaredDistanceToSegment(x, y, vx[i], vy[i], vx[j], vy[j]) > sq_margin)
+        {
+          continue;
+        }
+        covered[index] = true;
+        mask.offsets.push_back(y * static_cast<int>(size_x_) + x);
+        mask.min_x = std::min(mask.min_x, x);
+        mask.max_x = std::max(mask.max_x, x);
+        mask.min_y = std::min(mask.min_y, y);
+        mask.max_y = std::max(mask.max_y, y);
+      }
+    }
+  }
+
+  // Walk the costmap in memory order when applying the mask
+  std::sort(mask.offsets.begin(), mask.offsets.end());
+  return mask;
+}
+
+void PathValidator::updateMasks(
+  const nav2_costmap_2d::Costmap2D & costmap, const nav2_costmap_2d::Footprint & footprint)
+{
+  if (!masks_.empty() && footprint == footprint_ &&
+    costmap.getSizeInCellsX() == size_x_ && costmap.getSizeInCellsY() == size_y_ &&
+    costmap.getResolution() == resolution_ &&
+    costmap.getOriginX() == origin_x_ && costmap.getOriginY() == origin_y_)
+  {
+    return;
+  }
+
+  footprint_ = footprint;
+  size_x_ = costmap.getSizeInCellsX();
+  size_y_ = costmap.getSizeInCellsY();
+  resolution_ = costmap.getResolution();
+  origin_x_ = costmap.getOriginX();
+  origin_y_ = costmap.getOriginY();
+  pose_checks_.clear();
+
+  const double bin_size = 2.0 * M_PI / orientation_bins_;
+  double radius = 0.0;
+  for (const auto & point : footprint_) {
+    radius = std::max(radius, std::hypot(point.x, point.y) / resolution_);
+  }
+
+  // FootprintCollisionChecker rasterizes the outline between the cells of the footprint
+  // vertices, so the cells it checks have their center within half a cell of the segments
+  // between the centers of the vertex cells. Those are within half a cell diagonal of the
+  // vertices, which are themselves within half a cell diagonal and half an orientation bin
+  // of the vertices of the mask, as the pose is within its cell and orientation bin.
+  const double margin = 0.5 + std::sqrt(2.0) + radius * bin_size / 2.0 + 1e-6;
+
+  // The subsampling masks also cover the poses up to subsample_distance_ cells away from
+  // the pose cell, in the neighboring orientation bins
+  subsample_distance_ = std::max(1.0, std::floor(SUBSAMPLING_RATIO * radius));
+  const double subsample_margin = margin + subsample_distance_ + radius * bin_size;
+
+  masks_.resize(orientation_bins_);
+  subsample_masks_.resize(orientation_bins_);
+  std::vector<double> vx(footprint_.size()), vy(footprint_.size());
+  for (unsigned int bin = 0; bin < orientation_bins_; ++bin) {
+    // Footprint vertices in cells, relative to the center of the pose cell
+    const double cos_th = std::cos(bin * bin_size);
+    const double sin_th = std::sin(bin * bin_size);
+    for (size_t i = 0; i < footprint_.size(); ++i) {
+      vx[i] = (footprint_[i].x * cos_th - footprint_[i].y * sin_th) / resolution_;
+      vy[i] = (footprint_[i].x * sin_th + footprint_[i].y * cos_th) / resolution_;
+    }
+    masks_[bin] = rasterizeMask(vx, vy, margin);
+    subsample_masks_[bin] = rasterizeMask(vx, vy, subsample_margin);
+  }
+}
+
+void PathValidator::invalidateChangedPoses(nav2_costmap_2d::LayeredCostmap & layered_costmap)
+{
+  unsigned int x0, xn, y0, yn;
+  if (!layered_costmap.getChangedBoundsSince(change_count_, x0, xn, y0, yn)) {
+    pose_checks_.clear();
+  } else if (x0 < xn && y0 < yn) {
+    for (auto & check : pose_checks_) {
+      if (!check.checked || check.key == NO_KEY) {
+        continue;
+      }
+      const FootprintMask & mask = masks_[check.key % orientation_bins_];
+      const uint64_t index = check.key / orientation_bins_;
+      const int mx = static_cast<int>(index % size_x_);
+      const int my = static_cast<int>(index / size_x_);
+      if (mx + mask.min_x < static_cast<int>(xn) && mx + mask.max_x >= static_cast<int>(x0) &&
+        my + mask.min_y < static_cast<int>(yn) && my + mask.max_y >= static_cast<int>(y0))
+      {
+        check.checked = false;
+      }
+    }
+  }
+  change_count_ = layered_costmap.getChangeCount();
+}
+
+uint64_t PathValidator::getKey(
+  const nav2_costmap_2d::Costmap2D & costmap, const geometry_msgs::msg::Pose & pose,
+  double & theta) const
+{
+  theta = tf2::getYaw(pose.orientation);
+  unsigned int mx, my;
+  if (!costmap.worldToMap(pose.position.x, pose.position.y, mx, my)) {
+    return NO_KEY;
+  }
+  const double bin_size = 2.0 * M_PI / orientation_bins_;
+  int bin = static_cast<int>(std::lround(theta / bin_size)) % static_cast<int>(orientation_bins_);
+  if (bin < 0) {
+    bin += orientation_bins_;
+  }
+  return (static_cast<uint64_t>(my) * size_x_ + mx) * orientation_bins_ + bin;
+}
+
+unsigned char PathValidator::getMaskCost(
+  const FootprintMask & mask, const uint64_t key, const unsigned char * costs) const
+{
+  const uint64_t index = key / orientation_bins_;
+  const int x = static_cast<int>(index % size_x_);
+  const int y = static_cast<int>(index / size_x_);
+  if (x + mask.min_x < 0 || x + mask.max_x >= static_cast<int>(size_x_) ||
+    y + mask.min_y < 0 || y + mask.max_y >= static_cast<int>(size_y_))
+  {
+    return nav2_costmap_2d::NO_INFORMATION;
+  }
+
+  const unsigned char * center = costs + index;
+  unsigned char cost = nav2_costmap_2d::FREE_SPACE;
+  for (const int offset : mask.offsets) {
+    cost = std::max(cost, center[offset]);
+    if (cost == nav2_costmap_2d::NO_INFORMATION) {
+      break;
+    }
+  }
+  return cost;
+}
+
+bool PathValidator::isPathValid(
+  const nav_msgs::msg::Path & path, const unsigned int start_index,
+  nav2_costmap_2d::LayeredCostmap & layered_costmap,
+  const nav2_costmap_2d::Footprint & footprint, const bool use_radius,
+  const unsigned char max_cost, const bool consider_unknown_as_obstacle)
+{
+  nav2_costmap_2d::Costmap2D * costmap = layered_costmap.getCostmap();
+
+  if (use_radius || footprint.empty()) {
+    unsigned int mx, my;
+    for (unsigned int i = start_index; i < path.poses.size(); ++i) {
+      const auto & position = path.poses[i].pose.position;
+      unsigned int cost = nav2_costmap_2d::LETHAL_OBSTACLE;
+      if (costmap->worldToMap(position.x, position.y, mx, my)) {
+        cost = costmap->getCost(mx, my);
+      }
+      if (isInCollision(cost, use_radius, max_cost, consider_unknown_as_obstacle)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  collision_checker_.setCostmap(costmap);
+  updateMasks(*costmap, footprint);
+  invalidateChangedPoses(layered_costmap);
+  if (pose_checks_.size() < path.poses.size()) {
+    pose_checks_.resize(path.poses.size(), PoseCheck{NO_KEY, 0, false});
+  }
+
+  // Mask costs bound the footprint cost from above, a pose is collision free if its
+  // mask cost is, otherwise its footprint cost is computed exactly
+  auto may_collide = [&](const unsigned char cost) {
+      return cost == nav2_costmap_2d::NO_INFORMATION ||
+             isInCollision(cost, false, max_cost, consider_unknown_as_obstacle);
+    };
+
+  const unsigned char * costs = costmap->getCharMap();
+  double theta;
+  for (unsigned int i = start_index; i < path.poses.size(); ++i) {
+    const auto & pose = path.poses[i].pose;
+    const uint64_t key = getKey(*costmap, pose, theta);
+
+    PoseCheck & check = pose_checks_[i];
+    if (key == NO_KEY) {
+      check = PoseCheck{NO_KEY, nav2_costmap_2d::NO_INFORMATION, true};
+    } else if (!check.checked || check.key != key) {
+      check = PoseCheck{key, nav2_costmap_2d::NO_INFORMATION, true};
+      if (i > start_index && pose_checks_[i - 1].key == key) {
+        // Consecutive poses in the same cell and orientation bin share their mask
+        check.cost = pose_checks_[i - 1].cost;
+      } else {
+        // Try to clear the next poses near this one at once with its subsampling mask
+        const unsigned char subsample_cost =
+          getMaskCost(subsample_masks_[key % orientation_bins_], key, costs);
+        if (!may_collide(subsample_cost)) {
+          check.cost = subsample_cost;
+          coverSubsampledPoses(*costmap, path, i, subsample_cost);
+        } else {
+          check.cost = getMaskCost(masks_[key % orientation_bins_], key, costs);
+        }
+      }
+    }
+
+    if (!may_collide(check.cost)) {
+      continue;
+    }
+    const unsigned int cost = static_cast<unsigned int>(collision_checker_.footprintCostAtPose(
+        pose.position.x, pose.position.y, theta, footprint));
+    if (isInCollision(cost, false, max_cost, consider_unknown_as_obstacle)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void PathValidator::coverSubsampledPoses(
+  const nav2_costmap_2d::Costmap2D & costmap, const nav_msgs::msg::Path & path,
+  const unsigned int index, const unsigned char cost)
+{
+  const uint64_t key = pose_checks_[index].key;
+  const uint64_t cell = key / orientation_bins_;
+  const int mx = static_cast<int>(cell % size_x_);
+  const int my = static_cast<int>(cell / size_x_);
+  const int bin = static_cast<int>(key % orientation_bins_);
+  const double sq_distance = subsample_distance_ * subsample_distance_;
+
+  double theta;
+  for (unsigned int i = index + 1; i < path.poses.size(); ++i) {
+    const uint64_t next_key = getKey(costmap, path.poses[i].pose, theta);
+    if (next_key == NO_KEY) {
+      return;
+    }
+    const uint64_t next_cell = next_key / orientation_bins_;
+    const int dx = static_cast<int>(next_cell % size_x_) - mx;
+    const int dy = static_cast<int>(next_cell / size_x_) - my;
+    const int bins = static_cast<int>(orientation_bins_);
+    const int dbin = std::abs(static_cast<int>(next_key % orientation_bins_) - bin);
+    if (dx * dx + dy * dy > sq_distance || std::min(dbin, bins - dbin) > 1) {
+      return;
+    }
+    PoseCheck & check = pose_checks_[i];
+    if (!check.checked || check.key != next_key) {
+      check = PoseCheck{next_key, cost, true};
+    }
+  }
+}
+
+}  // namespace nav2_planner
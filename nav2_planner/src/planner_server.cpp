@@ -13,8 +13,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -27,7 +31,6 @@
 #include "lifecycle_msgs/msg/state.hpp"
 #include "nav2_util/costmap.hpp"
 #include "nav2_ros_common/node_utils.hpp"
-#include "nav2_util/geometry_utils.hpp"
 #include "nav2_costmap_2d/cost_values.hpp"
 
 #include "nav2_planner/planner_server.hpp"
@@ -44,6 +47,7 @@ PlannerServer::PlannerServer(const rclcpp::NodeOptions & options)
   gp_loader_("nav2_core", "nav2_core::GlobalPlanner"),
   default_ids_{"GridBased"},
   default_types_{"nav2_navfn_planner::NavfnPlanner"},
+  planner_threads_(1),
   costmap_update_timeout_(1s),
   costmap_(nullptr)
 {
@@ -53,6 +57,7 @@ PlannerServer::PlannerServer(const rclcpp::NodeOptions & options)
   declare_parameter("planner_plugins", default_ids_);
   declare_parameter("expected_planner_frequency", 1.0);
   declare_parameter("costmap_update_timeout", 1.0);
+  declare_parameter("planner_threads", 1);
 
   get_parameter("planner_plugins", planner_ids_);
   if (planner_ids_ == default_ids_) {
@@ -73,6 +78,8 @@ PlannerServer::~PlannerServer()
    * Backstop ensuring this state is destroyed, even if deactivate/cleanup are
    * never called.
    */
+  compute_paths_thread_.reset();
+  planner_pool_.clear();
   planners_.clear();
   costmap_thread_.reset();
 }
@@ -85,12 +92,6 @@ PlannerServer::on_configure(const rclcpp_lifecycle::State & state)
   costmap_ros_->configure();
   costmap_ = costmap_ros_->getCostmap();
 
-  if (!costmap_ros_->getUseRadius()) {
-    collision_checker_ =
-      std::make_unique<nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *>>(
-      costmap_);
-  }
-
   // Launch a thread to run the costmap node
   costmap_thread_ = std::make_unique<nav2::NodeThread>(costmap_ros_);
 
@@ -124,6 +125,28 @@ PlannerServer::on_configure(const rclcpp_lifecycle::State & state)
     }
   }
 
+  // Create additional instances of the planners, each holding its own search state, to plan
+  // independent legs or requests concurrently
+  get_parameter("planner_threads", planner_threads_);
+  for (int thread = 1; thread < planner_threads_; thread++) {
+    PlannerMap planners;
+    try {
+      for (size_t i = 0; i != planner_ids_.size(); i++) {
+        nav2_core::GlobalPlanner::Ptr planner =
+          gp_loader_.createUniqueInstance(planner_types_[i]);
+        planner->configure(node, planner_ids_[i], tf_, costmap_ros_);
+        planners.insert({planner_ids_[i], planner});
+      }
+    } catch (const std::exception & ex) {
+      RCLCPP_FATAL(
+        get_logger(), "Failed to create additional global planner instances. Exception: %s",
+        ex.what());
+      on_cleanup(state);
+      return nav2::CallbackReturn::FAILURE;
+    }
+    planner_pool_.push_back(std::move(planners));
+  }
+
   for (size_t i = 0; i != planner_ids_.size(); i++) {
     planner_ids_concat_ += planner_ids_[i] + std::string(" ");
   }
@@ -166,6 +189,13 @@ PlannerServer::on_configure(const rclcpp_lifecycle::State & state)
     std::chrono::milliseconds(500),
     true);
 
+  // Batches of paths are computed on their own thread, not to block the other services
+  compute_paths_callback_group_ = create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  auto executor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  executor->add_callback_group(compute_paths_callback_group_, get_node_base_interface());
+  compute_paths_thread_ = std::make_unique<nav2::NodeThread>(executor);
+
   return nav2::CallbackReturn::SUCCESS;
 }
 
@@ -186,12 +216,23 @@ PlannerServer::on_activate(const rclcpp_lifecycle::State & /*state*/)
   for (it = planners_.begin(); it != planners_.end(); ++it) {
     it->second->activate();
   }
+  for (auto & planners : planner_pool_) {
+    for (it = planners.begin(); it != planners.end(); ++it) {
+      it->second->activate();
+    }
+  }
 
   is_path_valid_service_ = create_service<nav2_msgs::srv::IsPathValid>(
     "is_path_valid",
     std::bind(&PlannerServer::isPathValid, this, std::placeholders::_1, std::placeholders::_2,
       std::placeholders::_3));
 
+  compute_paths_service_ = create_service<nav2_msgs::srv::ComputePaths>(
+    "compute_paths",
+    std::bind(&PlannerServer::computePaths, this, std::placeholders::_1, std::placeholders::_2,
+      std::placeholders::_3),
+    compute_paths_callback_group_);
+
   // Add callback for dynamic parameters
   dyn_params_handler_ = add_on_set_parameters_callback(
     std::bind(&PlannerServer::dynamicParametersCallback, this, _1));
@@ -224,6 +265,11 @@ PlannerServer::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
   for (it = planners_.begin(); it != planners_.end(); ++it) {
     it->second->deactivate();
   }
+  for (auto & planners : planner_pool_) {
+    for (it = planners.begin(); it != planners.end(); ++it) {
+      it->second->deactivate();
+    }
+  }
 
   dyn_params_handler_.reset();
 
@@ -239,6 +285,9 @@ PlannerServer::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   RCLCPP_INFO(get_logger(), "Cleaning up");
 
   is_path_valid_service_.reset();
+  compute_paths_thread_.reset();
+  compute_paths_service_.reset();
+  compute_paths_callback_group_.reset();
   action_server_pose_.reset();
   action_server_poses_.reset();
   plan_publisher_.reset();
@@ -250,7 +299,13 @@ PlannerServer::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
   for (it = planners_.begin(); it != planners_.end(); ++it) {
     it->second->cleanup();
   }
+  for (auto & planners : planner_pool_) {
+    for (it = planners.begin(); it != planners.end(); ++it) {
+      it->second->cleanup();
+    }
+  }
 
+  planner_pool_.clear();
   planners_.clear();
   costmap_thread_.reset();
   costmap_ = nullptr;
@@ -401,37 +456,75 @@ void PlannerServer::computePlanThroughPoses()
         return action_server_poses_->is_cancel_requested();
       };
 
-    // Get consecutive paths through these points
-    for (unsigned int i = 0; i != goal->goals.goals.size(); i++) {
-      // Get starting point
-      if (i == 0) {
-        curr_start = start;
-      } else {
-        // pick the end of the last planning task as the start for the next one
-        // to allow for path tolerance deviations
-        curr_start = concat_path.poses.back();
-        curr_start.header = concat_path.header;
+    // Plan the legs concurrently if there are several planner instances, each from the
+    // previous goal. Legs whose previous path does not end at that goal, e.g. within the goal
+    // tolerance of the planner, are planned again from the end of the previous path
+    if (!planner_pool_.empty() && goal->goals.goals.size() > 1) {
+      std::vector<geometry_msgs::msg::PoseStamped> starts, goals;
+      for (unsigned int i = 0; i != goal->goals.goals.size(); i++) {
+        curr_start = i == 0 ? start : goal->goals.goals[i - 1];
+        curr_goal = goal->goals.goals[i];
+        if (!transformPosesToGlobalFrame(curr_start, curr_goal)) {
+          throw nav2_core::PlannerTFError("Unable to transform poses to global frame");
+        }
+        starts.push_back(curr_start);
+        goals.push_back(curr_goal);
       }
-      curr_goal = goal->goals.goals[i];
 
-      // Transform them into the global frame
-      if (!transformPosesToGlobalFrame(curr_start, curr_goal)) {
-        throw nav2_core::PlannerTFError("Unable to transform poses to global frame");
+      auto legs = getPlans(starts, goals, goal->planner_id, cancel_checker, true);
+
+      // Concatenate paths together, reporting the failure of the first leg that failed
+      for (unsigned int i = 0; i != legs.size(); i++) {
+        curr_start = starts[i];
+        curr_goal = goals[i];
+        if (legs[i].exception) {
+          std::rethrow_exception(legs[i].exception);
+        }
+        if (i > 0 && !isSamePose(concat_path.poses.back().pose, curr_start.pose)) {
+          curr_start = concat_path.poses.back();
+          curr_start.header = concat_path.header;
+          legs[i].path = getPlan(curr_start, curr_goal, goal->planner_id, cancel_checker);
+          if (!validatePath<ActionThroughPoses>(curr_goal, legs[i].path, goal->planner_id)) {
+            throw nav2_core::NoValidPathCouldBeFound(goal->planner_id + " generated a empty path");
+          }
+        }
+        concat_path.poses.insert(
+          concat_path.poses.end(), legs[i].path.poses.begin(), legs[i].path.poses.end());
+        concat_path.header = legs[i].path.header;
       }
+    } else {
+      // Get consecutive paths through these points
+      for (unsigned int i = 0; i != goal->goals.goals.size(); i++) {
+        // Get starting point
+        if (i == 0) {
+          curr_start = start;
+        } else {
+          // pick the end of the last planning task as the start for the next one
+          // to allow for path tolerance deviations
+          curr_start = concat_path.poses.back();
+          curr_start.header = concat_path.header;
+        }
+        curr_goal = goal->goals.goals[i];
 
-      // Get plan from start -> goal
-      nav_msgs::msg::Path curr_path = getPlan(
-        curr_start, curr_goal, goal->planner_id,
-        cancel_checker);
+        // Transform them into the global frame
+        if (!transformPosesToGlobalFrame(curr_start, curr_goal)) {
+          throw nav2_core::PlannerTFError("Unable to transform poses to global frame");
+        }
 
-      if (!validatePath<ActionThroughPoses>(curr_goal, curr_path, goal->planner_id)) {
-        throw nav2_core::NoValidPathCouldBeFound(goal->planner_id + " generated a empty path");
-      }
+        // Get plan from start -> goal
+        nav_msgs::msg::Path curr_path = getPlan(
+          curr_start, curr_goal, goal->planner_id,
+          cancel_checker);
+
+        if (!validatePath<ActionThroughPoses>(curr_goal, curr_path, goal->planner_id)) {
+          throw nav2_core::NoValidPathCouldBeFound(goal->planner_id + " generated a empty path");
+        }
 
-      // Concatenate paths together
-      concat_path.poses.insert(
-        concat_path.poses.end(), curr_path.poses.begin(), curr_path.poses.end());
-      concat_path.header = curr_path.header;
+        // Concatenate paths together
+        concat_path.poses.insert(
+          concat_path.poses.end(), curr_path.poses.begin(), curr_path.poses.end());
+        concat_path.header = curr_path.header;
+      }
     }
 
     // Publish the plan for visualization purposes
@@ -604,21 +697,32 @@ PlannerServer::getPlan(
   const geometry_msgs::msg::PoseStamped & goal,
   const std::string & planner_id,
   std::function<bool()> cancel_checker)
+{
+  return getPlan(start, goal, planner_id, cancel_checker, planners_);
+}
+
+nav_msgs::msg::Path
+PlannerServer::getPlan(
+  const geometry_msgs::msg::PoseStamped & start,
+  const geometry_msgs::msg::PoseStamped & goal,
+  const std::string & planner_id,
+  std::function<bool()> cancel_checker,
+  PlannerMap & planners)
 {
   RCLCPP_DEBUG(
     get_logger(), "Attempting to a find path from (%.2f, %.2f) to "
     "(%.2f, %.2f).", start.pose.position.x, start.pose.position.y,
     goal.pose.position.x, goal.pose.position.y);
 
-  if (planners_.find(planner_id) != planners_.end()) {
-    return planners_[planner_id]->createPlan(start, goal, cancel_checker);
+  if (planners.find(planner_id) != planners.end()) {
+    return planners[planner_id]->createPlan(start, goal, cancel_checker);
   } else {
-    if (planners_.size() == 1 && planner_id.empty()) {
+    if (planners.size() == 1 && planner_id.empty()) {
       RCLCPP_WARN_ONCE(
         get_logger(), "No planners specified in action call. "
         "Server will use only plugin %s in server."
         " This warning will appear once.", planner_ids_concat_.c_str());
-      return planners_[planners_.begin()->first]->createPlan(start, goal, cancel_checker);
+      return planners.begin()->second->createPlan(start, goal, cancel_checker);
     } else {
       RCLCPP_ERROR(
         get_logger(), "planner %s is not a valid planner. "
@@ -631,6 +735,114 @@ PlannerServer::getPlan(
   return nav_msgs::msg::Path();
 }
 
+std::vector<PlannerServer::PlanResult>
+PlannerServer::getPlans(
+  const std::vector<geometry_msgs::msg::PoseStamped> & starts,
+  const std::vector<geometry_msgs::msg::PoseStamped> & goals,
+  const std::string & planner_id,
+  std::function<bool()> cancel_checker,
+  bool stop_on_failure)
+{
+  const size_t num_pairs = std::min(starts.size(), goals.size());
+  std::vector<PlannerMap *> planner_sets = acquirePoolPlanners(num_pairs > 0 ? num_pairs - 1 : 0);
+  planner_sets.insert(planner_sets.begin(), &planners_);
+  auto results = getPlans(planner_sets, starts, goals, planner_id, cancel_checker, stop_on_failure);
+  planner_sets.erase(planner_sets.begin());
+  releasePoolPlanners(planner_sets);
+  return results;
+}
+
+std::vector<PlannerServer::PlanResult>
+PlannerServer::getPlans(
+  const std::vector<PlannerMap *> & planner_sets,
+  const std::vector<geometry_msgs::msg::PoseStamped> & starts,
+  const std::vector<geometry_msgs::msg::PoseStamped> & goals,
+  const std::string & planner_id,
+  std::function<bool()> cancel_checker,
+  bool stop_on_failure)
+{
+  std::vector<PlanResult> results(std::min(starts.size(), goals.size()));
+  std::atomic<size_t> next_pair{0};
+  std::atomic<bool> failed{false};
+
+  // Each worker plans with its own planner instances, taking the next pair until none is left
+  auto worker = [&](PlannerMap & planners) {
+      for (size_t i = next_pair++; i < results.size(); i = next_pair++) {
+        if (stop_on_failure && failed) {
+          return;
+        }
+        try {
+          if (cancel_checker()) {
+            throw nav2_core::PlannerCancelled("Planning was canceled");
+          }
+          results[i].path = getPlan(starts[i], goals[i], planner_id, cancel_checker, planners);
+          if (!validatePath<ActionToPose>(goals[i], results[i].path, planner_id)) {
+            throw nav2_core::NoValidPathCouldBeFound(planner_id + " generated a empty path");
+          }
+        } catch (...) {
+          results[i].exception = std::current_exception();
+          failed = true;
+        }
+      }
+    };
+
+  if (planner_sets.empty()) {
+    return results;
+  }
+
+  const size_t num_workers = std::min(planner_sets.size(), results.size());
+  std::vector<std::future<void>> workers;
+  for (size_t i = 1; i < num_workers; i++) {
+    workers.push_back(std::async(std::launch::async, worker, std::ref(*planner_sets[i])));
+  }
+  worker(*planner_sets.front());
+  for (auto & pool_worker : workers) {
+    pool_worker.wait();
+  }
+
+  return results;
+}
+
+bool
+PlannerServer::isSamePose(
+  const geometry_msgs::msg::Pose & pose_a,
+  const geometry_msgs::msg::Pose & pose_b)
+{
+  // Quaternions q and -q are the same orientation
+  const double orientation_dot =
+    pose_a.orientation.x * pose_b.orientation.x + pose_a.orientation.y * pose_b.orientation.y +
+    pose_a.orientation.z * pose_b.orientation.z + pose_a.orientation.w * pose_b.orientation.w;
+  const double distance = std::hypot(
+    pose_a.position.x - pose_b.position.x, pose_a.position.y - pose_b.position.y,
+    pose_a.position.z - pose_b.position.z);
+  return distance < 1e-3 && std::abs(orientation_dot) > 1.0 - 1e-6;
+}
+
+std::vector<PlannerServer::PlannerMap *>
+PlannerServer::acquirePoolPlanners(size_t max_instances)
+{
+  std::lock_guard<std::mutex> lock(planner_pool_lock_);
+  std::vector<PlannerMap *> planner_sets;
+  for (auto & planners : planner_pool_) {
+    if (planner_sets.size() == max_instances) {
+      break;
+    }
+    if (busy_pool_planners_.insert(&planners).second) {
+      planner_sets.push_back(&planners);
+    }
+  }
+  return planner_sets;
+}
+
+void
+PlannerServer::releasePoolPlanners(const std::vector<PlannerMap *> & planner_sets)
+{
+  std::lock_guard<std::mutex> lock(planner_pool_lock_);
+  for (const auto planners : planner_sets) {
+    busy_pool_planners_.erase(planners);
+  }
+}
+
 void
 PlannerServer::publishPlan(const nav_msgs::msg::Path & path)
 {
@@ -655,19 +867,17 @@ void PlannerServer::isPathValid(
   geometry_msgs::msg::PoseStamped current_pose;
   unsigned int closest_point_index = 0;
   if (costmap_ros_->getRobotPose(current_pose)) {
-    float current_distance = std::numeric_limits<float>::max();
-    float closest_distance = current_distance;
-    geometry_msgs::msg::Point current_point = current_pose.pose.position;
+    // Squared distances preserve the order of the distances
+    double closest_sq_distance = std::numeric_limits<double>::max();
+    const geometry_msgs::msg::Point & current_point = current_pose.pose.position;
     for (unsigned int i = 0; i < request->path.poses.size(); ++i) {
-      geometry_msgs::msg::Point path_point = request->path.poses[i].pose.position;
-
-      current_distance = nav2_util::geometry_utils::euclidean_distance(
-        current_point,
-        path_point);
-
-      if (current_distance < closest_distance) {
+      const geometry_msgs::msg::Point & path_point = request->path.poses[i].pose.position;
+      const double dx = path_point.x - current_point.x;
+      const double dy = path_point.y - current_point.y;
+      const double sq_distance = dx * dx + dy * dy;
+      if (sq_distance < closest_sq_distance) {
         closest_point_index = i;
-        closest_distance = current_distance;
+        closest_sq_distance = sq_distance;
       }
     }
 
@@ -676,46 +886,137 @@ void PlannerServer::isPathValid(
      * and may have become occupied. The method for collision detection is based on the shape of
      * the footprint.
      */
+    const nav2_costmap_2d::Footprint footprint = costmap_ros_->getRobotFootprint();
     std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
-    unsigned int mx = 0;
-    unsigned int my = 0;
+    response->is_valid = path_validator_.isPathValid(
+      request->path, closest_point_index, *costmap_ros_->getLayeredCostmap(), footprint,
+      costmap_ros_->getUseRadius(), request->max_cost, request->consider_unknown_as_obstacle);
+  }
+}
 
-    bool use_radius = costmap_ros_->getUseRadius();
+void PlannerServer::computePaths(
+  const std::shared_ptr<rmw_request_id_t>/*request_header*/,
+  const std::shared_ptr<nav2_msgs::srv::ComputePaths::Request> request,
+  std::shared_ptr<nav2_msgs::srv::ComputePaths::Response> response)
+{
+  auto start_time = this->now();
+  const size_t num_pairs = request->goals.size();
+  response->paths.resize(num_pairs);
+  response->error_codes.resize(num_pairs, ActionToPoseResult::NONE);
+  response->error_msgs.resize(num_pairs);
 
-    unsigned int cost = nav2_costmap_2d::FREE_SPACE;
-    for (unsigned int i = closest_point_index; i < request->path.poses.size(); ++i) {
-      auto & position = request->path.poses[i].pose.position;
-      if (use_radius) {
-        if (costmap_->worldToMap(position.x, position.y, mx, my)) {
-          cost = costmap_->getCost(mx, my);
-        } else {
-          cost = nav2_costmap_2d::LETHAL_OBSTACLE;
-        }
-      } else {
-        nav2_costmap_2d::Footprint footprint = costmap_ros_->getRobotFootprint();
-        auto theta = tf2::getYaw(request->path.poses[i].pose.orientation);
-        cost = static_cast<unsigned int>(collision_checker_->footprintCostAtPose(
-            position.x, position.y, theta, footprint));
-      }
+  if (request->starts.size() != num_pairs) {
+    RCLCPP_WARN(
+      get_logger(), "Got %zu starts for %zu goals, unable to compute paths.",
+      request->starts.size(), num_pairs);
+    std::fill(
+      response->error_codes.begin(), response->error_codes.end(), ActionToPoseResult::UNKNOWN);
+    std::fill(
+      response->error_msgs.begin(), response->error_msgs.end(),
+      "Number of starts and goals differ");
+    return;
+  }
 
-      if (cost == nav2_costmap_2d::NO_INFORMATION && request->consider_unknown_as_obstacle) {
-        cost = nav2_costmap_2d::LETHAL_OBSTACLE;
-      } else if (cost == nav2_costmap_2d::NO_INFORMATION) {
-        cost = nav2_costmap_2d::FREE_SPACE;
-      }
+  RCLCPP_INFO(get_logger(), "Computing paths for %zu pairs of poses.", num_pairs);
+
+  try {
+    waitForCostmap();
+  } catch (nav2_core::PlannerTimedOut & ex) {
+    RCLCPP_WARN(get_logger(), "%s", ex.what());
+    std::fill(
+      response->error_codes.begin(), response->error_codes.end(), ActionToPoseResult::TIMEOUT);
+    std::fill(response->error_msgs.begin(), response->error_msgs.end(), ex.what());
+    return;
+  }
+
+  // Transform the poses into the global frame, only planning the pairs which could be
+  std::vector<size_t> pairs;
+  std::vector<geometry_msgs::msg::PoseStamped> starts, goals;
+  for (size_t i = 0; i != num_pairs; i++) {
+    geometry_msgs::msg::PoseStamped start = request->starts[i];
+    geometry_msgs::msg::PoseStamped goal = request->goals[i];
+    if (!transformPosesToGlobalFrame(start, goal)) {
+      exceptionWarning(
+        start, goal, request->planner_id,
+        nav2_core::PlannerTFError("Unable to transform poses to global frame"),
+        response->error_msgs[i]);
+      response->error_codes[i] = ActionToPoseResult::TF_ERROR;
+      continue;
+    }
+    pairs.push_back(i);
+    starts.push_back(start);
+    goals.push_back(goal);
+  }
 
-      if (use_radius &&
-        (cost >= request->max_cost || cost == nav2_costmap_2d::LETHAL_OBSTACLE ||
-        cost == nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE))
-      {
-        response->is_valid = false;
-        break;
-      } else if (cost == nav2_costmap_2d::LETHAL_OBSTACLE || cost >= request->max_cost) {
-        response->is_valid = false;
-        break;
+  // Give up on the pairs not planned within the planning time of the batch
+  const rclcpp::Duration max_planning_time(request->max_planning_time);
+  const auto deadline = std::chrono::steady_clock::now() +
+    max_planning_time.to_chrono<std::chrono::nanoseconds>();
+  auto cancel_checker = [&]() {
+      return !rclcpp::ok() ||
+             (max_planning_time.nanoseconds() > 0 && std::chrono::steady_clock::now() > deadline);
+    };
+
+  // Plan on the pool instances not in use by another request, so that the batch does not
+  // block the planning actions. Without any, share the main instances with the actions,
+  // only owning them while planning each pair
+  std::vector<PlanResult> results;
+  auto planner_sets = acquirePoolPlanners(starts.size());
+  if (!planner_sets.empty()) {
+    results = getPlans(planner_sets, starts, goals, request->planner_id, cancel_checker);
+    releasePoolPlanners(planner_sets);
+  } else {
+    for (size_t j = 0; j != starts.size(); j++) {
+      std::lock_guard<std::mutex> lock(dynamic_params_lock_);
+      auto result = getPlans(
+        {&planners_}, {starts[j]}, {goals[j]}, request->planner_id, cancel_checker);
+      results.push_back(std::move(result.front()));
+    }
+  }
+
+  for (size_t j = 0; j != results.size(); j++) {
+    const size_t i = pairs[j];
+    if (!results[j].exception) {
+      response->paths[i] = std::move(results[j].path);
+      continue;
+    }
+    try {
+      std::rethrow_exception(results[j].exception);
+    } catch (const std::exception & ex) {
+      exceptionWarning(starts[j], goals[j], request->planner_id, ex, response->error_msgs[i]);
+      response->error_codes[i] = getErrorCode(ex);
+      if (dynamic_cast<const nav2_core::PlannerCancelled *>(&ex)) {
+        response->error_codes[i] = ActionToPoseResult::TIMEOUT;
+        response->error_msgs[i] = "Exceeded the planning time of the batch";
       }
+    } catch (...) {
+      response->error_codes[i] = ActionToPoseResult::UNKNOWN;
     }
   }
+
+  response->planning_time = this->now() - start_time;
+}
+
+uint16_t PlannerServer::getErrorCode(const std::exception & ex)
+{
+  if (dynamic_cast<const nav2_core::InvalidPlanner *>(&ex)) {
+    return ActionToPoseResult::INVALID_PLANNER;
+  } else if (dynamic_cast<const nav2_core::StartOccupied *>(&ex)) {
+    return ActionToPoseResult::START_OCCUPIED;
+  } else if (dynamic_cast<const nav2_core::GoalOccupied *>(&ex)) {
+    return ActionToPoseResult::GOAL_OCCUPIED;
+  } else if (dynamic_cast<const nav2_core::NoValidPathCouldBeFound *>(&ex)) {
+    return ActionToPoseResult::NO_VALID_PATH;
+  } else if (dynamic_cast<const nav2_core::PlannerTimedOut *>(&ex)) {
+    return ActionToPoseResult::TIMEOUT;
+  } else if (dynamic_cast<const nav2_core::StartOutsideMapBounds *>(&ex)) {
+    return ActionToPoseResult::START_OUTSIDE_MAP;
+  } else if (dynamic_cast<const nav2_core::GoalOutsideMapBounds *>(&ex)) {
+    return ActionToPoseResult::GOAL_OUTSIDE_MAP;
+  } else if (dynamic_cast<const nav2_core::PlannerTFError *>(&ex)) {
+    return ActionToPoseResult::TF_ERROR;
+  }
+  return ActionToPoseResult::UNKNOWN;
 }
 
 rcl_interfaces::msg::SetParametersResult
@@ -0,0 +1,279 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_core/global_planner.hpp"
+#include "nav2_core/planner_exceptions.hpp"
+#include "nav2_planner/planner_server.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;  // NOLINT
+
+// Returns the start and goal as a path after a delay, failing for goals with a negative x
+class FakePlanner : public nav2_core::GlobalPlanner
+{
+public:
+  explicit FakePlanner(std::atomic<int> & num_planning, std::atomic<int> & max_num_planning)
+  : num_planning_(num_planning), max_num_planning_(max_num_planning)
+  {
+  }
+
+  void configure(
+    const nav2::LifecycleNode::WeakPtr &, std::string, std::shared_ptr<tf2_ros::Buffer>,
+    std::shared_ptr<nav2_costmap_2d::Costmap2DROS>) override {}
+  void cleanup() override {}
+  void activate() override {}
+  void deactivate() override {}
+
+  nav_msgs::msg::Path createPlan(
+    const geometry_msgs::msg::PoseStamped & start,
+    const geometry_msgs::msg::PoseStamped & goal,
+    std::function<bool()>) override
+  {
+    // Each instance only plans one path at a time
+    EXPECT_FALSE(busy_.exchange(true));
+    const int num_planning = ++num_planning_;
+    int max_num_planning = max_num_planning_;
+    while (num_planning > max_num_planning &&
+      !max_num_planning_.compare_exchange_weak(max_num_planning, num_planning))
+    {
+    }
+    std::this_thread::sleep_for(20ms);
+    --num_planning_;
+    busy_ = false;
+
+    if (goal.pose.position.x < 0.0) {
+      throw nav2_core::GoalOccupied("Goal occupied");
+    }
+    nav_msgs::msg::Path path;
+    path.poses = {start, goal};
+    return path;
+  }
+
+protected:
+  std::atomic<int> & num_planning_;
+  std::atomic<int> & max_num_planning_;
+  std::atomic<bool> busy_{false};
+};
+
+class PlannerShim : public nav2_planner::PlannerServer
+{
+public:
+  PlannerShim()
+  : nav2_planner::PlannerServer(rclcpp::NodeOptions())
+  {
+  }
+
+  // Since we cannot call configure/activate due to costmaps
+  // requiring TF
+  void setPlanners(unsigned int num_instances)
+  {
+    planners_ = PlannerMap{
+      {"Fake", std::make_shared<FakePlanner>(num_planning, max_num_planning)}};
+    for (unsigned int i = 1; i < num_instances; ++i) {
+      planner_pool_.push_back(
+        PlannerMap{{"Fake", std::make_shared<FakePlanner>(num_planning, max_num_planning)}});
+    }
+  }
+
+  using nav2_planner::PlannerServer::getErrorCode;
+  using nav2_planner::PlannerServer::getPlans;
+  using nav2_planner::PlannerServer::acquirePoolPlanners;
+  using nav2_planner::PlannerServer::releasePoolPlanners;
+  using nav2_planner::PlannerServer::isSamePose;
+
+  std::atomic<int> num_planning{0};
+  std::atomic<int> max_num_planning{0};
+};
+
+geometry_msgs::msg::PoseStamped makePose(double x)
+{
+  geometry_msgs::msg::PoseStamped pose;
+  pose.pose.position.x = x;
+  return pose;
+}
+
+TEST(ParallelPlanningTest, getPlans)
+{
+  auto planner = std::make_shared<PlannerShim>();
+  planner->setPlanners(4);
+
+  std::vector<geometry_msgs::msg::PoseStamped> starts, goals;
+  for (int i = 0; i < 12; ++i) {
+    starts.push_back(makePose(100.0 + i));
+    goals.push_back(makePose(i == 5 ? -1.0 : i + 1.0));
+  }
+
+  auto results = planner->getPlans(starts, goals, "Fake", []() {return false;});
+  ASSERT_EQ(results.size(), 12u);
+  for (int i = 0; i < 12; ++i) {
+    if (i == 5) {
+      ASSERT_TRUE(results[i].exception);
+      EXPECT_TRUE(results[i].path.poses.empty());
+      try {
+        std::rethrow_exception(results[i].exception);
+      } catch (const std::exception & ex) {
+        EXPECT_EQ(
+          planner->getErrorCode(ex), nav2_msgs::action::ComputePathToPose::Result::GOAL_OCCUPIED);
+      }
+      continue;
+    }
+    // Results are in the order of the pairs
+    EXPECT_FALSE(results[i].exception);
+    ASSERT_EQ(results[i].path.poses.size(), 2u);
+    EXPECT_EQ(results[i].path.poses[0].pose.position.x, 100.0 + i);
+    EXPECT_EQ(results[i].path.poses[1].pose.position.x, i + 1.0);
+  }
+
+  // The pairs were planned concurrently, up to the number of planner instances
+  EXPECT_GT(planner->max_num_planning, 1);
+  EXPECT_LE(planner->max_num_planning, 4);
+
+  // Unknown planners fail every pair
+  results = planner->getPlans(starts, goals, "Unknown", []() {return false;});
+  for (const auto & result : results) {
+    ASSERT_TRUE(result.exception);
+    EXPECT_THROW(std::rethrow_exception(result.exception), nav2_core::InvalidPlanner);
+  }
+}
+
+TEST(ParallelPlanningTest, getPlansStopOnFailure)
+{
+  auto planner = std::make_shared<PlannerShim>();
+  planner->setPlanners(2);
+
+  // Once the first pair failed, the remaining pairs are not planned
+  std::vector<geometry_msgs::msg::PoseStamped> starts, goals;
+  for (int i = 0; i < 20; ++i) {
+    starts.push_back(makePose(0.0));
+    goals.push_back(makePose(i == 0 ? -1.0 : 1.0));
+  }
+  auto results = planner->getPlans(starts, goals, "Fake", []() {return false;}, true);
+  ASSERT_EQ(results.size(), 20u);
+  EXPECT_TRUE(results[0].exception);
+  EXPECT_TRUE(results.back().path.poses.empty());
+  EXPECT_FALSE(results.back().exception);
+
+  // A single planner instance plans sequentially
+  planner = std::make_shared<PlannerShim>();
+  planner->setPlanners(1);
+  starts.resize(3);
+  goals = {makePose(1.0), makePose(2.0), makePose(3.0)};
+  results = planner->getPlans(starts, goals, "", []() {return false;});
+  for (const auto & result : results) {
+    EXPECT_FALSE(result.exception);
+    EXPECT_EQ(result.path.poses.size(), 2u);
+  }
+  EXPECT_EQ(planner->max_num_planning, 1);
+}
+
+TEST(ParallelPlanningTest, poolPlannersCheckout)
+{
+  auto planner = std::make_shared<PlannerShim>();
+  planner->setPlanners(4);
+
+  // Pool instances are only handed to one request at a time
+  auto first = planner->acquirePoolPlanners(2);
+  EXPECT_EQ(first.size(), 2u);
+  auto second = planner->acquirePoolPlanners(5);
+  ASSERT_EQ(second.size(), 1u);
+  EXPECT_TRUE(planner->acquirePoolPlanners(1).empty());
+  EXPECT_NE(second.front(), first.front());
+  EXPECT_NE(second.front(), first.back());
+
+  // The public API plans on the main instances and the pool instances left
+  std::vector<geometry_msgs::msg::PoseStamped> starts(6), goals(6, makePose(1.0));
+  auto results = planner->getPlans(starts, goals, "Fake", []() {return false;});
+  for (const auto & result : results) {
+    EXPECT_FALSE(result.exception);
+  }
+  EXPECT_EQ(planner->max_num_planning, 1);
+
+  planner->releasePoolPlanners(first);
+  EXPECT_EQ(planner->acquirePoolPlanners(5).size(), 2u);
+  planner->releasePoolPlanners(second);
+  EXPECT_EQ(planner->acquirePoolPlanners(5).size(), 1u);
+}
+
+TEST(ParallelPlanningTest, getPlansCanceled)
+{
+  auto planner = std::make_shared<PlannerShim>();
+  planner->setPlanners(2);
+  auto planner_sets = planner->acquirePoolPlanners(1);
+  ASSERT_EQ(planner_sets.size(), 1u);
+
+  // Once canceled, e.g. past the deadline of a batch, the pairs left fail without planning
+  std::vector<geometry_msgs::msg::PoseStamped> starts(10), goals(10, makePose(1.0));
+  std::atomic<int> num_checks{0};
+  auto results = planner->getPlans(
+    planner_sets, starts, goals, "Fake", [&]() {return ++num_checks > 2;});
+  ASSERT_EQ(results.size(), 10u);
+  int num_canceled = 0;
+  for (const auto & result : results) {
+    if (result.exception) {
+      EXPECT_THROW(std::rethrow_exception(result.exception), nav2_core::PlannerCancelled);
+      ++num_canceled;
+    }
+  }
+  EXPECT_GE(num_canceled, 8);
+
+  // No planner instances, no pair is planned
+  results = planner->getPlans({}, starts, goals, "Fake", []() {return false;});
+  for (const auto & result : results) {
+    EXPECT_FALSE(result.exception);
+    EXPECT_TRUE(result.path.poses.empty());
+  }
+}
+
+TEST(ParallelPlanningTest, isSamePose)
+{
+  // Concurrent legs are kept if the previous path ends at their start
+  geometry_msgs::msg::Pose pose_a = makePose(1.0).pose;
+  geometry_msgs::msg::Pose pose_b = pose_a;
+  pose_a.orientation.w = 1.0;
+  pose_b.orientation.w = -1.0;
+  EXPECT_TRUE(PlannerShim::isSamePose(pose_a, pose_b));
+  pose_b.position.x += 1e-4;
+  EXPECT_TRUE(PlannerShim::isSamePose(pose_a, pose_b));
+
+  // Otherwise, e.g. for a path ending within the goal tolerance, they are planned again
+  pose_b.position.x += 0.05;
+  EXPECT_FALSE(PlannerShim::isSamePose(pose_a, pose_b));
+  pose_b = pose_a;
+  pose_b.orientation.z = std::sin(0.1);
+  pose_b.orientation.w = std::cos(0.1);
+  EXPECT_FALSE(PlannerShim::isSamePose(pose_a, pose_b));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  rclcpp::init(0, nullptr);
+
+  int result = RUN_ALL_TESTS();
+
+  rclcpp::shutdown();
+
+  return result;
+}
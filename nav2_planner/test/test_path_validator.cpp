@@ -0,0 +1,166 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <random>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/footprint_collision_checker.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+#include "nav2_planner/path_validator.hpp"
+#include "tf2/LinearMath/Quaternion.hpp"
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
+
+using nav2_costmap_2d::Footprint;
+
+Footprint makeFootprint()
+{
+  Footprint footprint;
+  for (auto [x, y] : {std::pair{0.4, 0.25}, {-0.3, 0.25}, {-0.3, -0.25}, {0.4, -0.25}}) {
+    geometry_msgs::msg::Point point;
+    point.x = x;
+    point.y = y;
+    footprint.push_back(point);
+  }
+  return footprint;
+}
+
+nav_msgs::msg::Path makePath(std::mt19937 & rng)
+{
+  // A wandering path within the costmap
+  std::uniform_real_distribution<double> turn(-0.2, 0.2);
+  nav_msgs::msg::Path path;
+  double x = 2.0, y = 2.0, yaw = 0.6;
+  for (int i = 0; i < 150; ++i) {
+    geometry_msgs::msg::PoseStamped pose;
+    pose.pose.position.x = x;
+    pose.pose.position.y = y;
+    tf2::Quaternion q;
+    q.setRPY(0.0, 0.0, yaw);
+    pose.pose.orientation = tf2::toMsg(q);
+    path.poses.push_back(pose);
+    yaw += turn(rng);
+    x += 0.03 * std::cos(yaw);
+    y += 0.03 * std::sin(yaw);
+  }
+  return path;
+}
+
+bool referenceIsPathValid(
+  const nav_msgs::msg::Path & path, nav2_costmap_2d::Costmap2D * costmap,
+  const Footprint & footprint, unsigned char max_cost, bool consider_unknown_as_obstacle)
+{
+  nav2_costmap_2d::FootprintCollisionChecker<nav2_costmap_2d::Costmap2D *> checker(costmap);
+  for (const auto & pose : path.poses) {
+    auto cost = static_cast<unsigned int>(checker.footprintCostAtPose(
+        pose.pose.position.x, pose.pose.position.y, tf2::getYaw(pose.pose.orientation),
+        footprint));
+    if (cost == nav2_costmap_2d::NO_INFORMATION) {
+      cost = consider_unknown_as_obstacle ?
+        nav2_costmap_2d::LETHAL_OBSTACLE : nav2_costmap_2d::FREE_SPACE;
+    }
+    if (cost == nav2_costmap_2d::LETHAL_OBSTACLE || cost >= max_cost) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(PathValidatorTest, matchesFootprintCollisionChecker)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", false, false);
+  layered_costmap.resizeMap(100, 100, 0.05, 0.0, 0.0);
+  nav2_costmap_2d::Costmap2D * costmap = layered_costmap.getCostmap();
+  const Footprint footprint = makeFootprint();
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<unsigned int> cell(0, 99);
+  std::uniform_int_distribution<int> value(0, 255);
+  nav2_planner::PathValidator validator;
+  int num_valid = 0;
+  for (int trial = 0; trial < 200; ++trial) {
+    costmap->resetMap(0, 0, 100, 100);
+    for (int i = 0; i < 20; ++i) {
+      costmap->setCost(cell(rng), cell(rng), static_cast<unsigned char>(value(rng)));
+    }
+    layered_costmap.recordChange(0, 100, 0, 100);
+
+    const auto path = makePath(rng);
+    for (unsigned char max_cost : {100, 253}) {
+      for (bool unknown_is_obstacle : {false, true}) {
+        const bool valid = referenceIsPathValid(
+          path, costmap, footprint, max_cost, unknown_is_obstacle);
+        EXPECT_EQ(
+          validator.isPathValid(
+            path, 0, layered_costmap, footprint, false, max_cost, unknown_is_obstacle),
+          valid);
+        num_valid += valid;
+      }
+    }
+  }
+
+  // Both outcomes were exercised
+  EXPECT_GT(num_valid, 0);
+  EXPECT_LT(num_valid, 800);
+}
+
+TEST(PathValidatorTest, incrementalChecks)
+{
+  nav2_costmap_2d::LayeredCostmap layered_costmap("map", false, false);
+  layered_costmap.resizeMap(100, 100, 0.05, 0.0, 0.0);
+  nav2_costmap_2d::Costmap2D * costmap = layered_costmap.getCostmap();
+  const Footprint footprint = makeFootprint();
+
+  nav_msgs::msg::Path path;
+  for (int i = 0; i < 40; ++i) {
+    geometry_msgs::msg::PoseStamped pose;
+    pose.pose.position.x = 1.0 + 0.05 * i;
+    pose.pose.position.y = 2.5;
+    pose.pose.orientation.w = 1.0;
+    path.poses.push_back(pose);
+  }
+
+  nav2_planner::PathValidator validator;
+  EXPECT_TRUE(validator.isPathValid(path, 0, layered_costmap, footprint, false, 253, false));
+
+  // An obstacle on the path outline is found once the change is recorded
+  unsigned int mx, my;
+  ASSERT_TRUE(costmap->worldToMap(2.0, 2.5 + 0.25, mx, my));
+  costmap->setCost(mx, my, nav2_costmap_2d::LETHAL_OBSTACLE);
+  layered_costmap.recordChange(mx, mx + 1, my, my + 1);
+  EXPECT_FALSE(validator.isPathValid(path, 0, layered_costmap, footprint, false, 253, false));
+
+  // Poses past the obstacle are valid
+  EXPECT_TRUE(validator.isPathValid(path, 35, layered_costmap, footprint, false, 253, false));
+
+  // Clearing the obstacle makes the path valid again
+  costmap->setCost(mx, my, nav2_costmap_2d::FREE_SPACE);
+  layered_costmap.recordChange(mx, mx + 1, my, my + 1);
+  EXPECT_TRUE(validator.isPathValid(path, 0, layered_costmap, footprint, false, 253, false));
+
+  // Changes older than the recorded history invalidate all the poses
+  costmap->setCost(mx, my, nav2_costmap_2d::LETHAL_OBSTACLE);
+  for (int i = 0; i < 20; ++i) {
+    layered_costmap.recordChange(0, 1, 0, 1);
+  }
+  EXPECT_FALSE(validator.isPathValid(path, 0, layered_costmap, footprint, false, 253, false));
+
+  // Only the center cell is checked with use_radius
+  EXPECT_TRUE(validator.isPathValid(path, 0, layered_costmap, footprint, true, 253, false));
+  ASSERT_TRUE(costmap->worldToMap(2.0, 2.5, mx, my));
+  costmap->setCost(mx, my, nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE);
+  EXPECT_FALSE(validator.isPathValid(path, 0, layered_costmap, footprint, true, 254, false));
+}
@@ -26,6 +26,7 @@
 #include "nav2_costmap_2d/footprint_collision_checker.hpp"
 #include "nav2_util/odometry_utils.hpp"
 #include "nav2_util/geometry_utils.hpp"
+#include "nav2_util/path_tracker.hpp"
 #include "nav2_core/controller_exceptions.hpp"
 #include "geometry_msgs/msg/pose.hpp"
 
@@ -77,9 +78,9 @@ public:
     const geometry_msgs::msg::PoseStamped & in_pose,
     geometry_msgs::msg::PoseStamped & out_pose) const;
 
-  void setPlan(const nav_msgs::msg::Path & path) {global_plan_ = path;}
+  void setPlan(const nav_msgs::msg::Path & path) {path_tracker_.setPlan(path);}
 
-  nav_msgs::msg::Path getPlan() {return global_plan_;}
+  nav_msgs::msg::Path getPlan() {return path_tracker_.getRemainingPlan();}
 
 protected:
   /**
@@ -92,7 +93,7 @@ protected:
   tf2::Duration transform_tolerance_;
   std::shared_ptr<tf2_ros::Buffer> tf_;
   std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
-  nav_msgs::msg::Path global_plan_;
+  nav2_util::PathTracker path_tracker_;
 };
 
 }  // namespace nav2_regulated_pure_pursuit_controller
@@ -27,8 +27,6 @@
 namespace nav2_regulated_pure_pursuit_controller
 {
 
-using nav2_util::geometry_utils::euclidean_distance;
-
 PathHandler::PathHandler(
   tf2::Duration transform_tolerance,
   std::shared_ptr<tf2_ros::Buffer> tf,
@@ -50,76 +48,61 @@ nav_msgs::msg::Path PathHandler::transformGlobalPlan(
   double max_robot_pose_search_dist,
   bool reject_unit_path)
 {
-  if (global_plan_.poses.empty()) {
+  if (path_tracker_.empty()) {
     throw nav2_core::InvalidPath("Received plan with zero length");
   }
 
-  if (reject_unit_path && global_plan_.poses.size() == 1) {
+  if (reject_unit_path && path_tracker_.size() == 1) {
     throw nav2_core::InvalidPath("Received plan with length of one");
   }
 
   // let's get the pose of the robot in the frame of the plan
   geometry_msgs::msg::PoseStamped robot_pose;
-  if (!transformPose(global_plan_.header.frame_id, pose, robot_pose)) {
+  if (!transformPose(path_tracker_.getFrameId(), pose, robot_pose)) {
     throw nav2_core::ControllerTFError("Unable to transform robot pose into global plan's frame");
   }
+  const double robot_x = robot_pose.pose.position.x;
+  const double robot_y = robot_pose.pose.position.y;
 
-  auto closest_pose_upper_bound =
-    nav2_util::geometry_utils::first_after_integrated_distance(
-    global_plan_.poses.begin(), global_plan_.poses.end(), max_robot_pose_search_dist);
+  const size_t plan_begin = path_tracker_.begin();
+  const size_t closest_pose_upper_bound =
+    path_tracker_.firstAfterIntegratedDistance(plan_begin, max_robot_pose_search_dist);
 
   // First find the closest pose on the path to the robot
   // bounded by when the path turns around (if it does) so we don't get a pose from a later
   // portion of the path
-  auto transformation_begin =
-    nav2_util::geometry_utils::min_by(
-    global_plan_.poses.begin(), closest_pose_upper_bound,
-    [&robot_pose](const geometry_msgs::msg::PoseStamped & ps) {
-      return euclidean_distance(robot_pose, ps);
-    });
+  size_t transformation_begin =
+    path_tracker_.findClosestPose(plan_begin, closest_pose_upper_bound, robot_x, robot_y);
 
   // Make sure we always have at least 2 points on the transformed plan and that we don't prune
   // the global plan below 2 points in order to have always enough point to interpolate the
   // end of path direction
-  if (global_plan_.poses.begin() != closest_pose_upper_bound && global_plan_.poses.size() > 1 &&
-    transformation_begin == std::prev(closest_pose_upper_bound))
+  if (plan_begin != closest_pose_upper_bound && path_tracker_.size() > 1 &&
+    transformation_begin == closest_pose_upper_bound - 1 &&
+    closest_pose_upper_bound >= plan_begin + 2)
   {
-    transformation_begin = std::prev(std::prev(closest_pose_upper_bound));
+    transformation_begin = closest_pose_upper_bound - 2;
   }
 
   // We'll discard points on the plan that are outside the local costmap
-  const double max_costmap_extent = getCostmapMaxExtent();
-  auto transformation_end = std::find_if(
-    transformation_begin, global_plan_.poses.end(),
-    [&](const auto & global_plan_pose) {
-      return euclidean_distance(global_plan_pose, robot_pose) > max_costmap_extent;
-    });
-
-  // Lambda to transform a PoseStamped from global frame to local
-  auto transformGlobalPoseToLocal = [&](const auto & global_plan_pose) {
-      geometry_msgs::msg::PoseStamped stamped_pose, transformed_pose;
-      stamped_pose.header.frame_id = global_plan_.header.frame_id;
-      stamped_pose.header.stamp = robot_pose.header.stamp;
-      stamped_pose.pose = global_plan_pose.pose;
-      if (!transformPose(costmap_ros_->getBaseFrameID(), stamped_pose, transformed_pose)) {
-        throw nav2_core::ControllerTFError("Unable to transform plan pose into local frame");
-      }
-      transformed_pose.pose.position.z = 0.0;
-      return transformed_pose;
-    };
+  const size_t transformation_end = path_tracker_.findFirstFurtherThan(
+    transformation_begin, path_tracker_.end(), robot_x, robot_y, getCostmapMaxExtent());
 
   // Transform the near part of the global plan into the robot's frame of reference.
   nav_msgs::msg::Path transformed_plan;
-  std::transform(
-    transformation_begin, transformation_end,
-    std::back_inserter(transformed_plan.poses),
-    transformGlobalPoseToLocal);
-  transformed_plan.header.frame_id = costmap_ros_->getBaseFrameID();
-  transformed_plan.header.stamp = robot_pose.header.stamp;
+  if (!path_tracker_.transformPoses(
+      transformation_begin, transformation_end, *tf_, costmap_ros_->getBaseFrameID(),
+      robot_pose.header.stamp, transform_tolerance_, transformed_plan))
+  {
+    throw nav2_core::ControllerTFError("Unable to transform plan pose into local frame");
+  }
+  for (auto & transformed_pose : transformed_plan.poses) {
+    transformed_pose.pose.position.z = 0.0;
+  }
 
   // Remove the portion of the global plan that we've already passed so we don't
   // process it on the next iteration (this is called path pruning)
-  global_plan_.poses.erase(begin(global_plan_.poses), transformation_begin);
+  path_tracker_.prune(transformation_begin);
 
   if (transformed_plan.poses.empty()) {
     throw nav2_core::InvalidPath("Resulting plan has 0 poses in it.");
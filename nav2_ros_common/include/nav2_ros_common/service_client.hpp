@@ -18,6 +18,7 @@
 #include <string>
 #include <memory>
 #include <chrono>
+#include <functional>
 #include "rclcpp/rclcpp.hpp"
 #include "nav2_ros_common/node_utils.hpp"
 
@@ -190,6 +191,15 @@ public:
     return client_->wait_for_service(timeout);
   }
 
+  /**
+  * @brief Set a callback called whenever the client receives a response, without taking it
+  * @param callback Callback given the number of responses received since the last call
+  */
+  void set_on_new_response_callback(std::function<void(size_t)> callback)
+  {
+    client_->set_on_new_response_callback(callback);
+  }
+
   /**
    * @brief Spins the executor until the provided future is complete or the timeout is reached.
    *
@@ -54,6 +54,11 @@ public:
   // ExecuteCallback.
   typedef std::function<void ()> CompletionCallback;
 
+  // Callback function to notify the user that a cancel or a preemption request was
+  // received, e.g. to wake up an ExecuteCallback waiting for something else. It is
+  // called from the action server callbacks, under the action server lock.
+  typedef std::function<void ()> RequestCallback;
+
   /**
    * @brief An constructor for SimpleActionServer
    * @param node Ptr to node to make actions
@@ -187,9 +192,22 @@ public:
     }
 
     debug_msg("Received request for goal cancellation");
+    // The goal handle is only set canceling once the request is accepted, so
+    // is_cancel_requested() may not report it yet when called back
+    if (request_callback_) {request_callback_();}
     return rclcpp_action::CancelResponse::ACCEPT;
   }
 
+  /**
+   * @brief Sets the callback notified of cancel and preemption requests
+   * @param request_callback Callback to notify, or nullptr to notify none
+   */
+  void set_request_callback(RequestCallback request_callback)
+  {
+    std::lock_guard<std::recursive_mutex> lock(update_mutex_);
+    request_callback_ = request_callback;
+  }
+
   /**
    * @brief Sets thread priority level
    */
@@ -221,6 +239,7 @@ public:
       }
       pending_handle_ = handle;
       preempt_requested_ = true;
+      if (request_callback_) {request_callback_();}
     } else {
       if (is_active(pending_handle_)) {
         // Shouldn't reach a state with a pending goal but no current one.
@@ -543,6 +562,7 @@ protected:
 
   ExecuteCallback execute_callback_;
   CompletionCallback completion_callback_;
+  RequestCallback request_callback_;
   std::future<void> execution_future_;
   bool stop_execution_{false};
   bool use_realtime_prioritization_{false};
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -27,6 +28,9 @@ using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
 using std::placeholders::_1;
 using namespace std::chrono_literals;
 
+// Number of cancel and preemption requests the server was notified of
+std::atomic<int> g_request_count{0};
+
 class FibonacciServerNode : public rclcpp::Node
 {
 public:
@@ -45,6 +49,7 @@ public:
       shared_from_this(),
       "fibonacci",
       std::bind(&FibonacciServerNode::execute, this));
+    action_server_->set_request_callback([]() {g_request_count++;});
 
     deactivate_subs_ = create_subscription<std_msgs::msg::Empty>(
       "deactivate_server",
@@ -421,6 +426,7 @@ TEST_F(ActionTest, test_simple_action_preemption)
       future_goal_handle), rclcpp::FutureReturnCode::SUCCESS);
 
   // Preempt the goal
+  const int request_count = g_request_count.load();
   auto preemption_goal = Fibonacci::Goal();
   preemption_goal.order = 1;
 
@@ -453,6 +459,7 @@ TEST_F(ActionTest, test_simple_action_preemption)
   }
 
   EXPECT_EQ(sum, 1);
+  EXPECT_EQ(g_request_count.load(), request_count + 1);
   SUCCEED();
 }
 
@@ -556,6 +563,7 @@ TEST_F(ActionTest, test_handle_cancel)
       future_goal_handle), rclcpp::FutureReturnCode::SUCCESS);
 
   // Cancel the goal
+  const int request_count = g_request_count.load();
   auto cancel_response = node_->action_client_->async_cancel_goal(future_goal_handle.get());
   EXPECT_EQ(
     rclcpp::spin_until_future_complete(
@@ -564,6 +572,7 @@ TEST_F(ActionTest, test_handle_cancel)
 
   // Check cancelled
   EXPECT_EQ(future_goal_handle.get()->get_status(), rclcpp_action::GoalStatus::STATUS_CANCELING);
+  EXPECT_EQ(g_request_count.load(), request_count + 1);
 
   SUCCEED();
 }
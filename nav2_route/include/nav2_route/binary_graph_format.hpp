@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_ROUTE__BINARY_GRAPH_FORMAT_HPP_
+#define NAV2_ROUTE__BINARY_GRAPH_FORMAT_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace nav2_route
+{
+
+namespace binary_graph
+{
+
+// File layout, all sections 8-byte aligned and in host (little-endian) byte order:
+//   Header
+//   String offsets:  uint32_t[num_strings + 1], offsets into the string data
+//   String data:     char[], interned frames, metadata keys, string values and operation types
+//   Nodes:           NodeRecord[num_nodes]
+//   Edge offsets:    uint32_t[num_nodes + 1], CSR row offsets of each node's edges
+//   Edges:           EdgeRecord[num_edges], grouped by starting node
+//   Blob:            uint8_t[blob_size], serialized metadata and operations
+//
+// Metadata in the blob: uint32_t count, then per entry uint32_t key string index,
+// uint8_t ValueType and the value. Nested metadata is stored inline, arrays are
+// uint32_t count followed by typed values. Operations in the blob: uint32_t count,
+// then per operation uint32_t type string index, uint8_t trigger and its metadata.
+
+constexpr char MAGIC[8] = {'N', 'A', 'V', '2', 'G', 'R', 'P', 'H'};
+constexpr uint32_t VERSION = 1u;
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @enum nav2_route::binary_graph::ValueType
+ * @brief Types of values stored in the metadata
+ */
+enum class ValueType : uint8_t
+{
+  INT = 0,
+  UINT = 1,
+  FLOAT = 2,
+  BOOL = 3,
+  STRING = 4,
+  METADATA = 5,
+  ARRAY = 6
+};
+
+/**
+ * @struct nav2_route::binary_graph::Header
+ * @brief Header of the binary graph file
+ */
+struct Header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  uint32_t num_nodes;
+  uint32_t num_edges;
+  uint32_t num_strings;
+  uint32_t reserved;
+  uint64_t string_offsets_offset;
+  uint64_t string_data_offset;
+  uint64_t nodes_offset;
+  uint64_t edge_offsets_offset;
+  uint64_t edges_offset;
+  uint64_t blob_offset;
+  uint64_t blob_size;
+};
+
+/**
+ * @struct nav2_route::binary_graph::NodeRecord
+ * @brief A node of the binary graph file
+ */
+struct NodeRecord
+{
+  uint32_t nodeid;
+  float x;
+  float y;
+  uint32_t frame;       // String index
+  uint32_t metadata;    // Blob offset or NONE
+  uint32_t operations;  // Blob offset or NONE
+};
+
+/**
+ * @struct nav2_route::binary_graph::EdgeRecord
+ * @brief An edge of the binary graph file
+ */
+struct EdgeRecord
+{
+  uint32_t edgeid;
+  uint32_t end;         // Index of the ending node
+  float cost;
+  uint32_t overridable;
+  uint32_t metadata;    // Blob offset or NONE
+  uint32_t operations;  // Blob offset or NONE
+};
+
+static_assert(std::is_trivially_copyable<Header>::value, "Header must be trivially copyable");
+static_assert(sizeof(Header) == 88, "Unexpected binary graph header size");
+static_assert(sizeof(NodeRecord) == 24, "Unexpected binary graph node size");
+static_assert(sizeof(EdgeRecord) == 24, "Unexpected binary graph edge size");
+
+/**
+ * @brief Rounds up a file offset to the section alignment
+ * @param offset File offset
+ * @return Aligned offset
+ */
+inline uint64_t align(const uint64_t offset)
+{
+  return (offset + 7u) & ~static_cast<uint64_t>(7u);
+}
+
+}  // namespace binary_graph
+
+}  // namespace nav2_route
+
+#endif  // NAV2_ROUTE__BINARY_GRAPH_FORMAT_HPP_
@@ -59,7 +59,14 @@ public:
   ~EdgeScorer() = default;
 
   /**
-   * @brief Score the edge with the set of plugins
+   * @brief Prepare the plugins for a new search, grabbing the data to use
+   * for all of the edges scored in it
+   */
+  void prepare();
+
+  /**
+   * @brief Score the edge with the set of plugins. prepare() should be called once
+   * before scoring the edges of a new search.
    * @param edge Ptr to edge for scoring
    * @param goal_pose Pose Stamped of desired goal
    * @param score of edge
@@ -71,6 +78,14 @@ public:
     const EdgeType & edge_type,
     float & score);
 
+  /**
+   * @brief Lower bound of the edge cost for any request, as the sum of
+   * lower bounds provided by the plugins
+   * @param edge Ptr to edge for finding cost lower bound
+   * @return Lower bound of the edge cost
+   */
+  float getCostLowerBound(const EdgePtr edge);
+
   /**
    * @brief Provide the number of plugisn in the scorer loaded
    * @return Number of scoring plugins
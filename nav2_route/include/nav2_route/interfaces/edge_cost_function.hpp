@@ -80,6 +80,16 @@ public:
    * to use for all immediate requests, or otherwise prepare for scoring
    */
   virtual void prepare() {}
+
+  /**
+   * @brief Lower bound of the cost this plugin may score the edge with for any
+   * request and environment state. Used to precompute admissible search heuristics,
+   * so it must never exceed the value returned by score(). By default, scores
+   * are assumed to be non-negative, thus 0 is returned.
+   * @param edge The edge pointer to find the cost lower bound for
+   * @return Lower bound of the edge cost
+   */
+  virtual float getCostLowerBound(const EdgePtr /*edge*/) {return 0.0f;}
 };
 
 }  // namespace nav2_route
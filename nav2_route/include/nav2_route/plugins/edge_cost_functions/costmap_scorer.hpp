@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "nav2_ros_common/lifecycle_node.hpp"
 #include "nav2_route/interfaces/edge_cost_function.hpp"
@@ -78,6 +79,37 @@ public:
   void prepare() override;
 
 protected:
+  /**
+   * @brief Cached score of an edge, valid while the costmap cells under
+   * the edge are unchanged
+   */
+  struct CachedEdgeScore
+  {
+    Coordinates start, end;
+    unsigned int min_x, min_y, max_x, max_y;
+    bool valid;
+    float cost;
+  };
+
+  /**
+   * @brief Removes the cached scores of edges which could be affected by
+   * costmap changes since the last prepare() call
+   */
+  void invalidateCache();
+
+  /**
+   * @brief Scores the edge by the costmap cells under it
+   * @param x0 Edge start X-coordinate in costmap cells
+   * @param y0 Edge start Y-coordinate in costmap cells
+   * @param x1 Edge end X-coordinate in costmap cells
+   * @param y1 Edge end Y-coordinate in costmap cells
+   * @param cost of the edge scored
+   * @return bool if this edge is open valid to traverse
+   */
+  bool scoreCells(
+    const unsigned int x0, const unsigned int y0,
+    const unsigned int x1, const unsigned int y1, float & cost);
+
   rclcpp::Logger logger_{rclcpp::get_logger("CostmapScorer")};
   rclcpp::Clock::SharedPtr clock_;
   std::string name_;
@@ -85,7 +117,10 @@ protected:
   float weight_, max_cost_;
   std::shared_ptr<nav2_costmap_2d::CostmapSubscriber> costmap_subscriber_;
   std::shared_ptr<nav2_costmap_2d::Costmap2D> costmap_{nullptr};
+  uint64_t costmap_version_{0};
   unsigned int check_resolution_ {1u};
+  std::unordered_map<unsigned int, CachedEdgeScore> cache_;
+  uint64_t cache_version_{0};
 };
 
 }  // namespace nav2_route
@@ -69,6 +69,13 @@ public:
    */
   std::string getName() override;
 
+  /**
+   * @brief Lower bound of the edge cost: distance score depends only on the graph
+   * @param edge The edge pointer to find the cost lower bound for
+   * @return Lower bound of the edge cost
+   */
+  float getCostLowerBound(const EdgePtr edge) override;
+
 protected:
   std::string name_;
   std::string speed_tag_;
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <any>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nav2_core/route_exceptions.hpp"
+#include "nav2_route/binary_graph_format.hpp"
+#include "nav2_route/interfaces/graph_file_loader.hpp"
+#include "nav2_ros_common/lifecycle_node.hpp"
+
+#ifndef NAV2_ROUTE__PLUGINS__GRAPH_FILE_LOADERS__BINARY_GRAPH_FILE_LOADER_HPP_
+#define NAV2_ROUTE__PLUGINS__GRAPH_FILE_LOADERS__BINARY_GRAPH_FILE_LOADER_HPP_
+
+namespace nav2_route
+{
+
+/**
+ * @class nav2_route::BinaryGraphFileLoader
+ * @brief A GraphFileLoader plugin to load a binary graph representation, as
+ * written by the BinaryGraphFileSaver, by memory-mapping the file
+ */
+class BinaryGraphFileLoader : public GraphFileLoader
+{
+public:
+  /**
+   * @brief Constructor
+   */
+  BinaryGraphFileLoader() = default;
+
+  /**
+   * @brief Destructor
+   */
+  ~BinaryGraphFileLoader() = default;
+
+  /**
+   * @brief Configure, but do not store the node
+   * @param parent pointer to user's node
+   */
+  void configure(
+    const nav2::LifecycleNode::SharedPtr node) override;
+
+  /**
+   * @brief Loads the binary graph file into the graph
+   * @param graph The graph to be populated by the binary file
+   * @param graph_to_id_map A map of node id's to the graph index
+   * @param filepath The path of the file to load
+   * @return True if the graph was successfully loaded
+   */
+  bool loadGraphFromFile(
+    Graph & graph,
+    GraphToIDMap & graph_to_id_map,
+    std::string filepath) override;
+
+protected:
+  /**
+   * @brief Populates the graph from the mapped file contents
+   * @param data Pointer to the start of the file
+   * @param size Size of the file
+   * @param graph The graph to be populated
+   * @param graph_to_id_map A map of node id's to the graph index
+   */
+  void parseGraph(
+    const uint8_t * data, const size_t size,
+    Graph & graph, GraphToIDMap & graph_to_id_map);
+
+  /**
+   * @brief Checks that a section of the file is within its bounds
+   * @param offset Offset of the section
+   * @param count Number of elements in the section
+   * @param element_size Size of each element
+   * @param size Size of the file
+   */
+  void checkSection(
+    const uint64_t offset, const uint64_t count, const uint64_t element_size,
+    const size_t size);
+
+  /**
+   * @brief Reads a trivially copyable value from the blob and advances the read offset
+   * @param offset Blob offset, advanced past the value
+   * @return The value read
+   */
+  template<typename T>
+  T read(uint64_t & offset);
+
+  /**
+   * @brief Gets a string from the interned string table
+   * @param id String index
+   * @return The string
+   */
+  const std::string & getString(const uint32_t id);
+
+  /**
+   * @brief Deserializes the metadata from the blob
+   * @param offset Blob offset, advanced past the metadata
+   * @return The metadata
+   */
+  Metadata readMetadata(uint64_t & offset);
+
+  /**
+   * @brief Deserializes a single typed value from the blob
+   * @param offset Blob offset, advanced past the value
+   * @return The value
+   */
+  std::any readValue(uint64_t & offset);
+
+  /**
+   * @brief Deserializes the operations from the blob
+   * @param offset Blob offset, advanced past the operations
+   * @return The operations
+   */
+  Operations readOperations(uint64_t & offset);
+
+  const uint8_t * blob_{nullptr};
+  uint64_t blob_size_{0};
+  std::vector<std::string> strings_;
+  rclcpp::Logger logger_{rclcpp::get_logger("BinaryGraphFileLoader")};
+};
+
+}  // namespace nav2_route
+
+#endif  // NAV2_ROUTE__PLUGINS__GRAPH_FILE_LOADERS__BINARY_GRAPH_FILE_LOADER_HPP_
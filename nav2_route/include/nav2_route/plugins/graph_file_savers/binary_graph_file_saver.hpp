@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <any>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nav2_route/binary_graph_format.hpp"
+#include "nav2_route/interfaces/graph_file_saver.hpp"
+#include "nav2_ros_common/lifecycle_node.hpp"
+
+#ifndef NAV2_ROUTE__PLUGINS__GRAPH_FILE_SAVERS__BINARY_GRAPH_FILE_SAVER_HPP_
+#define NAV2_ROUTE__PLUGINS__GRAPH_FILE_SAVERS__BINARY_GRAPH_FILE_SAVER_HPP_
+
+namespace nav2_route
+{
+
+/**
+ * @class nav2_route::BinaryGraphFileSaver
+ * @brief A GraphFileSaver plugin to save a compact binary graph representation
+ * with CSR adjacency and interned strings, for fast memory-mapped loading
+ */
+class BinaryGraphFileSaver : public GraphFileSaver
+{
+public:
+  /**
+   * @brief Constructor
+   */
+  BinaryGraphFileSaver() = default;
+
+  /**
+   * @brief Destructor
+   */
+  ~BinaryGraphFileSaver() = default;
+
+  /**
+   * @brief Configure, but do not store the node
+   * @param parent pointer to user's node
+   */
+  void configure(
+    const nav2::LifecycleNode::SharedPtr node) override;
+
+  /**
+   * @brief Saves the graph to a binary graph file
+   * @param graph The graph to save to the binary file
+   * @param filepath The path to save the graph to
+   * @return True if successful
+   */
+  bool saveGraphToFile(
+    Graph & graph,
+    std::string filepath) override;
+
+protected:
+  /**
+   * @brief Gets the index of the string in the string table, adding it if new
+   * @param str String to intern
+   * @return Index of the string
+   */
+  uint32_t internString(const std::string & str);
+
+  /**
+   * @brief Serializes the metadata into the blob
+   * @param metadata Metadata from a node, edge or operation in the graph
+   * @return Blob offset of the metadata, or NONE if empty
+   */
+  uint32_t writeMetadata(const Metadata & metadata);
+
+  /**
+   * @brief Serializes the operations into the blob
+   * @param operations Operations from a node or edge in the graph
+   * @return Blob offset of the operations, or NONE if empty
+   */
+  uint32_t writeOperations(const Operations & operations);
+
+  /**
+   * @brief Serializes the metadata entries at the end of the blob
+   * @param metadata Metadata to serialize
+   */
+  void appendMetadata(const Metadata & metadata);
+
+  /**
+   * @brief Serializes a single typed value at the end of the blob. Values of
+   * unknown types are stored as their type name, as with the GeoJSON saver
+   * @param value Value to serialize
+   */
+  void appendValue(const std::any & value);
+
+  /**
+   * @brief Appends a trivially copyable value to the blob
+   * @param value Value to append
+   */
+  template<typename T>
+  void append(const T & value);
+
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, uint32_t> string_ids_;
+  std::vector<uint8_t> blob_;
+  rclcpp::Logger logger_{rclcpp::get_logger("BinaryGraphFileSaver")};
+};
+}  // namespace nav2_route
+
+#endif  // NAV2_ROUTE__PLUGINS__GRAPH_FILE_SAVERS__BINARY_GRAPH_FILE_SAVER_HPP_
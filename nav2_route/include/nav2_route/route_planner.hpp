@@ -74,6 +74,14 @@ public:
     const std::vector<unsigned int> & blocked_ids,
     const RouteRequest & route_request);
 
+  /**
+   * @brief Set the graph to plan in, precomputing the landmark-based (ALT) search
+   * heuristic for it, if enabled. Should be called each time the graph is changed,
+   * otherwise the search falls back to Dijkstra's algorithm for a different graph.
+   * @param graph Graph to precompute heuristic for
+   */
+  void setGraph(Graph & graph);
+
 protected:
   /**
    * @brief Reset the search state of the graph nodes
@@ -104,6 +112,40 @@ protected:
     const EdgePtr edge, float & score, const std::vector<unsigned int> & blocked_ids,
     const RouteRequest & route_request);
 
+  /**
+   * @brief Finds the lowest costs from the landmark to all of the graph nodes
+   * using the edge cost lower bounds. Run on the reversed graph edges, finds
+   * the lowest costs from all of the nodes to the landmark.
+   * @param edges Edges of each node as pairs of the connected node index and cost lower bound
+   * @param landmark Index of the landmark node
+   * @param costs Output costs, infinity for unreachable nodes
+   */
+  void computeLandmarkCosts(
+    const std::vector<std::vector<std::pair<unsigned int, float>>> & edges,
+    const unsigned int landmark, std::vector<float> & costs);
+
+  /**
+   * @brief Gets the lower bound of the edge cost for any route request
+   * @param edge Edge pointer to find lower bound for
+   * @return Edge cost lower bound
+   */
+  float getEdgeCostLowerBound(const EdgePtr edge);
+
+  /**
+   * @brief Prepares the landmark heuristic for a search towards the goal
+   * @param graph Graph to search
+   * @param goal_node Goal node pointer
+   */
+  void prepareHeuristic(const Graph & graph, const NodePtr goal_node);
+
+
+  /**
+   * @brief Gets the admissible estimate of the cost from the node to the goal
+   * @param node Node pointer to find the heuristic for
+   * @return Heuristic cost, 0 if heuristic is not used
+   */
+  inline float getHeuristicCost(const NodePtr node);
+
   /**
    * @brief Gets the next node in the priority queue for search
    * @return Next node pointer in queue with cost
@@ -155,6 +197,18 @@ protected:
   unsigned int goal_id_{0};
   NodeQueue queue_;
   std::unique_ptr<EdgeScorer> edge_scorer_;
+
+  // Landmark-based (ALT) heuristic state
+  bool use_landmark_heuristic_{false};
+  unsigned int num_landmarks_{0};
+  bool heuristic_active_{false};
+  const Node * heuristic_graph_{nullptr};
+  size_t heuristic_graph_size_{0};
+  // Node-major costs: [node_idx * num_landmarks + landmark_idx]
+  std::vector<float> costs_from_landmarks_;
+  std::vector<float> costs_to_landmarks_;
+  std::vector<float> goal_costs_from_landmarks_;
+  std::vector<float> goal_costs_to_landmarks_;
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
 };
 
@@ -63,6 +63,13 @@ EdgeScorer::EdgeScorer(
   }
 }
 
+void EdgeScorer::prepare()
+{
+  for (auto & plugin : plugins_) {
+    plugin->prepare();
+  }
+}
+
 bool EdgeScorer::score(
   const EdgePtr edge, const RouteRequest & route_request,
   const EdgeType & edge_type, float & total_score)
@@ -70,10 +77,6 @@ bool EdgeScorer::score(
   total_score = 0.0;
   float curr_score = 0.0;
 
-  for (auto & plugin : plugins_) {
-    plugin->prepare();
-  }
-
   for (auto & plugin : plugins_) {
     curr_score = 0.0;
     if (plugin->score(edge, route_request, edge_type, curr_score)) {
@@ -86,6 +89,15 @@ bool EdgeScorer::score(
   return true;
 }
 
+float EdgeScorer::getCostLowerBound(const EdgePtr edge)
+{
+  float lower_bound = 0.0f;
+  for (auto & plugin : plugins_) {
+    lower_bound += plugin->getCostLowerBound(edge);
+  }
+  return lower_bound;
+}
+
 int EdgeScorer::numPlugins() const
 {
   return plugins_.size();
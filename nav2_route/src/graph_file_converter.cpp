@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "nav2_route/plugins/graph_file_loaders/binary_graph_file_loader.hpp"
+#include "nav2_route/plugins/graph_file_loaders/geojson_graph_file_loader.hpp"
+#include "nav2_route/plugins/graph_file_savers/binary_graph_file_saver.hpp"
+#include "nav2_route/plugins/graph_file_savers/geojson_graph_file_saver.hpp"
+
+// Converts route graph files between the GeoJSON and binary graph formats.
+// The format of each file is selected by its extension: `.nav2graph` for the
+// binary format, anything else for GeoJSON.
+// Usage: graph_file_converter <input_file> <output_file>
+
+namespace
+{
+
+bool isBinaryGraphFile(const std::string & filepath)
+{
+  const std::string extension = ".nav2graph";
+  return filepath.size() >= extension.size() &&
+         filepath.compare(filepath.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  if (argc != 3) {
+    std::cerr << "Usage: graph_file_converter <input_file> <output_file>" << std::endl;
+    return 1;
+  }
+
+  const std::string input = argv[1];
+  const std::string output = argv[2];
+
+  std::shared_ptr<nav2_route::GraphFileLoader> loader;
+  if (isBinaryGraphFile(input)) {
+    loader = std::make_shared<nav2_route::BinaryGraphFileLoader>();
+  } else {
+    loader = std::make_shared<nav2_route::GeoJsonGraphFileLoader>();
+  }
+
+  std::shared_ptr<nav2_route::GraphFileSaver> saver;
+  if (isBinaryGraphFile(output)) {
+    saver = std::make_shared<nav2_route::BinaryGraphFileSaver>();
+  } else {
+    saver = std::make_shared<nav2_route::GeoJsonGraphFileSaver>();
+  }
+
+  nav2_route::Graph graph;
+  nav2_route::GraphToIDMap graph_to_id_map;
+  try {
+    if (!loader->loadGraphFromFile(graph, graph_to_id_map, input)) {
+      std::cerr << "Failed to load graph " << input << std::endl;
+      return 1;
+    }
+  } catch (std::exception & ex) {
+    std::cerr << "Failed to load graph " << input << ": " << ex.what() << std::endl;
+    return 1;
+  }
+
+  if (!saver->saveGraphToFile(graph, output)) {
+    std::cerr << "Failed to save graph " << output << std::endl;
+    return 1;
+  }
+
+  std::cout << "Converted graph of " << graph.size() << " nodes from " << input << " to " <<
+    output << std::endl;
+  return 0;
+}
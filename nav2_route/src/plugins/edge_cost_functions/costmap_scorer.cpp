@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -85,10 +86,45 @@ void CostmapScorer::configure(
 void CostmapScorer::prepare()
 {
   try {
-    costmap_ = costmap_subscriber_->getCostmap();
+    costmap_ = costmap_subscriber_->getCostmap(costmap_version_);
   } catch (...) {
     costmap_.reset();
   }
+
+  invalidateCache();
+}
+
+void CostmapScorer::invalidateCache()
+{
+  if (!costmap_) {
+    cache_.clear();
+    cache_version_ = 0;
+    return;
+  }
+
+  // Version of the costmap actually used, which may be older than the latest one
+  const uint64_t version = costmap_version_;
+  if (version == cache_version_) {
+    return;
+  }
+
+  unsigned int min_x, min_y, max_x, max_y;
+  if (!costmap_subscriber_->getUpdatedBounds(cache_version_, min_x, min_y, max_x, max_y)) {
+    cache_.clear();
+  } else if (min_x < max_x && min_y < max_y) {
+    // Drop only the edges passing through the updated area
+    for (auto it = cache_.begin(); it != cache_.end(); ) {
+      const CachedEdgeScore & entry = it->second;
+      if (entry.min_x < max_x && entry.max_x >= min_x &&
+        entry.min_y < max_y && entry.max_y >= min_y)
+      {
+        it = cache_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  cache_version_ = version;
 }
 
 bool CostmapScorer::score(
@@ -96,13 +132,29 @@ bool CostmapScorer::score(
   const RouteRequest & /* route_request */,
   const EdgeType & /* edge_type */, float & cost)
 {
+  if (!costmap_) {
+    // Scorer is being used without the search preparation, try to get the costmap now
+    prepare();
+  }
+
   if (!costmap_) {
     RCLCPP_WARN_THROTTLE(logger_, *clock_, 1000, "No costmap yet received!");
     return false;
   }
 
-  float largest_cost = 0.0, running_cost = 0.0, point_cost = 0.0;
-  unsigned int x0, y0, x1, y1, idx = 0;
+  // Edge scores are only depending on costmap cells under it, reuse them while unchanged
+  auto cached = cache_.find(edge->edgeid);
+  if (cached != cache_.end() &&
+    cached->second.start.x == edge->start->coords.x &&
+    cached->second.start.y == edge->start->coords.y &&
+    cached->second.end.x == edge->end->coords.x &&
+    cached->second.end.y == edge->end->coords.y)
+  {
+    cost = cached->second.cost;
+    return cached->second.valid;
+  }
+
+  unsigned int x0, y0, x1, y1;
   if (!costmap_->worldToMap(edge->start->coords.x, edge->start->coords.y, x0, y0) ||
     !costmap_->worldToMap(edge->end->coords.x, edge->end->coords.y, x1, y1))
   {
@@ -113,6 +165,29 @@ bool CostmapScorer::score(
     return true;
   }
 
+  CachedEdgeScore entry;
+  entry.start = edge->start->coords;
+  entry.end = edge->end->coords;
+  entry.min_x = std::min(x0, x1);
+  entry.min_y = std::min(y0, y1);
+  entry.max_x = std::max(x0, x1);
+  entry.max_y = std::max(y0, y1);
+  entry.cost = 0.0;
+  entry.valid = scoreCells(x0, y0, x1, y1, entry.cost);
+  cache_[edge->edgeid] = entry;
+
+  if (entry.valid) {
+    cost = entry.cost;
+  }
+  return entry.valid;
+}
+
+bool CostmapScorer::scoreCells(
+  const unsigned int x0, const unsigned int y0,
+  const unsigned int x1, const unsigned int y1, float & cost)
+{
+  float largest_cost = 0.0, running_cost = 0.0, point_cost = 0.0;
+  unsigned int idx = 0;
   for (nav2_util::LineIterator iter(x0, y0, x1, y1); iter.isValid(); ) {
     point_cost = static_cast<float>(costmap_->getCost(iter.getX(), iter.getY()));
     if (point_cost >= max_cost_ && max_cost_ != 255.0f /*Unknown*/ && invalid_on_collision_) {
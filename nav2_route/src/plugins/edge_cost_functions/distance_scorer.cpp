@@ -54,6 +54,13 @@ bool DistanceScorer::score(
   return true;
 }
 
+float DistanceScorer::getCostLowerBound(const EdgePtr edge)
+{
+  float cost = 0.0f;
+  score(edge, RouteRequest(), EdgeType::NONE, cost);
+  return cost;
+}
+
 std::string DistanceScorer::getName()
 {
   return name_;
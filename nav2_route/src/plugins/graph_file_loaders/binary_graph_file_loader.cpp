@@ -0,0 +1,288 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nav2_route/plugins/graph_file_loaders/binary_graph_file_loader.hpp"
+
+namespace nav2_route
+{
+
+void BinaryGraphFileLoader::configure(
+  const nav2::LifecycleNode::SharedPtr node)
+{
+  RCLCPP_INFO(node->get_logger(), "Configuring binary graph file loader");
+  logger_ = node->get_logger();
+}
+
+bool BinaryGraphFileLoader::loadGraphFromFile(
+  Graph & graph, GraphToIDMap & graph_to_id_map, std::string filepath)
+{
+  const int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    RCLCPP_ERROR(logger_, "The filepath %s does not exist", filepath.c_str());
+    return false;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    RCLCPP_ERROR(logger_, "Failed to read %s", filepath.c_str());
+    close(fd);
+    return false;
+  }
+
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void * data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    RCLCPP_ERROR(logger_, "Failed to memory-map %s", filepath.c_str());
+    return false;
+  }
+
+  // The whole file is parsed sequentially once
+  madvise(data, size, MADV_SEQUENTIAL);
+
+  bool result = true;
+  try {
+    parseGraph(static_cast<const uint8_t *>(data), size, graph, graph_to_id_map);
+  } catch (std::exception & ex) {
+    RCLCPP_ERROR(logger_, "Failed to parse %s: %s", filepath.c_str(), ex.what());
+    graph.clear();
+    graph_to_id_map.clear();
+    result = false;
+  }
+
+  munmap(data, size);
+  blob_ = nullptr;
+  blob_size_ = 0;
+  strings_.clear();
+  return result;
+}
+
+void BinaryGraphFileLoader::parseGraph(
+  const uint8_t * data, const size_t size,
+  Graph & graph, GraphToIDMap & graph_to_id_map)
+{
+  binary_graph::Header header;
+  if (size < sizeof(header)) {
+    throw nav2_core::NoValidGraph("File is too small for a binary graph");
+  }
+  std::memcpy(&header, data, sizeof(header));
+
+  if (std::memcmp(header.magic, binary_graph::MAGIC, sizeof(header.magic)) != 0) {
+    throw nav2_core::NoValidGraph("File is not a binary graph");
+  }
+  if (header.version != binary_graph::VERSION) {
+    throw nav2_core::NoValidGraph(
+            "Unsupported binary graph version " + std::to_string(header.version));
+  }
+  if (header.byte_order_mark != binary_graph::BYTE_ORDER_MARK) {
+    throw nav2_core::NoValidGraph("Binary graph was saved with a different byte order");
+  }
+  if (header.num_nodes == 0 || header.num_edges == 0) {
+    throw nav2_core::NoValidGraph("The graph is malformed. Is does not contain nodes or edges");
+  }
+
+  checkSection(header.string_offsets_offset, header.num_strings + 1ul, sizeof(uint32_t), size);
+  checkSection(header.nodes_offset, header.num_nodes, sizeof(binary_graph::NodeRecord), size);
+  checkSection(header.edge_offsets_offset, header.num_nodes + 1ul, sizeof(uint32_t), size);
+  checkSection(header.edges_offset, header.num_edges, sizeof(binary_graph::EdgeRecord), size);
+  checkSection(header.blob_offset, header.blob_size, 1u, size);
+
+  // Intern the string table once, so shared frames and keys are decoded a single time
+  std::vector<uint32_t> string_offsets(header.num_strings + 1);
+  std::memcpy(
+    string_offsets.data(), data + header.string_offsets_offset,
+    string_offsets.size() * sizeof(uint32_t));
+  checkSection(header.string_data_offset, string_offsets.back(), 1u, size);
+  const char * string_data = reinterpret_cast<const char *>(data + header.string_data_offset);
+  strings_.resize(header.num_strings);
+  for (uint32_t i = 0; i != header.num_strings; i++) {
+    if (string_offsets[i] > string_offsets[i + 1]) {
+      throw nav2_core::NoValidGraph("Malformed binary graph string table");
+    }
+    strings_[i].assign(string_data + string_offsets[i], string_offsets[i + 1] - string_offsets[i]);
+  }
+
+  blob_ = data + header.blob_offset;
+  blob_size_ = header.blob_size;
+
+  std::vector<uint32_t> edge_offsets(header.num_nodes + 1);
+  std::memcpy(
+    edge_offsets.data(), data + header.edge_offsets_offset,
+    edge_offsets.size() * sizeof(uint32_t));
+  if (edge_offsets.back() != header.num_edges) {
+    throw nav2_core::NoValidGraph("Malformed binary graph edge offsets");
+  }
+
+  graph.resize(header.num_nodes);
+  graph_to_id_map.reserve(header.num_nodes);
+  const uint8_t * nodes = data + header.nodes_offset;
+  for (uint32_t i = 0; i != header.num_nodes; i++) {
+    binary_graph::NodeRecord record;
+    std::memcpy(&record, nodes + i * sizeof(record), sizeof(record));
+    Node & node = graph[i];
+    node.nodeid = record.nodeid;
+    graph_to_id_map[node.nodeid] = i;
+    node.coords.x = record.x;
+    node.coords.y = record.y;
+    node.coords.frame_id = getString(record.frame);
+    if (record.metadata != binary_graph::NONE) {
+      uint64_t offset = record.metadata;
+      node.metadata = readMetadata(offset);
+    }
+    if (record.operations != binary_graph::NONE) {
+      uint64_t offset = record.operations;
+      node.operations = readOperations(offset);
+    }
+  }
+
+  const uint8_t * edges = data + header.edges_offset;
+  for (uint32_t i = 0; i != header.num_nodes; i++) {
+    if (edge_offsets[i] > edge_offsets[i + 1]) {
+      throw nav2_core::NoValidGraph("Malformed binary graph edge offsets");
+    }
+
+    Node & node = graph[i];
+    node.neighbors.reserve(edge_offsets[i + 1] - edge_offsets[i]);
+    for (uint32_t j = edge_offsets[i]; j != edge_offsets[i + 1]; j++) {
+      binary_graph::EdgeRecord record;
+      std::memcpy(&record, edges + j * sizeof(record), sizeof(record));
+      if (record.end >= header.num_nodes) {
+        RCLCPP_ERROR(
+          logger_, "End index of %u does not exist for edge id %u", record.end, record.edgeid);
+        throw nav2_core::NoValidGraph("End id does not exist");
+      }
+
+      EdgeCost edge_cost;
+      edge_cost.cost = record.cost;
+      edge_cost.overridable = record.overridable != 0u;
+      node.neighbors.push_back({record.edgeid, &node, &graph[record.end], edge_cost, {}, {}});
+      DirectionalEdge & edge = node.neighbors.back();
+      if (record.metadata != binary_graph::NONE) {
+        uint64_t offset = record.metadata;
+        edge.metadata = readMetadata(offset);
+      }
+      if (record.operations != binary_graph::NONE) {
+        uint64_t offset = record.operations;
+        edge.operations = readOperations(offset);
+      }
+    }
+  }
+}
+
+void BinaryGraphFileLoader::checkSection(
+  const uint64_t offset, const uint64_t count, const uint64_t element_size,
+  const size_t size)
+{
+  if (offset > size || count > (size - offset) / element_size) {
+    throw nav2_core::NoValidGraph("Binary graph section exceeds the file size");
+  }
+}
+
+template<typename T>
+T BinaryGraphFileLoader::read(uint64_t & offset)
+{
+  if (offset + sizeof(T) > blob_size_) {
+    throw nav2_core::NoValidGraph("Binary graph metadata exceeds the file size");
+  }
+  T value;
+  std::memcpy(&value, blob_ + offset, sizeof(T));
+  offset += sizeof(T);
+  return value;
+}
+
+const std::string & BinaryGraphFileLoader::getString(const uint32_t id)
+{
+  if (id >= strings_.size()) {
+    throw nav2_core::NoValidGraph("Binary graph string index is out of range");
+  }
+  return strings_[id];
+}
+
+Metadata BinaryGraphFileLoader::readMetadata(uint64_t & offset)
+{
+  Metadata metadata;
+  const uint32_t count = read<uint32_t>(offset);
+  metadata.data.reserve(std::min<uint64_t>(count, blob_size_));
+  for (uint32_t i = 0; i != count; i++) {
+    const std::string & key = getString(read<uint32_t>(offset));
+    metadata.data[key] = readValue(offset);
+  }
+  return metadata;
+}
+
+std::any BinaryGraphFileLoader::readValue(uint64_t & offset)
+{
+  using binary_graph::ValueType;
+  const auto type = static_cast<ValueType>(read<uint8_t>(offset));
+  switch (type) {
+    case ValueType::INT:
+      return static_cast<int>(read<int32_t>(offset));
+    case ValueType::UINT:
+      return static_cast<unsigned int>(read<uint32_t>(offset));
+    case ValueType::FLOAT:
+      return read<float>(offset);
+    case ValueType::BOOL:
+      return read<uint8_t>(offset) != 0u;
+    case ValueType::STRING:
+      return getString(read<uint32_t>(offset));
+    case ValueType::METADATA:
+      return readMetadata(offset);
+    case ValueType::ARRAY:
+      {
+        const uint32_t count = read<uint32_t>(offset);
+        std::vector<std::any> array;
+        array.reserve(std::min<uint64_t>(count, blob_size_));
+        for (uint32_t i = 0; i != count; i++) {
+          array.push_back(readValue(offset));
+        }
+        return array;
+      }
+  }
+  throw nav2_core::NoValidGraph("Unknown binary graph metadata type");
+}
+
+Operations BinaryGraphFileLoader::readOperations(uint64_t & offset)
+{
+  Operations operations;
+  const uint32_t count = read<uint32_t>(offset);
+  operations.reserve(std::min<uint64_t>(count, blob_size_));
+  for (uint32_t i = 0; i != count; i++) {
+    Operation operation;
+    operation.type = getString(read<uint32_t>(offset));
+    const uint8_t trigger = read<uint8_t>(offset);
+    if (trigger > static_cast<uint8_t>(OperationTrigger::ON_EXIT)) {
+      throw nav2_core::NoValidGraph("Unknown binary graph operation trigger");
+    }
+    operation.trigger = static_cast<OperationTrigger>(trigger);
+    operation.metadata = readMetadata(offset);
+    operations.push_back(operation);
+  }
+  return operations;
+}
+
+}  // namespace nav2_route
+
+#include "pluginlib/class_list_macros.hpp"
+PLUGINLIB_EXPORT_CLASS(nav2_route::BinaryGraphFileLoader, nav2_route::GraphFileLoader)
@@ -0,0 +1,263 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nav2_route/plugins/graph_file_savers/binary_graph_file_saver.hpp"
+
+namespace nav2_route
+{
+
+void BinaryGraphFileSaver::configure(
+  const nav2::LifecycleNode::SharedPtr node)
+{
+  RCLCPP_INFO(node->get_logger(), "Configuring binary graph file saver");
+  logger_ = node->get_logger();
+}
+
+bool BinaryGraphFileSaver::saveGraphToFile(
+  Graph & graph, std::string filepath)
+{
+  if (filepath.empty()) {
+    RCLCPP_ERROR(logger_, "File path is empty");
+    return false;
+  }
+
+  strings_.clear();
+  string_ids_.clear();
+  blob_.clear();
+
+  try {
+    // Compact the node indices, skipping "deleted" nodes
+    std::vector<uint32_t> node_indices(graph.size(), binary_graph::NONE);
+    uint32_t num_nodes = 0;
+    for (unsigned int i = 0; i != graph.size(); i++) {
+      if (graph[i].nodeid != std::numeric_limits<int>::max()) {
+        node_indices[i] = num_nodes++;
+      }
+    }
+
+    std::vector<binary_graph::NodeRecord> nodes;
+    std::vector<uint32_t> edge_offsets;
+    std::vector<binary_graph::EdgeRecord> edges;
+    nodes.reserve(num_nodes);
+    edge_offsets.reserve(num_nodes + 1);
+    edge_offsets.push_back(0u);
+    for (unsigned int i = 0; i != graph.size(); i++) {
+      const Node & node = graph[i];
+      if (node_indices[i] == binary_graph::NONE) {
+        continue;
+      }
+
+      binary_graph::NodeRecord node_record;
+      node_record.nodeid = node.nodeid;
+      node_record.x = node.coords.x;
+      node_record.y = node.coords.y;
+      node_record.frame = internString(node.coords.frame_id);
+      node_record.metadata = writeMetadata(node.metadata);
+      node_record.operations = writeOperations(node.operations);
+      nodes.push_back(node_record);
+
+      for (const auto & edge : node.neighbors) {
+        const auto end_idx = static_cast<size_t>(edge.end - graph.data());
+        if (end_idx >= graph.size() || node_indices[end_idx] == binary_graph::NONE) {
+          RCLCPP_WARN(
+            logger_, "Skipping edge %u leading to a node outside of the graph", edge.edgeid);
+          continue;
+        }
+
+        binary_graph::EdgeRecord edge_record;
+        edge_record.edgeid = edge.edgeid;
+        edge_record.end = node_indices[end_idx];
+        edge_record.cost = edge.edge_cost.cost;
+        edge_record.overridable = edge.edge_cost.overridable ? 1u : 0u;
+        edge_record.metadata = writeMetadata(edge.metadata);
+        edge_record.operations = writeOperations(edge.operations);
+        edges.push_back(edge_record);
+      }
+      edge_offsets.push_back(static_cast<uint32_t>(edges.size()));
+    }
+
+    if (blob_.size() >= binary_graph::NONE) {
+      RCLCPP_ERROR(logger_, "Graph metadata is too large for the binary graph format");
+      return false;
+    }
+
+    // String table
+    std::vector<uint32_t> string_offsets;
+    string_offsets.reserve(strings_.size() + 1);
+    string_offsets.push_back(0u);
+    uint64_t string_data_size = 0;
+    for (const auto & str : strings_) {
+      string_data_size += str.size();
+      string_offsets.push_back(static_cast<uint32_t>(string_data_size));
+    }
+
+    binary_graph::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, binary_graph::MAGIC, sizeof(header.magic));
+    header.version = binary_graph::VERSION;
+    header.byte_order_mark = binary_graph::BYTE_ORDER_MARK;
+    header.num_nodes = num_nodes;
+    header.num_edges = static_cast<uint32_t>(edges.size());
+    header.num_strings = static_cast<uint32_t>(strings_.size());
+    header.string_offsets_offset = binary_graph::align(sizeof(header));
+    header.string_data_offset = binary_graph::align(
+      header.string_offsets_offset + string_offsets.size() * sizeof(uint32_t));
+    header.nodes_offset = binary_graph::align(header.string_data_offset + string_data_size);
+    header.edge_offsets_offset = binary_graph::align(
+      header.nodes_offset + nodes.size() * sizeof(binary_graph::NodeRecord));
+    header.edges_offset = binary_graph::align(
+      header.edge_offsets_offset + edge_offsets.size() * sizeof(uint32_t));
+    header.blob_offset = binary_graph::align(
+      header.edges_offset + edges.size() * sizeof(binary_graph::EdgeRecord));
+    header.blob_size = blob_.size();
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      RCLCPP_ERROR(logger_, "Failed to open %s for writing", filepath.c_str());
+      return false;
+    }
+
+    uint64_t written = 0;
+    auto write = [&](const void * data, const uint64_t size, const uint64_t offset) {
+        static const char padding[8] = {0};
+        file.write(padding, offset - written);
+        file.write(reinterpret_cast<const char *>(data), size);
+        written = offset + size;
+      };
+    write(&header, sizeof(header), 0u);
+    write(
+      string_offsets.data(), string_offsets.size() * sizeof(uint32_t),
+      header.string_offsets_offset);
+    write(nullptr, 0u, header.string_data_offset);
+    for (const auto & str : strings_) {
+      write(str.data(), str.size(), written);
+    }
+    write(nodes.data(), nodes.size() * sizeof(binary_graph::NodeRecord), header.nodes_offset);
+    write(
+      edge_offsets.data(), edge_offsets.size() * sizeof(uint32_t), header.edge_offsets_offset);
+    write(edges.data(), edges.size() * sizeof(binary_graph::EdgeRecord), header.edges_offset);
+    write(blob_.data(), blob_.size(), header.blob_offset);
+    file.close();
+    if (!file) {
+      RCLCPP_ERROR(logger_, "Failed to write %s", filepath.c_str());
+      return false;
+    }
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(logger_, "An error occurred: %s", e.what());
+    return false;
+  }
+  return true;
+}
+
+uint32_t BinaryGraphFileSaver::internString(const std::string & str)
+{
+  auto it = string_ids_.find(str);
+  if (it != string_ids_.end()) {
+    return it->second;
+  }
+
+  const uint32_t id = static_cast<uint32_t>(strings_.size());
+  strings_.push_back(str);
+  string_ids_.emplace(str, id);
+  return id;
+}
+
+uint32_t BinaryGraphFileSaver::writeMetadata(const Metadata & metadata)
+{
+  if (metadata.data.empty()) {
+    return binary_graph::NONE;
+  }
+
+  const uint32_t offset = static_cast<uint32_t>(blob_.size());
+  appendMetadata(metadata);
+  return offset;
+}
+
+uint32_t BinaryGraphFileSaver::writeOperations(const Operations & operations)
+{
+  if (operations.empty()) {
+    return binary_graph::NONE;
+  }
+
+  const uint32_t offset = static_cast<uint32_t>(blob_.size());
+  append(static_cast<uint32_t>(operations.size()));
+  for (const auto & operation : operations) {
+    append(internString(operation.type));
+    append(static_cast<uint8_t>(operation.trigger));
+    appendMetadata(operation.metadata);
+  }
+  return offset;
+}
+
+void BinaryGraphFileSaver::appendMetadata(const Metadata & metadata)
+{
+  append(static_cast<uint32_t>(metadata.data.size()));
+  for (const auto & [key, value] : metadata.data) {
+    append(internString(key));
+    appendValue(value);
+  }
+}
+
+void BinaryGraphFileSaver::appendValue(const std::any & value)
+{
+  using binary_graph::ValueType;
+  if (value.type() == typeid(std::string)) {
+    append(ValueType::STRING);
+    append(internString(std::any_cast<std::string>(value)));
+  } else if (value.type() == typeid(int)) {
+    append(ValueType::INT);
+    append(static_cast<int32_t>(std::any_cast<int>(value)));
+  } else if (value.type() == typeid(unsigned int)) {
+    append(ValueType::UINT);
+    append(static_cast<uint32_t>(std::any_cast<unsigned int>(value)));
+  } else if (value.type() == typeid(float)) {
+    append(ValueType::FLOAT);
+    append(std::any_cast<float>(value));
+  } else if (value.type() == typeid(bool)) {
+    append(ValueType::BOOL);
+    append(static_cast<uint8_t>(std::any_cast<bool>(value)));
+  } else if (value.type() == typeid(Metadata)) {
+    append(ValueType::METADATA);
+    appendMetadata(std::any_cast<Metadata>(value));
+  } else if (value.type() == typeid(std::vector<std::any>)) {
+    const auto & array = std::any_cast<const std::vector<std::any> &>(value);
+    append(ValueType::ARRAY);
+    append(static_cast<uint32_t>(array.size()));
+    for (const auto & element : array) {
+      appendValue(element);
+    }
+  } else {
+    append(ValueType::STRING);
+    append(internString(value.type().name()));
+  }
+}
+
+template<typename T>
+void BinaryGraphFileSaver::append(const T & value)
+{
+  const auto * bytes = reinterpret_cast<const uint8_t *>(&value);
+  blob_.insert(blob_.end(), bytes, bytes + sizeof(T));
+}
+
+}  // namespace nav2_route
+
+#include "pluginlib/class_list_macros.hpp"
+PLUGINLIB_EXPORT_CLASS(nav2_route::BinaryGraphFileSaver, nav2_route::GraphFileSaver)
@@ -18,6 +18,9 @@
 #include <vector>
 #include <mutex>
 #include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
 
 #include "nav2_route/route_planner.hpp"
 
@@ -37,9 +40,169 @@ void RoutePlanner::configure(
     max_iterations_ = std::numeric_limits<int>::max();
   }
 
+  nav2::declare_parameter_if_not_declared(
+    node, "use_landmark_heuristic", rclcpp::ParameterValue(false));
+  use_landmark_heuristic_ = node->get_parameter("use_landmark_heuristic").as_bool();
+  nav2::declare_parameter_if_not_declared(
+    node, "num_landmarks", rclcpp::ParameterValue(8));
+  num_landmarks_ = static_cast<unsigned int>(
+    std::max<int64_t>(node->get_parameter("num_landmarks").as_int(), 1));
+
   edge_scorer_ = std::make_unique<EdgeScorer>(node, tf_buffer, costmap_subscriber);
 }
 
+void RoutePlanner::setGraph(Graph & graph)
+{
+  heuristic_graph_ = nullptr;
+  heuristic_graph_size_ = 0;
+  costs_from_landmarks_.clear();
+  costs_to_landmarks_.clear();
+
+  if (!use_landmark_heuristic_ || graph.empty()) {
+    return;
+  }
+
+  // Lower bounds of edge costs for any request, in forward and reversed directions
+  const Node * graph_begin = graph.data();
+  const unsigned int num_nodes = graph.size();
+  std::vector<std::vector<std::pair<unsigned int, float>>> forward_edges(num_nodes);
+  std::vector<std::vector<std::pair<unsigned int, float>>> reverse_edges(num_nodes);
+  bool informative = false;
+  for (unsigned int i = 0; i != num_nodes; i++) {
+    for (DirectionalEdge & edge : graph[i].neighbors) {
+      const unsigned int end = static_cast<unsigned int>(edge.end - graph_begin);
+      if (end >= num_nodes) {
+        // Edge leads out of this graph storage, cannot be indexed
+        return;
+      }
+      const float cost = getEdgeCostLowerBound(&edge);
+      informative = informative || cost > 0.0f;
+      forward_edges[i].emplace_back(end, cost);
+      reverse_edges[end].emplace_back(i, cost);
+    }
+  }
+
+  if (!informative) {
+    // e.g. no plugins providing cost lower bounds: heuristic would be 0 everywhere
+    return;
+  }
+
+  // Select landmarks by the farthest-point strategy: the next landmark is
+  // the node which is the farthest one from all of the already selected landmarks
+  const unsigned int num_landmarks = std::min(num_landmarks_, num_nodes);
+  costs_from_landmarks_.assign(
+    static_cast<size_t>(num_nodes) * num_landmarks, std::numeric_limits<float>::infinity());
+  costs_to_landmarks_.assign(
+    static_cast<size_t>(num_nodes) * num_landmarks, std::numeric_limits<float>::infinity());
+  std::vector<float> min_landmark_costs(num_nodes, std::numeric_limits<float>::infinity());
+  std::vector<float> costs;
+
+  // Seed the selection with the farthest node from an arbitrary one
+  computeLandmarkCosts(forward_edges, 0u, costs);
+  unsigned int landmark = 0u;
+  for (unsigned int l = 0; l != num_landmarks; l++) {
+    float farthest_cost = -1.0f;
+    for (unsigned int i = 0; i != num_nodes; i++) {
+      const float cost = l == 0 ? costs[i] : min_landmark_costs[i];
+      if (cost != std::numeric_limits<float>::infinity() && cost > farthest_cost) {
+        farthest_cost = cost;
+        landmark = i;
+      }
+    }
+
+    computeLandmarkCosts(forward_edges, landmark, costs);
+    for (unsigned int i = 0; i != num_nodes; i++) {
+      costs_from_landmarks_[static_cast<size_t>(i) * num_landmarks + l] = costs[i];
+      min_landmark_costs[i] = std::min(min_landmark_costs[i], costs[i]);
+    }
+    computeLandmarkCosts(reverse_edges, landmark, costs);
+    for (unsigned int i = 0; i != num_nodes; i++) {
+      costs_to_landmarks_[static_cast<size_t>(i) * num_landmarks + l] = costs[i];
+    }
+  }
+
+  goal_costs_from_landmarks_.resize(num_landmarks);
+  goal_costs_to_landmarks_.resize(num_landmarks);
+  heuristic_graph_ = graph_begin;
+  heuristic_graph_size_ = num_nodes;
+}
+
+void RoutePlanner::computeLandmarkCosts(
+  const std::vector<std::vector<std::pair<unsigned int, float>>> & edges,
+  const unsigned int landmark, std::vector<float> & costs)
+{
+  typedef std::pair<float, unsigned int> Element;
+  std::priority_queue<Element, std::vector<Element>, std::greater<Element>> queue;
+  costs.assign(edges.size(), std::numeric_limits<float>::infinity());
+  costs[landmark] = 0.0f;
+  queue.emplace(0.0f, landmark);
+
+  while (!queue.empty()) {
+    auto [curr_cost, idx] = queue.top();
+    queue.pop();
+    if (curr_cost != costs[idx]) {
+      continue;
+    }
+
+    for (const auto & [next_idx, edge_cost] : edges[idx]) {
+      const float potential_cost = curr_cost + edge_cost;
+      if (potential_cost < costs[next_idx]) {
+        costs[next_idx] = potential_cost;
+        queue.emplace(potential_cost, next_idx);
+      }
+    }
+  }
+}
+
+float RoutePlanner::getEdgeCostLowerBound(const EdgePtr edge)
+{
+  if (!edge->edge_cost.overridable || edge_scorer_->numPlugins() == 0) {
+    return std::max(edge->edge_cost.cost, 0.0f);
+  }
+  return std::max(edge_scorer_->getCostLowerBound(edge), 0.0f);
+}
+
+void RoutePlanner::prepareHeuristic(const Graph & graph, const NodePtr goal_node)
+{
+  heuristic_active_ = heuristic_graph_ != nullptr &&
+    heuristic_graph_ == graph.data() && heuristic_graph_size_ == graph.size();
+  if (!heuristic_active_) {
+    return;
+  }
+
+  const size_t num_landmarks = goal_costs_from_landmarks_.size();
+  const size_t goal_offset = static_cast<size_t>(goal_node - heuristic_graph_) * num_landmarks;
+  for (size_t l = 0; l != num_landmarks; l++) {
+    goal_costs_from_landmarks_[l] = costs_from_landmarks_[goal_offset + l];
+    goal_costs_to_landmarks_[l] = costs_to_landmarks_[goal_offset + l];
+  }
+}
+
+float RoutePlanner::getHeuristicCost(const NodePtr node)
+{
+  if (!heuristic_active_) {
+    return 0.0f;
+  }
+
+  // By triangle inequality for each landmark L, cost(n, goal) is at least
+  // cost(L, goal) - cost(L, n) and cost(n, L) - cost(goal, L)
+  constexpr float inf = std::numeric_limits<float>::infinity();
+  const size_t num_landmarks = goal_costs_from_landmarks_.size();
+  const size_t offset = static_cast<size_t>(node - heuristic_graph_) * num_landmarks;
+  float heuristic = 0.0f;
+  for (size_t l = 0; l != num_landmarks; l++) {
+    const float from_landmark = costs_from_landmarks_[offset + l];
+    const float to_landmark = costs_to_landmarks_[offset + l];
+    if (from_landmark != inf && goal_costs_from_landmarks_[l] != inf) {
+      heuristic = std::max(heuristic, goal_costs_from_landmarks_[l] - from_landmark);
+    }
+    if (to_landmark != inf && goal_costs_to_landmarks_[l] != inf) {
+      heuristic = std::max(heuristic, to_landmark - goal_costs_to_landmarks_[l]);
+    }
+  }
+  return heuristic;
+}
+
 Route RoutePlanner::findRoute(
   Graph & graph, unsigned int start_index, unsigned int goal_index,
   const std::vector<unsigned int> & blocked_ids,
@@ -88,12 +251,14 @@ void RoutePlanner::findShortestGraphTraversal(
   const std::vector<unsigned int> & blocked_ids,
   const RouteRequest & route_request)
 {
-  // Setup the Dijkstra's search
+  // Setup the search: Dijkstra's, or A* if landmark heuristic is available for the graph
   resetSearchStates(graph);
+  edge_scorer_->prepare();
+  prepareHeuristic(graph, goal_node);
   start_id_ = start_node->nodeid;
   goal_id_ = goal_node->nodeid;
   start_node->search_state.integrated_cost = 0.0;
-  addNode(0.0, start_node);
+  addNode(getHeuristicCost(start_node), start_node);
 
   NodePtr neighbor{nullptr};
   EdgePtr edge{nullptr};
@@ -103,10 +268,11 @@ void RoutePlanner::findShortestGraphTraversal(
     iterations++;
 
     // Get the next lowest cost node
-    auto [curr_cost, node] = getNextNode();
+    auto [curr_priority, node] = getNextNode();
+    const float curr_cost = node->search_state.integrated_cost;
 
     // This has been visited, thus already lowest cost
-    if (curr_cost != node->search_state.integrated_cost) {
+    if (curr_priority != curr_cost + getHeuristicCost(node)) {
       continue;
     }
 
@@ -133,7 +299,7 @@ void RoutePlanner::findShortestGraphTraversal(
         neighbor->search_state.parent_edge = edge;
         neighbor->search_state.integrated_cost = potential_cost;
         neighbor->search_state.traversal_cost = traversal_cost;
-        addNode(potential_cost, neighbor);
+        addNode(potential_cost + getHeuristicCost(neighbor), neighbor);
       }
     }
   }
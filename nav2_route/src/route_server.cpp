@@ -88,6 +88,7 @@ RouteServer::on_configure(const rclcpp_lifecycle::State & /*state*/)
 
     route_planner_ = std::make_shared<RoutePlanner>();
     route_planner_->configure(node, tf_, costmap_subscriber_);
+    route_planner_->setGraph(graph_);
 
     route_tracker_ = std::make_shared<RouteTracker>();
     route_tracker_->configure(
@@ -368,9 +369,11 @@ void RouteServer::setRouteGraph(
   RCLCPP_INFO(get_logger(), "Setting new route graph: %s.", request->graph_filepath.c_str());
   graph_.clear();
   id_to_graph_map_.clear();
+  route_planner_->setGraph(graph_);
   try {
     if (graph_loader_->loadGraphFromFile(graph_, id_to_graph_map_, request->graph_filepath)) {
       goal_intent_extractor_->setGraph(graph_, &id_to_graph_map_);
+      route_planner_->setGraph(graph_);
       graph_vis_publisher_->publish(utils::toMsg(graph_, route_frame_, this->now()));
       response->success = true;
       return;
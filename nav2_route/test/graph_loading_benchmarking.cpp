@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_route/types.hpp"
+#include "nav2_route/plugins/graph_file_loaders/binary_graph_file_loader.hpp"
+#include "nav2_route/plugins/graph_file_loaders/geojson_graph_file_loader.hpp"
+#include "nav2_route/plugins/graph_file_savers/binary_graph_file_saver.hpp"
+#include "nav2_route/plugins/graph_file_savers/geojson_graph_file_saver.hpp"
+
+using namespace nav2_route;  // NOLINT
+
+// This is a script to compare the loading times of the GeoJSON and binary graph
+// file formats for a regularized but arbitrarily sized graph with metadata
+
+// Size of the benchmarking side length (e.g. 300 x 300 = 90,000 nodes)
+const unsigned int DIM = 300;
+// Number of tests to average results over
+const unsigned int NUM_TESTS = 5;
+
+inline Graph createGraph()
+{
+  Graph graph;
+  graph.resize(DIM * DIM);
+
+  EdgeCost e_cost;
+  Metadata edge_metadata;
+  float speed_limit = 0.5f;
+  edge_metadata.setValue("speed_limit", speed_limit);
+  unsigned int curr_edge_idx = DIM * DIM + 1;
+
+  unsigned int curr_graph_idx = 0;
+  for (unsigned int j = 0; j != DIM; j++) {
+    for (unsigned int i = 0; i != DIM; i++) {
+      Node & node = graph[curr_graph_idx];
+      node.nodeid = curr_graph_idx + 1;
+      node.coords.x = i;
+      node.coords.y = j;
+      node.coords.frame_id = "map";
+      std::string building = "building_" + std::to_string(j / 50);
+      node.metadata.setValue("building", building);
+
+      if (i > 0) {
+        // (i - 1, j)
+        node.addEdge(e_cost, &graph[curr_graph_idx - 1], curr_edge_idx++, edge_metadata);
+        graph[curr_graph_idx - 1].addEdge(e_cost, &node, curr_edge_idx++, edge_metadata);
+      }
+      if (j > 0) {
+        // (i, j - 1)
+        node.addEdge(e_cost, &graph[curr_graph_idx - DIM], curr_edge_idx++, edge_metadata);
+        graph[curr_graph_idx - DIM].addEdge(e_cost, &node, curr_edge_idx++, edge_metadata);
+      }
+
+      curr_graph_idx++;
+    }
+  }
+
+  return graph;
+}
+
+template<typename LoaderT>
+double timeLoading(const std::string & filepath, Graph & graph)
+{
+  LoaderT loader;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i != NUM_TESTS; i++) {
+    graph.clear();
+    GraphToIDMap graph_to_id_map;
+    loader.loadGraphFromFile(graph, graph_to_id_map, filepath);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         static_cast<double>(NUM_TESTS);
+}
+
+int main(int argc, char const * argv[])
+{
+  rclcpp::init(argc, argv);
+  auto logger = rclcpp::get_logger("graph_loading_benchmarking");
+
+  const auto directory = std::filesystem::temp_directory_path();
+  const std::string geojson_path = (directory / "benchmark_graph.geojson").string();
+  const std::string binary_path = (directory / "benchmark_graph.nav2graph").string();
+
+  Graph graph = createGraph();
+  GeoJsonGraphFileSaver geojson_saver;
+  BinaryGraphFileSaver binary_saver;
+  geojson_saver.saveGraphToFile(graph, geojson_path);
+  binary_saver.saveGraphToFile(graph, binary_path);
+
+  RCLCPP_INFO(
+    logger, "Graph of %u nodes: GeoJSON file %lu bytes, binary file %lu bytes.", DIM * DIM,
+    std::filesystem::file_size(geojson_path), std::filesystem::file_size(binary_path));
+
+  Graph loaded_graph;
+  const double geojson_time = timeLoading<GeoJsonGraphFileLoader>(geojson_path, loaded_graph);
+  const double binary_time = timeLoading<BinaryGraphFileLoader>(binary_path, loaded_graph);
+  RCLCPP_INFO(
+    logger, "Loading took %0.2f milliseconds from GeoJSON and %0.2f milliseconds from binary "
+    "(%0.1fx speedup).", geojson_time, binary_time, geojson_time / binary_time);
+
+  std::filesystem::remove(geojson_path);
+  std::filesystem::remove(binary_path);
+  rclcpp::shutdown();
+  return 0;
+}
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cstdlib>
+#include <utility>
+#include <vector>
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
@@ -140,5 +142,52 @@ int main(int argc, char const * argv[])
     "Finding the nodes in the K-d tree took %0.5f milliseconds.",
     (end - start).seconds() * 1000.0 / static_cast<double>(NUM_TESTS));
 
+  // Fourth test: Random start and goal poses using Dijkstra's vs. landmark (ALT) heuristic
+  auto alt_node = std::make_shared<nav2::LifecycleNode>("route_benchmarking_alt");
+  alt_node->declare_parameter("use_landmark_heuristic", rclcpp::ParameterValue(true));
+  RoutePlanner alt_planner;
+  alt_planner.configure(alt_node, tf_buffer, costmap_subscriber);
+  start = node->now();
+  alt_planner.setGraph(graph);
+  end = node->now();
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Landmark preprocessing took %0.5f milliseconds.", (end - start).seconds() * 1000.0);
+
+  RouteRequest route_request;
+  std::vector<std::pair<unsigned int, unsigned int>> queries;
+  for (unsigned int i = 0; i != NUM_TESTS; i++) {
+    unsigned int start_idx = rand_r(&seed) % (DIM * DIM);
+    unsigned int goal_idx = rand_r(&seed) % (DIM * DIM);
+    while (start_idx == goal_idx) {
+      goal_idx = rand_r(&seed) % (DIM * DIM);
+    }
+    queries.emplace_back(start_idx, goal_idx);
+  }
+
+  double dijkstra_cost = 0.0;
+  start = node->now();
+  for (const auto & [start_idx, goal_idx] : queries) {
+    route = planner.findRoute(graph, start_idx, goal_idx, blocked_ids, route_request);
+    dijkstra_cost += route.route_cost;
+  }
+  end = node->now();
+  const double dijkstra_time = (end - start).seconds() * 1000.0 / static_cast<double>(NUM_TESTS);
+
+  double alt_cost = 0.0;
+  start = node->now();
+  for (const auto & [start_idx, goal_idx] : queries) {
+    route = alt_planner.findRoute(graph, start_idx, goal_idx, blocked_ids, route_request);
+    alt_cost += route.route_cost;
+  }
+  end = node->now();
+  const double alt_time = (end - start).seconds() * 1000.0 / static_cast<double>(NUM_TESTS);
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Random planning took %0.5f milliseconds with Dijkstra's and %0.5f milliseconds with "
+    "landmarks (%0.2fx speedup). Total route costs: %0.2f vs %0.2f.",
+    dijkstra_time, alt_time, dijkstra_time / alt_time, dijkstra_cost, alt_cost);
+
   return 0;
 }
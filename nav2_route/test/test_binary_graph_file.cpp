@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <ament_index_cpp/get_package_share_directory.hpp>
+
+#include "nav2_route/plugins/graph_file_loaders/binary_graph_file_loader.hpp"
+#include "nav2_route/plugins/graph_file_loaders/geojson_graph_file_loader.hpp"
+#include "nav2_route/plugins/graph_file_savers/binary_graph_file_saver.hpp"
+
+class RclCppFixture
+{
+public:
+  RclCppFixture() {rclcpp::init(0, nullptr);}
+  ~RclCppFixture() {rclcpp::shutdown();}
+};
+RclCppFixture g_rclcppfixture;
+
+using namespace nav2_route; // NOLINT
+
+TEST(BinaryGraphFile, test_invalid_files)
+{
+  Graph graph;
+  GraphToIDMap graph_to_id_map;
+  BinaryGraphFileLoader graph_file_loader;
+  EXPECT_FALSE(graph_file_loader.loadGraphFromFile(graph, graph_to_id_map, "missing.nav2graph"));
+
+  std::string file_path = "invalid.nav2graph";
+  std::ofstream file(file_path);
+  file << "{\"features\": []}";
+  file.close();
+  EXPECT_FALSE(graph_file_loader.loadGraphFromFile(graph, graph_to_id_map, file_path));
+  EXPECT_TRUE(graph.empty());
+  std::filesystem::remove(file_path);
+
+  BinaryGraphFileSaver graph_file_saver;
+  EXPECT_FALSE(graph_file_saver.saveGraphToFile(graph, ""));
+}
+
+TEST(BinaryGraphFile, test_truncated_file)
+{
+  auto geojson_path = ament_index_cpp::get_package_share_directory("nav2_route") +
+    "/graphs/sample_graph.geojson";
+  Graph graph;
+  GraphToIDMap graph_to_id_map;
+  GeoJsonGraphFileLoader geojson_loader;
+  ASSERT_TRUE(geojson_loader.loadGraphFromFile(graph, graph_to_id_map, geojson_path));
+
+  std::string file_path = "truncated.nav2graph";
+  BinaryGraphFileSaver graph_file_saver;
+  ASSERT_TRUE(graph_file_saver.saveGraphToFile(graph, file_path));
+  std::filesystem::resize_file(file_path, std::filesystem::file_size(file_path) / 2);
+
+  Graph graph2;
+  GraphToIDMap graph_to_id_map2;
+  BinaryGraphFileLoader graph_file_loader;
+  EXPECT_FALSE(graph_file_loader.loadGraphFromFile(graph2, graph_to_id_map2, file_path));
+  std::filesystem::remove(file_path);
+}
+
+TEST(BinaryGraphFile, test_round_trip)
+{
+  auto geojson_path = ament_index_cpp::get_package_share_directory("nav2_route") +
+    "/graphs/sample_graph.geojson";
+  Graph graph;
+  GraphToIDMap graph_to_id_map;
+  GeoJsonGraphFileLoader geojson_loader;
+  ASSERT_TRUE(geojson_loader.loadGraphFromFile(graph, graph_to_id_map, geojson_path));
+
+  std::string file_path = "sample_graph.nav2graph";
+  BinaryGraphFileSaver graph_file_saver;
+  EXPECT_TRUE(graph_file_saver.saveGraphToFile(graph, file_path));
+
+  Graph graph2;
+  GraphToIDMap graph_to_id_map2;
+  BinaryGraphFileLoader graph_file_loader;
+  EXPECT_TRUE(graph_file_loader.loadGraphFromFile(graph2, graph_to_id_map2, file_path));
+  std::filesystem::remove(file_path);
+
+  ASSERT_EQ(graph.size(), graph2.size());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    EXPECT_EQ(graph[i].nodeid, graph2[i].nodeid);
+    EXPECT_EQ(graph[i].coords.x, graph2[i].coords.x);
+    EXPECT_EQ(graph[i].coords.y, graph2[i].coords.y);
+    EXPECT_EQ(graph[i].coords.frame_id, graph2[i].coords.frame_id);
+    EXPECT_EQ(graph[i].metadata.data.size(), graph2[i].metadata.data.size());
+    EXPECT_EQ(graph[i].operations.size(), graph2[i].operations.size());
+    ASSERT_EQ(graph[i].neighbors.size(), graph2[i].neighbors.size());
+    for (size_t j = 0; j < graph[i].neighbors.size(); ++j) {
+      EXPECT_EQ(graph[i].neighbors[j].edgeid, graph2[i].neighbors[j].edgeid);
+      EXPECT_EQ(graph2[i].neighbors[j].start, &graph2[i]);
+      EXPECT_EQ(graph[i].neighbors[j].end->nodeid, graph2[i].neighbors[j].end->nodeid);
+      EXPECT_EQ(graph[i].neighbors[j].edge_cost.cost, graph2[i].neighbors[j].edge_cost.cost);
+      EXPECT_EQ(
+        graph[i].neighbors[j].edge_cost.overridable,
+        graph2[i].neighbors[j].edge_cost.overridable);
+      EXPECT_EQ(
+        graph[i].neighbors[j].metadata.data.size(),
+        graph2[i].neighbors[j].metadata.data.size());
+      EXPECT_EQ(
+        graph[i].neighbors[j].operations.size(),
+        graph2[i].neighbors[j].operations.size());
+    }
+  }
+  EXPECT_EQ(graph_to_id_map, graph_to_id_map2);
+
+  // Check nested metadata
+  Metadata region;
+  region = graph2[0].metadata.getValue("region", region);
+  EXPECT_EQ(region.data.size(), 3u);
+
+  std::vector<std::any> x_values;
+  x_values = region.getValue("x_values", x_values);
+  EXPECT_EQ(x_values.size(), 4u);
+
+  EXPECT_EQ(graph2[0].neighbors[0].edge_cost.cost, 10.0f);
+  EXPECT_EQ(graph2[0].neighbors[0].edge_cost.overridable, false);
+
+  // Check operations
+  auto & operations = graph2[0].neighbors[0].operations;
+  auto & original_operations = graph[0].neighbors[0].operations;
+  ASSERT_EQ(operations.size(), original_operations.size());
+  for (size_t i = 0; i < operations.size(); ++i) {
+    EXPECT_EQ(operations[i].type, original_operations[i].type);
+    EXPECT_EQ(operations[i].trigger, original_operations[i].trigger);
+  }
+
+  std::string type, original_type;
+  type = operations[1].metadata.getValue("type", type);
+  original_type = original_operations[1].metadata.getValue("type", original_type);
+  EXPECT_EQ(type, original_type);
+}
@@ -426,6 +426,81 @@ TEST(EdgeScorersTest, test_costmap_scoring_alt_profile)
   node_thread.reset();
 }
 
+TEST(EdgeScorersTest, test_costmap_scoring_cache)
+{
+  // Test CostmapScorer cached scores being invalidated by costmap changes
+  auto node = std::make_shared<nav2::LifecycleNode>("edge_scorer_test");
+  node->declare_parameter("costmap_topic", "dummy_topic");
+  auto node_thread = std::make_unique<nav2::NodeThread>(node);
+  std::shared_ptr<tf2_ros::Buffer> tf_buffer;
+
+  node->declare_parameter(
+    "edge_cost_functions", rclcpp::ParameterValue(std::vector<std::string>{"CostmapScorer"}));
+  nav2::declare_parameter_if_not_declared(
+    node, "CostmapScorer.plugin",
+    rclcpp::ParameterValue(std::string{"nav2_route::CostmapScorer"}));
+
+  std::shared_ptr<nav2_costmap_2d::CostmapSubscriber> costmap_subscriber;
+  EdgeScorer scorer(node, tf_buffer, costmap_subscriber);
+  EXPECT_EQ(scorer.numPlugins(), 1);  // CostmapScorer
+
+  // Create two edges to score in free space
+  Node n1, n2, n3, n4;
+  n1.coords.x = 1.0;
+  n1.coords.y = 1.0;
+  n2.coords.x = 1.0;
+  n2.coords.y = 4.0;
+  n3.coords.x = 8.0;
+  n3.coords.y = 1.0;
+  n4.coords.x = 8.0;
+  n4.coords.y = 4.0;
+
+  DirectionalEdge edge1, edge2;
+  edge1.edgeid = 10;
+  edge1.start = &n1;
+  edge1.end = &n2;
+  edge2.edgeid = 11;
+  edge2.start = &n3;
+  edge2.end = &n4;
+  RouteRequest route_request;
+  EdgeType edge_type = EdgeType::NONE;
+
+  nav2_costmap_2d::Costmap2D * costmap =
+    new nav2_costmap_2d::Costmap2D(100, 100, 0.1, 0.0, 0.0, 0);
+  nav2_costmap_2d::Costmap2DPublisher publisher(
+    node, costmap, "map", "global_costmap/costmap", true);
+  publisher.on_activate();
+  publisher.publishCostmap();
+
+  // Give it a moment to receive the costmap
+  rclcpp::Rate r(10);
+  r.sleep();
+
+  scorer.prepare();
+  float traversal_cost = -1;
+  EXPECT_TRUE(scorer.score(&edge1, route_request, edge_type, traversal_cost));
+  EXPECT_EQ(traversal_cost, 0.0);
+  traversal_cost = -1;
+  EXPECT_TRUE(scorer.score(&edge2, route_request, edge_type, traversal_cost));
+  EXPECT_EQ(traversal_cost, 0.0);
+
+  // Block the first edge only
+  for (unsigned int j = 15; j <= 35; ++j) {
+    costmap->setCost(10, j, 254);
+  }
+  publisher.publishCostmap();
+  r.sleep();
+
+  scorer.prepare();
+  traversal_cost = -1;
+  EXPECT_FALSE(scorer.score(&edge1, route_request, edge_type, traversal_cost));
+  traversal_cost = -1;
+  EXPECT_TRUE(scorer.score(&edge2, route_request, edge_type, traversal_cost));
+  EXPECT_EQ(traversal_cost, 0.0);
+
+  node_thread.reset();
+}
+
 TEST(EdgeScorersTest, test_time_scoring)
 {
   // Test Time scorer plugin loading
@@ -224,3 +224,56 @@ TEST(RoutePlannerTest, test_route_planner_negative)
       graph, start, goal, blocked_ids,
       route_request), nav2_core::NoValidGraph);
 }
+
+TEST(RoutePlannerTest, test_route_planner_landmark_heuristic)
+{
+  RouteRequest route_request;
+  std::shared_ptr<tf2_ros::Buffer> tf_buffer;
+  std::shared_ptr<nav2_costmap_2d::CostmapSubscriber> collision_checker;
+
+  auto node = std::make_shared<nav2::LifecycleNode>("router_test_dijkstra");
+  RoutePlanner planner;
+  planner.configure(node, tf_buffer, collision_checker);
+
+  auto alt_node = std::make_shared<nav2::LifecycleNode>("router_test_landmarks");
+  alt_node->declare_parameter("use_landmark_heuristic", rclcpp::ParameterValue(true));
+  alt_node->declare_parameter("num_landmarks", rclcpp::ParameterValue(3));
+  RoutePlanner alt_planner;
+  alt_planner.configure(alt_node, tf_buffer, collision_checker);
+
+  Graph graph = create4x4Graph();
+  alt_planner.setGraph(graph);
+  std::vector<unsigned int> blocked_ids;
+
+  // Landmark heuristic search must find routes as good as Dijkstra's for all queries
+  for (unsigned int start = 0; start != graph.size(); start++) {
+    for (unsigned int goal = 0; goal != graph.size(); goal++) {
+      if (start == goal) {
+        continue;
+      }
+      if (goal == 15u || start == 15u) {
+        // Only reachable from one direction, checked separately
+        continue;
+      }
+      Route route = planner.findRoute(graph, start, goal, blocked_ids, route_request);
+      Route alt_route = alt_planner.findRoute(graph, start, goal, blocked_ids, route_request);
+      EXPECT_NEAR(route.route_cost, alt_route.route_cost, 0.001);
+    }
+  }
+
+  Route alt_route = alt_planner.findRoute(graph, 0u, 15u, blocked_ids, route_request);
+  EXPECT_NEAR(alt_route.route_cost, 6.0, 0.001);
+  EXPECT_THROW(
+    alt_planner.findRoute(graph, 15u, 0u, blocked_ids, route_request),
+    nav2_core::NoValidRouteCouldBeFound);
+
+  // Blocking edges only increases costs, so the heuristic remains valid
+  blocked_ids.push_back(19u);
+  alt_route = alt_planner.findRoute(graph, 0u, 12u, blocked_ids, route_request);
+  EXPECT_NEAR(alt_route.route_cost, 5.0, 0.001);
+
+  // A different graph than the one preprocessed falls back to Dijkstra's
+  Graph other_graph = create4x4Graph();
+  alt_route = alt_planner.findRoute(other_graph, 0u, 12u, blocked_ids, route_request);
+  EXPECT_NEAR(alt_route.route_cost, 5.0, 0.001);
+}
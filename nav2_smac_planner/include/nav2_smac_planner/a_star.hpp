@@ -33,6 +33,7 @@
 #include "nav2_smac_planner/node_lattice.hpp"
 #include "nav2_smac_planner/node_basic.hpp"
 #include "nav2_smac_planner/goal_manager.hpp"
+#include "nav2_smac_planner/search_corridor.hpp"
 #include "nav2_smac_planner/types.hpp"
 #include "nav2_smac_planner/constants.hpp"
 
@@ -125,6 +126,25 @@ public:
    */
   void setCollisionChecker(GridCollisionChecker * collision_checker);
 
+  /**
+   * @brief Restricts the search to a corridor, for hierarchical planning
+   * @param search_corridor Corridor to search within, or nullptr to search the full costmap
+   */
+  void setSearchCorridor(const SearchCorridor * search_corridor);
+
+  /**
+   * @brief Sets the maximum planning time of the next searches, e.g. the time left
+   * for a search following another one in the same planning request
+   * @param max_planning_time Maximum time (in seconds) to wait for a plan
+   */
+  void setMaxPlanningTime(const double & max_planning_time);
+
+  /**
+   * @brief Whether the last createPath() call failed by exceeding the maximum planning time
+   * @return True if the last search ran out of time
+   */
+  bool hasTimedOut() const;
+
   /**
    * @brief Set the goal for planning, as a node index
    * @param mx The node X index of the goal
@@ -269,6 +289,7 @@ protected:
   int _max_on_approach_iterations;
   int _terminal_checking_interval;
   double _max_planning_time;
+  bool _timed_out{false};
   float _tolerance;
   unsigned int _x_size;
   unsigned int _y_size;
@@ -286,6 +307,7 @@ protected:
 
   GridCollisionChecker * _collision_checker;
   nav2_costmap_2d::Costmap2D * _costmap;
+  const SearchCorridor * _search_corridor{nullptr};
   std::unique_ptr<AnalyticExpansion<NodeT>> _expander;
 };
 
@@ -19,10 +19,15 @@
 #include <ompl/base/spaces/DubinsStateSpace.h>
 #include <ompl/base/spaces/ReedsSheppStateSpace.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "nav2_smac_planner/node_2d.hpp"
@@ -93,6 +98,37 @@ public:
     int direction_changes{0};
   };
 
+  /**
+   * @class nav2_smac_planner::AnalyticExpansion::SpeculationScope
+   * @brief Speculative analytic expansions of a search, cancelled and waited for
+   * when the search ends however it does
+   */
+  class SpeculationScope
+  {
+public:
+    /**
+     * @brief Starts speculating analytic expansions for a search
+     * @param expander Analytic expansion object of the search
+     * @param coarse_check_goals Coarse list of goals nodes to plan to
+     * @param max_index Number of nodes in the search graph
+     */
+    SpeculationScope(
+      AnalyticExpansion & expander, const NodeVector & coarse_check_goals,
+      const uint64_t & max_index)
+    : expander_(expander)
+    {
+      expander_.startSpeculation(coarse_check_goals, max_index);
+    }
+
+    ~SpeculationScope()
+    {
+      expander_.stopSpeculation();
+    }
+
+private:
+    AnalyticExpansion & expander_;
+  };
+
   /**
    * @brief Constructor for analytic expansion object
    */
@@ -102,6 +138,11 @@ public:
     const bool & traverse_unknown,
     const unsigned int & dim_3_size);
 
+  /**
+   * @brief Destructor for analytic expansion object, joins the speculation workers
+   */
+  ~AnalyticExpansion();
+
   /**
    * @brief Sets the collision checker and costmap to use in expansion validation
    * @param collision_checker Collision checker to use
@@ -128,6 +169,21 @@ public:
     const NodeGetter & getter, int & iterations,
     int & closest_distance);
 
+  /**
+   * @brief Attempt an analytic path completion from a node to the goals on the search thread
+   * @param node The node to start the analytic path from
+   * @param coarse_check_goals Coarse list of goals nodes to plan to
+   * @param fine_check_goals Fine list of goals nodes to plan to
+   * @param getter Gets a node at a set of coordinates
+   * @return Node pointer reference to goal node with the best score out of the goals node if
+   * successful, else return nullptr
+   */
+  NodePtr expandToGoals(
+    const NodePtr & node,
+    const NodeVector & coarse_check_goals,
+    const NodeVector & fine_check_goals,
+    const NodeGetter & getter);
+
   /**
    * @brief Perform an analytic path expansion to the goal
    * @param node The node to start the analytic path from
@@ -140,6 +196,32 @@ public:
     const NodePtr & node, const NodePtr & goal,
     const NodeGetter & getter, const ompl::base::StateSpacePtr & state_space);
 
+  /**
+   * @brief Whether an analytic path from a pose to a goal pose would be found valid by
+   * getAnalyticPath(), without reading nor modifying the search graph, so that it may
+   * run on the speculation workers
+   * @param start Coordinates of the node to start the analytic path from
+   * @param start_index Index of the node to start the analytic path from
+   * @param goal Coordinates of the goal node to plan to
+   * @param collision_checker Collision checker of the calling thread
+   * @param generation Speculation generation the check was requested in
+   * @return Whether the analytic path is collision free and within the cost limits
+   */
+  bool isAnalyticPathFeasible(
+    const Coordinates & start, const uint64_t & start_index, const Coordinates & goal,
+    GridCollisionChecker & collision_checker, const uint64_t & generation);
+
+  /**
+   * @brief Whether the costs along an analytic path are acceptable
+   * @param node_costs Costs of the intermediary poses of the path
+   * @param distance Length of the path
+   * @param min_turning_radius Minimum turning radius of the motion model
+   * @return Whether the path stays out of high cost areas, or only enters them on approach
+   */
+  bool isCostProfileAcceptable(
+    const std::vector<float> & node_costs, const float & distance,
+    const float & min_turning_radius) const;
+
   /**
    * @brief Refined analytic path from the current node to the goal
    * @param node The node to start the analytic path from. Node head may
@@ -181,12 +263,73 @@ public:
   void cleanNode(const NodePtr & nodes);
 
 protected:
+  /**
+   * @brief Snapshot of a node to speculatively expand to the goals
+   */
+  struct SpeculativeCandidate
+  {
+    NodePtr node;
+    uint64_t index;
+    Coordinates coords;
+  };
+
+  /**
+   * @brief Starts speculating analytic expansions for a new search, the workers
+   * must be idle, see SpeculationScope
+   * @param coarse_check_goals Coarse list of goals nodes to plan to
+   * @param max_index Number of nodes in the search graph
+   */
+  void startSpeculation(const NodeVector & coarse_check_goals, const uint64_t & max_index);
+
+  /**
+   * @brief Cancels the pending speculative analytic expansions and waits for the workers
+   */
+  void stopSpeculation();
+
+  /**
+   * @brief Submits a node to speculatively expand to the goals
+   * @param node Node to expand
+   * @param scheduled Whether the analytic expansion of the node is due, rather than
+   * opportunistic, in which case it is only submitted if a worker is idle
+   */
+  void submitSpeculation(const NodePtr & node, const bool & scheduled);
+
+  /**
+   * @brief Takes the nodes found to expand to a goal by the workers since the last call
+   * @param nodes Output nodes
+   */
+  void takeSpeculationResults(NodeVector & nodes);
+
+  /**
+   * @brief Main loop of a speculation worker
+   * @param worker_id Index of the worker
+   */
+  void speculationWorker(const unsigned int worker_id);
+
   MotionModel _motion_model;
   SearchInfo _search_info;
   bool _traverse_unknown;
   unsigned int _dim_3_size;
   GridCollisionChecker * _collision_checker;
   std::list<std::unique_ptr<NodeT>> _detached_nodes;
+
+  // Speculative analytic expansions, evaluated by workers against snapshots of the nodes
+  // and their own copy of the collision checker, and only confirmed on the search thread
+  std::vector<std::thread> _workers;
+  std::vector<std::unique_ptr<GridCollisionChecker>> _worker_collision_checkers;
+  std::mutex _speculation_mutex;
+  std::condition_variable _speculation_cv;
+  std::condition_variable _speculation_idle_cv;
+  std::deque<SpeculativeCandidate> _speculation_queue;
+  NodeVector _speculation_results;
+  std::vector<Coordinates> _speculation_goals;
+  uint64_t _speculation_max_index{0};
+  unsigned int _busy_workers{0};
+  bool _stop_workers{false};
+  bool _speculating{false};
+  std::atomic<uint64_t> _speculation_generation{0};
+  std::atomic<unsigned int> _pending_speculations{0};
+  std::atomic<bool> _has_speculation_results{false};
 };
 
 }  // namespace nav2_smac_planner
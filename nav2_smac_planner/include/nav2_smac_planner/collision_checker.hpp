@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 
+#include "nav2_costmap_2d/cost_values.hpp"
 #include "nav2_costmap_2d/footprint_collision_checker.hpp"
 #include "nav2_costmap_2d/costmap_2d_ros.hpp"
 #include "nav2_smac_planner/constants.hpp"
@@ -123,8 +124,66 @@ public:
   bool outsideRange(const unsigned int & max, const float & value);
 
 protected:
+  /**
+   * @brief Cells of the footprint outline for an orientation bin, as rasterized by
+   * FootprintCollisionChecker::footprintCost() for a pattern of footprint vertex cells
+   */
+  struct OutlineCells
+  {
+    // Vertex cells relative to the pose cell, interleaved X and Y
+    std::vector<int> vertex_cells;
+    // Outline cell index offsets from the pose cell, edge after edge
+    std::vector<int> offsets;
+    // End of each edge in the offsets
+    std::vector<unsigned int> edge_ends;
+  };
+
+  /**
+   * @brief Rasterize the outline cells of the oriented footprints for the current costmap
+   * resolution and width. The outline of an oriented footprint only depends on the vertex
+   * cells relative to the pose cell, which are precomputed along with their alternatives
+   * for vertices lying on a cell boundary, where rounding may go either way.
+   */
+  void precomputeOutlineCells();
+
+  /**
+   * @brief Check the outline of a footprint placed on a pose cell with the semantics
+   * of FootprintCollisionChecker::footprintCost()
+   * @param costs Costmap char map
+   * @param pose_index Index of the pose cell
+   * @param outline Outline cells of the oriented footprint
+   * @param traverse_unknown Whether or not to traverse in unknown space
+   * @return boolean if in collision or not.
+   */
+  bool outlineInCollision(
+    const unsigned char * costs,
+    const int pose_index,
+    const OutlineCells & outline,
+    const bool & traverse_unknown) const;
+
+  /**
+   * @brief Check the outline of a footprint placed on a pose cell, rasterizing it on the fly
+   * @param costs Costmap char map
+   * @param mx X coordinate of the pose cell
+   * @param my Y coordinate of the pose cell
+   * @param oriented_footprint Oriented footprint to check
+   * @param traverse_unknown Whether or not to traverse in unknown space
+   * @return boolean if in collision or not.
+   */
+  bool rasterizedOutlineInCollision(
+    const unsigned char * costs,
+    const unsigned int mx,
+    const unsigned int my,
+    const nav2_costmap_2d::Footprint & oriented_footprint,
+    const bool & traverse_unknown) const;
+
   std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
   std::vector<nav2_costmap_2d::Footprint> oriented_footprints_;
+  // Outline cells for each orientation bin and vertex cells pattern
+  std::vector<std::vector<OutlineCells>> oriented_outlines_;
+  // Costmap geometry the outline cells were precomputed for
+  double outlines_resolution_{0.0};
+  unsigned int outlines_size_x_{0};
   nav2_costmap_2d::Footprint unoriented_footprint_;
   float center_cost_;
   bool footprint_is_radius_{false};
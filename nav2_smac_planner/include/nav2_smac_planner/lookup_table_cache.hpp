@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_SMAC_PLANNER__LOOKUP_TABLE_CACHE_HPP_
+#define NAV2_SMAC_PLANNER__LOOKUP_TABLE_CACHE_HPP_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nav2_smac_planner
+{
+
+/**
+ * @class nav2_smac_planner::LookupTableCache
+ * @brief Persists precomputed lookup tables in a directory, so that they are only computed
+ * once for a given set of inputs rather than at every planner configuration. Tables are
+ * identified by a name and a key hashing all the inputs they were computed from.
+ */
+class LookupTableCache
+{
+public:
+  /**
+   * @brief A constructor for nav2_smac_planner::LookupTableCache
+   * @param directory Directory to store the tables in, caching is disabled if empty
+   */
+  explicit LookupTableCache(const std::string & directory);
+
+  /**
+   * @brief Whether tables are stored
+   */
+  bool isEnabled() const {return !directory_.empty();}
+
+  /**
+   * @brief Adds the bytes of a value to a key, FNV-1a style
+   * @param key Key to update
+   * @param value Value to add to the key
+   */
+  template<typename T>
+  static void hash(uint64_t & key, const T & value)
+  {
+    const unsigned char * bytes = reinterpret_cast<const unsigned char *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      key = (key ^ bytes[i]) * 1099511628211ull;
+    }
+  }
+
+  /**
+   * @brief Initial value of a key
+   */
+  static constexpr uint64_t INITIAL_KEY = 14695981039346656037ull;
+
+  /**
+   * @brief Loads a table
+   * @param name Name of the table
+   * @param key Key of the inputs the table is computed from
+   * @param size Expected number of elements of the table
+   * @param table Output table
+   * @return Whether a valid table was found
+   */
+  bool load(
+    const std::string & name, const uint64_t key, const size_t size,
+    std::vector<float> & table) const;
+
+  /**
+   * @brief Stores a table, replacing any previous table of the same name and key
+   * @param name Name of the table
+   * @param key Key of the inputs the table is computed from
+   * @param table Table to store
+   * @return Whether the table was stored
+   */
+  bool save(const std::string & name, const uint64_t key, const std::vector<float> & table) const;
+
+protected:
+  /**
+   * @brief Gets the file path of a table
+   */
+  std::string getFilePath(const std::string & name, const uint64_t key) const;
+
+  std::string directory_;
+};
+
+}  // namespace nav2_smac_planner
+
+#endif  // NAV2_SMAC_PLANNER__LOOKUP_TABLE_CACHE_HPP_
@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_SMAC_PLANNER__SEARCH_CORRIDOR_HPP_
+#define NAV2_SMAC_PLANNER__SEARCH_CORRIDOR_HPP_
+
+#include <vector>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+
+namespace nav2_smac_planner
+{
+
+/**
+ * @class nav2_smac_planner::SearchCorridor
+ * @brief Corridor around a path planned on a coarse version of the costmap, to restrict
+ * the full resolution search to for hierarchical planning. Each coarse cell takes the lowest
+ * cost of the cells it covers, so that narrow passages remain open on the coarse map. The
+ * coarse path may then cross thin obstacles, in which case the restricted search fails and
+ * the full search should be run instead.
+ */
+class SearchCorridor
+{
+public:
+  /**
+   * @brief A constructor for nav2_smac_planner::SearchCorridor
+   */
+  SearchCorridor() = default;
+
+  /**
+   * @brief Plans on a coarse version of a costmap and sets the corridor around the coarse path
+   * @param costmap Costmap the search runs on
+   * @param start_x X coordinate of the start cell
+   * @param start_y Y coordinate of the start cell
+   * @param goal_x X coordinate of the goal cell
+   * @param goal_y Y coordinate of the goal cell
+   * @param downsampling_factor Number of costmap cells per coarse cell, in each dimension
+   * @param corridor_radius Radius of the corridor around the coarse path, in costmap cells
+   * @param allow_unknown Whether unknown space may be traversed
+   * @return Whether a coarse path was found, the corridor is cleared otherwise
+   */
+  bool compute(
+    const nav2_costmap_2d::Costmap2D & costmap,
+    const unsigned int & start_x, const unsigned int & start_y,
+    const unsigned int & goal_x, const unsigned int & goal_y,
+    const unsigned int & downsampling_factor,
+    const float & corridor_radius,
+    const bool & allow_unknown);
+
+  /**
+   * @brief Clears the corridor
+   */
+  void clear();
+
+  /**
+   * @brief Whether a corridor is set
+   */
+  bool isSet() const {return !_mask.empty();}
+
+  /**
+   * @brief Whether a costmap cell is within the corridor, which must be set
+   * @param mx X coordinate of the cell
+   * @param my Y coordinate of the cell
+   * @return Whether the cell is within the corridor
+   */
+  inline bool contains(const unsigned int & mx, const unsigned int & my) const
+  {
+    const unsigned int cx = mx / _downsampling_factor;
+    const unsigned int cy = my / _downsampling_factor;
+    return cx < _size_x && cy < _size_y && _mask[cy * _size_x + cx];
+  }
+
+  /**
+   * @brief Gets the coarse path of the corridor
+   * @return Coarse cell indices from the start to the goal
+   */
+  const std::vector<unsigned int> & getCoarsePath() const {return _coarse_path;}
+
+protected:
+  /**
+   * @brief Sets the coarse costs, the lowest cost of the costmap cells each coarse cell covers
+   */
+  void downsample(const nav2_costmap_2d::Costmap2D & costmap);
+
+  /**
+   * @brief Plans a path between coarse cells, 8-connected
+   * @return Whether a path was found
+   */
+  bool plan(const unsigned int & start, const unsigned int & goal, const bool & allow_unknown);
+
+  unsigned int _downsampling_factor{1};
+  unsigned int _size_x{0};
+  unsigned int _size_y{0};
+  std::vector<unsigned char> _costs;
+  std::vector<unsigned int> _coarse_path;
+  std::vector<unsigned char> _mask;
+};
+
+}  // namespace nav2_smac_planner
+
+#endif  // NAV2_SMAC_PLANNER__SEARCH_CORRIDOR_HPP_
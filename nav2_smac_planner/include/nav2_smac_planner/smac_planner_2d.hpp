@@ -24,6 +24,7 @@
 #include "nav2_smac_planner/smoother.hpp"
 #include "nav2_smac_planner/utils.hpp"
 #include "nav2_smac_planner/costmap_downsampler.hpp"
+#include "nav2_smac_planner/search_corridor.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
 #include "nav2_core/global_planner.hpp"
 #include "nav_msgs/msg/path.hpp"
@@ -111,6 +112,10 @@ protected:
   bool _downsample_costmap;
   nav2::Publisher<nav_msgs::msg::Path>::SharedPtr _raw_plan_publisher;
   double _max_planning_time;
+  bool _hierarchical_planning;
+  int _hierarchical_downsampling_factor;
+  double _hierarchical_corridor_width;
+  SearchCorridor _search_corridor;
   bool _allow_unknown;
   int _max_iterations;
   int _max_on_approach_iterations;
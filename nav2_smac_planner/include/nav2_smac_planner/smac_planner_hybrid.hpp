@@ -23,6 +23,7 @@
 #include "nav2_smac_planner/smoother.hpp"
 #include "nav2_smac_planner/utils.hpp"
 #include "nav2_smac_planner/costmap_downsampler.hpp"
+#include "nav2_smac_planner/search_corridor.hpp"
 #include "nav_msgs/msg/occupancy_grid.hpp"
 #include "nav2_core/global_planner.hpp"
 #include "nav_msgs/msg/path.hpp"
@@ -125,6 +126,10 @@ protected:
   MotionModel _motion_model;
   GoalHeadingMode _goal_heading_mode;
   int _coarse_search_resolution;
+  bool _hierarchical_planning;
+  int _hierarchical_downsampling_factor;
+  double _hierarchical_corridor_width;
+  SearchCorridor _search_corridor;
   nav2::Publisher<nav_msgs::msg::Path>::SharedPtr _raw_plan_publisher;
   nav2::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr
     _planned_footprints_publisher;
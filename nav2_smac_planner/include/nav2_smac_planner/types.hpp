@@ -45,7 +45,9 @@ struct SearchInfo
   float analytic_expansion_max_length{60.0};
   float analytic_expansion_max_cost{200.0};
   bool analytic_expansion_max_cost_override{false};
+  int analytic_expansion_threads{0};
   std::string lattice_filepath;
+  std::string lookup_table_cache_directory;
   bool cache_obstacle_heuristic{false};
   bool allow_reverse_expansion{false};
   bool allow_primitive_interpolation{false};
@@ -121,6 +121,24 @@ void AStarAlgorithm<NodeT>::setCollisionChecker(GridCollisionChecker * collision
   _expander->setCollisionChecker(_collision_checker);
 }
 
+template<typename NodeT>
+void AStarAlgorithm<NodeT>::setSearchCorridor(const SearchCorridor * search_corridor)
+{
+  _search_corridor = search_corridor && search_corridor->isSet() ? search_corridor : nullptr;
+}
+
+template<typename NodeT>
+void AStarAlgorithm<NodeT>::setMaxPlanningTime(const double & max_planning_time)
+{
+  _max_planning_time = max_planning_time;
+}
+
+template<typename NodeT>
+bool AStarAlgorithm<NodeT>::hasTimedOut() const
+{
+  return _timed_out;
+}
+
 template<typename NodeT>
 typename AStarAlgorithm<NodeT>::NodePtr AStarAlgorithm<NodeT>::addToGraph(
   const uint64_t & index)
@@ -331,6 +349,7 @@ bool AStarAlgorithm<NodeT>::createPath(
   std::vector<std::tuple<float, float, float>> * expansions_log)
 {
   steady_clock::time_point start_time = steady_clock::now();
+  _timed_out = false;
   _tolerance = tolerance;
   _best_heuristic_node = {std::numeric_limits<float>::max(), 0};
   clearQueue();
@@ -369,10 +388,21 @@ bool AStarAlgorithm<NodeT>::createPath(
         return false;
       }
 
+      if (_search_corridor) {
+        const uint64_t cell = index / getSizeDim3();
+        if (!_search_corridor->contains(cell % getSizeX(), cell / getSizeX())) {
+          return false;
+        }
+      }
+
       neighbor_rtn = addToGraph(index);
       return true;
     };
 
+  // Analytic expansions may be speculated by workers until the search ends
+  typename AnalyticExpansion<NodeT>::SpeculationScope speculation(
+    *_expander, coarse_check_goals, max_index);
+
   while (iterations < getMaxIterations() && !_queue.empty()) {
     // Check for planning timeout and cancel only on every Nth iteration
     if (iterations % _terminal_checking_interval == 0) {
@@ -382,6 +412,7 @@ bool AStarAlgorithm<NodeT>::createPath(
       std::chrono::duration<double> planning_duration =
         std::chrono::duration_cast<std::chrono::duration<double>>(steady_clock::now() - start_time);
       if (static_cast<double>(planning_duration.count()) >= _max_planning_time) {
+        _timed_out = true;
         return false;
       }
     }
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <vector>
 #include <memory>
+#include <utility>
 
 #include "nav2_smac_planner/analytic_expansion.hpp"
 
@@ -33,6 +34,29 @@ AnalyticExpansion<NodeT>::AnalyticExpansion(
   _dim_3_size(dim_3_size),
   _collision_checker(nullptr)
 {
+  // Only motion models supporting analytic expansions speculate them
+  if (_motion_model == MotionModel::DUBIN || _motion_model == MotionModel::REEDS_SHEPP ||
+    _motion_model == MotionModel::STATE_LATTICE)
+  {
+    for (int i = 0; i < _search_info.analytic_expansion_threads; ++i) {
+      _workers.emplace_back(&AnalyticExpansion<NodeT>::speculationWorker, this, i);
+    }
+    _worker_collision_checkers.resize(_workers.size());
+  }
+}
+
+template<typename NodeT>
+AnalyticExpansion<NodeT>::~AnalyticExpansion()
+{
+  {
+    std::lock_guard<std::mutex> lock(_speculation_mutex);
+    _stop_workers = true;
+    ++_speculation_generation;
+  }
+  _speculation_cv.notify_all();
+  for (auto & worker : _workers) {
+    worker.join();
+  }
 }
 
 template<typename NodeT>
@@ -60,10 +84,18 @@ typename AnalyticExpansion<NodeT>::NodePtr AnalyticExpansion<NodeT>::tryAnalytic
       NodeT::getCoords(
       current_node->getIndex(), _collision_checker->getCostmap()->getSizeInCellsX(), _dim_3_size);
 
-    AnalyticExpansionNodes current_best_analytic_nodes;
-    NodePtr current_best_goal = nullptr;
-    NodePtr current_best_node = nullptr;
-    float current_best_score = std::numeric_limits<float>::max();
+    // Confirm the expansions found valid by the speculation workers, the search graph
+    // may hold collision results that the workers did not see
+    if (_speculating && _has_speculation_results) {
+      NodeVector speculation_results;
+      takeSpeculationResults(speculation_results);
+      for (auto & node : speculation_results) {
+        NodePtr goal = expandToGoals(node, coarse_check_goals, fine_check_goals, getter);
+        if (goal) {
+          return goal;
+        }
+      }
+    }
 
     closest_distance = std::min(
       closest_distance,
@@ -84,64 +116,297 @@ typename AnalyticExpansion<NodeT>::NodePtr AnalyticExpansion<NodeT>::tryAnalytic
     if (analytic_iterations <= 0) {
       // Reset the counter and try the analytic path expansion
       analytic_iterations = desired_iterations;
-      bool found_valid_expansion = false;
-
-      // First check the coarse search resolution goals
-      for (auto & current_goal_node : coarse_check_goals) {
-        AnalyticExpansionNodes analytic_nodes =
-          getAnalyticPath(
-          current_node, current_goal_node, getter,
-          current_node->motion_table.state_space);
-        if (!analytic_nodes.nodes.empty()) {
-          found_valid_expansion = true;
-          NodePtr node = current_node;
-          float score = refineAnalyticPath(
-            node, current_goal_node, getter, analytic_nodes);
-          // Update the best score if we found a better path
-          if (score < current_best_score) {
-            current_best_analytic_nodes = analytic_nodes;
-            current_best_goal = current_goal_node;
-            current_best_score = score;
-            current_best_node = node;
-          }
+      if (_speculating) {
+        submitSpeculation(current_node, true);
+      } else {
+        NodePtr goal = expandToGoals(current_node, coarse_check_goals, fine_check_goals, getter);
+        if (goal) {
+          return goal;
         }
       }
+    } else if (_speculating) {
+      submitSpeculation(current_node, false);
+    }
 
-      // perform a final search if we found a goal
-      if (found_valid_expansion) {
-        for (auto & current_goal_node : fine_check_goals) {
-          AnalyticExpansionNodes analytic_nodes =
-            getAnalyticPath(
-            current_node, current_goal_node, getter,
-            current_node->motion_table.state_space);
-          if (!analytic_nodes.nodes.empty()) {
-            NodePtr node = current_node;
-            float score = refineAnalyticPath(
-              node, current_goal_node, getter, analytic_nodes);
-            // Update the best score if we found a better path
-            if (score < current_best_score) {
-              current_best_analytic_nodes = analytic_nodes;
-              current_best_goal = current_goal_node;
-              current_best_score = score;
-              current_best_node = node;
-            }
-          }
-        }
+    analytic_iterations--;
+  }
+
+  // No valid motion model - return nullptr
+  return NodePtr(nullptr);
+}
+
+template<typename NodeT>
+typename AnalyticExpansion<NodeT>::NodePtr AnalyticExpansion<NodeT>::expandToGoals(
+  const NodePtr & current_node,
+  const NodeVector & coarse_check_goals,
+  const NodeVector & fine_check_goals,
+  const NodeGetter & getter)
+{
+  AnalyticExpansionNodes current_best_analytic_nodes;
+  NodePtr current_best_goal = nullptr;
+  NodePtr current_best_node = nullptr;
+  float current_best_score = std::numeric_limits<float>::max();
+  bool found_valid_expansion = false;
+
+  // First check the coarse search resolution goals
+  for (auto & current_goal_node : coarse_check_goals) {
+    AnalyticExpansionNodes analytic_nodes =
+      getAnalyticPath(
+      current_node, current_goal_node, getter,
+      current_node->motion_table.state_space);
+    if (!analytic_nodes.nodes.empty()) {
+      found_valid_expansion = true;
+      NodePtr node = current_node;
+      float score = refineAnalyticPath(
+        node, current_goal_node, getter, analytic_nodes);
+      // Update the best score if we found a better path
+      if (score < current_best_score) {
+        current_best_analytic_nodes = analytic_nodes;
+        current_best_goal = current_goal_node;
+        current_best_score = score;
+        current_best_node = node;
       }
     }
+  }
 
-    if (!current_best_analytic_nodes.nodes.empty()) {
-      return setAnalyticPath(
-        current_best_node, current_best_goal,
-        current_best_analytic_nodes);
+  // perform a final search if we found a goal
+  if (found_valid_expansion) {
+    for (auto & current_goal_node : fine_check_goals) {
+      AnalyticExpansionNodes analytic_nodes =
+        getAnalyticPath(
+        current_node, current_goal_node, getter,
+        current_node->motion_table.state_space);
+      if (!analytic_nodes.nodes.empty()) {
+        NodePtr node = current_node;
+        float score = refineAnalyticPath(
+          node, current_goal_node, getter, analytic_nodes);
+        // Update the best score if we found a better path
+        if (score < current_best_score) {
+          current_best_analytic_nodes = analytic_nodes;
+          current_best_goal = current_goal_node;
+          current_best_score = score;
+          current_best_node = node;
+        }
+      }
     }
-    analytic_iterations--;
   }
 
-  // No valid motion model - return nullptr
+  if (!current_best_analytic_nodes.nodes.empty()) {
+    return setAnalyticPath(
+      current_best_node, current_best_goal,
+      current_best_analytic_nodes);
+  }
   return NodePtr(nullptr);
 }
 
+template<typename NodeT>
+void AnalyticExpansion<NodeT>::startSpeculation(
+  const NodeVector & coarse_check_goals,
+  const uint64_t & max_index)
+{
+  _speculating = !_workers.empty() && _collision_checker;
+  if (!_speculating) {
+    return;
+  }
+
+  // The workers are idle, their state may be set without synchronization. The workers
+  // check against their own copy of the collision checker, which keeps the last cost.
+  _speculation_goals.clear();
+  for (const auto & goal : coarse_check_goals) {
+    _speculation_goals.push_back(goal->pose);
+  }
+  _speculation_max_index = max_index;
+  for (auto & collision_checker : _worker_collision_checkers) {
+    collision_checker = std::make_unique<GridCollisionChecker>(*_collision_checker);
+  }
+}
+
+template<typename NodeT>
+void AnalyticExpansion<NodeT>::stopSpeculation()
+{
+  if (!_speculating) {
+    return;
+  }
+  _speculating = false;
+
+  // The workers read the costmap, which must not be released to other threads before
+  // they are done
+  std::unique_lock<std::mutex> lock(_speculation_mutex);
+  ++_speculation_generation;
+  _speculation_queue.clear();
+  _speculation_results.clear();
+  _has_speculation_results = false;
+  _speculation_idle_cv.wait(lock, [this]() {return _busy_workers == 0;});
+  _pending_speculations = 0;
+}
+
+template<typename NodeT>
+void AnalyticExpansion<NodeT>::submitSpeculation(const NodePtr & node, const bool & scheduled)
+{
+  // Avoid locking on each iteration while all the workers are busy
+  if (!scheduled && _pending_speculations >= _workers.size()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_speculation_mutex);
+    if (!scheduled && _speculation_queue.size() + _busy_workers >= _workers.size()) {
+      return;
+    }
+    // Newer nodes are closer to the goal, drop the oldest ones the workers did not get to
+    if (_speculation_queue.size() >= 2 * _workers.size()) {
+      _speculation_queue.pop_front();
+    }
+    _speculation_queue.push_back(SpeculativeCandidate{node, node->getIndex(), node->pose});
+    _pending_speculations = static_cast<unsigned int>(_speculation_queue.size()) + _busy_workers;
+  }
+  _speculation_cv.notify_one();
+}
+
+template<typename NodeT>
+void AnalyticExpansion<NodeT>::takeSpeculationResults(NodeVector & nodes)
+{
+  std::lock_guard<std::mutex> lock(_speculation_mutex);
+  nodes.swap(_speculation_results);
+  _speculation_results.clear();
+  _has_speculation_results = false;
+}
+
+template<typename NodeT>
+void AnalyticExpansion<NodeT>::speculationWorker(const unsigned int worker_id)
+{
+  std::unique_lock<std::mutex> lock(_speculation_mutex);
+  while (true) {
+    _speculation_cv.wait(lock, [this]() {return _stop_workers || !_speculation_queue.empty();});
+    if (_stop_workers) {
+      return;
+    }
+
+    const SpeculativeCandidate candidate = _speculation_queue.front();
+    _speculation_queue.pop_front();
+    const uint64_t generation = _speculation_generation;
+    ++_busy_workers;
+    lock.unlock();
+
+    bool feasible = false;
+    for (const auto & goal : _speculation_goals) {
+      if (isAnalyticPathFeasible(
+          candidate.coords, candidate.index, goal, *_worker_collision_checkers[worker_id],
+          generation))
+      {
+        feasible = true;
+        break;
+      }
+    }
+
+    lock.lock();
+    --_busy_workers;
+    _pending_speculations = static_cast<unsigned int>(_speculation_queue.size()) + _busy_workers;
+    if (feasible && generation == _speculation_generation) {
+      _speculation_results.push_back(candidate.node);
+      _has_speculation_results = true;
+    }
+    _speculation_idle_cv.notify_all();
+  }
+}
+
+template<typename NodeT>
+bool AnalyticExpansion<NodeT>::isAnalyticPathFeasible(
+  const Coordinates & start,
+  const uint64_t & start_index,
+  const Coordinates & goal,
+  GridCollisionChecker & collision_checker,
+  const uint64_t & generation)
+{
+  // Same as getAnalyticPath(), with temporary nodes instead of the search graph ones
+  const ompl::base::StateSpacePtr & state_space = NodeT::motion_table.state_space;
+  ompl::base::ScopedState<> from(state_space), to(state_space), s(state_space);
+  from[0] = start.x;
+  from[1] = start.y;
+  from[2] = NodeT::motion_table.getAngleFromBin(start.theta);
+  to[0] = goal.x;
+  to[1] = goal.y;
+  to[2] = NodeT::motion_table.getAngleFromBin(goal.theta);
+
+  const float d = state_space->distance(from(), to());
+  static const float sqrt_2 = sqrtf(2.0f);
+  if (d > _search_info.analytic_expansion_max_length || d < sqrt_2) {
+    return false;
+  }
+
+  unsigned int num_intervals = static_cast<unsigned int>(std::floor(d / sqrt_2));
+  std::vector<float> node_costs;
+  node_costs.reserve(num_intervals);
+  std::vector<double> reals;
+  double theta;
+  float angle = 0.0;
+  uint64_t index = 0;
+  uint64_t prev_index = start_index;
+  for (float i = 1; i <= num_intervals; i++) {
+    // Cancelled by the end of the search
+    if (generation != _speculation_generation) {
+      return false;
+    }
+
+    state_space->interpolate(from(), to(), i / num_intervals, s());
+    reals = s.reals();
+    theta = (reals[2] < 0.0) ? (reals[2] + 2.0 * M_PI) : reals[2];
+    theta = (theta > 2.0 * M_PI) ? (theta - 2.0 * M_PI) : theta;
+    angle = NodeT::motion_table.getAngle(theta);
+
+    index = NodeT::getIndex(
+      static_cast<unsigned int>(reals[0]),
+      static_cast<unsigned int>(reals[1]),
+      static_cast<unsigned int>(angle));
+    if (index >= _speculation_max_index || index == prev_index) {
+      return false;
+    }
+
+    NodeT node(index);
+    node.setPose(Coordinates(static_cast<float>(reals[0]), static_cast<float>(reals[1]), angle));
+    if (!node.isNodeValid(_traverse_unknown, &collision_checker)) {
+      return false;
+    }
+    node_costs.emplace_back(node.getCost());
+    prev_index = index;
+  }
+
+  return isCostProfileAcceptable(node_costs, d, NodeT::motion_table.min_turning_radius);
+}
+
+template<typename NodeT>
+bool AnalyticExpansion<NodeT>::isCostProfileAcceptable(
+  const std::vector<float> & node_costs,
+  const float & distance,
+  const float & min_turning_radius) const
+{
+  // We found 'a' valid expansion. Now to tell if its a quality option...
+  const float max_cost = _search_info.analytic_expansion_max_cost;
+  auto max_cost_it = std::max_element(node_costs.begin(), node_costs.end());
+  if (max_cost_it == node_costs.end() || *max_cost_it <= max_cost) {
+    return true;
+  }
+
+  // If any element is above the comfortable cost limit, check edge cases:
+  // (1) Check if goal is in greater than max_cost space requiring
+  //  entering it, but only entering it on final approach, not in-and-out
+  // (2) Checks if goal is in normal space, but enters costed space unnecessarily
+  //  mid-way through, skirting obstacle or in non-globally confined space
+  bool cost_exit_high_cost_region = false;
+  for (auto iter = node_costs.rbegin(); iter != node_costs.rend(); ++iter) {
+    const float & curr_cost = *iter;
+    if (curr_cost <= max_cost) {
+      cost_exit_high_cost_region = true;
+    } else if (curr_cost > max_cost && cost_exit_high_cost_region) {
+      // (3) Handle exception: there may be no other option close to goal
+      // if max cost is set too low (optional)
+      return distance < 2.0f * M_PI * min_turning_radius &&
+             _search_info.analytic_expansion_max_cost_override;
+    }
+  }
+  return true;
+}
+
 template<typename NodeT>
 int AnalyticExpansion<NodeT>::countDirectionChanges(
   const ompl::base::ReedsSheppStateSpace::ReedsSheppPath & path)
@@ -255,36 +520,7 @@ typename AnalyticExpansion<NodeT>::AnalyticExpansionNodes AnalyticExpansion<Node
   }
 
   if (!failure) {
-    // We found 'a' valid expansion. Now to tell if its a quality option...
-    const float max_cost = _search_info.analytic_expansion_max_cost;
-    auto max_cost_it = std::max_element(node_costs.begin(), node_costs.end());
-    if (max_cost_it != node_costs.end() && *max_cost_it > max_cost) {
-      // If any element is above the comfortable cost limit, check edge cases:
-      // (1) Check if goal is in greater than max_cost space requiring
-      //  entering it, but only entering it on final approach, not in-and-out
-      // (2) Checks if goal is in normal space, but enters costed space unnecessarily
-      //  mid-way through, skirting obstacle or in non-globally confined space
-      bool cost_exit_high_cost_region = false;
-      for (auto iter = node_costs.rbegin(); iter != node_costs.rend(); ++iter) {
-        const float & curr_cost = *iter;
-        if (curr_cost <= max_cost) {
-          cost_exit_high_cost_region = true;
-        } else if (curr_cost > max_cost && cost_exit_high_cost_region) {
-          failure = true;
-          break;
-        }
-      }
-
-      // (3) Handle exception: there may be no other option close to goal
-      // if max cost is set too low (optional)
-      if (failure) {
-        if (d < 2.0f * M_PI * goal->motion_table.min_turning_radius &&
-          _search_info.analytic_expansion_max_cost_override)
-        {
-          failure = false;
-        }
-      }
-    }
+    failure = !isCostProfileAcceptable(node_costs, d, goal->motion_table.min_turning_radius);
   }
 
   // Reset to initial poses to not impact future searches
@@ -472,6 +708,27 @@ typename AnalyticExpansion<Node2D>::NodePtr AnalyticExpansion<Node2D>::setAnalyt
   return NodePtr(nullptr);
 }
 
+template<>
+typename AnalyticExpansion<Node2D>::NodePtr AnalyticExpansion<Node2D>::expandToGoals(
+  const NodePtr &,
+  const NodeVector &,
+  const NodeVector &,
+  const NodeGetter &)
+{
+  return NodePtr(nullptr);
+}
+
+template<>
+bool AnalyticExpansion<Node2D>::isAnalyticPathFeasible(
+  const Coordinates &,
+  const uint64_t &,
+  const Coordinates &,
+  GridCollisionChecker &,
+  const uint64_t &)
+{
+  return false;
+}
+
 template<>
 typename AnalyticExpansion<Node2D>::NodePtr AnalyticExpansion<Node2D>::tryAnalyticExpansion(
   const NodePtr &,
@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License. Reserved.
 
+#include <cmath>
+#include <cstdint>
+
 #include "nav2_smac_planner/collision_checker.hpp"
+#include "nav2_util/line_iterator.hpp"
 
 namespace nav2_smac_planner
 {
@@ -71,8 +75,13 @@ void GridCollisionChecker::setFootprint(
     return;
   }
 
-  // No change, no updates required
+  // No change, no updates required, unless the costmap geometry changed
   if (footprint == unoriented_footprint_) {
+    if (costmap_ && (outlines_resolution_ != costmap_->getResolution() ||
+      outlines_size_x_ != costmap_->getSizeInCellsX()))
+    {
+      precomputeOutlineCells();
+    }
     return;
   }
 
@@ -99,6 +108,74 @@ void GridCollisionChecker::setFootprint(
   }
 
   unoriented_footprint_ = footprint;
+  precomputeOutlineCells();
+}
+
+void GridCollisionChecker::precomputeOutlineCells()
+{
+  // Beyond this number of patterns, poses with alternative vertex cells are rasterized on the fly
+  static constexpr size_t MAX_VERTEX_CELLS_PATTERNS = 16;
+  // Distance to a cell boundary in cells from which rounding may go either way
+  static constexpr double BOUNDARY_EPSILON = 1e-6;
+
+  oriented_outlines_.clear();
+  if (!costmap_) {
+    return;
+  }
+  outlines_resolution_ = costmap_->getResolution();
+  outlines_size_x_ = costmap_->getSizeInCellsX();
+  const int size_x = static_cast<int>(outlines_size_x_);
+
+  oriented_outlines_.resize(oriented_footprints_.size());
+  for (unsigned int bin = 0; bin != oriented_footprints_.size(); bin++) {
+    const nav2_costmap_2d::Footprint & oriented_footprint = oriented_footprints_[bin];
+    const unsigned int footprint_size = oriented_footprint.size();
+    if (footprint_size == 0) {
+      continue;
+    }
+
+    // The footprint is placed at the pose cell center, so a vertex lands in the cell
+    // at floor(0.5 + v) from the pose cell, v being the vertex coordinate in cells
+    std::vector<std::vector<int>> patterns(1);
+    for (unsigned int j = 0; j < 2 * footprint_size; j++) {
+      const double v = 0.5 + (j % 2 == 0 ? oriented_footprint[j / 2].x :
+        oriented_footprint[j / 2].y) / outlines_resolution_;
+      const int nominal = static_cast<int>(std::floor(v));
+      const int low = static_cast<int>(std::floor(v - BOUNDARY_EPSILON));
+      const int high = static_cast<int>(std::floor(v + BOUNDARY_EPSILON));
+      const int alternative = low != nominal ? low : high;
+      const size_t num_patterns = patterns.size();
+      if (alternative != nominal && 2 * num_patterns <= MAX_VERTEX_CELLS_PATTERNS) {
+        for (size_t k = 0; k < num_patterns; k++) {
+          patterns.push_back(patterns[k]);
+          patterns.back().push_back(alternative);
+        }
+      }
+      for (size_t k = 0; k < num_patterns; k++) {
+        patterns[k].push_back(nominal);
+      }
+    }
+
+    // Rasterize the edges in the order of FootprintCollisionChecker::footprintCost()
+    oriented_outlines_[bin].resize(patterns.size());
+    for (size_t k = 0; k < patterns.size(); k++) {
+      OutlineCells & outline = oriented_outlines_[bin][k];
+      outline.vertex_cells = patterns[k];
+      const std::vector<int> & cells = outline.vertex_cells;
+      auto add_edge = [&](unsigned int a, unsigned int b) {
+          for (nav2_util::LineIterator line(cells[2 * a], cells[2 * a + 1], cells[2 * b],
+            cells[2 * b + 1]); line.isValid(); line.advance())
+          {
+            outline.offsets.push_back(line.getY() * size_x + line.getX());
+          }
+          outline.edge_ends.push_back(outline.offsets.size());
+        };
+      for (unsigned int j = 0; j + 1 < footprint_size; j++) {
+        add_edge(j, j + 1);
+      }
+      add_edge(0, footprint_size - 1);
+    }
+  }
 }
 
 bool GridCollisionChecker::inCollision(
@@ -137,27 +214,49 @@ bool GridCollisionChecker::inCollision(
 
     // if possible inscribed, need to check actual footprint pose.
     // Use precomputed oriented footprints are done on initialization,
-    // offset by translation value to collision check
+    // placed at the center of the pose cell to collision check
+    const unsigned int mx = static_cast<unsigned int>(x);
+    const unsigned int my = static_cast<unsigned int>(y);
     double wx, wy;
-    costmap_->mapToWorld(static_cast<double>(x), static_cast<double>(y), wx, wy);
-    geometry_msgs::msg::Point new_pt;
-    const nav2_costmap_2d::Footprint & oriented_footprint = oriented_footprints_[angle_bin];
-    nav2_costmap_2d::Footprint current_footprint;
-    current_footprint.reserve(oriented_footprint.size());
+    costmap_->mapToWorld(mx, my, wx, wy);
+    const unsigned int bin = static_cast<unsigned int>(angle_bin);
+    const nav2_costmap_2d::Footprint & oriented_footprint = oriented_footprints_[bin];
+    const bool outlines_valid = bin < oriented_outlines_.size() &&
+      outlines_resolution_ == costmap_->getResolution() &&
+      outlines_size_x_ == costmap_->getSizeInCellsX();
+
+    // A footprint vertex off the costmap is a collision, otherwise find the precomputed
+    // outline whose vertex cells match the actual ones
+    uint32_t matching_outlines = outlines_valid ?
+      (1u << oriented_outlines_[bin].size()) - 1u : 0u;
+    unsigned int vx, vy;
     for (unsigned int i = 0; i < oriented_footprint.size(); ++i) {
-      new_pt.x = wx + oriented_footprint[i].x;
-      new_pt.y = wy + oriented_footprint[i].y;
-      current_footprint.push_back(new_pt);
+      if (!costmap_->worldToMap(
+          wx + oriented_footprint[i].x, wy + oriented_footprint[i].y, vx, vy))
+      {
+        return true;
+      }
+      const int dx = static_cast<int>(vx) - static_cast<int>(mx);
+      const int dy = static_cast<int>(vy) - static_cast<int>(my);
+      for (uint32_t k = 0; matching_outlines >> k; ++k) {
+        const std::vector<int> & cells = oriented_outlines_[bin][k].vertex_cells;
+        if (cells[2 * i] != dx || cells[2 * i + 1] != dy) {
+          matching_outlines &= ~(1u << k);
+        }
+      }
     }
 
-    float footprint_cost = static_cast<float>(footprintCost(current_footprint));
-
-    if (footprint_cost == UNKNOWN_COST && traverse_unknown) {
-      return false;
+    const unsigned char * costs = costmap_->getCharMap();
+    if (matching_outlines == 0u) {
+      return rasterizedOutlineInCollision(costs, mx, my, oriented_footprint, traverse_unknown);
     }
-
-    // if occupied or unknown and not to traverse unknown space
-    return footprint_cost >= OCCUPIED_COST;
+    unsigned int k = 0;
+    while (!(matching_outlines & (1u << k))) {
+      ++k;
+    }
+    return outlineInCollision(
+      costs, static_cast<int>(costmap_->getIndex(mx, my)), oriented_outlines_[bin][k],
+      traverse_unknown);
   } else {
     // if radius, then we can check the center of the cost assuming inflation is used
     if (center_cost_ == UNKNOWN_COST && traverse_unknown) {
@@ -182,6 +281,85 @@ bool GridCollisionChecker::inCollision(
   return center_cost_ >= INSCRIBED_COST;
 }
 
+bool GridCollisionChecker::outlineInCollision(
+  const unsigned char * costs,
+  const int pose_index,
+  const OutlineCells & outline,
+  const bool & traverse_unknown) const
+{
+  // footprintCost() stops at the first lethal cell, and the maximum cost is unknown
+  // if an edge before that one had an unknown cell
+  unsigned int i = 0;
+  for (const unsigned int edge_end : outline.edge_ends) {
+    bool unknown = false;
+    for (; i < edge_end; ++i) {
+      const unsigned char cost = costs[pose_index + outline.offsets[i]];
+      if (cost == nav2_costmap_2d::LETHAL_OBSTACLE) {
+        return true;
+      }
+      if (cost == nav2_costmap_2d::NO_INFORMATION) {
+        if (!traverse_unknown) {
+          return true;
+        }
+        unknown = true;
+      }
+    }
+    if (unknown) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool GridCollisionChecker::rasterizedOutlineInCollision(
+  const unsigned char * costs,
+  const unsigned int mx,
+  const unsigned int my,
+  const nav2_costmap_2d::Footprint & oriented_footprint,
+  const bool & traverse_unknown) const
+{
+  const unsigned int footprint_size = oriented_footprint.size();
+  if (footprint_size == 0) {
+    return false;
+  }
+
+  // Same as outlineInCollision(), rasterizing the edges between the vertex cells,
+  // which are known to be within the costmap
+  double wx, wy;
+  costmap_->mapToWorld(mx, my, wx, wy);
+  const unsigned int size_x = costmap_->getSizeInCellsX();
+  auto vertex_cell = [&](unsigned int i, unsigned int & vx, unsigned int & vy) {
+      costmap_->worldToMap(wx + oriented_footprint[i].x, wy + oriented_footprint[i].y, vx, vy);
+    };
+  unsigned int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+  for (unsigned int j = 0; j < footprint_size; ++j) {
+    if (j + 1 < footprint_size) {
+      vertex_cell(j, x0, y0);
+      vertex_cell(j + 1, x1, y1);
+    } else {
+      vertex_cell(0, x0, y0);
+      vertex_cell(footprint_size - 1, x1, y1);
+    }
+    bool unknown = false;
+    for (nav2_util::LineIterator line(x0, y0, x1, y1); line.isValid(); line.advance()) {
+      const unsigned char cost = costs[line.getY() * size_x + line.getX()];
+      if (cost == nav2_costmap_2d::LETHAL_OBSTACLE) {
+        return true;
+      }
+      if (cost == nav2_costmap_2d::NO_INFORMATION) {
+        if (!traverse_unknown) {
+          return true;
+        }
+        unknown = true;
+      }
+    }
+    if (unknown) {
+      return false;
+    }
+  }
+  return false;
+}
+
 float GridCollisionChecker::getCost()
 {
   // Assumes inCollision called prior
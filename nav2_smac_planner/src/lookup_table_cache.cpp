@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "nav2_smac_planner/lookup_table_cache.hpp"
+
+namespace nav2_smac_planner
+{
+
+namespace
+{
+
+// Header of the table files, followed by the table elements
+struct TableHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t element_size;
+  uint64_t key;
+  uint64_t size;
+};
+
+constexpr char MAGIC[8] = "SMACLUT";
+constexpr uint32_t VERSION = 1;
+
+}  // namespace
+
+LookupTableCache::LookupTableCache(const std::string & directory)
+: directory_(directory)
+{
+}
+
+std::string LookupTableCache::getFilePath(const std::string & name, const uint64_t key) const
+{
+  char key_str[17];
+  snprintf(key_str, sizeof(key_str), "%016llx", static_cast<unsigned long long>(key));
+  return (std::filesystem::path(directory_) / (name + "_" + key_str + ".bin")).string();
+}
+
+bool LookupTableCache::load(
+  const std::string & name, const uint64_t key, const size_t size,
+  std::vector<float> & table) const
+{
+  if (!isEnabled()) {
+    return false;
+  }
+
+  std::ifstream file(getFilePath(name, key), std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  // Only use a table matching the expected inputs and size in full
+  TableHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+    std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+    header.element_size != sizeof(float) || header.key != key || header.size != size)
+  {
+    return false;
+  }
+
+  std::vector<float> loaded_table(size);
+  if (!file.read(reinterpret_cast<char *>(loaded_table.data()), size * sizeof(float)) ||
+    file.peek() != std::ifstream::traits_type::eof())
+  {
+    return false;
+  }
+  table.swap(loaded_table);
+  return true;
+}
+
+bool LookupTableCache::save(
+  const std::string & name, const uint64_t key, const std::vector<float> & table) const
+{
+  if (!isEnabled()) {
+    return false;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  if (error) {
+    return false;
+  }
+
+  // Write to a temporary file then rename it, so that concurrent planners
+  // never read a partially written table
+  const std::string path = getFilePath(name, key);
+  const std::string tmp_path = path + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return false;
+    }
+    TableHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.element_size = sizeof(float);
+    header.key = key;
+    header.size = table.size();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(float));
+    if (!file) {
+      file.close();
+      std::filesystem::remove(tmp_path, error);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmp_path, path, error);
+  if (error) {
+    std::filesystem::remove(tmp_path, error);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace nav2_smac_planner
@@ -27,6 +27,7 @@
 #include "ompl/base/spaces/DubinsStateSpace.h"
 #include "ompl/base/spaces/ReedsSheppStateSpace.h"
 
+#include "nav2_smac_planner/lookup_table_cache.hpp"
 #include "nav2_smac_planner/node_hybrid.hpp"
 
 using namespace std::chrono;  // NOLINT
@@ -816,13 +817,25 @@ void NodeHybrid::precomputeDistanceHeuristic(
   unsigned int index = 0;
   int dim_3_size_int = static_cast<int>(dim_3_size);
   float angular_bin_size = 2 * M_PI / static_cast<float>(dim_3_size);
+  const size_t table_size = size_lookup * ceil(size_lookup / 2.0) * dim_3_size_int;
+
+  // Reuse the table computed for the same inputs, if any
+  LookupTableCache cache(search_info.lookup_table_cache_directory);
+  uint64_t key = LookupTableCache::INITIAL_KEY;
+  LookupTableCache::hash(key, motion_model);
+  LookupTableCache::hash(key, search_info.minimum_turning_radius);
+  LookupTableCache::hash(key, size_lookup);
+  LookupTableCache::hash(key, dim_3_size);
+  if (cache.load("hybrid_distance_heuristic", key, table_size, dist_heuristic_lookup_table)) {
+    return;
+  }
 
   // Create a lookup table of Dubin/Reeds-Shepp distances in a window around the goal
   // to help drive the search towards admissible approaches. Deu to symmetries in the
   // Heuristic space, we need to only store 2 of the 4 quadrants and simply mirror
   // around the X axis any relative node lookup. This reduces memory overhead and increases
   // the size of a window a platform can store in memory.
-  dist_heuristic_lookup_table.resize(size_lookup * ceil(size_lookup / 2.0) * dim_3_size_int);
+  dist_heuristic_lookup_table.resize(table_size);
   for (float x = ceil(-size_lookup / 2.0); x <= floor(size_lookup / 2.0); x += 1.0) {
     for (float y = 0.0; y <= floor(size_lookup / 2.0); y += 1.0) {
       for (int heading = 0; heading != dim_3_size_int; heading++) {
@@ -835,6 +848,8 @@ void NodeHybrid::precomputeDistanceHeuristic(
       }
     }
   }
+
+  cache.save("hybrid_distance_heuristic", key, dist_heuristic_lookup_table);
 }
 
 void NodeHybrid::getNeighbors(
@@ -15,11 +15,15 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <filesystem>
 #include <fstream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "angles/angles.h"
@@ -28,6 +32,7 @@
 #include "ompl/base/spaces/DubinsStateSpace.h"
 #include "ompl/base/spaces/ReedsSheppStateSpace.h"
 
+#include "nav2_smac_planner/lookup_table_cache.hpp"
 #include "nav2_smac_planner/node_lattice.hpp"
 
 using namespace std::chrono;  // NOLINT
@@ -40,6 +45,80 @@ LatticeMotionTable NodeLattice::motion_table;
 float NodeLattice::size_lookup = 25;
 LookupTable NodeLattice::dist_heuristic_lookup_table;
 
+namespace
+{
+
+/**
+ * @brief Contents of a parsed lattice file, with the primitives grouped by start angle
+ */
+struct LatticeFile
+{
+  std::filesystem::file_time_type write_time;
+  std::uintmax_t size;
+  LatticeMetadata metadata;
+  std::vector<MotionPrimitives> motion_primitives;
+};
+
+/**
+ * @brief Parses a lattice file once per process, and again only if it was modified since,
+ * since the metadata and primitives are requested on every planner configuration
+ * @param lattice_filepath Path of the lattice file
+ * @return Parsed lattice file
+ */
+std::shared_ptr<const LatticeFile> parseLatticeFile(const std::string & lattice_filepath)
+{
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::shared_ptr<const LatticeFile>> lattice_files;
+
+  std::error_code ec;
+  const auto write_time = std::filesystem::last_write_time(lattice_filepath, ec);
+  const auto size = ec ? 0 : std::filesystem::file_size(lattice_filepath, ec);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = lattice_files.find(lattice_filepath);
+  if (!ec && it != lattice_files.end() && it->second->write_time == write_time &&
+    it->second->size == size)
+  {
+    return it->second;
+  }
+
+  std::ifstream lattice_file(lattice_filepath);
+  if (!lattice_file.is_open()) {
+    throw std::runtime_error("Could not open lattice file!");
+  }
+
+  nlohmann::json json;
+  lattice_file >> json;
+  auto parsed = std::make_shared<LatticeFile>();
+  parsed->write_time = write_time;
+  parsed->size = size;
+  fromJsonToMetaData(json["lattice_metadata"], parsed->metadata);
+
+  // Group the motion primitives by heading angle
+  float prev_start_angle = 0.0;
+  MotionPrimitives primitives;
+  nlohmann::json json_primitives = json["primitives"];
+  for (unsigned int i = 0; i < json_primitives.size(); ++i) {
+    MotionPrimitive new_primitive;
+    fromJsonToMotionPrimitive(json_primitives[i], new_primitive);
+
+    if (prev_start_angle != new_primitive.start_angle) {
+      parsed->motion_primitives.push_back(primitives);
+      primitives.clear();
+      prev_start_angle = new_primitive.start_angle;
+    }
+    primitives.push_back(new_primitive);
+  }
+  parsed->motion_primitives.push_back(primitives);
+
+  if (!ec) {
+    lattice_files[lattice_filepath] = parsed;
+  }
+  return parsed;
+}
+
+}  // namespace
+
 // Each of these tables are the projected motion models through
 // time and space applied to the search on the current node in
 // continuous map-coordinates (e.g. not meters but partial map cells)
@@ -68,13 +147,8 @@ void LatticeMotionTable::initMotionModel(
   min_turning_radius = search_info.minimum_turning_radius;
 
   // Get the metadata about this minimum control set
-  lattice_metadata = getLatticeMetadata(current_lattice_filepath);
-  std::ifstream latticeFile(current_lattice_filepath);
-  if (!latticeFile.is_open()) {
-    throw std::runtime_error("Could not open lattice file");
-  }
-  nlohmann::json json;
-  latticeFile >> json;
+  const auto lattice_file = parseLatticeFile(current_lattice_filepath);
+  lattice_metadata = lattice_file->metadata;
   num_angle_quantization = lattice_metadata.number_of_headings;
 
   if (!state_space) {
@@ -90,23 +164,10 @@ void LatticeMotionTable::initMotionModel(
   }
 
   // Populate the motion primitives at each heading angle
-  float prev_start_angle = 0.0;
-  std::vector<MotionPrimitive> primitives;
-  nlohmann::json json_primitives = json["primitives"];
-  for (unsigned int i = 0; i < json_primitives.size(); ++i) {
-    MotionPrimitive new_primitive;
-    fromJsonToMotionPrimitive(json_primitives[i], new_primitive);
-
-    if (prev_start_angle != new_primitive.start_angle) {
-      motion_primitives.push_back(primitives);
-      primitives.clear();
-      prev_start_angle = new_primitive.start_angle;
-    }
-    primitives.push_back(new_primitive);
-  }
-  motion_primitives.push_back(primitives);
+  motion_primitives = lattice_file->motion_primitives;
 
   // Populate useful precomputed values to be leveraged
+  trig_values.clear();
   trig_values.reserve(lattice_metadata.number_of_headings);
   for (unsigned int i = 0; i < lattice_metadata.heading_angles.size(); ++i) {
     trig_values.emplace_back(
@@ -149,16 +210,7 @@ MotionPrimitivePtrs LatticeMotionTable::getMotionPrimitives(
 
 LatticeMetadata LatticeMotionTable::getLatticeMetadata(const std::string & lattice_filepath)
 {
-  std::ifstream lattice_file(lattice_filepath);
-  if (!lattice_file.is_open()) {
-    throw std::runtime_error("Could not open lattice file!");
-  }
-
-  nlohmann::json j;
-  lattice_file >> j;
-  LatticeMetadata metadata;
-  fromJsonToMetaData(j["lattice_metadata"], metadata);
-  return metadata;
+  return parseLatticeFile(lattice_filepath)->metadata;
 }
 
 unsigned int LatticeMotionTable::getClosestAngularBin(const double & theta)
@@ -470,13 +522,28 @@ void NodeLattice::precomputeDistanceHeuristic(
   float motion_heuristic = 0.0;
   unsigned int index = 0;
   int dim_3_size_int = static_cast<int>(dim_3_size);
+  const size_t table_size = size_lookup * ceil(size_lookup / 2.0) * dim_3_size_int;
+
+  // Reuse the table computed for the same inputs, if any
+  LookupTableCache cache(search_info.lookup_table_cache_directory);
+  uint64_t key = LookupTableCache::INITIAL_KEY;
+  LookupTableCache::hash(key, motion_table.motion_model);
+  LookupTableCache::hash(key, search_info.minimum_turning_radius);
+  LookupTableCache::hash(key, size_lookup);
+  LookupTableCache::hash(key, dim_3_size);
+  for (int heading = 0; heading != dim_3_size_int; heading++) {
+    LookupTableCache::hash(key, motion_table.getAngleFromBin(heading));
+  }
+  if (cache.load("lattice_distance_heuristic", key, table_size, dist_heuristic_lookup_table)) {
+    return;
+  }
 
   // Create a lookup table of Dubin/Reeds-Shepp distances in a window around the goal
   // to help drive the search towards admissible approaches. Due to symmetries in the
   // Heuristic space, we need to only store 2 of the 4 quadrants and simply mirror
   // around the X axis any relative node lookup. This reduces memory overhead and increases
   // the size of a window a platform can store in memory.
-  dist_heuristic_lookup_table.resize(size_lookup * ceil(size_lookup / 2.0) * dim_3_size_int);
+  dist_heuristic_lookup_table.resize(table_size);
   for (float x = ceil(-size_lookup / 2.0); x <= floor(size_lookup / 2.0); x += 1.0) {
     for (float y = 0.0; y <= floor(size_lookup / 2.0); y += 1.0) {
       for (int heading = 0; heading != dim_3_size_int; heading++) {
@@ -489,6 +556,8 @@ void NodeLattice::precomputeDistanceHeuristic(
       }
     }
   }
+
+  cache.save("lattice_distance_heuristic", key, dist_heuristic_lookup_table);
 }
 
 void NodeLattice::getNeighbors(
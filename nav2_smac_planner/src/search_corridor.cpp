@@ -0,0 +1,170 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "nav2_smac_planner/constants.hpp"
+#include "nav2_smac_planner/search_corridor.hpp"
+
+namespace nav2_smac_planner
+{
+
+bool SearchCorridor::compute(
+  const nav2_costmap_2d::Costmap2D & costmap,
+  const unsigned int & start_x, const unsigned int & start_y,
+  const unsigned int & goal_x, const unsigned int & goal_y,
+  const unsigned int & downsampling_factor,
+  const float & corridor_radius,
+  const bool & allow_unknown)
+{
+  clear();
+  _downsampling_factor = std::max(downsampling_factor, 1u);
+  _size_x = (costmap.getSizeInCellsX() + _downsampling_factor - 1) / _downsampling_factor;
+  _size_y = (costmap.getSizeInCellsY() + _downsampling_factor - 1) / _downsampling_factor;
+  if (start_x >= costmap.getSizeInCellsX() || start_y >= costmap.getSizeInCellsY() ||
+    goal_x >= costmap.getSizeInCellsX() || goal_y >= costmap.getSizeInCellsY())
+  {
+    return false;
+  }
+
+  downsample(costmap);
+  const unsigned int start = (start_y / _downsampling_factor) * _size_x +
+    start_x / _downsampling_factor;
+  const unsigned int goal = (goal_y / _downsampling_factor) * _size_x +
+    goal_x / _downsampling_factor;
+  if (!plan(start, goal, allow_unknown)) {
+    _coarse_path.clear();
+    return false;
+  }
+
+  // Stamp a disk around each cell of the coarse path
+  const int radius = static_cast<int>(std::ceil(corridor_radius / _downsampling_factor));
+  const int radius_sq = radius * radius;
+  _mask.assign(_size_x * _size_y, 0);
+  for (const unsigned int & index : _coarse_path) {
+    const int cx = static_cast<int>(index % _size_x);
+    const int cy = static_cast<int>(index / _size_x);
+    for (int dy = -radius; dy <= radius; ++dy) {
+      const int y = cy + dy;
+      if (y < 0 || y >= static_cast<int>(_size_y)) {
+        continue;
+      }
+      const int dx_max = static_cast<int>(std::sqrt(static_cast<float>(radius_sq - dy * dy)));
+      const int x_min = std::max(cx - dx_max, 0);
+      const int x_max = std::min(cx + dx_max, static_cast<int>(_size_x) - 1);
+      std::fill(
+        _mask.begin() + y * _size_x + x_min, _mask.begin() + y * _size_x + x_max + 1, 1);
+    }
+  }
+  return true;
+}
+
+void SearchCorridor::clear()
+{
+  _mask.clear();
+  _coarse_path.clear();
+}
+
+void SearchCorridor::downsample(const nav2_costmap_2d::Costmap2D & costmap)
+{
+  const unsigned int size_x = costmap.getSizeInCellsX();
+  const unsigned int size_y = costmap.getSizeInCellsY();
+  const unsigned char * char_map = costmap.getCharMap();
+  _costs.assign(_size_x * _size_y, 255);
+  for (unsigned int my = 0; my < size_y; ++my) {
+    unsigned char * coarse_row = &_costs[(my / _downsampling_factor) * _size_x];
+    const unsigned char * row = char_map + my * size_x;
+    for (unsigned int mx = 0; mx < size_x; ++mx) {
+      unsigned char & coarse_cost = coarse_row[mx / _downsampling_factor];
+      coarse_cost = std::min(coarse_cost, row[mx]);
+    }
+  }
+}
+
+bool SearchCorridor::plan(
+  const unsigned int & start, const unsigned int & goal, const bool & allow_unknown)
+{
+  const unsigned int size = _size_x * _size_y;
+  const int goal_x = static_cast<int>(goal % _size_x);
+  const int goal_y = static_cast<int>(goal / _size_x);
+  static const float sqrt_2 = std::sqrt(2.0f);
+  auto heuristic = [&](const unsigned int & index) {
+      const float dx = std::abs(static_cast<int>(index % _size_x) - goal_x);
+      const float dy = std::abs(static_cast<int>(index / _size_x) - goal_y);
+      return std::max(dx, dy) + (sqrt_2 - 1.0f) * std::min(dx, dy);
+    };
+  auto is_traversable = [&](const unsigned int & index) {
+      const float cost = static_cast<float>(_costs[index]);
+      return cost < INSCRIBED_COST || (cost == UNKNOWN_COST && allow_unknown) ||
+             index == start || index == goal;
+    };
+
+  // A* on the coarse cells, with the traversal cost of the 2D search
+  std::vector<float> g_costs(size, std::numeric_limits<float>::max());
+  std::vector<unsigned int> parents(size, std::numeric_limits<unsigned int>::max());
+  using QueueElement = std::pair<float, unsigned int>;
+  std::priority_queue<QueueElement, std::vector<QueueElement>, std::greater<QueueElement>> queue;
+  g_costs[start] = 0.0f;
+  queue.emplace(heuristic(start), start);
+  static const int dx[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+  static const int dy[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+  while (!queue.empty()) {
+    const auto [f_cost, index] = queue.top();
+    queue.pop();
+    if (index == goal) {
+      for (unsigned int i = goal; i != start; i = parents[i]) {
+        _coarse_path.push_back(i);
+      }
+      _coarse_path.push_back(start);
+      std::reverse(_coarse_path.begin(), _coarse_path.end());
+      return true;
+    }
+    const float g_cost = g_costs[index];
+    if (f_cost > g_cost + heuristic(index)) {
+      // Already expanded with a lower cost
+      continue;
+    }
+
+    const int x = static_cast<int>(index % _size_x);
+    const int y = static_cast<int>(index / _size_x);
+    for (unsigned int i = 0; i < 8; ++i) {
+      const int nx = x + dx[i];
+      const int ny = y + dy[i];
+      if (nx < 0 || ny < 0 || nx >= static_cast<int>(_size_x) || ny >= static_cast<int>(_size_y)) {
+        continue;
+      }
+      const unsigned int neighbor = static_cast<unsigned int>(ny) * _size_x + nx;
+      if (!is_traversable(neighbor)) {
+        continue;
+      }
+      const float cost = static_cast<float>(_costs[neighbor]);
+      const float normalized_cost = cost == UNKNOWN_COST ? 0.0f : cost / MAX_NON_OBSTACLE_COST;
+      const float new_g_cost = g_cost + (i < 4 ? 1.0f : sqrt_2) * (1.0f + normalized_cost);
+      if (new_g_cost < g_costs[neighbor]) {
+        g_costs[neighbor] = new_g_cost;
+        parents[neighbor] = index;
+        queue.emplace(new_g_cost + heuristic(neighbor), neighbor);
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace nav2_smac_planner
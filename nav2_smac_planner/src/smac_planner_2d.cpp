@@ -93,6 +93,17 @@ void SmacPlanner2D::configure(
   nav2::declare_parameter_if_not_declared(
     node, name + ".max_planning_time", rclcpp::ParameterValue(2.0));
   node->get_parameter(name + ".max_planning_time", _max_planning_time);
+
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".hierarchical_planning", rclcpp::ParameterValue(false));
+  node->get_parameter(name + ".hierarchical_planning", _hierarchical_planning);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".hierarchical_downsampling_factor", rclcpp::ParameterValue(8));
+  node->get_parameter(
+    name + ".hierarchical_downsampling_factor", _hierarchical_downsampling_factor);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".hierarchical_corridor_width", rclcpp::ParameterValue(4.0));
+  node->get_parameter(name + ".hierarchical_corridor_width", _hierarchical_corridor_width);
   // Note that we need to declare it here to prevent the parameter from being declared in the
   // dynamic reconfigure callback
   nav2::declare_parameter_if_not_declared(
@@ -282,11 +293,45 @@ nav_msgs::msg::Path SmacPlanner2D::createPlan(
   // Compute plan
   Node2D::CoordinateVector path;
   int num_iterations = 0;
+  // Restrict the search to a corridor around a path planned on a coarse costmap, if hierarchical
+  bool corridor_set = false;
+  if (_hierarchical_planning) {
+    corridor_set = _search_corridor.compute(
+      *costmap, static_cast<unsigned int>(mx_start), static_cast<unsigned int>(my_start),
+      static_cast<unsigned int>(mx_goal), static_cast<unsigned int>(my_goal),
+      static_cast<unsigned int>(std::max(_hierarchical_downsampling_factor, 1)),
+      0.5 * _hierarchical_corridor_width / costmap->getResolution(), _allow_unknown);
+  }
+  _a_star->setSearchCorridor(corridor_set ? &_search_corridor : nullptr);
+  _a_star->setMaxPlanningTime(_max_planning_time);
+
   // Note: All exceptions thrown are handled by the planner server and returned to the action
-  if (!_a_star->createPath(
-      path, num_iterations,
-      _tolerance / static_cast<float>(costmap->getResolution()), cancel_checker))
+  bool path_found = _a_star->createPath(
+    path, num_iterations,
+    _tolerance / static_cast<float>(costmap->getResolution()), cancel_checker);
+
+  // The coarse costmap may hide obstacles blocking the corridor, fall back to the full search
+  // within the time left if the corridor was exhausted, but not if the search ran out of time
+  // or iterations
+  const double fallback_time = _max_planning_time -
+    duration_cast<duration<double>>(steady_clock::now() - a).count();
+  if (!path_found && corridor_set && !_a_star->hasTimedOut() &&
+    num_iterations < _a_star->getMaxIterations() && fallback_time > 0.0)
   {
+    RCLCPP_DEBUG(_logger, "No path found within the search corridor, searching the full costmap");
+    _a_star->setSearchCorridor(nullptr);
+    _a_star->setMaxPlanningTime(fallback_time);
+    _a_star->setCollisionChecker(&_collision_checker);
+    _a_star->setStart(mx_start, my_start, 0);
+    _a_star->setGoal(mx_goal, my_goal, 0);
+    path.clear();
+    num_iterations = 0;
+    path_found = _a_star->createPath(
+      path, num_iterations,
+      _tolerance / static_cast<float>(costmap->getResolution()), cancel_checker);
+  }
+
+  if (!path_found) {
     // Note: If the start is blocked only one iteration will occur before failure
     if (num_iterations == 1) {
       throw nav2_core::StartOccupied("Start occupied");
@@ -366,7 +411,9 @@ SmacPlanner2D::dynamicParametersCallback(std::vector<rclcpp::Parameter> paramete
       continue;
     }
     if (param_type == ParameterType::PARAMETER_DOUBLE) {
-      if (param_name == _name + ".tolerance") {
+      if (param_name == _name + ".hierarchical_corridor_width") {
+        _hierarchical_corridor_width = parameter.as_double();
+      } else if (param_name == _name + ".tolerance") {
         _tolerance = static_cast<float>(parameter.as_double());
       } else if (param_name == _name + ".cost_travel_multiplier") {
         reinit_a_star = true;
@@ -376,7 +423,9 @@ SmacPlanner2D::dynamicParametersCallback(std::vector<rclcpp::Parameter> paramete
         _max_planning_time = parameter.as_double();
       }
     } else if (param_type == ParameterType::PARAMETER_BOOL) {
-      if (param_name == _name + ".downsample_costmap") {
+      if (param_name == _name + ".hierarchical_planning") {
+        _hierarchical_planning = parameter.as_bool();
+      } else if (param_name == _name + ".downsample_costmap") {
         reinit_downsampler = true;
         _downsample_costmap = parameter.as_bool();
       } else if (param_name == _name + ".allow_unknown") {
@@ -386,7 +435,9 @@ SmacPlanner2D::dynamicParametersCallback(std::vector<rclcpp::Parameter> paramete
         _use_final_approach_orientation = parameter.as_bool();
       }
     } else if (param_type == ParameterType::PARAMETER_INTEGER) {
-      if (param_name == _name + ".downsampling_factor") {
+      if (param_name == _name + ".hierarchical_downsampling_factor") {
+        _hierarchical_downsampling_factor = parameter.as_int();
+      } else if (param_name == _name + ".downsampling_factor") {
         reinit_downsampler = true;
         _downsampling_factor = parameter.as_int();
       } else if (param_name == _name + ".max_iterations") {
@@ -137,6 +137,10 @@ void SmacPlannerHybrid::configure(
   node->get_parameter(
     name + ".analytic_expansion_max_cost_override",
     _search_info.analytic_expansion_max_cost_override);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".analytic_expansion_threads", rclcpp::ParameterValue(0));
+  node->get_parameter(
+    name + ".analytic_expansion_threads", _search_info.analytic_expansion_threads);
   nav2::declare_parameter_if_not_declared(
     node, name + ".use_quadratic_cost_penalty", rclcpp::ParameterValue(false));
   node->get_parameter(
@@ -158,6 +162,10 @@ void SmacPlannerHybrid::configure(
   nav2::declare_parameter_if_not_declared(
     node, name + ".lookup_table_size", rclcpp::ParameterValue(20.0));
   node->get_parameter(name + ".lookup_table_size", _lookup_table_size);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".lookup_table_cache_directory", rclcpp::ParameterValue(std::string("")));
+  node->get_parameter(
+    name + ".lookup_table_cache_directory", _search_info.lookup_table_cache_directory);
 
   nav2::declare_parameter_if_not_declared(
     node, name + ".debug_visualizations", rclcpp::ParameterValue(false));
@@ -181,6 +189,17 @@ void SmacPlannerHybrid::configure(
     node, name + ".coarse_search_resolution", rclcpp::ParameterValue(1));
   node->get_parameter(name + ".coarse_search_resolution", _coarse_search_resolution);
 
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".hierarchical_planning", rclcpp::ParameterValue(false));
+  node->get_parameter(name + ".hierarchical_planning", _hierarchical_planning);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".hierarchical_downsampling_factor", rclcpp::ParameterValue(8));
+  node->get_parameter(
+    name + ".hierarchical_downsampling_factor", _hierarchical_downsampling_factor);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".hierarchical_corridor_width", rclcpp::ParameterValue(4.0));
+  node->get_parameter(name + ".hierarchical_corridor_width", _hierarchical_corridor_width);
+
   if (_goal_heading_mode == GoalHeadingMode::UNKNOWN) {
     std::string error_msg = "Unable to get GoalHeader type. Given '" + goal_heading_type + "' "
       "Valid options are DEFAULT, BIDIRECTIONAL, ALL_DIRECTION. ";
@@ -422,7 +441,8 @@ nav_msgs::msg::Path SmacPlannerHybrid::createPlan(
   if (orientation_bin >= static_cast<float>(_angle_quantizations)) {
     orientation_bin -= static_cast<float>(_angle_quantizations);
   }
-  _a_star->setStart(mx_start, my_start, static_cast<unsigned int>(orientation_bin));
+  const unsigned int start_bin = static_cast<unsigned int>(orientation_bin);
+  _a_star->setStart(mx_start, my_start, start_bin);
 
   // Set goal point, in A* bin search coordinates
   if (!costmap->worldToMapContinuous(
@@ -443,8 +463,8 @@ nav_msgs::msg::Path SmacPlannerHybrid::createPlan(
   if (orientation_bin >= static_cast<float>(_angle_quantizations)) {
     orientation_bin -= static_cast<float>(_angle_quantizations);
   }
-  _a_star->setGoal(mx_goal, my_goal, static_cast<unsigned int>(orientation_bin),
-    _goal_heading_mode, _coarse_search_resolution);
+  const unsigned int goal_bin = static_cast<unsigned int>(orientation_bin);
+  _a_star->setGoal(mx_goal, my_goal, goal_bin, _goal_heading_mode, _coarse_search_resolution);
 
   // Setup message
   nav_msgs::msg::Path plan;
@@ -482,11 +502,48 @@ nav_msgs::msg::Path SmacPlannerHybrid::createPlan(
   if (_debug_visualizations) {
     expansions = std::make_unique<std::vector<std::tuple<float, float, float>>>();
   }
+  // Restrict the search to a corridor around a path planned on a coarse costmap, if hierarchical
+  bool corridor_set = false;
+  if (_hierarchical_planning) {
+    corridor_set = _search_corridor.compute(
+      *costmap, static_cast<unsigned int>(mx_start), static_cast<unsigned int>(my_start),
+      static_cast<unsigned int>(mx_goal), static_cast<unsigned int>(my_goal),
+      static_cast<unsigned int>(std::max(_hierarchical_downsampling_factor, 1)),
+      0.5 * _hierarchical_corridor_width / costmap->getResolution(), _allow_unknown);
+  }
+  _a_star->setSearchCorridor(corridor_set ? &_search_corridor : nullptr);
+  _a_star->setMaxPlanningTime(_max_planning_time);
+
   // Note: All exceptions thrown are handled by the planner server and returned to the action
-  if (!_a_star->createPath(
-      path, num_iterations,
-      _tolerance / static_cast<float>(costmap->getResolution()), cancel_checker, expansions.get()))
+  bool path_found = _a_star->createPath(
+    path, num_iterations,
+    _tolerance / static_cast<float>(costmap->getResolution()), cancel_checker, expansions.get());
+
+  // The coarse costmap may hide obstacles blocking the corridor, fall back to the full search
+  // within the time left if the corridor was exhausted, but not if the search ran out of time
+  // or iterations
+  const double fallback_time = _max_planning_time -
+    duration_cast<duration<double>>(steady_clock::now() - a).count();
+  if (!path_found && corridor_set && !_a_star->hasTimedOut() &&
+    num_iterations < _a_star->getMaxIterations() && fallback_time > 0.0)
   {
+    RCLCPP_DEBUG(_logger, "No path found within the search corridor, searching the full costmap");
+    _a_star->setSearchCorridor(nullptr);
+    _a_star->setMaxPlanningTime(fallback_time);
+    _a_star->setCollisionChecker(&_collision_checker);
+    _a_star->setStart(mx_start, my_start, start_bin);
+    _a_star->setGoal(mx_goal, my_goal, goal_bin, _goal_heading_mode, _coarse_search_resolution);
+    path.clear();
+    num_iterations = 0;
+    if (expansions) {
+      expansions->clear();
+    }
+    path_found = _a_star->createPath(
+      path, num_iterations,
+      _tolerance / static_cast<float>(costmap->getResolution()), cancel_checker, expansions.get());
+  }
+
+  if (!path_found) {
     if (_debug_visualizations) {
       geometry_msgs::msg::PoseArray msg;
       geometry_msgs::msg::Pose msg_pose;
@@ -624,7 +681,9 @@ SmacPlannerHybrid::dynamicParametersCallback(std::vector<rclcpp::Parameter> para
       continue;
     }
     if (param_type == ParameterType::PARAMETER_DOUBLE) {
-      if (param_name == _name + ".max_planning_time") {
+      if (param_name == _name + ".hierarchical_corridor_width") {
+        _hierarchical_corridor_width = parameter.as_double();
+      } else if (param_name == _name + ".max_planning_time") {
         reinit_a_star = true;
         _max_planning_time = parameter.as_double();
       } else if (param_name == _name + ".tolerance") {
@@ -677,7 +736,9 @@ SmacPlannerHybrid::dynamicParametersCallback(std::vector<rclcpp::Parameter> para
         reinit_smoother = true;
       }
     } else if (param_type == ParameterType::PARAMETER_BOOL) {
-      if (param_name == _name + ".downsample_costmap") {
+      if (param_name == _name + ".hierarchical_planning") {
+        _hierarchical_planning = parameter.as_bool();
+      } else if (param_name == _name + ".downsample_costmap") {
         reinit_downsampler = true;
         _downsample_costmap = parameter.as_bool();
       } else if (param_name == _name + ".allow_unknown") {
@@ -725,6 +786,9 @@ SmacPlannerHybrid::dynamicParametersCallback(std::vector<rclcpp::Parameter> para
       } else if (param_name == _name + ".terminal_checking_interval") {
         reinit_a_star = true;
         _terminal_checking_interval = parameter.as_int();
+      } else if (param_name == _name + ".analytic_expansion_threads") {
+        reinit_a_star = true;
+        _search_info.analytic_expansion_threads = parameter.as_int();
       } else if (param_name == _name + ".angle_quantization_bins") {
         reinit_collision_checker = true;
         reinit_a_star = true;
@@ -739,6 +803,8 @@ SmacPlannerHybrid::dynamicParametersCallback(std::vector<rclcpp::Parameter> para
           );
           _coarse_search_resolution = 1;
         }
+      } else if (param_name == _name + ".hierarchical_downsampling_factor") {
+        _hierarchical_downsampling_factor = parameter.as_int();
       } else if (param_name == _name + ".coarse_search_resolution") {
         _coarse_search_resolution = parameter.as_int();
         if (_coarse_search_resolution <= 0) {
@@ -121,6 +121,10 @@ void SmacPlannerLattice::configure(
   node->get_parameter(
     name + ".analytic_expansion_max_cost_override",
     _search_info.analytic_expansion_max_cost_override);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".analytic_expansion_threads", rclcpp::ParameterValue(0));
+  node->get_parameter(
+    name + ".analytic_expansion_threads", _search_info.analytic_expansion_threads);
   nav2::declare_parameter_if_not_declared(
     node, name + ".analytic_expansion_max_length", rclcpp::ParameterValue(3.0));
   node->get_parameter(name + ".analytic_expansion_max_length", analytic_expansion_max_length_m);
@@ -133,6 +137,10 @@ void SmacPlannerLattice::configure(
   nav2::declare_parameter_if_not_declared(
     node, name + ".lookup_table_size", rclcpp::ParameterValue(20.0));
   node->get_parameter(name + ".lookup_table_size", _lookup_table_size);
+  nav2::declare_parameter_if_not_declared(
+    node, name + ".lookup_table_cache_directory", rclcpp::ParameterValue(std::string("")));
+  node->get_parameter(
+    name + ".lookup_table_cache_directory", _search_info.lookup_table_cache_directory);
   nav2::declare_parameter_if_not_declared(
     node, name + ".allow_reverse_expansion", rclcpp::ParameterValue(false));
   node->get_parameter(name + ".allow_reverse_expansion", _search_info.allow_reverse_expansion);
@@ -624,6 +632,9 @@ SmacPlannerLattice::dynamicParametersCallback(std::vector<rclcpp::Parameter> par
       } else if (param_name == _name + ".terminal_checking_interval") {
         reinit_a_star = true;
         _terminal_checking_interval = parameter.as_int();
+      } else if (param_name == _name + ".analytic_expansion_threads") {
+        reinit_a_star = true;
+        _search_info.analytic_expansion_threads = parameter.as_int();
       } else if (param_name == _name + ".coarse_search_resolution") {
         _coarse_search_resolution = parameter.as_int();
         if (_coarse_search_resolution <= 0) {
@@ -0,0 +1,128 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "nav2_smac_planner/collision_checker.hpp"
+
+// This is a script to benchmark the footprint collision checks of the GridCollisionChecker
+// against laying down the oriented footprint in the costmap with footprintCost(), for a
+// 0.5 x 0.3 m robot in a 0.05 m, 400 x 400 cells costmap, where most poses are close enough
+// to obstacles that their full footprint has to be checked
+
+const unsigned int SIZE = 400;
+const unsigned int NUM_OBSTACLES = 400;
+const unsigned int NUM_BINS = 72;
+const unsigned int NUM_CHECKS = 1000000;
+const double POSSIBLE_COLLISION_COST = 100.0;
+
+class GridCollisionCheckerBenchmark : public nav2_smac_planner::GridCollisionChecker
+{
+public:
+  using GridCollisionChecker::GridCollisionChecker;
+
+  // GridCollisionChecker::inCollision() before precomputing the footprint outline cells
+  bool footprintCostInCollision(float x, float y, unsigned int angle_bin)
+  {
+    const float center_cost = static_cast<float>(costmap_->getCost(
+      static_cast<unsigned int>(x + 0.5f), static_cast<unsigned int>(y + 0.5f)));
+    if (center_cost < possible_collision_cost_) {
+      return false;
+    }
+    if (center_cost >= nav2_smac_planner::INSCRIBED_COST) {
+      return true;
+    }
+    double wx, wy;
+    costmap_->mapToWorld(static_cast<unsigned int>(x), static_cast<unsigned int>(y), wx, wy);
+    geometry_msgs::msg::Point new_pt;
+    const nav2_costmap_2d::Footprint & oriented_footprint = oriented_footprints_[angle_bin];
+    nav2_costmap_2d::Footprint current_footprint;
+    current_footprint.reserve(oriented_footprint.size());
+    for (unsigned int i = 0; i < oriented_footprint.size(); ++i) {
+      new_pt.x = wx + oriented_footprint[i].x;
+      new_pt.y = wy + oriented_footprint[i].y;
+      current_footprint.push_back(new_pt);
+    }
+    return footprintCost(current_footprint) >= nav2_smac_planner::OCCUPIED_COST;
+  }
+};
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto node = std::make_shared<nav2::LifecycleNode>("collision_checker_benchmark");
+  auto costmap_ros = std::make_shared<nav2_costmap_2d::Costmap2DROS>();
+  costmap_ros->on_configure(rclcpp_lifecycle::State());
+  nav2_costmap_2d::Costmap2D * costmap = costmap_ros->getCostmap();
+  *costmap = nav2_costmap_2d::Costmap2D(SIZE, SIZE, 0.05, 0.0, 0.0, 0);
+
+  // Inflated costs everywhere, with some obstacles
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  unsigned char * costs = costmap->getCharMap();
+  for (unsigned int i = 0; i < SIZE * SIZE; ++i) {
+    costs[i] = static_cast<unsigned char>(150 + rng() % 50);
+  }
+  for (unsigned int i = 0; i < NUM_OBSTACLES; ++i) {
+    costs[rng() % (SIZE * SIZE)] = nav2_costmap_2d::LETHAL_OBSTACLE;
+  }
+
+  nav2_costmap_2d::Footprint footprint;
+  for (auto [x, y] : {std::pair{0.25, 0.15}, {-0.25, 0.15}, {-0.25, -0.15}, {0.25, -0.15}}) {
+    geometry_msgs::msg::Point point;
+    point.x = x;
+    point.y = y;
+    footprint.push_back(point);
+  }
+  GridCollisionCheckerBenchmark collision_checker(costmap_ros, NUM_BINS, node);
+  collision_checker.setFootprint(footprint, false, POSSIBLE_COLLISION_COST);
+
+  std::vector<std::tuple<float, float, unsigned int>> poses;
+  poses.reserve(NUM_CHECKS);
+  for (unsigned int i = 0; i < NUM_CHECKS; ++i) {
+    poses.emplace_back(
+      20.0f + uniform(rng) * (SIZE - 40), 20.0f + uniform(rng) * (SIZE - 40), rng() % NUM_BINS);
+  }
+
+  unsigned int footprint_cost_collisions = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto & [x, y, bin] : poses) {
+    footprint_cost_collisions += collision_checker.footprintCostInCollision(x, y, bin);
+  }
+  const std::chrono::duration<double> footprint_cost_time = std::chrono::steady_clock::now() -
+    start;
+
+  unsigned int collisions = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto & [x, y, bin] : poses) {
+    collisions += collision_checker.inCollision(x, y, static_cast<float>(bin), false);
+  }
+  const std::chrono::duration<double> time = std::chrono::steady_clock::now() - start;
+
+  printf(
+    "footprintCost():  %.2f M checks/s\n"
+    "inCollision():    %.2f M checks/s\n"
+    "Collisions: %u / %u %s\n",
+    NUM_CHECKS / footprint_cost_time.count() * 1e-6, NUM_CHECKS / time.count() * 1e-6,
+    collisions, footprint_cost_collisions,
+    collisions == footprint_cost_collisions ? "(consistent)" : "(INCONSISTENT)");
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -27,6 +27,7 @@
 #include "nav2_smac_planner/node_lattice.hpp"
 #include "nav2_smac_planner/a_star.hpp"
 #include "nav2_smac_planner/collision_checker.hpp"
+#include "nav2_smac_planner/search_corridor.hpp"
 #include "ament_index_cpp/get_package_share_directory.hpp"
 
 TEST(AStarTest, test_a_star_2d)
@@ -291,6 +292,166 @@ TEST(AStarTest, test_a_star_analytic_expansion)
   nav2_smac_planner::NodeHybrid::destroyStaticAssets();
 }
 
+TEST(AStarTest, test_a_star_speculative_analytic_expansion)
+{
+  auto lnode = std::make_shared<nav2::LifecycleNode>("test");
+  nav2_smac_planner::SearchInfo info;
+  info.change_penalty = 0.0;
+  info.non_straight_penalty = 1.1;
+  info.reverse_penalty = 0.0;
+  info.minimum_turning_radius = 8;  // in grid coordinates
+  info.retrospective_penalty = 0.015;
+  info.analytic_expansion_max_length = 2000.0;  // in grid coordinates
+  info.analytic_expansion_ratio = 3.5;
+  info.analytic_expansion_threads = 2;
+  unsigned int size_theta = 72;
+  info.cost_penalty = 1.7;
+  nav2_smac_planner::AStarAlgorithm<nav2_smac_planner::NodeHybrid> a_star(
+    nav2_smac_planner::MotionModel::REEDS_SHEPP, info);
+  int max_iterations = 10000;
+  float tolerance = 10.0;
+  int it_on_approach = 10;
+  int terminal_checking_interval = 5000;
+  double max_planning_time = 120.0;
+  int num_it = 0;
+
+  a_star.initialize(
+    false, max_iterations, it_on_approach, terminal_checking_interval,
+    max_planning_time, 401, size_theta);
+
+  nav2_costmap_2d::Costmap2D * costmapA =
+    new nav2_costmap_2d::Costmap2D(100, 100, 0.1, 0.0, 0.0, 0);
+
+  // Convert raw costmap into a costmap ros object
+  auto costmap_ros = std::make_shared<nav2_costmap_2d::Costmap2DROS>();
+  costmap_ros->on_configure(rclcpp_lifecycle::State());
+  auto costmap = costmap_ros->getCostmap();
+  *costmap = *costmapA;
+
+  std::unique_ptr<nav2_smac_planner::GridCollisionChecker> checker =
+    std::make_unique<nav2_smac_planner::GridCollisionChecker>(costmap_ros, size_theta, lnode);
+  checker->setFootprint(nav2_costmap_2d::Footprint(), true, 0.0);
+
+  // should be a straight path running backwards, found by the speculation workers
+  // and confirmed on the search thread
+  a_star.setCollisionChecker(checker.get());
+  a_star.setStart(80u, 0u, 0u);
+  a_star.setGoal(20u, 0u, 0u);
+  nav2_smac_planner::NodeHybrid::CoordinateVector path;
+  std::unique_ptr<std::vector<std::tuple<float, float, float>>> expansions = nullptr;
+  expansions = std::make_unique<std::vector<std::tuple<float, float, float>>>();
+
+  auto dummy_cancel_checker = []() {
+      return false;
+    };
+
+  EXPECT_TRUE(a_star.createPath(path, num_it, tolerance, dummy_cancel_checker, expansions.get()));
+
+  // all straight with no wiggle, from the goal to the start
+  ASSERT_FALSE(path.empty());
+  EXPECT_NEAR(path.front().x, 20.0, 1e-3);
+  EXPECT_NEAR(path.back().x, 80.0, 1e-3);
+  for (unsigned int i = 0; i != path.size(); i++) {
+    EXPECT_NEAR(path[i].theta, 0.0, 1e-3);
+  }
+
+  // The workers are idle between searches, the search can run again
+  num_it = 0;
+  path.clear();
+  EXPECT_TRUE(a_star.createPath(path, num_it, tolerance, dummy_cancel_checker, expansions.get()));
+
+  delete costmapA;
+  nav2_smac_planner::NodeHybrid::destroyStaticAssets();
+}
+
+TEST(AStarTest, test_a_star_search_corridor)
+{
+  auto lnode = std::make_shared<nav2::LifecycleNode>("test");
+  nav2_smac_planner::SearchInfo info;
+  nav2_smac_planner::AStarAlgorithm<nav2_smac_planner::Node2D> a_star(
+    nav2_smac_planner::MotionModel::TWOD, info);
+  int max_iterations = 10000;
+  float tolerance = 0.0;
+  int it_on_approach = 10;
+  int terminal_checking_interval = 1;
+  double max_planning_time = 120.0;
+  int num_it = 0;
+
+  a_star.initialize(
+    false, max_iterations, it_on_approach, terminal_checking_interval,
+    max_planning_time, 0.0, 1);
+
+  nav2_costmap_2d::Costmap2D * costmapA =
+    new nav2_costmap_2d::Costmap2D(100, 100, 0.1, 0.0, 0.0, 0);
+  // island in the middle of lethal cost to cross
+  for (unsigned int i = 40; i <= 60; ++i) {
+    for (unsigned int j = 40; j <= 60; ++j) {
+      costmapA->setCost(i, j, 254);
+    }
+  }
+
+  // Convert raw costmap into a costmap ros object
+  auto costmap_ros = std::make_shared<nav2_costmap_2d::Costmap2DROS>();
+  costmap_ros->on_configure(rclcpp_lifecycle::State());
+  auto costmap = costmap_ros->getCostmap();
+  *costmap = *costmapA;
+
+  auto dummy_cancel_checker = []() {
+      return false;
+    };
+
+  std::unique_ptr<nav2_smac_planner::GridCollisionChecker> checker =
+    std::make_unique<nav2_smac_planner::GridCollisionChecker>(costmap_ros, 1, lnode);
+  checker->setFootprint(nav2_costmap_2d::Footprint(), true, 0.0);
+  a_star.setCollisionChecker(checker.get());
+
+  // Search over the full costmap
+  nav2_smac_planner::Node2D::CoordinateVector path;
+  a_star.setStart(20u, 20u, 0);
+  a_star.setGoal(80u, 80u, 0);
+  EXPECT_TRUE(a_star.createPath(path, num_it, tolerance, dummy_cancel_checker));
+  EXPECT_FALSE(a_star.hasTimedOut());
+  const int full_iterations = num_it;
+
+  // The corridor around the coarse path around the island cuts the expansions
+  nav2_smac_planner::SearchCorridor corridor;
+  ASSERT_TRUE(corridor.compute(*costmapA, 20, 20, 80, 80, 4, 8.0f, false));
+  a_star.setSearchCorridor(&corridor);
+  a_star.setStart(20u, 20u, 0);
+  a_star.setGoal(80u, 80u, 0);
+  path.clear();
+  num_it = 0;
+  EXPECT_TRUE(a_star.createPath(path, num_it, tolerance, dummy_cancel_checker));
+  EXPECT_LT(num_it, full_iterations);
+  for (unsigned int i = 0; i != path.size(); i++) {
+    EXPECT_TRUE(
+      corridor.contains(
+        static_cast<unsigned int>(path[i].x), static_cast<unsigned int>(path[i].y)));
+    EXPECT_EQ(costmapA->getCost(path[i].x, path[i].y), 0);
+  }
+
+  // The time limit still applies within the corridor, reported as a time out
+  a_star.setMaxPlanningTime(0.0);
+  a_star.setStart(20u, 20u, 0);
+  a_star.setGoal(80u, 80u, 0);
+  path.clear();
+  num_it = 0;
+  EXPECT_FALSE(a_star.createPath(path, num_it, tolerance, dummy_cancel_checker));
+  EXPECT_TRUE(a_star.hasTimedOut());
+  EXPECT_LT(num_it, full_iterations);
+
+  // The time out is reset by the next search
+  a_star.setMaxPlanningTime(max_planning_time);
+  a_star.setStart(20u, 20u, 0);
+  a_star.setGoal(80u, 80u, 0);
+  path.clear();
+  num_it = 0;
+  EXPECT_TRUE(a_star.createPath(path, num_it, tolerance, dummy_cancel_checker));
+  EXPECT_FALSE(a_star.hasTimedOut());
+
+  delete costmapA;
+}
+
 TEST(AStarTest, test_a_star_lattice)
 {
   auto lnode = std::make_shared<nav2::LifecycleNode>("test");
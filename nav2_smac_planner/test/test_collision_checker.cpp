@@ -13,15 +13,28 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cmath>
 #include <string>
 #include <vector>
 #include <memory>
+#include <random>
 
 #include "gtest/gtest.h"
 #include "nav2_smac_planner/collision_checker.hpp"
 
 using namespace nav2_costmap_2d;  // NOLINT
 
+class GridCollisionCheckerWrapper : public nav2_smac_planner::GridCollisionChecker
+{
+public:
+  using GridCollisionChecker::GridCollisionChecker;
+
+  const nav2_costmap_2d::Footprint & getOrientedFootprint(unsigned int bin)
+  {
+    return oriented_footprints_[bin];
+  }
+};
+
 TEST(collision_footprint, test_basic)
 {
   auto node = std::make_shared<nav2::LifecycleNode>("testA");
@@ -215,6 +228,74 @@ TEST(collision_footprint, test_point_and_line_cost)
   delete costmap_;
 }
 
+TEST(collision_footprint, test_matches_footprint_cost)
+{
+  auto node = std::make_shared<nav2::LifecycleNode>("testF");
+  auto costmap_ros = std::make_shared<nav2_costmap_2d::Costmap2DROS>();
+  costmap_ros->on_configure(rclcpp_lifecycle::State());
+  auto costmap = costmap_ros->getCostmap();
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  for (int trial = 0; trial < 20; ++trial) {
+    // Alternate round and arbitrary geometries, vertices on cell boundaries being the tricky ones
+    const double resolution = trial % 2 == 0 ? 0.05 : 0.02 + 0.1 * uniform(rng);
+    const double origin_x = trial % 2 == 0 ? 0.0 : -5.0 * uniform(rng);
+    *costmap = nav2_costmap_2d::Costmap2D(80 + trial, 90, resolution, origin_x, 0.0, 0);
+    for (unsigned int i = 0; i < costmap->getSizeInCellsX() * costmap->getSizeInCellsY(); ++i) {
+      const double r = uniform(rng);
+      costmap->getCharMap()[i] =
+        r < 0.7 ? 0 : r < 0.85 ? 200 : r < 0.9 ? 253 : r < 0.95 ? 254 : 255;
+    }
+
+    nav2_costmap_2d::Footprint footprint;
+    const int num_vertices = trial % 2 == 0 ? 4 : 3 + trial % 5;
+    for (int i = 0; i < num_vertices; ++i) {
+      geometry_msgs::msg::Point p;
+      if (trial % 2 == 0) {
+        p.x = i < 2 ? 0.25 : -0.25;
+        p.y = i == 0 || i == 3 ? 0.15 : -0.15;
+      } else {
+        const double angle = 2.0 * M_PI * i / num_vertices;
+        const double radius = 0.1 + 0.4 * uniform(rng);
+        p.x = radius * std::cos(angle);
+        p.y = radius * std::sin(angle);
+      }
+      footprint.push_back(p);
+    }
+
+    GridCollisionCheckerWrapper collision_checker(costmap_ros, 72, node);
+    collision_checker.setFootprint(footprint, false /*use footprint*/, 100.0);
+    const unsigned int num_bins = collision_checker.getPrecomputedAngles().size();
+
+    for (int i = 0; i < 2000; ++i) {
+      const float x = uniform(rng) * costmap->getSizeInCellsX();
+      const float y = uniform(rng) * costmap->getSizeInCellsY();
+      const unsigned int bin = i % num_bins;
+      const bool traverse_unknown = i % 2 == 0;
+
+      // Reference from the oriented footprint placed at the pose cell center
+      bool expected = true;
+      const unsigned char center_cost = costmap->getCost(
+        static_cast<unsigned int>(x + 0.5f), static_cast<unsigned int>(y + 0.5f));
+      if (center_cost < 100) {
+        expected = false;
+      } else if (center_cost < 253 || (center_cost == 255 && traverse_unknown)) {
+        double wx, wy;
+        costmap->mapToWorld(static_cast<unsigned int>(x), static_cast<unsigned int>(y), wx, wy);
+        nav2_costmap_2d::Footprint oriented_footprint = collision_checker.getOrientedFootprint(bin);
+        for (auto & point : oriented_footprint) {
+          point.x += wx;
+          point.y += wy;
+        }
+        const double cost = collision_checker.footprintCost(oriented_footprint);
+        expected = traverse_unknown && cost == 255.0 ? false : cost >= 254.0;
+      }
+      EXPECT_EQ(collision_checker.inCollision(x, y, bin, traverse_unknown), expected);
+    }
+  }
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
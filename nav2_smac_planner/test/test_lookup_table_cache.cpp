@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "nav2_smac_planner/lookup_table_cache.hpp"
+
+using nav2_smac_planner::LookupTableCache;
+
+TEST(LookupTableCacheTest, test_disabled)
+{
+  LookupTableCache cache("");
+  EXPECT_FALSE(cache.isEnabled());
+  std::vector<float> table{1.0f, 2.0f};
+  EXPECT_FALSE(cache.save("table", 1u, table));
+  EXPECT_FALSE(cache.load("table", 1u, 2u, table));
+}
+
+TEST(LookupTableCacheTest, test_save_load)
+{
+  const auto directory = std::filesystem::temp_directory_path() / "test_lookup_table_cache";
+  std::filesystem::remove_all(directory);
+  LookupTableCache cache(directory.string());
+  EXPECT_TRUE(cache.isEnabled());
+
+  uint64_t key = LookupTableCache::INITIAL_KEY;
+  LookupTableCache::hash(key, 0.4f);
+  LookupTableCache::hash(key, 72u);
+  uint64_t other_key = LookupTableCache::INITIAL_KEY;
+  LookupTableCache::hash(other_key, 0.5f);
+  LookupTableCache::hash(other_key, 72u);
+  EXPECT_NE(key, other_key);
+
+  std::vector<float> table;
+  for (unsigned int i = 0; i < 1000; ++i) {
+    table.push_back(0.5f * i);
+  }
+
+  // Nothing stored yet, the directory is created on saving
+  std::vector<float> loaded;
+  EXPECT_FALSE(cache.load("table", key, table.size(), loaded));
+  ASSERT_TRUE(cache.save("table", key, table));
+  ASSERT_TRUE(cache.load("table", key, table.size(), loaded));
+  EXPECT_EQ(loaded, table);
+
+  // Tables of other names, keys or sizes are not loaded
+  EXPECT_FALSE(cache.load("other_table", key, table.size(), loaded));
+  EXPECT_FALSE(cache.load("table", other_key, table.size(), loaded));
+  EXPECT_FALSE(cache.load("table", key, table.size() + 1, loaded));
+
+  // Truncated or corrupted files are not loaded
+  for (const auto & entry : std::filesystem::directory_iterator(directory)) {
+    std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) - 1);
+  }
+  EXPECT_FALSE(cache.load("table", key, table.size(), loaded));
+  for (const auto & entry : std::filesystem::directory_iterator(directory)) {
+    std::ofstream file(entry.path(), std::ios::binary | std::ios::trunc);
+    file << "not a lookup table";
+  }
+  EXPECT_FALSE(cache.load("table", key, table.size(), loaded));
+
+  // Saving again replaces the table
+  ASSERT_TRUE(cache.save("table", key, table));
+  ASSERT_TRUE(cache.load("table", key, table.size(), loaded));
+  EXPECT_EQ(loaded, table);
+
+  std::filesystem::remove_all(directory);
+}
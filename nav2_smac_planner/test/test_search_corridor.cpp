@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_smac_planner/search_corridor.hpp"
+
+using nav2_smac_planner::SearchCorridor;
+
+TEST(SearchCorridorTest, test_corridor_around_coarse_path)
+{
+  // A wall across the costmap with a door at the top, covering whole coarse cells
+  nav2_costmap_2d::Costmap2D costmap(100, 100, 0.05, 0.0, 0.0, 0);
+  auto set_wall = [&](unsigned int y_min, unsigned int y_max, unsigned char cost) {
+      for (unsigned int x = 48; x < 56; ++x) {
+        for (unsigned int y = y_min; y < y_max; ++y) {
+          costmap.setCost(x, y, cost);
+        }
+      }
+    };
+  set_wall(0, 80, nav2_costmap_2d::LETHAL_OBSTACLE);
+
+  SearchCorridor corridor;
+  EXPECT_FALSE(corridor.isSet());
+  ASSERT_TRUE(corridor.compute(costmap, 10, 10, 90, 10, 4, 8.0f, false));
+  EXPECT_TRUE(corridor.isSet());
+  EXPECT_TRUE(corridor.contains(10, 10));
+  EXPECT_TRUE(corridor.contains(90, 10));
+
+  // The corridor goes through the door, not along the bottom of the wall
+  EXPECT_TRUE(corridor.contains(50, 85));
+  EXPECT_FALSE(corridor.contains(50, 10));
+  EXPECT_FALSE(corridor.contains(200, 10));
+
+  // The coarse path goes from the start to the goal
+  const auto & coarse_path = corridor.getCoarsePath();
+  ASSERT_GE(coarse_path.size(), 2u);
+  EXPECT_EQ(coarse_path.front(), 2u * 25u + 2u);
+  EXPECT_EQ(coarse_path.back(), 2u * 25u + 22u);
+
+  // Without a door, no corridor is set
+  set_wall(80, 100, nav2_costmap_2d::LETHAL_OBSTACLE);
+  EXPECT_FALSE(corridor.compute(costmap, 10, 10, 90, 10, 4, 8.0f, false));
+  EXPECT_FALSE(corridor.isSet());
+
+  // Unless unknown space may be traversed through
+  set_wall(80, 100, nav2_costmap_2d::NO_INFORMATION);
+  EXPECT_FALSE(corridor.compute(costmap, 10, 10, 90, 10, 4, 8.0f, false));
+  EXPECT_TRUE(corridor.compute(costmap, 10, 10, 90, 10, 4, 8.0f, true));
+  EXPECT_TRUE(corridor.contains(50, 85));
+}
+
+TEST(SearchCorridorTest, test_thin_obstacles_hidden)
+{
+  // A wall thinner than a coarse cell is not seen by the coarse path
+  nav2_costmap_2d::Costmap2D costmap(100, 100, 0.05, 0.0, 0.0, 0);
+  for (unsigned int y = 0; y < 100; ++y) {
+    costmap.setCost(50, y, nav2_costmap_2d::LETHAL_OBSTACLE);
+  }
+  SearchCorridor corridor;
+  EXPECT_TRUE(corridor.compute(costmap, 10, 10, 90, 10, 4, 8.0f, false));
+
+  // Out of bounds start or goal
+  EXPECT_FALSE(corridor.compute(costmap, 100, 10, 90, 10, 4, 8.0f, false));
+  EXPECT_FALSE(corridor.isSet());
+}
@@ -0,0 +1,205 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_UTIL__PATH_TRACKER_HPP_
+#define NAV2_UTIL__PATH_TRACKER_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "geometry_msgs/msg/transform_stamped.hpp"
+#include "nav_msgs/msg/path.hpp"
+#include "rclcpp/logger.hpp"
+#include "tf2/time.hpp"
+#include "tf2_ros/buffer.h"
+
+namespace nav2_util
+{
+
+/**
+ * @class nav2_util::PathTracker
+ * @brief Tracks the progress of a controller along its global plan. The plan positions
+ * and integrated distances are cached in flat arrays when the plan is set, so that
+ * searching along the plan does not go through the pose messages, the passed poses are
+ * pruned in constant time, and only the poses in use are transformed, with a single
+ * transform lookup. Indices are those of the poses in the plan given to setPlan().
+ */
+class PathTracker
+{
+public:
+  /**
+   * @brief How the transform tolerance of transformPoses() is applied
+   */
+  enum class TransformTolerance
+  {
+    /// Timeout of the transform lookup at the requested time
+    LOOKUP_TIMEOUT,
+    /// Maximum age of the latest transform, used without waiting when the transform
+    /// at the requested time is not available yet, as nav_2d_utils::transformPose() does
+    LATEST_TRANSFORM_AGE
+  };
+
+  /**
+   * @brief Sets the plan to track, from its first pose
+   * @param plan Plan to track
+   */
+  void setPlan(const nav_msgs::msg::Path & plan);
+
+  /**
+   * @brief Whether there are no poses of the plan left to track
+   */
+  bool empty() const {return begin_ == x_.size();}
+
+  /**
+   * @brief Number of poses of the plan left to track
+   */
+  size_t size() const {return x_.size() - begin_;}
+
+  /**
+   * @brief Index of the first pose of the plan left to track
+   */
+  size_t begin() const {return begin_;}
+
+  /**
+   * @brief Index past the last pose of the plan
+   */
+  size_t end() const {return x_.size();}
+
+  /**
+   * @brief Frame of the plan
+   */
+  const std::string & getFrameId() const {return plan_.header.frame_id;}
+
+  /**
+   * @brief Pose of the plan at an index
+   */
+  const geometry_msgs::msg::PoseStamped & getPose(const size_t index) const
+  {
+    return plan_.poses[index];
+  }
+
+  /**
+   * @brief Copy of the poses of the plan left to track
+   */
+  nav_msgs::msg::Path getRemainingPlan() const;
+
+  /**
+   * @brief 2D distance between the pose of the plan at an index and a position
+   */
+  double distance(const size_t index, const double x, const double y) const
+  {
+    return std::hypot(x_[index] - x, y_[index] - y);
+  }
+
+  /**
+   * @brief Index of the first pose further than an integrated distance along the plan
+   * from a pose, as geometry_utils::first_after_integrated_distance() but in log time
+   * @param first Index of the pose to integrate the distance from
+   * @param distance Integrated distance
+   * @return Index of the first pose past the integrated distance, or end()
+   */
+  size_t firstAfterIntegratedDistance(size_t first, double distance) const;
+
+  /**
+   * @brief Index of the closest pose to a position, the latest one on ties
+   * @param first Index of the first pose to search
+   * @param last Index past the last pose to search
+   * @param x X-coordinate of the position, in the plan frame
+   * @param y Y-coordinate of the position, in the plan frame
+   * @return Index of the closest pose, or last if the search range is empty
+   */
+  size_t findClosestPose(size_t first, size_t last, double x, double y) const;
+
+  /**
+   * @brief Index of the first pose further than a distance from a position
+   * @param first Index of the first pose to search
+   * @param last Index past the last pose to search
+   * @param x X-coordinate of the position, in the plan frame
+   * @param y Y-coordinate of the position, in the plan frame
+   * @param distance Distance from the position
+   * @return Index of the first pose further than distance, or last
+   */
+  size_t findFirstFurtherThan(
+    size_t first, size_t last, double x, double y, double distance) const;
+
+  /**
+   * @brief Index of the first pose closer than a distance from a position
+   * @param first Index of the first pose to search
+   * @param last Index past the last pose to search
+   * @param x X-coordinate of the position, in the plan frame
+   * @param y Y-coordinate of the position, in the plan frame
+   * @param distance Distance from the position
+   * @return Index of the first pose closer than distance, or last
+   */
+  size_t findFirstCloserThan(
+    size_t first, size_t last, double x, double y, double distance) const;
+
+  /**
+   * @brief Stops tracking the poses before an index, in constant time
+   * @param first Index of the first pose left to track
+   */
+  void prune(const size_t first)
+  {
+    begin_ = std::max(begin_, std::min(first, x_.size()));
+  }
+
+  /**
+   * @brief Transforms poses of the plan into another frame, looking up the transform once
+   * @param first Index of the first pose to transform
+   * @param last Index past the last pose to transform
+   * @param tf TF buffer to look up the transform from
+   * @param frame Frame to transform the poses into
+   * @param stamp Time to transform the poses at
+   * @param transform_tolerance Transform tolerance, applied as set by tolerance_type
+   * @param transformed_plan Output transformed poses, stamped at the given time
+   * @param tolerance_type How the transform tolerance is applied
+   * @return False if the transform is not available
+   */
+  bool transformPoses(
+    size_t first, size_t last, tf2_ros::Buffer & tf, const std::string & frame,
+    const builtin_interfaces::msg::Time & stamp, const tf2::Duration & transform_tolerance,
+    nav_msgs::msg::Path & transformed_plan,
+    TransformTolerance tolerance_type = TransformTolerance::LOOKUP_TIMEOUT) const;
+
+protected:
+  /**
+   * @brief Looks up the transform from the plan frame at a time, falling back to the latest
+   * transform without waiting when the one at that time is not available yet
+   * @param tf TF buffer to look up the transform from
+   * @param frame Frame to transform into
+   * @param stamp Time to look up the transform at
+   * @param max_age Maximum age of the latest transform relative to the stamp
+   * @return The transform
+   * @throw tf2::TransformException if no transform is available or the latest one is too old
+   */
+  geometry_msgs::msg::TransformStamped lookupLatestTransform(
+    tf2_ros::Buffer & tf, const std::string & frame, const builtin_interfaces::msg::Time & stamp,
+    const tf2::Duration & max_age) const;
+
+  rclcpp::Logger logger_{rclcpp::get_logger("PathTracker")};
+  nav_msgs::msg::Path plan_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+  /// @brief Distance integrated along the plan from its first pose to each pose
+  std::vector<double> integrated_distance_;
+  size_t begin_{0};
+};
+
+}  // namespace nav2_util
+
+#endif  // NAV2_UTIL__PATH_TRACKER_HPP_
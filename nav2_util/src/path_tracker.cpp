@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_util/path_tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
+#include "rclcpp/logging.hpp"
+
+namespace nav2_util
+{
+
+void PathTracker::setPlan(const nav_msgs::msg::Path & plan)
+{
+  plan_ = plan;
+  begin_ = 0;
+
+  const size_t size = plan_.poses.size();
+  x_.resize(size);
+  y_.resize(size);
+  integrated_distance_.resize(size);
+  double integrated_distance = 0.0;
+  for (size_t i = 0; i < size; ++i) {
+    x_[i] = plan_.poses[i].pose.position.x;
+    y_[i] = plan_.poses[i].pose.position.y;
+    if (i > 0) {
+      integrated_distance += std::hypot(x_[i] - x_[i - 1], y_[i] - y_[i - 1]);
+    }
+    integrated_distance_[i] = integrated_distance;
+  }
+}
+
+nav_msgs::msg::Path PathTracker::getRemainingPlan() const
+{
+  nav_msgs::msg::Path plan;
+  plan.header = plan_.header;
+  plan.poses.assign(plan_.poses.begin() + begin_, plan_.poses.end());
+  return plan;
+}
+
+size_t PathTracker::firstAfterIntegratedDistance(size_t first, double distance) const
+{
+  if (first >= end()) {
+    return end();
+  }
+  const double max_integrated_distance = integrated_distance_[first] + distance;
+  return std::upper_bound(
+    integrated_distance_.begin() + first + 1, integrated_distance_.end(),
+    max_integrated_distance) - integrated_distance_.begin();
+}
+
+size_t PathTracker::findClosestPose(size_t first, size_t last, double x, double y) const
+{
+  last = std::min(last, end());
+  if (first >= last) {
+    return last;
+  }
+
+  // Squared distances preserve the order, the latest pose wins ties as in geometry_utils::min_by
+  size_t closest = first;
+  double closest_sq_distance = std::numeric_limits<double>::max();
+  for (size_t i = first; i < last; ++i) {
+    const double dx = x_[i] - x;
+    const double dy = y_[i] - y;
+    const double sq_distance = dx * dx + dy * dy;
+    if (sq_distance <= closest_sq_distance) {
+      closest_sq_distance = sq_distance;
+      closest = i;
+    }
+  }
+  return closest;
+}
+
+size_t PathTracker::findFirstFurtherThan(
+  size_t first, size_t last, double x, double y, double distance) const
+{
+  last = std::min(last, end());
+  const double sq_distance = distance * distance;
+  for (size_t i = first; i < last; ++i) {
+    const double dx = x_[i] - x;
+    const double dy = y_[i] - y;
+    if (dx * dx + dy * dy > sq_distance) {
+      return i;
+    }
+  }
+  return last;
+}
+
+size_t PathTracker::findFirstCloserThan(
+  size_t first, size_t last, double x, double y, double distance) const
+{
+  last = std::min(last, end());
+  const double sq_distance = distance * distance;
+  for (size_t i = first; i < last; ++i) {
+    const double dx = x_[i] - x;
+    const double dy = y_[i] - y;
+    if (dx * dx + dy * dy < sq_distance) {
+      return i;
+    }
+  }
+  return last;
+}
+
+bool PathTracker::transformPoses(
+  size_t first, size_t last, tf2_ros::Buffer & tf, const std::string & frame,
+  const builtin_interfaces::msg::Time & stamp, const tf2::Duration & transform_tolerance,
+  nav_msgs::msg::Path & transformed_plan, TransformTolerance tolerance_type) const
+{
+  last = std::min(last, end());
+  transformed_plan.header.frame_id = frame;
+  transformed_plan.header.stamp = stamp;
+  transformed_plan.poses.clear();
+  if (first >= last) {
+    return true;
+  }
+  transformed_plan.poses.reserve(last - first);
+
+  geometry_msgs::msg::TransformStamped transform;
+  const bool same_frame = plan_.header.frame_id == frame;
+  if (!same_frame) {
+    try {
+      if (tolerance_type == TransformTolerance::LOOKUP_TIMEOUT) {
+        transform = tf.lookupTransform(
+          frame, plan_.header.frame_id, tf2_ros::fromMsg(stamp), transform_tolerance);
+      } else {
+        transform = lookupLatestTransform(tf, frame, stamp, transform_tolerance);
+      }
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR(logger_, "Exception in transformPoses: %s", ex.what());
+      return false;
+    }
+  }
+
+  for (size_t i = first; i < last; ++i) {
+    geometry_msgs::msg::PoseStamped transformed_pose;
+    if (same_frame) {
+      transformed_pose.pose = plan_.poses[i].pose;
+    } else {
+      tf2::doTransform(plan_.poses[i].pose, transformed_pose.pose, transform);
+    }
+    transformed_pose.header.frame_id = frame;
+    transformed_pose.header.stamp = stamp;
+    transformed_plan.poses.push_back(std::move(transformed_pose));
+  }
+  return true;
+}
+
+geometry_msgs::msg::TransformStamped PathTracker::lookupLatestTransform(
+  tf2_ros::Buffer & tf, const std::string & frame, const builtin_interfaces::msg::Time & stamp,
+  const tf2::Duration & max_age) const
+{
+  try {
+    return tf.lookupTransform(frame, plan_.header.frame_id, tf2_ros::fromMsg(stamp));
+  } catch (tf2::ExtrapolationException &) {
+    // The transform at the stamp is not available yet: use the latest one, if recent enough
+    auto transform = tf.lookupTransform(frame, plan_.header.frame_id, tf2::TimePointZero);
+    if (tf2_ros::fromMsg(stamp) - tf2_ros::fromMsg(transform.header.stamp) > max_age) {
+      throw tf2::ExtrapolationException(
+              "Transform data too old when converting from " + plan_.header.frame_id + " to " +
+              frame);
+    }
+    return transform;
+  }
+}
+
+}  // namespace nav2_util
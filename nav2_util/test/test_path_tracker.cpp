@@ -0,0 +1,184 @@
+// Copyright (c) 2025 Open Navigation LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "nav2_util/geometry_utils.hpp"
+#include "nav2_util/path_tracker.hpp"
+#include "geometry_msgs/msg/transform_stamped.hpp"
+#include "nav_msgs/msg/path.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "tf2_ros/buffer.h"
+#include "gtest/gtest.h"
+
+using nav2_util::PathTracker;
+
+nav_msgs::msg::Path makePath()
+{
+  // A path going along X and turning back over itself
+  nav_msgs::msg::Path path;
+  path.header.frame_id = "map";
+  for (int i = 0; i < 10; ++i) {
+    geometry_msgs::msg::PoseStamped pose;
+    pose.pose.position.x = i;
+    path.poses.push_back(pose);
+  }
+  for (int i = 0; i < 10; ++i) {
+    geometry_msgs::msg::PoseStamped pose;
+    pose.pose.position.x = 9 - i;
+    pose.pose.position.y = 0.5;
+    path.poses.push_back(pose);
+  }
+  return path;
+}
+
+TEST(PathTracker, searchesMatchGeometryUtils)
+{
+  auto path = makePath();
+  PathTracker tracker;
+  tracker.setPlan(path);
+  EXPECT_EQ(tracker.size(), 20u);
+  EXPECT_EQ(tracker.getFrameId(), "map");
+
+  for (double distance : {0.0, 0.5, 3.0, 9.0, 12.2, 100.0}) {
+    auto expected = nav2_util::geometry_utils::first_after_integrated_distance(
+      path.poses.begin(), path.poses.end(), distance);
+    EXPECT_EQ(
+      tracker.firstAfterIntegratedDistance(0, distance),
+      static_cast<size_t>(expected - path.poses.begin()));
+  }
+
+  // The search bound keeps the closest pose on the first leg of the path
+  size_t upper_bound = tracker.firstAfterIntegratedDistance(0, 7.0);
+  EXPECT_EQ(tracker.findClosestPose(0, upper_bound, 2.1, 0.4), 2u);
+  EXPECT_EQ(tracker.findClosestPose(0, tracker.end(), 2.1, 0.4), 17u);
+  EXPECT_EQ(tracker.findClosestPose(3, 3, 2.1, 0.4), 3u);
+
+  EXPECT_EQ(tracker.findFirstFurtherThan(2, tracker.end(), 2.0, 0.0, 3.0), 6u);
+  EXPECT_EQ(tracker.findFirstCloserThan(0, tracker.end(), 5.0, 0.0, 1.5), 4u);
+  EXPECT_EQ(tracker.findFirstCloserThan(0, 3, 5.0, 0.0, 1.5), 3u);
+  EXPECT_NEAR(tracker.distance(4, 1.0, 4.0), 5.0, 1e-9);
+}
+
+TEST(PathTracker, prune)
+{
+  PathTracker tracker;
+  tracker.setPlan(makePath());
+  tracker.prune(5);
+  EXPECT_EQ(tracker.begin(), 5u);
+  EXPECT_EQ(tracker.size(), 15u);
+
+  // Integrated distances are taken from the given pose
+  EXPECT_EQ(tracker.firstAfterIntegratedDistance(tracker.begin(), 2.5), 8u);
+
+  // Pruning never moves backwards
+  tracker.prune(2);
+  EXPECT_EQ(tracker.begin(), 5u);
+
+  auto remaining = tracker.getRemainingPlan();
+  EXPECT_EQ(remaining.header.frame_id, "map");
+  ASSERT_EQ(remaining.poses.size(), 15u);
+  EXPECT_EQ(remaining.poses[0].pose.position.x, 5.0);
+
+  tracker.prune(100);
+  EXPECT_TRUE(tracker.empty());
+
+  // Setting a new plan tracks it from its start
+  tracker.setPlan(makePath());
+  EXPECT_EQ(tracker.begin(), 0u);
+  EXPECT_EQ(tracker.size(), 20u);
+}
+
+TEST(PathTracker, transformPoses)
+{
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  tf2_ros::Buffer buffer(clock);
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.frame_id = "odom";
+  transform.child_frame_id = "map";
+  transform.transform.translation.x = 1.0;
+  transform.transform.translation.y = -2.0;
+  transform.transform.rotation.w = 1.0;
+  buffer.setTransform(transform, "test", true);
+
+  PathTracker tracker;
+  tracker.setPlan(makePath());
+
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = 10;
+  nav_msgs::msg::Path transformed;
+  ASSERT_TRUE(
+    tracker.transformPoses(2, 5, buffer, "odom", stamp, tf2::durationFromSec(0.1), transformed));
+  EXPECT_EQ(transformed.header.frame_id, "odom");
+  EXPECT_EQ(transformed.header.stamp.sec, 10);
+  ASSERT_EQ(transformed.poses.size(), 3u);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(transformed.poses[i].header.frame_id, "odom");
+    EXPECT_NEAR(transformed.poses[i].pose.position.x, 3.0 + i, 1e-9);
+    EXPECT_NEAR(transformed.poses[i].pose.position.y, -2.0, 1e-9);
+  }
+
+  // Poses already in the target frame are copied
+  ASSERT_TRUE(
+    tracker.transformPoses(0, 2, buffer, "map", stamp, tf2::durationFromSec(0.1), transformed));
+  ASSERT_EQ(transformed.poses.size(), 2u);
+  EXPECT_EQ(transformed.poses[1].pose.position.x, 1.0);
+
+  // Unknown frames fail without throwing
+  EXPECT_FALSE(
+    tracker.transformPoses(0, 2, buffer, "base", stamp, tf2::durationFromSec(0.0), transformed));
+}
+
+TEST(PathTracker, transformPosesWithStaleTransform)
+{
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  tf2_ros::Buffer buffer(clock);
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.frame_id = "odom";
+  transform.header.stamp.sec = 10;
+  transform.child_frame_id = "map";
+  transform.transform.translation.x = 1.0;
+  transform.transform.rotation.w = 1.0;
+  buffer.setTransform(transform, "test", false);
+
+  PathTracker tracker;
+  tracker.setPlan(makePath());
+
+  // The transform lags half a second behind the requested time
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = 10;
+  stamp.nanosec = 500000000;
+  nav_msgs::msg::Path transformed;
+
+  // The latest transform is used if within the tolerance
+  ASSERT_TRUE(
+    tracker.transformPoses(
+      2, 4, buffer, "odom", stamp, tf2::durationFromSec(1.0), transformed,
+      PathTracker::TransformTolerance::LATEST_TRANSFORM_AGE));
+  ASSERT_EQ(transformed.poses.size(), 2u);
+  EXPECT_NEAR(transformed.poses[0].pose.position.x, 3.0, 1e-9);
+  EXPECT_EQ(transformed.header.stamp.nanosec, 500000000u);
+
+  // But not if older
+  EXPECT_FALSE(
+    tracker.transformPoses(
+      2, 4, buffer, "odom", stamp, tf2::durationFromSec(0.2), transformed,
+      PathTracker::TransformTolerance::LATEST_TRANSFORM_AGE));
+
+  // A lookup timeout does not accept the latest transform
+  EXPECT_FALSE(
+    tracker.transformPoses(
+      2, 4, buffer, "odom", stamp, tf2::durationFromSec(0.0), transformed,
+      PathTracker::TransformTolerance::LOOKUP_TIMEOUT));
+}
@@ -0,0 +1,85 @@
+#! /usr/bin/env python3
+# Copyright (c) 2025 Open Navigation LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import glob
+import os
+from random import seed
+import time
+
+from metrics import getRandomGoal, getRandomStart
+from nav2_msgs.srv import ComputePaths
+from nav2_simple_commander.robot_navigator import BasicNavigator
+import numpy as np
+import rclpy
+
+
+def main() -> None:
+    rclpy.init()
+
+    navigator = BasicNavigator()
+
+    # Set map to use, other options: 100by100_15, 100by100_10
+    map_path = os.getcwd() + '/' + glob.glob('**/100by100_20.yaml', recursive=True)[0]
+    navigator.changeMap(map_path)
+    time.sleep(2)
+
+    # Get the costmap for start/goal validation
+    costmap_msg = navigator.getGlobalCostmap()
+    costmap = np.asarray(costmap_msg.data)
+    costmap.resize(costmap_msg.metadata.size_y, costmap_msg.metadata.size_x)
+
+    planners = ['Navfn', 'ThetaStar', 'SmacHybrid', 'Smac2d', 'SmacLattice']
+    max_cost = 210
+    side_buffer = 100
+    time_stamp = navigator.get_clock().now().to_msg()
+    seed(33)
+
+    random_pairs = 100
+    res = costmap_msg.metadata.resolution
+    request = ComputePaths.Request()
+    for _ in range(random_pairs):
+        start = getRandomStart(costmap, max_cost, side_buffer, time_stamp, res)
+        request.starts.append(start)
+        request.goals.append(
+            getRandomGoal(costmap, start, max_cost, side_buffer, time_stamp, res))
+
+    client = navigator.create_client(ComputePaths, 'compute_paths')
+    while not client.wait_for_service(timeout_sec=1.0):
+        print("'compute_paths' service not available, waiting...")
+
+    # Compare the throughput of the action, one pair at a time, with the batch service
+    for planner in planners:
+        start_time = time.perf_counter()
+        for start, goal in zip(request.starts, request.goals):
+            navigator._getPathImpl(start, goal, planner, use_start=True)
+        sequential_time = time.perf_counter() - start_time
+
+        request.planner_id = planner
+        start_time = time.perf_counter()
+        future = client.call_async(request)
+        rclpy.spin_until_future_complete(navigator, future)
+        batch_time = time.perf_counter() - start_time
+        response = future.result()
+        num_valid = sum(1 for error_code in response.error_codes if error_code == 0)
+
+        print(f'{planner}: {random_pairs / sequential_time:.2f} paths/s sequentially, '
+              f'{random_pairs / batch_time:.2f} paths/s in a batch '
+              f'({num_valid} / {random_pairs} valid)')
+
+    exit(0)
+
+
+if __name__ == '__main__':
+    main()